@@ -0,0 +1,110 @@
+// benchmarks/bench_c_api.cpp
+#include <sparkplug/sparkplug_c.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Worst case for 1000 double metrics with names stays well below this
+constexpr size_t BUFFER_SIZE = 256 * 1024;
+
+// Build and serialize through the C API, as a C publisher does for each NDATA
+void BM_CPayloadSerialize(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer(BUFFER_SIZE);
+  size_t written = 0;
+  for (auto _ : state) {
+    sparkplug_payload_t* payload = sparkplug_payload_create();
+    for (uint64_t alias = 1; alias <= count; alias++) {
+      sparkplug_payload_add_double_by_alias(payload, alias, static_cast<double>(alias));
+    }
+    written = sparkplug_payload_serialize(payload, buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(written);
+    sparkplug_payload_destroy(payload);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] = static_cast<double>(written);
+}
+BENCHMARK(BM_CPayloadSerialize)->Arg(10)->Arg(100)->Arg(1000);
+
+// BM_CPayloadSerialize with one reused payload filled by a single bulk call
+void BM_CPayloadSerializeBulk(benchmark::State& state) {
+  auto count = static_cast<size_t>(state.range(0));
+  std::vector<uint8_t> buffer(BUFFER_SIZE);
+  std::vector<uint64_t> aliases(count);
+  std::vector<double> values(count);
+  for (size_t i = 0; i < count; i++) {
+    aliases[i] = i + 1;
+    values[i] = static_cast<double>(i + 1);
+  }
+  sparkplug_payload_t* payload = sparkplug_payload_create();
+  size_t written = 0;
+  for (auto _ : state) {
+    sparkplug_payload_reset(payload);
+    sparkplug_payload_add_double_array_by_alias(payload, aliases.data(), values.data(), count, 0);
+    written = sparkplug_payload_serialize(payload, buffer.data(), buffer.size());
+    benchmark::DoNotOptimize(written);
+  }
+  sparkplug_payload_destroy(payload);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes"] = static_cast<double>(written);
+}
+BENCHMARK(BM_CPayloadSerializeBulk)->Arg(10)->Arg(100)->Arg(1000);
+
+// Parse and read back every metric, as a C subscriber does in its message callback
+void BM_CPayloadParse(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer(BUFFER_SIZE);
+  sparkplug_payload_t* source = sparkplug_payload_create();
+  for (uint64_t alias = 1; alias <= count; alias++) {
+    auto name = std::format("Metric{}", alias);
+    sparkplug_payload_add_double_with_alias(source, name.c_str(), alias,
+                                            static_cast<double>(alias));
+  }
+  size_t size = sparkplug_payload_serialize(source, buffer.data(), buffer.size());
+  sparkplug_payload_destroy(source);
+
+  for (auto _ : state) {
+    sparkplug_payload_t* payload = sparkplug_payload_parse(buffer.data(), size);
+    size_t metrics = sparkplug_payload_get_metric_count(payload);
+    double sum = 0.0;
+    for (size_t i = 0; i < metrics; i++) {
+      sparkplug_metric_t metric;
+      if (sparkplug_payload_get_metric_at(payload, i, &metric) && !metric.is_null) {
+        sum += metric.value.double_value;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    sparkplug_payload_destroy(payload);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_CPayloadParse)->Arg(10)->Arg(100)->Arg(1000);
+
+// Serialize then parse the same payload: the full C encode/decode round trip
+void BM_CPayloadRoundTrip(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer(BUFFER_SIZE);
+  for (auto _ : state) {
+    sparkplug_payload_t* payload = sparkplug_payload_create();
+    for (uint64_t alias = 1; alias <= count; alias++) {
+      sparkplug_payload_add_double_by_alias(payload, alias, static_cast<double>(alias));
+    }
+    size_t size = sparkplug_payload_serialize(payload, buffer.data(), buffer.size());
+    sparkplug_payload_destroy(payload);
+
+    sparkplug_payload_t* parsed = sparkplug_payload_parse(buffer.data(), size);
+    benchmark::DoNotOptimize(sparkplug_payload_get_metric_count(parsed));
+    sparkplug_payload_destroy(parsed);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CPayloadRoundTrip)->Arg(10)->Arg(100)->Arg(1000);
+
+} // namespace
@@ -0,0 +1,46 @@
+// benchmarks/bench_common.hpp
+#pragma once
+
+#include <sparkplug/payload_builder.hpp>
+
+#include <array>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace sparkplug::bench {
+
+// Sparkplug seq wraps at 256, so one pre-encoded NDATA per seq value replays any stream
+constexpr size_t SEQ_VALUES = 256;
+
+inline std::string node_topic(std::string_view type, size_t node) {
+  return std::format("spBv1.0/Bench/{}/Node{:05}", type, node);
+}
+
+// NBIRTH declaring `metrics` double metrics with aliases 1..metrics, plus bdSeq
+inline std::vector<uint8_t> make_nbirth(size_t metrics, uint64_t bd_seq = 0) {
+  PayloadBuilder birth;
+  birth.set_seq(0);
+  birth.add_metric("bdSeq", bd_seq);
+  for (size_t i = 0; i < metrics; i++) {
+    birth.add_metric_with_alias(std::format("Metric{}", i), i + 1, static_cast<double>(i));
+  }
+  return birth.build();
+}
+
+// Alias-only NDATA updating every metric of make_nbirth(metrics), one per seq value
+inline std::array<std::vector<uint8_t>, SEQ_VALUES> make_ndata_stream(size_t metrics) {
+  std::array<std::vector<uint8_t>, SEQ_VALUES> stream;
+  for (size_t seq = 0; seq < SEQ_VALUES; seq++) {
+    PayloadBuilder data;
+    data.set_seq(seq);
+    for (size_t i = 0; i < metrics; i++) {
+      data.add_metric_by_alias(i + 1, static_cast<double>(seq + i));
+    }
+    stream[seq] = data.build();
+  }
+  return stream;
+}
+
+} // namespace sparkplug::bench
@@ -0,0 +1,118 @@
+// benchmarks/bench_host_ingest.cpp
+#include "bench_common.hpp"
+
+#include <sparkplug/host_application.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t METRICS_PER_MESSAGE = 10;
+
+enum class Tracking : int64_t {
+  None = 0,      // validate_sequence off: decode and callback only
+  Sequence = 1,  // default host: seq/bdSeq validation per node
+  Resolve = 2,   // plus resolve_aliases and track_values
+};
+
+sparkplug::HostApplication make_host(Tracking tracking, uint64_t& delivered) {
+  sparkplug::HostApplication::Config config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "bench_host",
+      .host_id = "bench_host",
+      .validate_sequence = tracking != Tracking::None,
+      .resolve_aliases = tracking == Tracking::Resolve,
+      .track_values = tracking == Tracking::Resolve,
+      .message_callback =
+          [&delivered](const sparkplug::Topic&, const org::eclipse::tahu::protobuf::Payload&) {
+            delivered++;
+          }};
+  return sparkplug::HostApplication(std::move(config));
+}
+
+// NDATA ingest (decode, validate_message, callback) round-robin across many online nodes
+void BM_HostIngestNodes(benchmark::State& state) {
+  auto node_count = static_cast<size_t>(state.range(0));
+  auto tracking = static_cast<Tracking>(state.range(1));
+
+  uint64_t delivered = 0;
+  auto host = make_host(tracking, delivered);
+
+  auto birth = sparkplug::bench::make_nbirth(METRICS_PER_MESSAGE);
+  auto stream = sparkplug::bench::make_ndata_stream(METRICS_PER_MESSAGE);
+
+  std::vector<std::string> topics;
+  topics.reserve(node_count);
+  for (size_t node = 0; node < node_count; node++) {
+    host.inject_message(sparkplug::bench::node_topic("NBIRTH", node), birth);
+    topics.push_back(sparkplug::bench::node_topic("NDATA", node));
+  }
+  std::vector<uint8_t> next_seq(node_count, 1); // Wraps 255 -> 0 like the Sparkplug seq
+  delivered = 0;
+
+  size_t node = 0;
+  for (auto _ : state) {
+    auto seq = next_seq[node]++;
+    host.inject_message(topics[node], stream[seq]);
+    node = node + 1 == node_count ? 0 : node + 1;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["delivered"] = static_cast<double>(delivered);
+}
+BENCHMARK(BM_HostIngestNodes)
+    ->ArgNames({"nodes", "tracking"})
+    ->ArgsProduct({{1, 100, 10000}, {0, 1, 2}});
+
+// NDATA ingest for a host that filters data out by topic: only the seq is decoded
+void BM_HostIngestFiltered(benchmark::State& state) {
+  auto filtered = state.range(0) != 0;
+
+  uint64_t delivered = 0;
+  auto host = make_host(Tracking::Sequence, delivered);
+  if (filtered) {
+    host.set_message_filter([](const sparkplug::TopicView& topic) {
+      return topic.message_type != sparkplug::MessageType::NDATA;
+    });
+  }
+
+  auto stream = sparkplug::bench::make_ndata_stream(METRICS_PER_MESSAGE);
+  host.inject_message(sparkplug::bench::node_topic("NBIRTH", 0),
+                      sparkplug::bench::make_nbirth(METRICS_PER_MESSAGE));
+  auto topic = sparkplug::bench::node_topic("NDATA", 0);
+
+  uint8_t seq = 1;
+  for (auto _ : state) {
+    host.inject_message(topic, stream[seq++]);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["skipped"] = static_cast<double>(host.stats().payloads_skipped);
+}
+BENCHMARK(BM_HostIngestFiltered)->ArgName("filtered")->Arg(0)->Arg(1);
+
+// NBIRTH ingest, which rebuilds the alias table (and value store) of the node
+void BM_HostIngestBirth(benchmark::State& state) {
+  auto metrics = static_cast<size_t>(state.range(0));
+  auto tracking = static_cast<Tracking>(state.range(1));
+
+  uint64_t delivered = 0;
+  auto host = make_host(tracking, delivered);
+  auto birth = sparkplug::bench::make_nbirth(metrics);
+  auto topic = sparkplug::bench::node_topic("NBIRTH", 0);
+
+  for (auto _ : state) {
+    host.inject_message(topic, birth);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * metrics));
+}
+BENCHMARK(BM_HostIngestBirth)
+    ->ArgNames({"metrics", "tracking"})
+    ->ArgsProduct({{10, 100, 1000}, {1, 2}});
+
+} // namespace
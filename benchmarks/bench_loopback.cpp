@@ -0,0 +1,72 @@
+// benchmarks/bench_loopback.cpp
+//
+// Broker-less end-to-end path: each iteration builds an NDATA the way EdgeNode does (aliases,
+// explicit seq, reusable buffer), hands the encoded bytes to HostApplication::inject_message()
+// and reads the values back in the message callback. Only the MQTT transport is left out.
+#include "bench_common.hpp"
+
+#include <sparkplug/host_application.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+void BM_Loopback(benchmark::State& state) {
+  auto node_count = static_cast<size_t>(state.range(0));
+  auto metrics = static_cast<uint64_t>(state.range(1));
+
+  uint64_t delivered = 0;
+  double checksum = 0.0;
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "bench_loopback",
+      .host_id = "bench_loopback",
+      .resolve_aliases = true,
+      .message_callback =
+          [&](const sparkplug::Topic&, const org::eclipse::tahu::protobuf::Payload& payload) {
+            for (const auto& metric : payload.metrics()) {
+              checksum += metric.double_value();
+            }
+            delivered++;
+          }});
+
+  auto birth = sparkplug::bench::make_nbirth(metrics);
+  std::vector<std::string> topics;
+  topics.reserve(node_count);
+  for (size_t node = 0; node < node_count; node++) {
+    host.inject_message(sparkplug::bench::node_topic("NBIRTH", node), birth);
+    topics.push_back(sparkplug::bench::node_topic("NDATA", node));
+  }
+  std::vector<uint8_t> next_seq(node_count, 1); // Wraps 255 -> 0 like the Sparkplug seq
+  delivered = 0;
+
+  std::vector<uint8_t> buffer;
+  size_t node = 0;
+  double value = 0.0;
+  for (auto _ : state) {
+    sparkplug::PayloadBuilder data;
+    data.set_seq(next_seq[node]++);
+    for (uint64_t alias = 1; alias <= metrics; alias++) {
+      data.add_metric_by_alias(alias, value);
+    }
+    data.build_into(buffer);
+    host.inject_message(topics[node], buffer);
+
+    value += 1.0;
+    node = node + 1 == node_count ? 0 : node + 1;
+  }
+
+  benchmark::DoNotOptimize(checksum);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["msgs/s"] =
+      benchmark::Counter(static_cast<double>(delivered), benchmark::Counter::kIsRate);
+  state.counters["metrics/s"] = benchmark::Counter(static_cast<double>(delivered * metrics),
+                                                   benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Loopback)->ArgNames({"nodes", "metrics"})->ArgsProduct({{1, 1000}, {10, 100}});
+
+} // namespace
@@ -0,0 +1,180 @@
+// benchmarks/bench_payload_builder.cpp
+#include "bench_common.hpp"
+
+#include <sparkplug/metric_frame.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> metric_names(size_t count) {
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    names.push_back(std::format("Sensors/Metric{}", i));
+  }
+  return names;
+}
+
+// Named metrics as in an NBIRTH, serialized into a fresh vector
+void BM_AddMetricAndBuild(benchmark::State& state) {
+  auto names = metric_names(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    sparkplug::PayloadBuilder payload;
+    for (size_t i = 0; i < names.size(); i++) {
+      payload.add_metric(names[i], static_cast<double>(i));
+    }
+    auto bytes = payload.build();
+    benchmark::DoNotOptimize(bytes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AddMetricAndBuild)->Arg(10)->Arg(100)->Arg(1000);
+
+// Two-column waveform capture as a DataSet, from typed columns or one element at a time
+void BM_AddDataSet(benchmark::State& state) {
+  auto rows = static_cast<size_t>(state.range(1));
+  std::vector<uint64_t> times(rows);
+  std::vector<float> samples(rows);
+  for (size_t i = 0; i < rows; i++) {
+    times[i] = 1700000000000 + i;
+    samples[i] = static_cast<float>(i) * 0.5f;
+  }
+
+  std::vector<uint8_t> buffer;
+  for (auto _ : state) {
+    sparkplug::PayloadBuilder payload;
+    if (state.range(0) == 1) {
+      payload.add_dataset_by_alias(1, {{"t", times}, {"volts", samples}});
+    } else {
+      auto* metric = payload.mutable_payload().add_metrics();
+      metric->set_alias(1);
+      metric->set_datatype(std::to_underlying(sparkplug::DataType::DataSet));
+      auto* dataset = metric->mutable_dataset_value();
+      dataset->set_num_of_columns(2);
+      dataset->add_columns("t");
+      dataset->add_columns("volts");
+      dataset->add_types(std::to_underlying(sparkplug::DataType::UInt64));
+      dataset->add_types(std::to_underlying(sparkplug::DataType::Float));
+      for (size_t i = 0; i < rows; i++) {
+        auto* row = dataset->add_rows();
+        row->add_elements()->set_long_value(times[i]);
+        row->add_elements()->set_float_value(samples[i]);
+      }
+    }
+    payload.build_into(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_AddDataSet)
+    ->ArgNames({"columnar", "rows"})
+    ->ArgsProduct({{0, 1}, {1000, 100000}});
+
+// Alias-only metrics as in an NDATA, serialized into a reused buffer
+void BM_AddAliasAndBuildInto(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer;
+  for (auto _ : state) {
+    sparkplug::PayloadBuilder payload;
+    for (uint64_t alias = 1; alias <= count; alias++) {
+      payload.add_metric_by_alias(alias, static_cast<double>(alias));
+    }
+    payload.build_into(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AddAliasAndBuildInto)->Arg(10)->Arg(100)->Arg(1000);
+
+// BM_AddAliasAndBuildInto reusing one builder through reset() instead of constructing one
+void BM_ResetAndBuildInto(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer;
+  sparkplug::PayloadBuilder payload;
+  for (auto _ : state) {
+    payload.reset();
+    for (uint64_t alias = 1; alias <= count; alias++) {
+      payload.add_metric_by_alias(alias, static_cast<double>(alias));
+    }
+    payload.build_into(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ResetAndBuildInto)->Arg(10)->Arg(100)->Arg(1000);
+
+// BM_AddAliasAndBuildInto with one coarse clock read per payload instead of one per metric
+void BM_AddAliasPerPayloadTimestamp(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  std::vector<uint8_t> buffer;
+  for (auto _ : state) {
+    sparkplug::PayloadBuilder payload(sparkplug::TimestampMode::PerPayload,
+                                      sparkplug::coarse_clock_ms);
+    for (uint64_t alias = 1; alias <= count; alias++) {
+      payload.add_metric_by_alias(alias, static_cast<double>(alias));
+    }
+    payload.build_into(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AddAliasPerPayloadTimestamp)->Arg(10)->Arg(100)->Arg(1000);
+
+// Same NDATA as BM_AddAliasAndBuildInto from a prepared MetricFrame: only values are patched
+void BM_MetricFrameSet(benchmark::State& state) {
+  auto count = static_cast<uint64_t>(state.range(0));
+  sparkplug::MetricFrame frame;
+  std::vector<sparkplug::FrameSlot<double>> slots;
+  for (uint64_t alias = 1; alias <= count; alias++) {
+    slots.push_back(frame.add_metric_by_alias(alias, 0.0));
+  }
+  uint64_t scan = 0;
+  for (auto _ : state) {
+    scan++;
+    for (size_t i = 0; i < slots.size(); i++) {
+      frame.set(slots[i], static_cast<double>(i + scan));
+    }
+    frame.set_timestamp(scan);
+    frame.set_seq(scan % sparkplug::bench::SEQ_VALUES);
+    benchmark::DoNotOptimize(frame.bytes().data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MetricFrameSet)->Arg(10)->Arg(100)->Arg(1000);
+
+// Serialization alone, for a payload that is already populated
+void BM_Build(benchmark::State& state) {
+  auto names = metric_names(static_cast<size_t>(state.range(0)));
+  sparkplug::PayloadBuilder payload;
+  for (size_t i = 0; i < names.size(); i++) {
+    payload.add_metric(names[i], static_cast<double>(i));
+  }
+  std::vector<uint8_t> buffer;
+  for (auto _ : state) {
+    payload.build_into(buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_Build)->Arg(10)->Arg(100)->Arg(1000);
+
+// Protobuf decode of an alias-only NDATA
+void BM_ParsePayload(benchmark::State& state) {
+  auto stream = sparkplug::bench::make_ndata_stream(static_cast<size_t>(state.range(0)));
+  const auto& bytes = stream[1];
+  org::eclipse::tahu::protobuf::Payload payload;
+  for (auto _ : state) {
+    payload.ParseFromArray(bytes.data(), static_cast<int>(bytes.size()));
+    benchmark::DoNotOptimize(payload.metrics_size());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes.size()));
+}
+BENCHMARK(BM_ParsePayload)->Arg(10)->Arg(100)->Arg(1000);
+
+} // namespace
@@ -0,0 +1,40 @@
+// benchmarks/bench_topic.cpp
+#include <sparkplug/topic.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+
+constexpr std::string_view NODE_TOPIC = "spBv1.0/Energy/NDATA/Gateway01";
+constexpr std::string_view DEVICE_TOPIC = "spBv1.0/Energy/DDATA/Gateway01/Sensor01";
+
+void BM_TopicParse(benchmark::State& state) {
+  auto topic_str = state.range(0) ? DEVICE_TOPIC : NODE_TOPIC;
+  for (auto _ : state) {
+    auto topic = sparkplug::Topic::parse(topic_str);
+    benchmark::DoNotOptimize(topic);
+  }
+}
+BENCHMARK(BM_TopicParse)->ArgName("device")->Arg(0)->Arg(1);
+
+void BM_TopicViewParse(benchmark::State& state) {
+  auto topic_str = state.range(0) ? DEVICE_TOPIC : NODE_TOPIC;
+  for (auto _ : state) {
+    auto view = sparkplug::TopicView::parse(topic_str);
+    benchmark::DoNotOptimize(view);
+  }
+}
+BENCHMARK(BM_TopicViewParse)->ArgName("device")->Arg(0)->Arg(1);
+
+void BM_TopicToString(benchmark::State& state) {
+  auto topic = sparkplug::Topic::parse(state.range(0) ? DEVICE_TOPIC : NODE_TOPIC).value();
+  for (auto _ : state) {
+    auto topic_str = topic.to_string();
+    benchmark::DoNotOptimize(topic_str.data());
+  }
+}
+BENCHMARK(BM_TopicToString)->ArgName("device")->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,501 @@
+// examples/load_test.cpp - Load generator and end-to-end latency meter
+//
+// The publisher side simulates N edge nodes x M devices x K metrics on an EdgeNodeGroup and
+// sends DDATA at a target aggregate rate, each carrying its send time. The subscriber side is a
+// HostApplication that reports end-to-end latency percentiles, throughput and the seq gaps
+// found by sequence validation. Run both roles in one process, or split them across machines
+// (latency is then only as good as the clock synchronization between them).
+//
+//   load_test --nodes 100 --devices 10 --metrics 20 --rate 20000 --duration 30
+//   load_test --role subscribe --group Load --duration 0
+//   load_test --role publish --group Load --prefix GatewayA --rate 50000
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sparkplug/edge_node_group.hpp>
+#include <sparkplug/host_application.hpp>
+#include <sparkplug/payload_builder.hpp>
+
+namespace {
+
+std::atomic<bool> running{true};
+
+void signal_handler(int signal) {
+  (void)signal;
+  running = false;
+}
+
+// Alias of the device metric holding the send time in microseconds since the epoch
+constexpr uint64_t SENT_AT_ALIAS = 0;
+
+struct Options {
+  std::string role = "both";
+  std::string broker_url = "tcp://localhost:1883";
+  std::string group_id = "LoadTest";
+  std::string prefix = "Load";
+  size_t nodes = 10;
+  size_t devices = 10;
+  size_t metrics = 10;
+  double rate = 1000.0; // DDATA per second over all devices
+  int duration_s = 10;  // 0 = until Ctrl-C
+  int report_s = 1;
+  size_t threads = 4; // Publishing threads, each owning a slice of the nodes
+  size_t workers = 4; // EdgeNodeGroup workers (connects and reconnects)
+  size_t dispatch = 0; // HostApplication dispatch threads
+};
+
+uint64_t now_us() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count());
+}
+
+std::string device_id(size_t index) {
+  return std::format("Device{:03}", index);
+}
+
+// Latency samples of one report interval and of the whole run, in microseconds
+class LatencyRecorder {
+public:
+  void record(uint64_t latency_us) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    interval_.push_back(static_cast<uint32_t>(std::min<uint64_t>(latency_us, UINT32_MAX)));
+  }
+
+  std::vector<uint32_t> take_interval() {
+    std::vector<uint32_t> samples;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      samples.swap(interval_);
+    }
+    total_.insert(total_.end(), samples.begin(), samples.end());
+    return samples;
+  }
+
+  std::vector<uint32_t>& total() noexcept {
+    return total_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<uint32_t> interval_;
+  std::vector<uint32_t> total_; // Only touched by the reporting thread
+};
+
+std::string format_us(uint64_t us) {
+  if (us >= 1000000) {
+    return std::format("{:.2f}s", static_cast<double>(us) / 1e6);
+  }
+  if (us >= 1000) {
+    return std::format("{:.2f}ms", static_cast<double>(us) / 1e3);
+  }
+  return std::format("{}us", us);
+}
+
+std::string percentiles(std::vector<uint32_t>& samples) {
+  if (samples.empty()) {
+    return "no samples";
+  }
+  std::ranges::sort(samples);
+  auto at = [&](double q) {
+    auto index = static_cast<size_t>(q * static_cast<double>(samples.size() - 1));
+    return format_us(samples[index]);
+  };
+  return std::format("p50 {} p90 {} p99 {} p99.9 {} max {}", at(0.5), at(0.9), at(0.99),
+                     at(0.999), format_us(samples.back()));
+}
+
+class LoadPublisher {
+public:
+  explicit LoadPublisher(const Options& options) : options_(options) {
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < options.nodes; i++) {
+      ids.push_back(std::format("{}Node{:04}", options.prefix, i));
+    }
+    group_ = std::make_unique<sparkplug::EdgeNodeGroup>(sparkplug::EdgeNodeGroup::Config{
+        .node = {.broker_url = options.broker_url,
+                 .client_id = std::format("load_test_{}", options.prefix),
+                 .group_id = options.group_id,
+                 .edge_node_id = {}, // Set per node from edge_node_ids
+                 .reconnect = {.enabled = true}},
+        .edge_node_ids = std::move(ids),
+        .workers = options.workers});
+  }
+
+  bool start() {
+    std::cout << std::format("[PUB] Connecting {} nodes on {} workers...\n", group_->size(),
+                             options_.workers);
+    auto started = group_->connect().and_then([this] {
+      return group_->for_each([this](sparkplug::EdgeNode& node) { return publish_births(node); });
+    });
+    if (!started) {
+      std::cerr << "[PUB] Startup failed: " << started.error() << "\n";
+      return false;
+    }
+    std::cout << std::format("[PUB] {} NBIRTH and {} DBIRTH published\n", group_->size(),
+                             group_->size() * options_.devices);
+    return true;
+  }
+
+  // Publishes until the deadline (if any) or Ctrl-C
+  void run(std::optional<std::chrono::steady_clock::time_point> until) {
+    size_t threads = std::clamp<size_t>(options_.threads, 1, std::max<size_t>(group_->size(), 1));
+    std::vector<std::thread> publishers;
+    for (size_t t = 0; t < threads; t++) {
+      publishers.emplace_back([this, t, threads, until] { publish_slice(t, threads, until); });
+    }
+    for (auto& thread : publishers) {
+      thread.join();
+    }
+  }
+
+  void stop() {
+    (void)group_->disconnect();
+  }
+
+  [[nodiscard]] uint64_t sent() const noexcept {
+    return sent_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] uint64_t failed() const noexcept {
+    return failed_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::expected<void, std::string> publish_births(sparkplug::EdgeNode& node) {
+    sparkplug::PayloadBuilder birth;
+    birth.add_metric_with_alias("Load/Devices", 1, static_cast<uint64_t>(options_.devices));
+    auto result = node.publish_birth(birth);
+
+    for (size_t d = 0; result && d < options_.devices; d++) {
+      sparkplug::PayloadBuilder device_birth;
+      device_birth.add_metric_with_alias("Load/SentAtUs", SENT_AT_ALIAS, now_us());
+      for (size_t k = 0; k < options_.metrics; k++) {
+        device_birth.add_metric_with_alias(std::format("Metric{:03}", k), k + 1, 0.0);
+      }
+      result = node.publish_device_birth(device_id(d), device_birth);
+    }
+    return result;
+  }
+
+  // Thread t drives nodes t, t + threads, ... so every node publishes from one thread only
+  void publish_slice(size_t t, size_t threads,
+                     std::optional<std::chrono::steady_clock::time_point> until) {
+    std::vector<sparkplug::EdgeNode*> nodes;
+    for (size_t i = t; i < group_->size(); i += threads) {
+      nodes.push_back(&group_->node(i));
+    }
+    size_t total_pairs = group_->size() * options_.devices;
+    size_t pairs = nodes.size() * options_.devices;
+    if (pairs == 0 || options_.rate <= 0) {
+      return;
+    }
+
+    auto rate = options_.rate * static_cast<double>(pairs) / static_cast<double>(total_pairs);
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate));
+    auto next = std::chrono::steady_clock::now();
+    sparkplug::PayloadBuilder data;
+    uint64_t counter = 0;
+
+    for (size_t slot = 0; running; slot = (slot + 1) % pairs) {
+      auto now = std::chrono::steady_clock::now();
+      if (until && now >= *until) {
+        break;
+      }
+      // After a stall, resume at the target rate instead of bursting to catch up
+      if (now - next > std::chrono::seconds(1)) {
+        next = now;
+      }
+      std::this_thread::sleep_until(next);
+      next += interval;
+
+      data.reset();
+      data.add_metric_by_alias(SENT_AT_ALIAS, now_us());
+      for (size_t k = 0; k < options_.metrics; k++) {
+        data.add_metric_by_alias(k + 1, static_cast<double>(counter++ % 1000) * 0.5);
+      }
+      auto* node = nodes[slot / options_.devices];
+      if (node->publish_device_data(device_id(slot % options_.devices), data)) {
+        sent_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  const Options& options_;
+  std::unique_ptr<sparkplug::EdgeNodeGroup> group_;
+  std::atomic<uint64_t> sent_{0};
+  std::atomic<uint64_t> failed_{0};
+};
+
+class LoadSubscriber {
+public:
+  explicit LoadSubscriber(const Options& options)
+      : group_id_(options.group_id),
+        host_(sparkplug::HostApplication::Config{
+            .broker_url = options.broker_url,
+            .client_id = std::format("load_test_host_{}", options.prefix),
+            .host_id = "LoadTestHost",
+            .dispatch_threads = options.dispatch,
+            .message_callback =
+                [this](const sparkplug::Topic& topic,
+                       const org::eclipse::tahu::protobuf::Payload& payload) {
+                  on_message(topic, payload);
+                },
+            .log_level = sparkplug::LogLevel::ERROR}) {
+  }
+
+  bool start() {
+    auto started = host_.connect().and_then([this] { return host_.subscribe_group(group_id_); });
+    if (!started) {
+      std::cerr << "[SUB] Startup failed: " << started.error() << "\n";
+      return false;
+    }
+    std::cout << "[SUB] Subscribed to group " << group_id_ << "\n";
+    return true;
+  }
+
+  void stop() {
+    (void)host_.disconnect();
+  }
+
+  [[nodiscard]] sparkplug::Stats stats() const {
+    return host_.stats();
+  }
+
+  LatencyRecorder& latency() noexcept {
+    return latency_;
+  }
+
+private:
+  void on_message(const sparkplug::Topic& topic,
+                  const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.message_type != sparkplug::MessageType::DDATA) {
+      return;
+    }
+    uint64_t received = now_us();
+    for (const auto& metric : payload.metrics()) {
+      if (metric.has_alias() && metric.alias() == SENT_AT_ALIAS) {
+        auto sent = metric.long_value();
+        latency_.record(received > sent ? received - sent : 0);
+        return;
+      }
+    }
+  }
+
+  std::string group_id_;
+  LatencyRecorder latency_; // Declared before host_, whose callback records into it
+  sparkplug::HostApplication host_;
+};
+
+uint64_t ddata_in(const sparkplug::Stats& stats) {
+  return stats.messages_in[std::to_underlying(sparkplug::MessageType::DDATA)];
+}
+
+void print_usage(const char* program) {
+  std::cout << "Usage: " << program << " [options]\n";
+  std::cout << "Options:\n";
+  std::cout << "  --role <role>       publish, subscribe or both (default: both)\n";
+  std::cout << "  --broker <url>      MQTT broker URL (default: tcp://localhost:1883)\n";
+  std::cout << "  --group <id>        Sparkplug group ID (default: LoadTest)\n";
+  std::cout << "  --prefix <name>     Edge node id and client id prefix (default: Load)\n";
+  std::cout << "  --nodes <n>         Simulated edge nodes (default: 10)\n";
+  std::cout << "  --devices <m>       Devices per node (default: 10)\n";
+  std::cout << "  --metrics <k>       Metrics per DDATA (default: 10)\n";
+  std::cout << "  --rate <r>          DDATA per second over all devices (default: 1000)\n";
+  std::cout << "  --duration <sec>    Run time, 0 = until Ctrl-C (default: 10)\n";
+  std::cout << "  --report <sec>      Report interval (default: 1)\n";
+  std::cout << "  --threads <t>       Publishing threads (default: 4)\n";
+  std::cout << "  --workers <w>       EdgeNodeGroup workers (default: 4)\n";
+  std::cout << "  --dispatch <d>      Host dispatch threads, 0 = MQTT thread (default: 0)\n";
+  std::cout << "  --help              Show this help\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::signal(SIGINT, signal_handler);
+  std::signal(SIGTERM, signal_handler);
+
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--role" && has_value) {
+      options.role = argv[++i];
+    } else if (arg == "--broker" && has_value) {
+      options.broker_url = argv[++i];
+    } else if (arg == "--group" && has_value) {
+      options.group_id = argv[++i];
+    } else if (arg == "--prefix" && has_value) {
+      options.prefix = argv[++i];
+    } else if (arg == "--nodes" && has_value) {
+      options.nodes = std::stoul(argv[++i]);
+    } else if (arg == "--devices" && has_value) {
+      options.devices = std::stoul(argv[++i]);
+    } else if (arg == "--metrics" && has_value) {
+      options.metrics = std::stoul(argv[++i]);
+    } else if (arg == "--rate" && has_value) {
+      options.rate = std::stod(argv[++i]);
+    } else if (arg == "--duration" && has_value) {
+      options.duration_s = std::stoi(argv[++i]);
+    } else if (arg == "--report" && has_value) {
+      options.report_s = std::max(std::stoi(argv[++i]), 1);
+    } else if (arg == "--threads" && has_value) {
+      options.threads = std::stoul(argv[++i]);
+    } else if (arg == "--workers" && has_value) {
+      options.workers = std::stoul(argv[++i]);
+    } else if (arg == "--dispatch" && has_value) {
+      options.dispatch = std::stoul(argv[++i]);
+    } else if (arg == "--help") {
+      print_usage(argv[0]);
+      return 0;
+    } else {
+      std::cerr << "Unknown option: " << arg << "\n";
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  bool publish = options.role == "publish" || options.role == "both";
+  bool subscribe = options.role == "subscribe" || options.role == "both";
+  if (!publish && !subscribe) {
+    std::cerr << "Unknown role: " << options.role << "\n";
+    return 1;
+  }
+
+  std::cout << "=== Sparkplug Load Test ===\n";
+  std::cout << std::format("Role: {}  Broker: {}  Group: {}\n", options.role, options.broker_url,
+                           options.group_id);
+  if (publish) {
+    std::cout << std::format("Load: {} nodes x {} devices x {} metrics at {} DDATA/s\n",
+                             options.nodes, options.devices, options.metrics, options.rate);
+  }
+  std::cout << "\n";
+
+  std::unique_ptr<LoadSubscriber> subscriber;
+  if (subscribe) {
+    subscriber = std::make_unique<LoadSubscriber>(options);
+    if (!subscriber->start()) {
+      return 1;
+    }
+  }
+
+  std::unique_ptr<LoadPublisher> publisher;
+  if (publish) {
+    publisher = std::make_unique<LoadPublisher>(options);
+    if (!publisher->start()) {
+      if (subscriber) {
+        subscriber->stop();
+      }
+      return 1;
+    }
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  std::optional<std::chrono::steady_clock::time_point> until;
+  if (options.duration_s > 0) {
+    until = started + std::chrono::seconds(options.duration_s);
+  }
+
+  std::thread publishing;
+  if (publisher) {
+    publishing = std::thread([&] { publisher->run(until); });
+  }
+
+  // Report once per interval until the deadline, then once more after in-flight data drained
+  uint64_t last_sent = 0;
+  uint64_t last_received = 0;
+  uint64_t last_bytes = 0;
+  auto report = [&](std::chrono::duration<double> elapsed, double seconds) {
+    std::string line = std::format("[{:6.1f}s]", elapsed.count());
+    if (publisher) {
+      auto sent = publisher->sent();
+      line += std::format(" sent {:8.0f}/s", static_cast<double>(sent - last_sent) / seconds);
+      last_sent = sent;
+    }
+    if (subscriber) {
+      auto stats = subscriber->stats();
+      auto received = ddata_in(stats);
+      line += std::format(" recv {:8.0f}/s {:7.2f} MB/s gaps {}",
+                          static_cast<double>(received - last_received) / seconds,
+                          static_cast<double>(stats.bytes_in - last_bytes) / seconds / 1e6,
+                          stats.seq_gaps);
+      auto samples = subscriber->latency().take_interval();
+      line += "  " + percentiles(samples);
+      last_received = received;
+      last_bytes = stats.bytes_in;
+    }
+    std::cout << line << "\n";
+  };
+
+  auto interval = std::chrono::seconds(options.report_s);
+  auto next_report = started + interval;
+  while (running && (!until || std::chrono::steady_clock::now() < *until)) {
+    std::this_thread::sleep_until(until ? std::min(next_report, *until) : next_report);
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_report) {
+      report(now - started, static_cast<double>(options.report_s));
+      next_report += interval;
+    }
+  }
+  running = false;
+  if (publishing.joinable()) {
+    publishing.join();
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started);
+
+  if (subscriber && publisher) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    (void)subscriber->latency().take_interval();
+  }
+
+  std::cout << "\n=== Summary ===\n";
+  std::cout << std::format("Duration: {:.1f}s\n", elapsed.count());
+  if (publisher) {
+    std::cout << std::format("Sent: {} DDATA ({:.0f}/s), {} rejected by the client\n",
+                             publisher->sent(),
+                             static_cast<double>(publisher->sent()) / elapsed.count(),
+                             publisher->failed());
+  }
+  if (subscriber) {
+    auto stats = subscriber->stats();
+    auto received = ddata_in(stats);
+    std::cout << std::format("Received: {} DDATA ({:.0f}/s), {:.2f} MB\n", received,
+                             static_cast<double>(received) / elapsed.count(),
+                             static_cast<double>(stats.bytes_in) / 1e6);
+    if (publisher) {
+      auto sent = publisher->sent();
+      std::cout << std::format("Lost: {}\n", sent > received ? sent - received : 0);
+    }
+    std::cout << std::format("Seq gaps: {}  Parse failures: {}\n", stats.seq_gaps,
+                             stats.parse_failures);
+    std::cout << "Latency: " << percentiles(subscriber->latency().total()) << "\n";
+    std::cout << std::format("Callback: mean {}ns max {}ns\n",
+                             stats.callback_duration.mean_ns(), stats.callback_duration.max_ns);
+  }
+
+  if (publisher) {
+    publisher->stop();
+  }
+  if (subscriber) {
+    subscriber->stop();
+  }
+  return 0;
+}
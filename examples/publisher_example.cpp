@@ -89,6 +89,8 @@ int main() {
 
   std::cout << "\nPublishing NDATA messages (Ctrl+C to stop)...\n";
 
+  // One builder for every NDATA; reset() keeps its memory between scans
+  sparkplug::PayloadBuilder data;
   while (running) {
     // Check for rebirth command (simulated)
     if (do_rebirth) {
@@ -103,10 +105,10 @@ int main() {
       do_rebirth = false;
     }
 
-    // Create NDATA payload
+    // Reuse the NDATA payload across scans
     // BEST PRACTICE: Only include metrics that changed
     // Use aliases to reduce bandwidth
-    sparkplug::PayloadBuilder data;
+    data.reset();
 
     // Simulate some changing values
     temperature += 0.1;
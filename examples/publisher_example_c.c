@@ -65,9 +65,11 @@ int main(void) {
 
   printf("\nPublishing NDATA messages...\n");
 
+  // One payload for every NDATA; reset keeps its memory between scans
+  sparkplug_payload_t* data = sparkplug_payload_create();
   for (int i = 0; i < 10; i++) {
-    // Create NDATA payload using aliases only (bandwidth optimization)
-    sparkplug_payload_t* data = sparkplug_payload_create();
+    // Reuse the NDATA payload, aliases only (bandwidth optimization)
+    sparkplug_payload_reset(data);
 
     // Only include changed values (Report by Exception)
     double temp = 20.5 + (i * 0.1);
@@ -77,9 +79,8 @@ int main(void) {
     sparkplug_payload_add_int64_by_alias(data, 4, uptime); // Uptime
     // Voltage and Active unchanged - not included
 
-    size = sparkplug_payload_serialize(data, buffer, sizeof(buffer));
-
-    if (size > 0 && sparkplug_publisher_publish_data(pub, buffer, size) == 0) {
+    // Publish the builder directly; no intermediate byte buffer
+    if (sparkplug_publisher_publish_data_payload(pub, data) == 0) {
       if ((i + 1) % 5 == 0) {
         printf("[OK] Published %d NDATA messages (seq: %llu)\n", i + 1,
                (unsigned long long)sparkplug_publisher_get_seq(pub));
@@ -88,7 +89,6 @@ int main(void) {
       fprintf(stderr, "Failed to publish NDATA #%d\n", i + 1);
     }
 
-    sparkplug_payload_destroy(data);
     sleep(1);
   }
 
@@ -103,17 +103,14 @@ int main(void) {
 
   printf("\nPublishing post-rebirth NDATA...\n");
   for (int i = 0; i < 3; i++) {
-    sparkplug_payload_t* data = sparkplug_payload_create();
+    sparkplug_payload_reset(data);
     sparkplug_payload_add_double_by_alias(data, 1, 25.0 + i);
 
-    size = sparkplug_payload_serialize(data, buffer, sizeof(buffer));
-    if (size > 0) {
-      sparkplug_publisher_publish_data(pub, buffer, size);
-    }
+    sparkplug_publisher_publish_data_payload(pub, data);
 
-    sparkplug_payload_destroy(data);
     sleep(1);
   }
+  sparkplug_payload_destroy(data);
 
   printf("[OK] Published 3 post-rebirth messages (seq: %llu)\n",
          (unsigned long long)sparkplug_publisher_get_seq(pub));
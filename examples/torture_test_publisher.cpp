@@ -174,6 +174,8 @@ public:
     std::cout << "[PUBLISHER] Send SIGINT (Ctrl+C) for graceful shutdown\n";
     std::cout << "[PUBLISHER] Send NCMD 'Node Control/Reboot' for ungraceful crash\n\n";
 
+    // One builder for every NDATA; reset() keeps its memory between scans
+    sparkplug::PayloadBuilder data;
     while (running) {
       if (do_rebirth) {
         std::cout << "\n[PUBLISHER] *** EXECUTING REBIRTH ***\n";
@@ -198,7 +200,7 @@ public:
                                                                 start_time)
                    .count();
 
-      sparkplug::PayloadBuilder data;
+      data.reset();
       data.add_metric_by_alias(1, temperature);
       data.add_metric_by_alias(2, pressure);
       data.add_metric_by_alias(3, humidity);
@@ -0,0 +1,153 @@
+// include/sparkplug/alias_registry.hpp
+#pragma once
+
+#include "datatype.hpp"
+#include "metric_value.hpp"
+#include "sparkplug_b.pb.h"
+#include "string_interner.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Maps metric aliases to the name, datatype and last value declared in a birth.
+ *
+ * Edge nodes normally assign small consecutive aliases, so entries are kept in a flat vector
+ * indexed by alias. When the aliases of a birth are too sparse for that (or exceed
+ * MAX_DENSE_ALIAS) the registry falls back to a hash map. The layout is chosen on every
+ * rebuild().
+ *
+ * @par Example
+ * @code
+ * sparkplug::StringInterner names;
+ * sparkplug::AliasRegistry registry;
+ * registry.rebuild(nbirth_payload, names);
+ * if (const auto* entry = registry.find(metric.alias())) {
+ *   std::cout << entry->name << "\n";
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe; HostApplication guards each registry with its node-state shard lock.
+ */
+class AliasRegistry {
+public:
+  /**
+   * @brief Information recorded for one alias.
+   */
+  struct Entry {
+    InternedString name;                   ///< Metric name from the birth certificate
+    DataType datatype{DataType::Unknown};  ///< Datatype declared in the birth certificate
+    MetricValue value{};                   ///< Most recent value (birth value until updated)
+  };
+
+  /// Largest alias stored in the dense vector; bigger aliases force the sparse layout
+  static constexpr uint64_t MAX_DENSE_ALIAS = 1u << 20;
+
+  /**
+   * @brief Chooses the alias layout of a birth (also used by ValueStore).
+   *
+   * @param count Number of aliased metrics in the birth
+   * @param max_alias Largest alias in the birth
+   *
+   * @return True if an alias-indexed vector wastes at most a couple of slots per alias
+   */
+  [[nodiscard]] static constexpr bool use_dense_layout(uint64_t count,
+                                                       uint64_t max_alias) noexcept {
+    return max_alias <= MAX_DENSE_ALIAS &&
+           max_alias < std::max(count * DENSE_SLACK_FACTOR, DENSE_MIN_SLOTS);
+  }
+
+  /**
+   * @brief Replaces all entries with the aliased metrics of a birth payload.
+   *
+   * @param birth NBIRTH or DBIRTH payload; metrics without both a name and an alias are ignored
+   * @param names Interner that owns the entry names (must outlive the registry)
+   */
+  void rebuild(const org::eclipse::tahu::protobuf::Payload& birth, StringInterner& names);
+
+  /**
+   * @brief Stores the values of aliased metrics from a data payload.
+   *
+   * @param data NDATA or DDATA payload; unknown aliases are ignored
+   *
+   * @return Number of entries updated
+   */
+  size_t update_values(const org::eclipse::tahu::protobuf::Payload& data);
+
+  /**
+   * @brief Looks up an alias.
+   *
+   * @return Pointer to the entry, or nullptr if the alias was not declared in the birth
+   *
+   * @note The pointer is invalidated by rebuild() and clear().
+   */
+  [[nodiscard]] const Entry* find(uint64_t alias) const noexcept;
+  [[nodiscard]] Entry* find(uint64_t alias) noexcept;
+
+  /**
+   * @brief Removes all entries.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Forgets the stored values while keeping names and datatypes.
+   *
+   * Every non-null value becomes std::monostate, so the next comparison against it reports a
+   * change.
+   */
+  void reset_values() noexcept;
+
+  /**
+   * @brief Returns the number of registered aliases.
+   */
+  [[nodiscard]] size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /**
+   * @brief Returns true if entries are stored in the flat alias-indexed vector.
+   */
+  [[nodiscard]] bool is_dense() const noexcept {
+    return !dense_.empty() || sparse_.empty();
+  }
+
+  /**
+   * @brief Calls fn(alias, entry) for every registered alias.
+   */
+  template <typename Fn> void for_each(Fn&& fn) const {
+    for (size_t alias = 0; alias < dense_.size(); alias++) {
+      if (dense_[alias].used) {
+        fn(static_cast<uint64_t>(alias), dense_[alias].entry);
+      }
+    }
+    for (const auto& [alias, entry] : sparse_) {
+      fn(alias, entry);
+    }
+  }
+
+private:
+  // A birth is stored densely when at most this many slots are wasted per used alias
+  static constexpr uint64_t DENSE_SLACK_FACTOR = 2;
+  static constexpr uint64_t DENSE_MIN_SLOTS = 64;
+
+  struct Slot {
+    bool used{false};
+    Entry entry;
+  };
+
+  std::vector<Slot> dense_;
+  std::unordered_map<uint64_t, Entry> sparse_;
+  size_t size_{0};
+};
+
+} // namespace sparkplug
@@ -0,0 +1,34 @@
+// include/sparkplug/backfill.hpp
+#pragma once
+
+#include "payload_builder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sparkplug {
+
+/**
+ * @brief Limits applied by EdgeNode::publish_backfill() and publish_device_backfill().
+ *
+ * @par Example
+ * @code
+ * // 16 KiB payloads, at most 256 KiB/s of backfill on the link
+ * config.backfill = {.max_payload_bytes = 16 * 1024, .bytes_per_second = 256 * 1024};
+ * @endcode
+ */
+struct BackfillConfig {
+  size_t max_payload_bytes = 64 * 1024; ///< Upper bound on one historical NDATA/DDATA
+  size_t bytes_per_second = 0;          ///< Budget shared by all backfills (0 = unpaced)
+};
+
+/**
+ * @brief One recorded value of a metric time series.
+ */
+template <SparkplugMetricType T>
+struct TimedSample {
+  uint64_t timestamp_ms; ///< When the value was sampled (milliseconds since Unix epoch)
+  T value;               ///< Sampled value
+};
+
+} // namespace sparkplug
@@ -0,0 +1,88 @@
+// include/sparkplug/birth_replay.hpp
+#pragma once
+
+#include "worker_thread.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace sparkplug {
+
+/**
+ * @brief Pacing of the DBIRTHs republished by an in-session rebirth or a reconnect.
+ *
+ * With a non-zero window, EdgeNode publishes the NBIRTH at once and hands the DBIRTHs to a
+ * background thread that releases `burst` of them immediately and spreads the rest over
+ * `window`. Each DBIRTH gets its seq when it is sent, so NDATA published meanwhile is not held
+ * back, and DDATA for a device whose DBIRTH is still queued sends that DBIRTH first.
+ *
+ * @par Example
+ * @code
+ * // 500 devices: 16 DBIRTHs at once, the rest over about two seconds
+ * config.birth_replay = {.window = std::chrono::seconds(2), .burst = 16};
+ * @endcode
+ */
+struct BirthReplayConfig {
+  std::chrono::milliseconds window{0}; ///< Time to spread the DBIRTHs over (0 = all at once)
+  size_t burst = 16;                   ///< DBIRTHs sent before pacing starts
+};
+
+namespace detail {
+
+/**
+ * @brief Thread that republishes queued DBIRTHs at the rate set by a BirthReplayConfig.
+ *
+ * start() paces calls to the send function until it reports that nothing is left, fails, or
+ * stop() is called. The replay thread sends under lock_sends(), and so does every publisher
+ * from the moment it reserves a seq, so a DBIRTH takes and sends its seq without being
+ * overtaken by data published meanwhile. DBIRTHs left queued after a failed or stopped
+ * replay are still sent ahead of their device's next DDATA.
+ */
+class BirthReplayer {
+public:
+  /// Sends the next queued DBIRTH; false when the queue is empty, error to give up
+  using SendNext = std::function<std::expected<bool, std::string>()>;
+
+  explicit BirthReplayer(BirthReplayConfig config) noexcept : config_(config) {
+  }
+  ~BirthReplayer();
+
+  BirthReplayer(const BirthReplayer&) = delete;
+  BirthReplayer& operator=(const BirthReplayer&) = delete;
+
+  /**
+   * @brief Starts pacing `births` DBIRTHs, replacing any replay in progress.
+   *
+   * @note Must not be called from inside the send function.
+   */
+  void start(size_t births, SendNext send_next);
+
+  /**
+   * @brief Cancels the replay and waits for the thread to exit.
+   *
+   * @warning Must not be called from inside the send function.
+   */
+  void stop();
+
+  /**
+   * @brief Locks out the replay thread while a caller sends a queued DBIRTH itself.
+   */
+  [[nodiscard]] std::unique_lock<std::mutex> lock_sends() {
+    return std::unique_lock<std::mutex>(send_mutex_);
+  }
+
+private:
+  void run(const WorkerThread::Run& worker, size_t births, const SendNext& send_next);
+
+  const BirthReplayConfig config_;
+  std::mutex send_mutex_;
+  WorkerThread thread_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,187 @@
+// include/sparkplug/columnar.hpp
+#pragma once
+
+#include "datatype.hpp"
+#include "payload_builder.hpp"
+#include "sparkplug_b.pb.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace sparkplug {
+
+/// Value of the Sparkplug "Quality" metric property for a good value
+inline constexpr int32_t QUALITY_GOOD = 192;
+
+/// Value of the Sparkplug "Quality" metric property for a bad value
+inline constexpr int32_t QUALITY_BAD = 0;
+
+/**
+ * @brief One column of a decoded DataSet, stored contiguously.
+ */
+struct DecodedColumn {
+  std::string name;                 ///< Column name
+  DataType type{DataType::Unknown}; ///< Column datatype declared by the DataSet
+  std::vector<double> values;       ///< Numeric, Boolean and DateTime columns; NaN if null
+  std::vector<std::string> strings; ///< String, Text and UUID columns
+};
+
+/**
+ * @brief A DataSet metric laid out column by column.
+ *
+ * Reuse one instance across decode_dataset() calls: its columns and their vectors keep their
+ * capacity, so decoding same-shaped DataSets stops allocating after the first.
+ */
+struct DecodedDataSet {
+  size_t row_count{0};
+  std::vector<DecodedColumn> columns;
+};
+
+/**
+ * @brief Converts a DataSet's rows into contiguous typed columns.
+ *
+ * Every column of a numeric, Boolean or DateTime type becomes a std::vector<double> with one
+ * entry per row, ready for vectorized aggregates. String-typed columns fill
+ * DecodedColumn::strings. Columns of other types (Bytes, arrays, ...) are left empty.
+ *
+ * @param dataset DataSet to decode (e.g. metric.dataset_value())
+ * @param out Destination; its previous contents are replaced
+ *
+ * @return void on success, or an error naming the first row whose element count or element
+ *         types do not match the declared columns
+ *
+ * @par Example
+ * @code
+ * sparkplug::DecodedDataSet table;
+ * if (sparkplug::decode_dataset(metric.dataset_value(), table)) {
+ *   const auto& volts = table.columns[1].values;
+ *   double peak = *std::max_element(volts.begin(), volts.end());
+ * }
+ * @endcode
+ */
+[[nodiscard]] std::expected<void, std::string>
+decode_dataset(const org::eclipse::tahu::protobuf::Payload::DataSet& dataset,
+               DecodedDataSet& out);
+
+/**
+ * @brief Copies one numeric column of a DataSet into a vector of its own type.
+ *
+ * Unlike decode_dataset(), values keep their exact type (no conversion through double), so
+ * 64-bit integers and timestamps are exact.
+ *
+ * @tparam T Element type of the output (any SparkplugNumeric or bool)
+ * @param dataset DataSet to read
+ * @param column Column index
+ * @param out Destination; resized to the row count, capacity kept
+ *
+ * @return Number of rows on success, error if the column does not exist or a row lacks it
+ *
+ * @note The value is read from whichever numeric member the element carries and then cast
+ *       to T; null cells read as 0.
+ */
+template <typename T>
+  requires SparkplugNumeric<T> || SparkplugBoolean<T>
+[[nodiscard]] std::expected<size_t, std::string>
+decode_dataset_column(const org::eclipse::tahu::protobuf::Payload::DataSet& dataset,
+                      size_t column, std::vector<T>& out) {
+  using DataSetValue = org::eclipse::tahu::protobuf::Payload::DataSet::DataSetValue;
+
+  if (column >= std::max<size_t>(dataset.num_of_columns(), dataset.columns_size())) {
+    return std::unexpected(std::format("DataSet has no column {}", column));
+  }
+
+  // Int8/16/32 cells carry their value sign-extended into the 32-bit int_value
+  auto type = column < static_cast<size_t>(dataset.types_size())
+                  ? static_cast<DataType>(dataset.types(static_cast<int>(column)))
+                  : DataType::Unknown;
+  bool signed_int =
+      type == DataType::Int8 || type == DataType::Int16 || type == DataType::Int32;
+
+  const auto& rows = dataset.rows();
+  out.resize(static_cast<size_t>(rows.size()));
+  for (int r = 0; r < rows.size(); r++) {
+    const auto& elements = rows[r].elements();
+    if (column >= static_cast<size_t>(elements.size())) {
+      return std::unexpected(std::format("DataSet row {} has no column {}", r, column));
+    }
+    const auto& element = elements[static_cast<int>(column)];
+    switch (element.value_case()) {
+    case DataSetValue::kIntValue:
+      out[r] = signed_int ? static_cast<T>(static_cast<int32_t>(element.int_value()))
+                          : static_cast<T>(element.int_value());
+      break;
+    case DataSetValue::kLongValue:
+      out[r] = static_cast<T>(element.long_value());
+      break;
+    case DataSetValue::kFloatValue:
+      out[r] = static_cast<T>(element.float_value());
+      break;
+    case DataSetValue::kDoubleValue:
+      out[r] = static_cast<T>(element.double_value());
+      break;
+    case DataSetValue::kBooleanValue:
+      out[r] = static_cast<T>(element.boolean_value());
+      break;
+    default:
+      out[r] = T{};
+      break;
+    }
+  }
+  return static_cast<size_t>(rows.size());
+}
+
+/**
+ * @brief Numeric NDATA/DDATA metrics of one or more payloads, as parallel columns.
+ *
+ * Entry i of every vector describes the same metric. decode_metrics() appends to the columns,
+ * so a run of data messages accumulates into one batch for a columnar historian; clear()
+ * empties it and keeps the capacity.
+ */
+struct MetricColumns {
+  std::vector<uint64_t> aliases;    ///< Metric alias
+  std::vector<uint64_t> timestamps; ///< Metric timestamp, or the payload's when absent
+  std::vector<double> values;       ///< Value as double; NaN if the metric is null
+  std::vector<int32_t> quality;     ///< "Quality" property, else QUALITY_GOOD (BAD if null)
+
+  [[nodiscard]] size_t size() const noexcept {
+    return values.size();
+  }
+
+  void clear() noexcept {
+    aliases.clear();
+    timestamps.clear();
+    values.clear();
+    quality.clear();
+  }
+};
+
+/**
+ * @brief Appends the aliased numeric metrics of a data payload to a MetricColumns batch.
+ *
+ * Integer, floating-point, Boolean and DateTime metrics are converted to double. Metrics
+ * without an alias, and metrics holding strings, DataSets, Templates or bytes, are skipped;
+ * use ValueStore or the payload itself for those.
+ *
+ * @param payload NDATA or DDATA payload
+ * @param out Batch to append to
+ *
+ * @return Number of metrics appended
+ *
+ * @par Example
+ * @code
+ * sparkplug::MetricColumns batch;
+ * for (const auto& payload : pending) {
+ *   sparkplug::decode_metrics(payload, batch);
+ * }
+ * historian.write(batch.aliases, batch.timestamps, batch.values, batch.quality);
+ * batch.clear();
+ * @endcode
+ */
+size_t decode_metrics(const org::eclipse::tahu::protobuf::Payload& payload, MetricColumns& out);
+
+} // namespace sparkplug
@@ -0,0 +1,127 @@
+// include/sparkplug/command_registry.hpp
+#pragma once
+
+#include "sparkplug_b.pb.h"
+#include "worker_thread.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Handler for one command metric of an NCMD or DCMD.
+ *
+ * @param device_id Device the DCMD is addressed to (empty for NCMD)
+ * @param metric Received command metric; hosts may send it by alias only, without a name
+ */
+using CommandHandler = std::function<void(
+    std::string_view device_id, const org::eclipse::tahu::protobuf::Payload::Metric& metric)>;
+
+namespace detail {
+
+/// Birth aliases whose metric name has a handler (alias -> handler index)
+using CommandAliases = std::unordered_map<uint64_t, size_t>;
+
+/**
+ * @brief Command handlers registered by metric name or alias.
+ *
+ * Handlers are stored once and referred to by index. A name is resolved against every birth
+ * certificate (resolve()), so commands that only carry the alias declared in the NBIRTH or
+ * DBIRTH reach the handler registered under the name. Lookups never allocate.
+ *
+ * @note Not synchronized: handlers are added before the owner connects and only read after.
+ */
+class CommandRegistry {
+public:
+  /// Registers handler for metric name, replacing an earlier handler of the same name
+  void add(std::string_view name, CommandHandler handler);
+
+  /// Registers handler for a fixed alias, replacing an earlier handler of the same alias
+  void add(uint64_t alias, CommandHandler handler);
+
+  [[nodiscard]] bool empty() const noexcept {
+    return handlers_.empty();
+  }
+
+  /// Index of the handler registered under name
+  [[nodiscard]] std::optional<size_t> find(std::string_view name) const noexcept;
+
+  /// Index of the handler registered for alias with add(uint64_t, ...)
+  [[nodiscard]] std::optional<size_t> find(uint64_t alias) const noexcept;
+
+  /// Rebuilds aliases from the named, aliased metrics of a birth that have a handler
+  void resolve(const org::eclipse::tahu::protobuf::Payload& birth, CommandAliases& aliases) const;
+
+  void invoke(size_t index, std::string_view device_id,
+              const org::eclipse::tahu::protobuf::Payload::Metric& metric) const {
+    handlers_[index](device_id, metric);
+  }
+
+private:
+  struct StringHash {
+    using is_transparent = void;
+    [[nodiscard]] size_t operator()(std::string_view sv) const noexcept {
+      return std::hash<std::string_view>{}(sv);
+    }
+  };
+
+  [[nodiscard]] size_t store(std::optional<size_t> existing, CommandHandler handler);
+
+  std::vector<CommandHandler> handlers_;
+  std::unordered_map<std::string, size_t, StringHash, std::equal_to<>> by_name_;
+  CommandAliases by_alias_;
+};
+
+/**
+ * @brief Runs a task on a background thread each time it is signalled.
+ *
+ * The thread is started by the first signal(). Signals that arrive while the task runs are
+ * coalesced into one more run, so no request made during a run is lost.
+ */
+class SignalledTask {
+public:
+  using Task = std::function<void()>;
+
+  explicit SignalledTask(Task task) : task_(std::move(task)) {
+  }
+  ~SignalledTask();
+
+  SignalledTask(const SignalledTask&) = delete;
+  SignalledTask& operator=(const SignalledTask&) = delete;
+
+  /**
+   * @brief Schedules a run of the task.
+   *
+   * @note Safe to call from MQTT client callbacks; ignored after stop().
+   */
+  void signal();
+
+  /**
+   * @brief Drops a pending run and waits for a running one to finish.
+   *
+   * @note Detaches instead when called from the task itself.
+   */
+  void stop();
+
+private:
+  void run(const WorkerThread::Run& worker);
+
+  const Task task_;
+  std::mutex mutex_; // Guards stopped_, and orders signal() against stop()
+  bool stopped_{false};
+  bool pending_{false}; // Guarded by thread_ (notify() and Run::wait())
+  WorkerThread thread_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,91 @@
+// include/sparkplug/compression.hpp
+#pragma once
+
+#include "sparkplug_b.pb.h"
+#include "wire_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Algorithms for Sparkplug compressed payloads, as named by Eclipse Tahu.
+ */
+enum class CompressionAlgorithm : uint8_t {
+  None,    ///< Payloads are sent as is
+  Deflate, ///< zlib stream ("DEFLATE")
+  Gzip,    ///< gzip stream ("GZIP")
+};
+
+/**
+ * @brief Payload compression settings for EdgeNode.
+ *
+ * Payloads of at least min_payload_bytes are compressed and wrapped in a payload whose uuid
+ * is COMPRESSED_PAYLOAD_UUID, whose body holds the compressed bytes and whose "algorithm"
+ * metric names the algorithm. The wrapper keeps the timestamp and seq of the original.
+ * HostApplication unwraps such payloads before validating or delivering them.
+ *
+ * @par Example
+ * @code
+ * // Compress births and other large payloads; NDATA frames below 8 KiB go out as is
+ * config.compression = {.algorithm = sparkplug::CompressionAlgorithm::Deflate,
+ *                       .min_payload_bytes = 8 * 1024};
+ * @endcode
+ */
+struct CompressionConfig {
+  CompressionAlgorithm algorithm = CompressionAlgorithm::None; ///< Disabled by default
+  size_t min_payload_bytes = 4096; ///< Smaller payloads are not compressed
+  int level = -1;                  ///< zlib level 1 (fast) to 9 (small); -1 = zlib default
+};
+
+/// uuid of a payload whose body is another, compressed payload
+inline constexpr std::string_view COMPRESSED_PAYLOAD_UUID = detail::wire::COMPRESSED_PAYLOAD_UUID;
+
+/// Largest payload decompress_payload() produces unless told otherwise
+inline constexpr size_t DEFAULT_MAX_DECOMPRESSED_BYTES = 64 * 1024 * 1024;
+
+/**
+ * @brief Compresses a serialized payload into a Sparkplug compressed payload.
+ *
+ * @param payload Serialized Sparkplug B payload
+ * @param algorithm Deflate or Gzip
+ * @param out Receives the serialized wrapper (contents replaced, capacity kept)
+ * @param level zlib compression level, or -1 for the zlib default
+ *
+ * @return void on success, error if the payload is malformed or the algorithm is None
+ */
+[[nodiscard]] std::expected<void, std::string>
+compress_payload(std::span<const uint8_t> payload, CompressionAlgorithm algorithm,
+                 std::vector<uint8_t>& out, int level = -1);
+
+/**
+ * @brief Returns true if a parsed payload is a compressed wrapper.
+ */
+[[nodiscard]] inline bool
+is_compressed_payload(const org::eclipse::tahu::protobuf::Payload& payload) noexcept {
+  return payload.has_uuid() && payload.uuid() == COMPRESSED_PAYLOAD_UUID;
+}
+
+/**
+ * @brief Decompresses the body of a compressed wrapper.
+ *
+ * @param wrapper Payload for which is_compressed_payload() is true
+ * @param out Receives the serialized original payload (contents replaced, capacity kept)
+ * @param max_size Limit on the decompressed size, guarding against decompression bombs
+ *
+ * @return void on success, error if the algorithm is unknown, the body is corrupt or the
+ *         result exceeds max_size
+ *
+ * @note A wrapper without an "algorithm" metric is taken to be DEFLATE, as in Tahu.
+ */
+[[nodiscard]] std::expected<void, std::string>
+decompress_payload(const org::eclipse::tahu::protobuf::Payload& wrapper, std::vector<uint8_t>& out,
+                   size_t max_size = DEFAULT_MAX_DECOMPRESSED_BYTES);
+
+} // namespace sparkplug
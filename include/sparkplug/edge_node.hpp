@@ -1,11 +1,25 @@
 // include/sparkplug/edge_node.hpp
 #pragma once
 
+#include "alias_registry.hpp"
+#include "backfill.hpp"
+#include "birth_replay.hpp"
+#include "command_registry.hpp"
+#include "compression.hpp"
+#include "metric_frame.hpp"
 #include "mqtt_handle.hpp"
 #include "payload_builder.hpp"
+#include "publish_window.hpp"
+#include "reconnect.hpp"
 #include "sparkplug_b.pb.h"
+#include "stats.hpp"
+#include "store_forward.hpp"
+#include "token_bucket.hpp"
 #include "topic.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <expected>
 #include <functional>
 #include <memory>
@@ -25,10 +39,20 @@ namespace sparkplug {
  *
  * @param topic Parsed command topic (message_type will be NCMD)
  * @param payload Command payload containing metrics with command names and values
+ *
+ * @see EdgeNode::register_command() for per-metric handlers that also cover DCMD
  */
 using CommandCallback =
     std::function<void(const Topic&, const org::eclipse::tahu::protobuf::Payload&)>;
 
+/**
+ * @brief How EdgeNode::rebirth() re-establishes the birth certificates.
+ */
+enum class RebirthMode {
+  Reconnect, ///< Disconnect and reconnect (new bdSeq), then republish NBIRTH
+  InSession  ///< Republish NBIRTH and all DBIRTHs on the existing connection (same bdSeq)
+};
+
 /**
  * @brief Sparkplug B Edge Node implementing the complete message lifecycle.
  *
@@ -40,22 +64,37 @@ using CommandCallback =
  * - Birth/Death sequence (bdSeq) tracking for session management
  *
  * @par Thread Safety
- * This class is fully thread-safe with coarse-grained locking:
- * - All public methods use a single internal mutex to protect shared state
+ * This class is fully thread-safe:
+ * - Lifecycle, birth/death and command methods use a single internal mutex
+ * - publish_data() is lock-free: concurrent producers only contend on the atomic seq counter
+ *   (with Config::birth_replay set, seq-carrying publishes also share one uncontended mutex
+ *   with the replay thread)
+ * - publish_device_data() locks only for the device table lookup; serialization is unlocked
+ * - publish_*_async() block only on the publish window, never while holding the mutex
  * - Methods can be safely called from any thread concurrently
  * - Callbacks (e.g., command_callback) are invoked on MQTT thread WITHOUT holding mutex
  * - Mutex is released before MQTT publish to prevent callback deadlocks
- * - Performance: Suitable for typical IIoT applications; not optimized for ultra-high-frequency
- *   (>10kHz) publishing from multiple threads
+ *
+ * @note Sequence numbers are assigned in call order, but concurrent NDATA/DDATA publishes from
+ *       different threads may reach the broker in a different order. Publish from one thread
+ *       per node when the host requires strictly increasing seq on the wire.
  *
  * @par Threading Model
  * - **Application threads**: Call EdgeNode methods (connect, publish_*, disconnect)
  * - **MQTT client thread**: Paho async library handles network I/O and invokes callbacks
- * - **Synchronization**: Single std::mutex protects all mutable state (seq_num_, bd_seq_num_,
- *   device_states_, last_birth_payload_, etc.)
+ * - **Synchronization**: seq_num_, bd_seq_num_, is_connected_ and a copy of the client handle
+ *   are atomics, so NDATA publishers never take the mutex; a single std::mutex protects the
+ *   remaining state (client_, device_states_, last_birth_payload_, etc.)
  * - **Lock acquisition**: Methods acquire mutex, prepare data, release before MQTT operations
  * - **Callback safety**: User callbacks invoked without mutex held (safe to call EdgeNode methods)
- * - **Blocking operations**: connect() and disconnect() block until completion or timeout
+ * - **Blocking operations**: connect() and disconnect() block until completion or timeout;
+ *   connect_async() returns immediately and reports through its callback
+ * - **Reconnect thread**: with Config::reconnect enabled, a background thread reconnects after
+ *   a connection loss and replays NBIRTH/DBIRTH; disconnect() cancels it
+ * - **Drain thread**: with Config::store_forward enabled, a background thread republishes the
+ *   buffered NDATA/DDATA after each birth; disconnect() stops it
+ * - **Node control thread**: with Config::handle_node_control enabled, a background thread
+ *   started by the first request answers Node Control/Rebirth and Scan Rate
  *
  * @par Rust FFI Compatibility
  * - Implements Send: Can transfer between threads safely (all state mutex-protected)
@@ -122,6 +161,18 @@ public:
     std::optional<std::string> password{}; ///< MQTT password for authentication (optional)
     std::optional<CommandCallback>
         command_callback{}; ///< Optional callback for NCMD messages (subscribed before NBIRTH)
+    size_t publish_window = 1000; ///< Maximum async publishes awaiting completion (0 = unlimited)
+    int publish_window_timeout_ms = 5000; ///< How long async publishes wait for a free slot
+    ReconnectPolicy reconnect{}; ///< Automatic reconnect after connection loss (NBIRTH and
+                                 ///< DBIRTHs are replayed with the new bdSeq)
+    StoreForwardConfig store_forward{}; ///< Buffer NDATA/DDATA while disconnected and
+                                        ///< republish them as historical after rebirth
+    BackfillConfig backfill{}; ///< Payload bound and bytes/s budget of publish_backfill()
+    CompressionConfig compression{}; ///< Compress payloads above a size (off by default)
+    BirthReplayConfig birth_replay{}; ///< Spread the DBIRTHs of a rebirth or reconnect over a
+                                      ///< window instead of one burst (off by default)
+    bool handle_node_control = false; ///< Answer Node Control/Rebirth and Node Control/Scan
+                                      ///< Rate in the library (see register_command())
   };
 
   /**
@@ -178,6 +229,38 @@ public:
    */
   [[nodiscard]] std::expected<void, std::string> connect();
 
+  /**
+   * @brief Starts connecting to the MQTT broker without waiting for the result.
+   *
+   * Performs the same session setup as connect() (NDEATH Will, NCMD subscription when a
+   * command callback is configured) but returns as soon as the request is queued. The internal
+   * mutex is not held while the broker answers, so many edge nodes can connect concurrently.
+   *
+   * @param on_complete Called on the MQTT thread once the session is established (NCMD
+   *                    subscribed) or the connection attempt fails
+   *
+   * @return void if the connection attempt started, error message otherwise (on_complete is
+   *         then not called)
+   *
+   * @par Example Usage
+   * @code
+   * std::atomic<int> online{0};
+   * std::latch ready(nodes.size());
+   * for (auto& node : nodes) {
+   *   (void)node.connect_async([&](auto result) {
+   *     if (result) online++;
+   *     ready.count_down();
+   *   });
+   * }
+   * ready.wait();
+   * @endcode
+   *
+   * @note publish_birth() must wait for on_complete to report success.
+   * @note If a later connect starts, or the node is moved or destroyed, before the broker has
+   *       answered, on_complete reports an error and the node is left disconnected.
+   */
+  [[nodiscard]] std::expected<void, std::string> connect_async(ConnectCallback on_complete);
+
   /**
    * @brief Gracefully disconnects from the MQTT broker.
    *
@@ -224,6 +307,9 @@ public:
    *
    * @note Sequence number is automatically incremented (0-255, wraps at 256).
    * @note Timestamp is automatically added if not explicitly set.
+   * @note With Config::store_forward enabled, a payload published while the connection is
+   *       down is flagged historical and buffered instead of failing; it is sent after the
+   *       next NBIRTH (with a new seq) once the session is back.
    *
    * @warning Must call publish_birth() before the first publish_data().
    *
@@ -231,6 +317,86 @@ public:
    */
   [[nodiscard]] std::expected<void, std::string> publish_data(PayloadBuilder& payload);
 
+  /**
+   * @brief Publishes a pre-encoded MetricFrame as NDATA.
+   *
+   * The frame's seq is overwritten with the next sequence number and its bytes are handed to
+   * the MQTT client as they are; nothing is built or serialized on this path.
+   *
+   * @param frame Frame whose values and timestamps are already up to date
+   *
+   * @return void on success, error message on failure
+   *
+   * @note Buffered like publish_data() when Config::store_forward is enabled and the
+   *       connection is down.
+   */
+  [[nodiscard]] std::expected<void, std::string> publish_data(MetricFrame& frame);
+
+  /**
+   * @brief Publishes an NDATA message and reports its delivery through a callback.
+   *
+   * Same as publish_data(), but the message occupies a slot of the publish window until the
+   * MQTT client confirms delivery. When Config::publish_window slots are outstanding the call
+   * blocks (up to Config::publish_window_timeout_ms) before a sequence number is assigned.
+   *
+   * @param payload PayloadBuilder containing changed metrics
+   * @param on_complete Called on the MQTT thread once the message is delivered or fails
+   *
+   * @return void if the message was queued, error message otherwise (on_complete is then not
+   *         called)
+   *
+   * @par Example Usage
+   * @code
+   * std::promise<std::expected<void, std::string>> delivered;
+   * auto result = edge_node.publish_data_async(data, [&](auto r) {
+   *   delivered.set_value(std::move(r));
+   * });
+   * if (result) {
+   *   auto ack = delivered.get_future().get();
+   * }
+   * @endcode
+   *
+   * @warning Do not call from inside a completion callback while the window may be full: the
+   *          slot it waits for can only be released by the thread it is blocking.
+   */
+  [[nodiscard]] std::expected<void, std::string> publish_data_async(PayloadBuilder& payload,
+                                                                    PublishCallback on_complete);
+
+  /**
+   * @brief Publishes an NDATA containing only the metrics that changed (report by exception).
+   *
+   * Each aliased metric in the snapshot is compared with the last value published for that
+   * alias (initially the NBIRTH value). Unchanged metrics are dropped; the rest are sent with
+   * publish_data(). Metrics without an alias, or with an alias not declared in the NBIRTH,
+   * are always sent.
+   *
+   * @param snapshot PayloadBuilder containing the current value of every metric (by alias)
+   *
+   * @return Number of metrics published (0 if nothing changed and no message was sent),
+   *         error message on failure
+   *
+   * @note Float/Double metrics honour the deadband set with set_deadband().
+   * @note The cache is only updated after the NDATA has been handed to MQTT.
+   *
+   * @par Example Usage
+   * @code
+   * sparkplug::PayloadBuilder scan;
+   * scan.add_metric_by_alias(1, read_temperature());
+   * scan.add_metric_by_alias(2, read_pressure());
+   * edge_node.publish_changed_data(scan); // sends only what moved
+   * @endcode
+   */
+  [[nodiscard]] std::expected<size_t, std::string> publish_changed_data(PayloadBuilder& snapshot);
+
+  /**
+   * @brief Sets the deadband for a node metric used by publish_changed_data().
+   *
+   * @param alias Metric alias
+   * @param deadband Minimum absolute change of a Float/Double value that is reported
+   *                 (0 reports every change)
+   */
+  void set_deadband(uint64_t alias, double deadband);
+
   /**
    * @brief Publishes an NDEATH (Node Death) message.
    *
@@ -244,21 +410,35 @@ public:
   [[nodiscard]] std::expected<void, std::string> publish_death();
 
   /**
-   * @brief Triggers a rebirth by publishing a new NBIRTH with incremented bdSeq.
+   * @brief Triggers a rebirth by republishing the stored birth certificates.
    *
    * Rebirth is used when:
    * - SCADA/Primary Application requests it via NCMD/Rebirth
    * - New metrics need to be added to the metric inventory
    * - Edge node configuration changes
    *
+   * With RebirthMode::Reconnect the MQTT session is torn down and re-established (new bdSeq,
+   * new NDEATH Will) before the last NBIRTH is republished. RebirthMode::InSession keeps the
+   * connection: the last NBIRTH and the DBIRTH of every online device are republished with
+   * the current bdSeq, a fresh timestamp and seq 0, 1, 2, ... patched directly into the cached
+   * bytes. Use it to answer Node Control/Rebirth without a reconnect storm on the broker.
+   *
+   * With Config::birth_replay set, only the NBIRTH is published before this returns; the
+   * DBIRTHs follow on a background thread, each taking the next seq when it is sent. NDATA can
+   * be published meanwhile, and DDATA for a device still waiting sends its DBIRTH first.
+   *
+   * @param mode How to rebirth (default: RebirthMode::Reconnect)
+   *
    * @return void on success, error message on failure
    *
-   * @note Automatically increments bdSeq and resets sequence number to 0.
-   * @note Republishes the last NBIRTH payload with updated bdSeq.
+   * @note Resets the sequence number to 0.
+   * @note InSession invalidates the report-by-exception caches, so the next
+   *       publish_changed_data()/publish_changed_device_data() sends every metric.
    *
    * @warning The new NBIRTH should contain ALL metrics (old + new), not just additions.
    */
-  [[nodiscard]] std::expected<void, std::string> rebirth();
+  [[nodiscard]] std::expected<void, std::string>
+  rebirth(RebirthMode mode = RebirthMode::Reconnect);
 
   /**
    * @brief Gets the current message sequence number.
@@ -267,9 +447,8 @@ public:
    *
    * @note Useful for monitoring and debugging.
    */
-  [[nodiscard]] uint64_t get_seq() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return seq_num_;
+  [[nodiscard]] uint64_t get_seq() const noexcept {
+    return seq_num_.load(std::memory_order_relaxed);
   }
 
   /**
@@ -279,11 +458,30 @@ public:
    *
    * @note Used by SCADA to detect new sessions/rebirths.
    */
-  [[nodiscard]] uint64_t get_bd_seq() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return bd_seq_num_;
+  [[nodiscard]] uint64_t get_bd_seq() const noexcept {
+    return bd_seq_num_.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Returns true while the MQTT session is established.
+   *
+   * @note With Config::reconnect enabled this turns false on connection loss and true again
+   *       once the automatic reconnect succeeds.
+   */
+  [[nodiscard]] bool is_connected() const noexcept {
+    return is_connected_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the number of NDATA/DDATA frames waiting in the store-and-forward buffer.
+   */
+  [[nodiscard]] size_t stored_messages() const;
+
+  /**
+   * @brief Returns how many buffered frames were discarded because the buffer was full.
+   */
+  [[nodiscard]] uint64_t dropped_stored_messages() const;
+
   /**
    * @brief Publishes a DBIRTH (Device Birth) message.
    *
@@ -317,12 +515,184 @@ public:
    *
    * @note Sequence number is automatically incremented per device (0-255, wraps at 256).
    * @note Must call publish_device_birth() before the first publish_device_data().
+   * @note Buffered like publish_data() when Config::store_forward is enabled and the
+   *       connection is down.
    *
    * @see publish_device_birth() for establishing aliases
    */
   [[nodiscard]] std::expected<void, std::string> publish_device_data(std::string_view device_id,
                                                                      PayloadBuilder& payload);
 
+  /**
+   * @brief Publishes a pre-encoded MetricFrame as DDATA.
+   *
+   * @param device_id The device identifier
+   * @param frame Frame whose values and timestamps are already up to date
+   *
+   * @return void on success, error message on failure
+   *
+   * @see publish_data(MetricFrame&)
+   */
+  [[nodiscard]] std::expected<void, std::string> publish_device_data(std::string_view device_id,
+                                                                     MetricFrame& frame);
+
+  /**
+   * @brief Publishes a DDATA message and reports its delivery through a callback.
+   *
+   * @param device_id The device identifier
+   * @param payload PayloadBuilder containing changed device metrics
+   * @param on_complete Called on the MQTT thread once the message is delivered or fails
+   *
+   * @return void if the message was queued, error message otherwise (on_complete is then not
+   *         called)
+   *
+   * @see publish_data_async() for the publish window semantics
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_device_data_async(std::string_view device_id, PayloadBuilder& payload,
+                            PublishCallback on_complete);
+
+  /**
+   * @brief Publishes a recorded time series of one metric as historical NDATA.
+   *
+   * The samples are packed in order, each as an alias-only metric with its own timestamp and
+   * the historical flag, into as few NDATA payloads as Config::backfill.max_payload_bytes
+   * allows. While connected, every payload first waits for Config::backfill.bytes_per_second
+   * budget, which is shared by all backfills of this node, so replaying after an outage does
+   * not saturate the link or the broker. Live publish_data() calls are not paced and
+   * interleave with the backfill.
+   *
+   * @tparam T Value type (give it explicitly when passing containers, e.g. <double>)
+   * @param alias Metric alias (must be established in NBIRTH)
+   * @param samples Samples to publish, oldest first
+   *
+   * @return Number of NDATA payloads published, or the first error (the payloads before it
+   *         were sent)
+   *
+   * @par Example
+   * @code
+   * std::vector<sparkplug::TimedSample<double>> samples = read_log(outage_start, now);
+   * auto payloads = edge_node.publish_backfill<double>(1, samples);
+   * @endcode
+   *
+   * @note Blocks while pacing; concurrent backfills are published one after another.
+   * @note Payloads go through publish_data(), so with Config::store_forward enabled they are
+   *       buffered (unpaced) while the connection is down.
+   * @note A single sample larger than the size bound is sent in a payload of its own.
+   */
+  template <SparkplugMetricType T>
+  [[nodiscard]] std::expected<size_t, std::string>
+  publish_backfill(uint64_t alias, std::span<const TimedSample<T>> samples) {
+    return publish_backfill_series({}, alias, samples);
+  }
+
+  /**
+   * @brief Publishes a recorded time series of one device metric as historical DDATA.
+   *
+   * @param device_id The device identifier (DBIRTH must have been published)
+   * @param alias Metric alias (must be established in the DBIRTH)
+   * @param samples Samples to publish, oldest first
+   *
+   * @return Number of DDATA payloads published, or the first error
+   *
+   * @see publish_backfill()
+   */
+  template <SparkplugMetricType T>
+  [[nodiscard]] std::expected<size_t, std::string>
+  publish_device_backfill(std::string_view device_id, uint64_t alias,
+                          std::span<const TimedSample<T>> samples) {
+    if (device_id.empty()) {
+      return std::unexpected("Device ID must not be empty");
+    }
+    return publish_backfill_series(device_id, alias, samples);
+  }
+
+  /**
+   * @brief Returns the number of async publishes still awaiting completion.
+   */
+  [[nodiscard]] size_t in_flight_publishes() const noexcept;
+
+  /**
+   * @brief Blocks until every async publish has completed.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return true if nothing is in flight any more, false on timeout
+   */
+  [[nodiscard]] bool wait_for_publishes(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Returns a snapshot of the message counters and latency histograms.
+   *
+   * Counts every NBIRTH/NDATA/DBIRTH/DDATA/DDEATH/NCMD/DCMD published and every command
+   * received, with byte totals, publish failures, command callback durations and the latency
+   * of async publishes. in_flight is the number of messages still pending in the MQTT client.
+   *
+   * @note Cheap enough to poll from a metrics exporter; recording never takes a lock.
+   */
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * @brief One entry of a batched DDATA publish.
+   */
+  struct DeviceData {
+    std::string_view device_id; ///< Device identifier (must have been born with DBIRTH)
+    PayloadBuilder& payload;    ///< Metrics for the device (seq is assigned by the batch)
+  };
+
+  /**
+   * @brief Publishes DDATA messages for many devices in one call.
+   *
+   * Every device is validated under a single lock acquisition, then each payload is given
+   * the next sequence number, serialized and handed to MQTT in batch order.
+   *
+   * @param batch Devices and payloads to publish, in the order they should be sequenced
+   *
+   * @return void on success, error message on failure
+   *
+   * @note If any device has not been born, nothing is published.
+   * @note If MQTT rejects a message, the entries before it have already been sent; the error
+   *       message reports how many. No sequence number is reserved for the entries after it.
+   * @note Messages published concurrently from other threads may take sequence numbers
+   *       between those of the batch.
+   *
+   * @par Example Usage
+   * @code
+   * std::vector<sparkplug::EdgeNode::DeviceData> batch;
+   * for (auto& [id, builder] : scan_results) {
+   *   batch.push_back({.device_id = id, .payload = builder});
+   * }
+   * edge_node.publish_device_data_batch(batch);
+   * @endcode
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_device_data_batch(std::span<const DeviceData> batch);
+
+  /**
+   * @brief Publishes a DDATA containing only the device metrics that changed.
+   *
+   * Device counterpart of publish_changed_data(); the per-device cache is initialized from
+   * the device's DBIRTH.
+   *
+   * @param device_id The device identifier
+   * @param snapshot PayloadBuilder containing the current value of every metric (by alias)
+   *
+   * @return Number of metrics published (0 if nothing changed), error message on failure
+   */
+  [[nodiscard]] std::expected<size_t, std::string>
+  publish_changed_device_data(std::string_view device_id, PayloadBuilder& snapshot);
+
+  /**
+   * @brief Sets the deadband for a device metric used by publish_changed_device_data().
+   *
+   * @param device_id The device identifier
+   * @param alias Metric alias
+   * @param deadband Minimum absolute change of a Float/Double value that is reported
+   *
+   * @note Deadbands are kept across DBIRTHs of the same device.
+   */
+  void set_device_deadband(std::string_view device_id, uint64_t alias, double deadband);
+
   /**
    * @brief Publishes a DDEATH (Device Death) message.
    *
@@ -385,29 +755,134 @@ public:
   publish_device_command(std::string_view target_edge_node_id, std::string_view target_device_id,
                          PayloadBuilder& payload);
 
+  /**
+   * @brief Registers the handler for one NCMD metric.
+   *
+   * Each metric of a received NCMD is dispatched to the handler registered under its name.
+   * Hosts may address a command by the alias declared in the NBIRTH instead; those aliases are
+   * resolved from every published NBIRTH, and add no work to the dispatch. Received commands
+   * are parsed into a per-thread arena, so dispatch does not allocate.
+   *
+   * With Config::handle_node_control, the library answers "Node Control/Rebirth" with an
+   * in-session rebirth on a background thread, and stores "Node Control/Scan Rate" (see
+   * scan_rate_ms()) and confirms it with an NDATA. Handlers registered for these names run
+   * after the library has handled them.
+   *
+   * @param name Metric name as declared in the NBIRTH (e.g. "Node Control/Reboot")
+   * @param handler Called on the MQTT thread with an empty device id
+   *
+   * @return void on success, error message if the node is connected
+   *
+   * @note Must be called before connect(). NCMD is subscribed when a handler, the command
+   *       callback or node control handling is configured; both the callback and the handlers
+   *       see every NCMD.
+   *
+   * @par Example Usage
+   * @code
+   * edge_node.register_command("Node Control/Reboot", [](auto, const auto& metric) {
+   *   if (metric.boolean_value()) schedule_reboot();
+   * });
+   * @endcode
+   */
+  [[nodiscard]] std::expected<void, std::string> register_command(std::string_view name,
+                                                                  CommandHandler handler);
+
+  /**
+   * @brief Registers the handler for one NCMD metric alias, whatever name the NBIRTH gives it.
+   */
+  [[nodiscard]] std::expected<void, std::string> register_command(uint64_t alias,
+                                                                  CommandHandler handler);
+
+  /**
+   * @brief Registers the handler for one DCMD metric of any device.
+   *
+   * Device counterpart of register_command(); aliases are resolved from each device's DBIRTH.
+   * DCMD is subscribed (for all devices of this node) once a device handler is registered.
+   *
+   * @param name Metric name as declared in the DBIRTHs
+   * @param handler Called on the MQTT thread with the id of the commanded device
+   *
+   * @return void on success, error message if the node is connected
+   */
+  [[nodiscard]] std::expected<void, std::string> register_device_command(std::string_view name,
+                                                                         CommandHandler handler);
+
+  /**
+   * @brief Registers the handler for one DCMD metric alias of any device.
+   */
+  [[nodiscard]] std::expected<void, std::string> register_device_command(uint64_t alias,
+                                                                         CommandHandler handler);
+
+  /**
+   * @brief Returns the scan rate set through Node Control/Scan Rate, in milliseconds.
+   *
+   * @return The last rate commanded by a host, else the value declared in the NBIRTH, else 0
+   *
+   * @note Only maintained with Config::handle_node_control. The rate is not patched into the
+   *       cached NBIRTH; publish a new birth to make it part of later rebirths.
+   */
+  [[nodiscard]] int64_t scan_rate_ms() const noexcept {
+    return scan_rate_ms_.load(std::memory_order_relaxed);
+  }
+
 private:
+  // Topic strings for one device, formatted once when the device is first born
+  struct DeviceTopics {
+    std::string birth; // DBIRTH topic
+    std::string data;  // DDATA topic
+    std::string death; // DDEATH topic
+  };
+
   /**
    * @brief Tracks state for an individual device attached to this edge node.
    */
   struct DeviceState {
     std::vector<uint8_t> last_birth_payload; // Last DBIRTH for rebirth
     bool is_online{false};                   // True if DBIRTH sent and device online
+    bool awaiting_birth{false};              // Online before the last NBIRTH, not reborn yet
+    bool birth_pending{false};               // DBIRTH queued for the paced replay
+    DeviceTopics topics;                     // Cached publish topics for this device
+    AliasRegistry published_values;          // Last published value per alias (from DBIRTH)
+    detail::CommandAliases command_aliases;  // DBIRTH aliases of registered device commands
+    std::unordered_map<uint64_t, double> deadbands; // Per-alias deadbands for changed data
   };
 
+  [[nodiscard]] DeviceTopics make_device_topics(std::string_view device_id) const;
+
   Config config_;
   MQTTAsyncHandle client_;
-  uint64_t seq_num_{0};    // Node message sequence (0-255)
-  uint64_t bd_seq_num_{0}; // Birth/Death sequence
+  // client_.get(), stored under the mutex whenever client_ changes, for lock-free readers
+  std::atomic<MQTTAsync> published_client_{nullptr};
+  std::atomic<uint64_t> seq_num_{0};    // Node message sequence (0-255)
+  std::atomic<uint64_t> bd_seq_num_{0}; // Birth/Death sequence
+
+  // Node topic strings never change, so they are formatted once at construction
+  std::string birth_topic_str_; // NBIRTH topic
+  std::string data_topic_str_;  // NDATA topic
 
   // Store the NDEATH payload for the MQTT Will
   std::vector<uint8_t> death_payload_data_;
-  std::string death_topic_str_;     // Topic string for MQTT Will (must outlive async connect)
+  std::string death_topic_str_;     // NDEATH topic, also used by the MQTT Will
   MQTTAsync_willOptions will_opts_; // Will options struct (must outlive async connect)
   MQTTAsync_SSLOptions ssl_opts_{};
 
   // Store last NBIRTH for rebirth command
   std::vector<uint8_t> last_birth_payload_;
 
+  // Metric names of published_values_ and the devices' registries. Shared with a node moved
+  // from this one, whose registries keep their handles; declared before them so it outlives them.
+  std::shared_ptr<StringInterner> names_;
+
+  // Report-by-exception state for publish_changed_data() (rebuilt from each NBIRTH)
+  AliasRegistry published_values_;
+  std::unordered_map<uint64_t, double> deadbands_;
+
+  // Bounds publish_*_async(); shared with the completion contexts queued in Paho
+  std::shared_ptr<PublishWindow> publish_window_;
+
+  // Counters behind stats(); shared with the completion contexts queued in Paho
+  std::shared_ptr<detail::StatsRecorder> stats_;
+
   // Hash and equality functors that support heterogeneous lookup (string_view)
   struct StringHash {
     using is_transparent = void;
@@ -426,21 +901,179 @@ private:
   // Track state of attached devices (device_id -> state, with heterogeneous lookup)
   std::unordered_map<std::string, DeviceState, StringHash, StringEqual> device_states_;
 
-  bool is_connected_{false};
+  // Devices queued for the Config::birth_replay thread, oldest first; entries whose
+  // birth_pending has been cleared since are skipped
+  std::deque<std::string> pending_births_;
+
+  std::atomic<bool> is_connected_{false};
 
   // Mutex for thread-safe access to all mutable state
   mutable std::mutex mutex_;
 
-  [[nodiscard]] static std::expected<void, std::string>
-  publish_message(MQTTAsync client, const std::string& topic_str,
+  // Config::compression: the wrapped payload in a per-thread buffer, or payload_data itself
+  // if it is below the threshold or cannot be compressed
+  [[nodiscard]] std::span<const uint8_t>
+  compress_for_publish(std::span<const uint8_t> payload_data);
+
+  // Hand one message to Paho and count it under type
+  [[nodiscard]] std::expected<void, std::string>
+  publish_message(MessageType type, MQTTAsync client, const std::string& topic_str,
                   std::span<const uint8_t> payload_data, int qos, bool retain);
 
-  // Static MQTT callback for message arrived (NCMD)
+  // birth_replay_->lock_sends() (an empty lock without Config::birth_replay), held by every
+  // publisher from seq reservation to send so the replay's DBIRTHs keep their place in seq order
+  [[nodiscard]] std::unique_lock<std::mutex> lock_replay_sends();
+
+  // published_client_, for publishers that need nothing else from the mutex
+  [[nodiscard]] MQTTAsync current_client() const noexcept;
+
+  // Assign seq, serialize and send an NDATA/DDATA (async when on_complete is set)
+  [[nodiscard]] std::expected<void, std::string>
+  send_data_message(MessageType type, MQTTAsync client, const std::string& topic_str,
+                    PayloadBuilder& payload, PublishWindow::Slot slot,
+                    PublishCallback on_complete);
+
+  // Copy the DDATA topic of an online device into topic_str and the current client into
+  // client, first sending its DBIRTH if the paced replay has not reached it yet
+  [[nodiscard]] std::expected<void, std::string>
+  device_data_topic(std::string_view device_id, std::string& topic_str, MQTTAsync& client);
+
+  // Send the queued DBIRTH of device_id (of the oldest queued device if empty) with the next
+  // seq; false if none was queued. The caller holds birth_replay_->lock_sends().
+  [[nodiscard]] std::expected<bool, std::string> send_pending_birth(std::string_view device_id);
+
+  // Send the queued DBIRTH of device_id now, if the paced replay has not sent it. The caller
+  // holds lock_replay_sends().
+  [[nodiscard]] std::expected<void, std::string> preempt_pending_birth(std::string_view device_id);
+
+  // RebirthMode::InSession: republish patched NBIRTH and DBIRTHs on the current connection
+  [[nodiscard]] std::expected<void, std::string> rebirth_in_session();
+
+  // One Config::reconnect attempt: connect (new bdSeq) and replay the stored births
+  [[nodiscard]] std::expected<void, std::string> reconnect_and_replay();
+
+  // Background retry loop for Config::reconnect (stopped before the node is torn down)
+  std::unique_ptr<detail::Reconnector> reconnector_;
+
+  // Set by EdgeNodeGroup, which reconnects its nodes itself; runs instead of reconnector_
+  friend class EdgeNodeGroup;
+  std::function<void()> connection_lost_hook_;
+
+  // Config::store_forward buffer and drain thread (null when disabled)
+  std::unique_ptr<detail::ForwardQueue> store_forward_;
+
+  // Buffer a copy of an NDATA/DDATA flagged historical while the session is down
+  [[nodiscard]] std::expected<void, std::string>
+  store_data_message(std::string_view device_id, const PayloadBuilder& payload);
+  [[nodiscard]] std::expected<void, std::string> store_data_message(std::string_view device_id,
+                                                                    const MetricFrame& frame);
+  [[nodiscard]] std::expected<void, std::string>
+  store_serialized_message(std::string_view device_id, std::span<const uint8_t> payload_data);
+
+  // Republish one buffered frame with a fresh seq (called on the drain thread)
+  [[nodiscard]] std::expected<void, std::string>
+  forward_stored_message(const StoreForwardBuffer::Frame& frame);
+
+  // Start draining the store-and-forward buffer once a birth has been (re)published
+  void start_forwarding();
+
+  // Historical payload being filled by publish_backfill_series()
+  struct BackfillBatch {
+    PayloadBuilder payload;
+    size_t bytes{0}; // Encoded size including the payload timestamp and seq
+  };
+
+  template <SparkplugMetricType T>
+  [[nodiscard]] std::expected<size_t, std::string>
+  publish_backfill_series(std::string_view device_id, uint64_t alias,
+                          std::span<const TimedSample<T>> samples) {
+    std::lock_guard<std::mutex> lock(backfill_mutex_);
+    BackfillBatch batch;
+    org::eclipse::tahu::protobuf::Payload::Metric metric;
+    size_t published = 0;
+    for (const auto& sample : samples) {
+      metric.Clear();
+      detail::fill_metric(&metric, "", sample.value, alias);
+      metric.set_timestamp(sample.timestamp_ms);
+      metric.set_is_historical(true);
+      auto sent = append_backfill_metric(device_id, batch, metric);
+      if (!sent) {
+        return std::unexpected(std::move(sent.error()));
+      }
+      published += *sent;
+    }
+    auto sent = flush_backfill(device_id, batch);
+    if (!sent) {
+      return std::unexpected(std::move(sent.error()));
+    }
+    return published + *sent;
+  }
+
+  // Move metric into batch, first publishing the batch if metric would overflow it;
+  // returns the number of payloads published
+  [[nodiscard]] std::expected<size_t, std::string>
+  append_backfill_metric(std::string_view device_id, BackfillBatch& batch,
+                         org::eclipse::tahu::protobuf::Payload::Metric& metric);
+
+  // Publish a non-empty batch once the budget allows and empty it; returns 0 or 1
+  [[nodiscard]] std::expected<size_t, std::string> flush_backfill(std::string_view device_id,
+                                                                  BackfillBatch& batch);
+
+  // Config::backfill.bytes_per_second; backfill_mutex_ serializes backfills and guards it
+  std::mutex backfill_mutex_;
+  TokenBucket backfill_budget_{0, 0};
+
+  // Config::birth_replay thread (null when the window is zero)
+  std::unique_ptr<detail::BirthReplayer> birth_replay_;
+
+  // Atomically advance seq_num_ (wrapping at 256) and return the new value
+  [[nodiscard]] uint64_t next_seq() noexcept;
+
+  // Registered NCMD/DCMD handlers (fixed once connected) and the NBIRTH aliases resolved for
+  // node commands (guarded by mutex_)
+  detail::CommandRegistry node_commands_;
+  detail::CommandRegistry device_commands_;
+  detail::CommandAliases node_command_aliases_;
+
+  // Config::handle_node_control: NBIRTH aliases of the control metrics (guarded by mutex_),
+  // requests for the control thread, and the commanded scan rate
+  std::optional<uint64_t> rebirth_alias_;
+  std::optional<uint64_t> scan_rate_alias_;
+  std::atomic<bool> rebirth_requested_{false};
+  std::atomic<bool> scan_rate_changed_{false};
+  std::atomic<int64_t> scan_rate_ms_{0};
+  std::unique_ptr<detail::SignalledTask> node_control_;
+
+  // Resolve command and control aliases from an NBIRTH that was just published
+  void resolve_node_commands(const org::eclipse::tahu::protobuf::Payload& birth);
+
+  // Run the handlers (and node controls) of every metric of a received NCMD/DCMD
+  void dispatch_commands(std::string_view device_id,
+                         const org::eclipse::tahu::protobuf::Payload& payload);
+
+  // Answer the queued node control requests (called on the node_control_ thread)
+  void run_node_control();
+
+  // Static MQTT callback for message arrived (NCMD/DCMD)
   static int on_message_arrived(void* context, char* topicName, int topicLen,
                                 MQTTAsync_message* message);
 
   // Static MQTT callback for connection lost
   static void on_connection_lost(void* context, char* cause);
+
+  // connect_async() state handed to Paho; completion callbacks below finish the session setup
+  struct ConnectContext;
+  static void on_connect_success(void* context, MQTTAsync_successData* response);
+  static void on_connect_failure(void* context, MQTTAsync_failureData* response);
+  // Queue the NCMD or DCMD subscription of node with ctx as its context
+  [[nodiscard]] static std::expected<void, std::string>
+  subscribe_commands(EdgeNode& node, ConnectContext& ctx, MessageType type);
+  static void on_subscribe_success(void* context, MQTTAsync_successData* response);
+  static void on_subscribe_failure(void* context, MQTTAsync_failureData* response);
+
+  // The attempt of the last connect_async() (guarded by mutex_), and how it is given up
+  std::shared_ptr<detail::ConnectAttempt<EdgeNode>> connect_attempt_;
+  void abandon_connect();
 };
 
 } // namespace sparkplug
\ No newline at end of file
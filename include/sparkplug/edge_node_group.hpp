@@ -0,0 +1,156 @@
+// include/sparkplug/edge_node_group.hpp
+#pragma once
+
+#include "edge_node.hpp"
+#include "stats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Many logical Edge Nodes of one group run on a bounded pool of worker threads.
+ *
+ * Gateways and simulators that stand in for hundreds of edge nodes would otherwise drive each
+ * EdgeNode from its own threads: one application thread per blocking connect(), and one
+ * reconnect thread per node after a broker outage, all started at the same moment. The group
+ * owns its nodes and runs connect(), disconnect(), for_each() and every automatic reconnect of
+ * Config::node.reconnect as tasks on Config::workers threads. Reconnects wait for their backoff
+ * delay in one shared timer queue, none of them block a thread while they wait.
+ *
+ * Every node keeps its own MQTT session, bdSeq, seq and NDEATH will: MQTT allows one will per
+ * connection, and Sparkplug requires each node's will to be its own NDEATH, so logical nodes
+ * never share a connection. Paho already serves all sessions of the process from its own
+ * network threads.
+ *
+ * @par Thread Safety
+ * Nodes are thread-safe EdgeNodes and may be used directly from any thread. Disconnect them
+ * through the group, which also cancels their pending reconnects.
+ *
+ * @par Example
+ * @code
+ * sparkplug::EdgeNodeGroup gateway({
+ *     .node = {.broker_url = "tcp://localhost:1883",
+ *              .client_id = "gateway",
+ *              .group_id = "Plant",
+ *              .edge_node_id = {},  // Set per node from edge_node_ids
+ *              .reconnect = {.enabled = true}},
+ *     .edge_node_ids = meter_ids,  // e.g. 1000 logical meters
+ *     .workers = 8});
+ *
+ * gateway.connect();
+ * gateway.for_each([](sparkplug::EdgeNode& node) {
+ *   sparkplug::PayloadBuilder birth;
+ *   birth.add_metric_with_alias("Energy", 1, 0.0);
+ *   return node.publish_birth(birth);
+ * });
+ * @endcode
+ */
+class EdgeNodeGroup {
+public:
+  /**
+   * @brief Configuration of a group of Edge Nodes.
+   */
+  struct Config {
+    EdgeNode::Config node; ///< Settings for every node; edge_node_id is set per node and the
+                           ///< client id gets "-<edge_node_id>"
+    std::vector<std::string> edge_node_ids{}; ///< One logical node per id
+    size_t workers = 4; ///< Threads running connects, reconnects and for_each() (at least 1)
+  };
+
+  /// Work run by for_each() on one node
+  using NodeTask = std::function<std::expected<void, std::string>(EdgeNode& node)>;
+
+  /**
+   * @brief Creates the nodes and starts the workers, without connecting.
+   *
+   * @param config Group configuration (moved)
+   */
+  explicit EdgeNodeGroup(Config config);
+  ~EdgeNodeGroup();
+
+  // Nodes report connection loss back to the group, so it cannot move
+  EdgeNodeGroup(const EdgeNodeGroup&) = delete;
+  EdgeNodeGroup& operator=(const EdgeNodeGroup&) = delete;
+
+  [[nodiscard]] size_t size() const noexcept {
+    return members_.size();
+  }
+
+  /**
+   * @brief Returns the node at index, in the order of Config::edge_node_ids.
+   */
+  [[nodiscard]] EdgeNode& node(size_t index) noexcept {
+    return *members_[index].node;
+  }
+  [[nodiscard]] const EdgeNode& node(size_t index) const noexcept {
+    return *members_[index].node;
+  }
+
+  /**
+   * @brief Looks up a node by its edge node id.
+   *
+   * @return The node, or nullptr if the group has no such node
+   */
+  [[nodiscard]] EdgeNode* find(std::string_view edge_node_id) noexcept;
+
+  /**
+   * @brief Connects every node, Config::workers at a time.
+   *
+   * @return void on success; on failure the nodes already connected are disconnected
+   *
+   * @note Automatic reconnect (Config::node.reconnect) is armed once a node is connected.
+   */
+  [[nodiscard]] std::expected<void, std::string> connect();
+
+  /**
+   * @brief Cancels pending reconnects, then disconnects every node (publishing its NDEATH).
+   *
+   * @return void on success, the first error otherwise (all nodes are still attempted)
+   */
+  [[nodiscard]] std::expected<void, std::string> disconnect();
+
+  /**
+   * @brief Runs task on every node on the worker threads and waits for all of them.
+   *
+   * @return void on success, the first error in node order otherwise
+   *
+   * @warning The task must not call connect(), disconnect() or for_each() of the group.
+   */
+  [[nodiscard]] std::expected<void, std::string> for_each(const NodeTask& task);
+
+  /**
+   * @brief Returns the counters of all nodes added together.
+   */
+  [[nodiscard]] Stats stats() const;
+
+private:
+  struct Member {
+    std::unique_ptr<EdgeNode> node;
+    std::atomic<bool> auto_reconnect{false}; // Set once connected, cleared by disconnect()
+  };
+
+  // Runs task on every member's node; results are indexed like members_
+  std::vector<std::expected<void, std::string>>
+  run_on_all(const std::function<std::expected<void, std::string>(Member&)>& task);
+
+  // Queue reconnect attempt `attempt` of a member after its backoff delay
+  void schedule_reconnect(size_t index, size_t attempt);
+
+  ReconnectPolicy reconnect_;
+  std::vector<Member> members_;
+
+  // Worker threads and their timer queue (defined in the translation unit). Declared last so
+  // the workers are joined before the nodes they use are destroyed.
+  class Scheduler;
+  std::unique_ptr<Scheduler> scheduler_;
+};
+
+} // namespace sparkplug
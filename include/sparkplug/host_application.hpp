@@ -1,19 +1,34 @@
 // include/sparkplug/host_application.hpp
 #pragma once
 
+#include "alias_registry.hpp"
 #include "mqtt_handle.hpp"
 #include "payload_builder.hpp"
+#include "publish_window.hpp"
+#include "reconnect.hpp"
+#include "snapshot.hpp"
 #include "sparkplug_b.pb.h"
+#include "stats.hpp"
+#include "string_interner.hpp"
+#include "token_bucket.hpp"
 #include "topic.hpp"
+#include "value_store.hpp"
+#include "wire_format.hpp"
 
+#include <array>
+#include <chrono>
 #include <expected>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <MQTTAsync.h>
 
@@ -39,10 +54,56 @@ using LogCallback = std::function<void(LogLevel, std::string_view)>;
  *
  * @param topic Parsed Sparkplug B topic containing group_id, message_type, edge_node_id, etc.
  * @param payload Decoded Sparkplug B protobuf payload with metrics
+ *
+ * @note The payload is only valid for the duration of the callback; copy it to retain it.
+ * @note With HostApplication::Config::dispatch_threads > 0 the callback runs concurrently on
+ *       several worker threads (one node is always handled by the same worker, in order).
  */
 using MessageCallback =
     std::function<void(const Topic&, const org::eclipse::tahu::protobuf::Payload&)>;
 
+/**
+ * @brief Predicate deciding from the topic alone whether a message is delivered.
+ *
+ * @param topic View into the MQTT topic name (valid only during the call)
+ *
+ * @return false to drop the message before its payload is decoded
+ *
+ * @note Without dispatch threads it is called once per message, on the MQTT client thread.
+ *       With HostApplication::Config::dispatch_threads > 0 it is called on the MQTT client
+ *       thread, to decide whether a message is queued whole or only its scanned header, and
+ *       again on the worker thread that handles the message. It must therefore be thread-safe
+ *       and give the same answer for the same topic.
+ */
+using MessageFilter = std::function<bool(const TopicView&)>;
+
+/**
+ * @brief Automatic recovery of nodes whose state a HostApplication has lost track of.
+ *
+ * A node loses its state when a seq gap is seen, or when NDATA, DBIRTH or DDATA arrive before
+ * the birth they depend on. The host then sends it an NCMD with "Node Control/Rebirth" = true.
+ * Requests are deduplicated per node: an unanswered one is repeated after min_interval_ms at
+ * the earliest. A budget of max_requests_per_second is shared by all nodes, so many nodes
+ * losing state at once after a broker hiccup are not all asked at the same instant. A node
+ * over budget stays marked and is asked on one of its next messages. Until its NBIRTH
+ * arrives, the node's NDATA, DBIRTH and DDATA are dropped without updating state or invoking
+ * callbacks.
+ *
+ * @par Example
+ * @code
+ * config.rebirth_recovery = {.enabled = true, .max_requests_per_second = 20};
+ * @endcode
+ *
+ * @note Requires Config::validate_sequence, and a connection for the requests to be sent.
+ */
+struct RebirthRecoveryPolicy {
+  bool enabled = false;                 ///< Request rebirths automatically
+  int min_interval_ms = 5000;           ///< Per node: delay before an unanswered request repeats
+  double max_requests_per_second = 10;  ///< Budget shared by all nodes (0 = unlimited)
+  size_t burst = 10;                    ///< Requests sent at once before the budget applies
+  bool drop_until_birth = true;         ///< Drop data of a node until it rebirths (false = deliver)
+};
+
 /**
  * @brief Sparkplug B Host Application for SCADA/Primary Applications.
  *
@@ -57,8 +118,10 @@ using MessageCallback =
  * A Host Application should use a single MQTT client that both receives data and sends commands.
  *
  * @par Thread Safety
- * This class is fully thread-safe with coarse-grained locking:
- * - All public methods use a single internal mutex to protect shared state
+ * This class is fully thread-safe:
+ * - Connection and configuration state is guarded by one internal mutex
+ * - Node state is split into hash-partitioned shards, each with its own mutex, so
+ *   get_node_state()/get_metric_name() only contend with ingest of nodes in the same shard
  * - Methods can be safely called from any thread concurrently
  * - Callbacks (message_callback, log_callback) invoked on MQTT thread WITHOUT holding mutex
  * - Mutex is released before MQTT publish to prevent callback deadlocks
@@ -124,22 +187,8 @@ public:
     bool is_online{false};      ///< True if DBIRTH received and device is online
     uint64_t last_seq{255};     ///< Last received device sequence number
     bool birth_received{false}; ///< True if DBIRTH has been received
-    std::unordered_map<uint64_t, std::string>
-        alias_map; ///< Maps metric alias to name (from DBIRTH)
-  };
-
-  /**
-   * @brief Transparent hash for string keys to enable heterogeneous lookup.
-   */
-  struct TransparentStringHash {
-    using is_transparent = void;
-    using hash_type = std::hash<std::string_view>;
-    [[nodiscard]] size_t operator()(std::string_view str) const noexcept {
-      return hash_type{}(str);
-    }
-    [[nodiscard]] size_t operator()(const std::string& str) const noexcept {
-      return hash_type{}(str);
-    }
+    AliasRegistry aliases;      ///< Metric alias registry (from DBIRTH)
+    ValueStore values;          ///< Last known metric values (Config::track_values)
   };
 
   /**
@@ -151,12 +200,24 @@ public:
     uint64_t bd_seq{0};          ///< Current birth/death sequence number
     uint64_t birth_timestamp{0}; ///< Timestamp of last NBIRTH
     bool birth_received{false};  ///< True if NBIRTH has been received
-    std::unordered_map<std::string, DeviceState, TransparentStringHash, std::equal_to<>>
-        devices; ///< Attached devices (device_id -> state)
-    std::unordered_map<uint64_t, std::string>
-        alias_map; ///< Maps metric alias to name (from NBIRTH)
+    std::unordered_map<InternedString, DeviceState, InternedStringHash, std::equal_to<>>
+        devices; ///< Attached devices (interned device_id -> state, string_view lookup)
+    AliasRegistry aliases; ///< Metric alias registry (from NBIRTH)
+    ValueStore values;     ///< Last known metric values (Config::track_values)
   };
 
+  /**
+   * @brief Last known value of one node or device metric, as copied by snapshot_node_values().
+   */
+  struct MetricSnapshot {
+    std::string device_id;         ///< Device the metric belongs to (empty for node metrics)
+    ValueStore::OwnedEntry metric; ///< Name, alias, datatype, timestamp and value
+  };
+
+  /// Visitor for visit_node_values(); device_id is empty for node metrics
+  using MetricVisitor =
+      std::function<void(std::string_view device_id, const ValueStore::Entry& metric)>;
+
   /**
    * @brief Configuration parameters for the Sparkplug B Host Application.
    */
@@ -171,11 +232,40 @@ public:
     int max_inflight = 100; ///< Maximum number of QoS 1/2 messages allowed in-flight (default: 100,
                             ///< paho default: 10)
     bool validate_sequence = true;   ///< Enable sequence number validation (detects packet loss)
+    bool resolve_aliases = false; ///< Fill in name and datatype of alias-only NDATA/DDATA metrics
+                                  ///< from the birth before delivery (requires validate_sequence)
+    bool track_values = false; ///< Keep the last known value of every metric from
+                               ///< NBIRTH/NDATA/DBIRTH/DDATA (requires validate_sequence)
+    size_t max_name_bytes = 64 * 1024 * 1024; ///< Cap on the pooled group, node, device and
+                                              ///< metric names; new nodes and births with new
+                                              ///< names are not tracked past it (0 = unlimited)
+    bool use_arena = false; ///< Parse payloads into a thread-local protobuf arena that is reset
+                            ///< after each message (avoids per-metric heap allocations)
+    size_t arena_block_size = 64 * 1024; ///< Initial arena block size in bytes, retained between
+                                         ///< messages (only used when use_arena is true)
+    size_t dispatch_threads = 0; ///< Worker threads for parsing, validation and callbacks
+                                 ///< (0 = handle messages on the MQTT client thread)
+    size_t dispatch_queue_capacity = 10000; ///< Per-worker queue bound; the MQTT thread blocks
+                                            ///< when a worker's queue is full
+    size_t publish_window = 1000; ///< Maximum async commands awaiting completion (0 = unlimited)
+    int publish_window_timeout_ms = 5000; ///< How long async commands wait for a free slot
+    ReconnectPolicy reconnect{}; ///< Automatic reconnect after connection loss (subscriptions
+                                 ///< and an online STATE are re-issued)
     std::optional<TlsOptions> tls{}; ///< TLS/SSL options (required if broker_url uses ssl://)
     std::optional<std::string> username{}; ///< MQTT username for authentication (optional)
     std::optional<std::string> password{}; ///< MQTT password for authentication (optional)
     MessageCallback message_callback{};    ///< Callback for received Sparkplug messages
+    /// Callbacks per MessageType (indexed by its value), used instead of message_callback
+    std::array<MessageCallback, MESSAGE_TYPE_COUNT> type_callbacks{};
+    MessageFilter message_filter{}; ///< Rejected messages are neither delivered nor fully decoded
     LogCallback log_callback{};            ///< Optional callback for library log messages
+    LogLevel log_level = LogLevel::DEBUG;  ///< Messages below this level are never formatted
+    int log_coalesce_interval_ms = 0; ///< Repeats of a sequence warning for the same node are
+                                      ///< suppressed for this long and counted into the next one,
+                                      ///< or reported at disconnect (0 = log every occurrence)
+    RebirthRecoveryPolicy rebirth_recovery{}; ///< Request rebirths of nodes with lost state
+                                              ///< (off by default)
+    SnapshotConfig snapshot{}; ///< Node state saved across restarts (off by default)
   };
 
   /**
@@ -227,6 +317,50 @@ public:
    */
   void set_message_callback(MessageCallback callback);
 
+  /**
+   * @brief Sets the callback for one message type, used instead of the general one.
+   *
+   * Message types without a callback of their own, and with no general message callback,
+   * are not delivered. Their payloads are only decoded as far as state tracking needs.
+   *
+   * @param type Message type to deliver to callback
+   * @param callback Callback function (empty to fall back to the general message callback)
+   *
+   * @note Must be called before connect().
+   *
+   * @par Example
+   * @code
+   * // Track node lifecycles only: NDATA/DDATA are never fully decoded
+   * host.set_message_callback(sparkplug::MessageType::NBIRTH, on_birth);
+   * host.set_message_callback(sparkplug::MessageType::NDEATH, on_death);
+   * host.set_message_callback(sparkplug::MessageType::STATE, on_state);
+   * @endcode
+   */
+  void set_message_callback(MessageType type, MessageCallback callback);
+
+  /**
+   * @brief Sets a predicate that drops messages by topic before their payload is decoded.
+   *
+   * A rejected message is not delivered. With validate_sequence enabled, its payload is then
+   * only scanned for seq, timestamp and (NDEATH) bdSeq, so gap and bdSeq checks keep working;
+   * NBIRTH and DBIRTH are still decoded to rebuild the alias registries. A rejected
+   * NDATA/DDATA is fully decoded only when Config::track_values needs its metrics.
+   *
+   * @param filter Predicate on the topic (empty to accept every message)
+   *
+   * @note Must be called before connect().
+   * @note With Config::dispatch_threads > 0 the filter runs on the MQTT client thread, which
+   *       scans rejected payloads itself and never queues them for a worker.
+   *
+   * @par Example
+   * @code
+   * host.set_message_filter([](const sparkplug::TopicView& topic) {
+   *   return topic.group_id == "Energy" || topic.message_type == sparkplug::MessageType::STATE;
+   * });
+   * @endcode
+   */
+  void set_message_filter(MessageFilter filter);
+
   /**
    * @brief Sets the log callback for receiving library diagnostic messages.
    *
@@ -248,6 +382,23 @@ public:
    */
   [[nodiscard]] std::expected<void, std::string> connect();
 
+  /**
+   * @brief Starts connecting to the MQTT broker without waiting for the result.
+   *
+   * The internal mutex is only held while the client is prepared, not while the broker
+   * answers.
+   *
+   * @param on_complete Called on the MQTT thread once the connection succeeds or fails
+   *
+   * @return void if the connection attempt started, error message otherwise (on_complete is
+   *         then not called)
+   *
+   * @note Subscribe and publish_state_birth() only after on_complete reports success.
+   * @note If a later connect starts, or the host is moved or destroyed, before the broker has
+   *       answered, on_complete reports an error and the host is left disconnected.
+   */
+  [[nodiscard]] std::expected<void, std::string> connect_async(ConnectCallback on_complete);
+
   /**
    * @brief Gracefully disconnects from the MQTT broker.
    *
@@ -344,12 +495,100 @@ public:
    *
    * @note Returns std::nullopt if the node/device hasn't sent a birth message yet,
    *       or if the alias is not found in the birth message.
+   * @note The view points into the host's name pool and is valid while the HostApplication is.
    */
   [[nodiscard]] std::optional<std::string_view> get_metric_name(std::string_view group_id,
                                                                 std::string_view edge_node_id,
                                                                 std::string_view device_id,
                                                                 uint64_t alias) const;
 
+  /**
+   * @brief Returns the last known value of a metric.
+   *
+   * Requires Config::track_values. Values are recorded from NBIRTH/DBIRTH and updated by every
+   * NDATA/DDATA before the message callback runs; they survive NDEATH/DDEATH, so check
+   * get_node_state() when staleness matters.
+   *
+   * @param group_id The group ID
+   * @param edge_node_id The edge node ID
+   * @param device_id The device ID (empty string for node-level metrics)
+   * @param metric_name Metric name as declared in the birth certificate
+   *
+   * @return Copy of the metric entry, std::nullopt if the node, device or metric is unknown
+   *
+   * @par Example Usage
+   * @code
+   * if (auto temp = host_app.get_metric_value("Energy", "Gateway01", "Sensor01", "Temp")) {
+   *   std::cout << std::get<double>(temp->value) << "\n";
+   * }
+   * @endcode
+   */
+  [[nodiscard]] std::optional<ValueStore::OwnedEntry>
+  get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                   std::string_view device_id, std::string_view metric_name) const;
+
+  /**
+   * @brief Returns the last known value of a metric identified by its alias.
+   *
+   * @see get_metric_value(std::string_view, std::string_view, std::string_view,
+   *      std::string_view) const
+   */
+  [[nodiscard]] std::optional<ValueStore::OwnedEntry>
+  get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                   std::string_view device_id, uint64_t alias) const;
+
+  /**
+   * @brief Copies the last known value of every metric of a node and its devices.
+   *
+   * The copy is taken under one lock, so it reflects a single point in the message stream.
+   *
+   * @return Node metrics first, then each device's metrics; std::nullopt if the node is unknown
+   */
+  [[nodiscard]] std::optional<std::vector<MetricSnapshot>>
+  snapshot_node_values(std::string_view group_id, std::string_view edge_node_id) const;
+
+  /**
+   * @brief Calls visitor for every metric of a node and its devices without copying them.
+   *
+   * @return false if the node is unknown
+   *
+   * @warning The visitor runs under the node-state lock: keep it short and do not call back
+   *          into the HostApplication from it.
+   */
+  bool visit_node_values(std::string_view group_id, std::string_view edge_node_id,
+                         const MetricVisitor& visitor) const;
+
+  /**
+   * @brief Writes the state of every born node to a snapshot file.
+   *
+   * Each node is copied under its shard lock: bdSeq, seq, online flags, and a birth rebuilt
+   * from its alias map and last values (Config::track_values), for the node and its devices.
+   * The file is written through a mapping of a temporary file that is then renamed over path,
+   * so a crash mid-save leaves the previous snapshot intact.
+   *
+   * @param path Snapshot file to replace
+   *
+   * @return Number of nodes saved, error message on failure
+   *
+   * @note Done automatically when Config::snapshot is set.
+   */
+  [[nodiscard]] std::expected<size_t, std::string> save_snapshot(const std::string& path) const;
+
+  /**
+   * @brief Loads node state written by save_snapshot().
+   *
+   * Nodes the host already has a birth for are left alone. Restored nodes are validated
+   * against the next message they send (see SnapshotConfig).
+   *
+   * @param path Snapshot file to read
+   *
+   * @return Number of nodes restored, error message if the file cannot be read or is corrupt
+   *         (in which case no state is changed)
+   *
+   * @note Done automatically by the first connect() when Config::snapshot is set.
+   */
+  [[nodiscard]] std::expected<size_t, std::string> restore_snapshot(const std::string& path);
+
   /**
    * @brief Publishes a STATE birth message to indicate Host Application is online.
    *
@@ -458,6 +697,97 @@ public:
   publish_device_command(std::string_view group_id, std::string_view target_edge_node_id,
                          std::string_view target_device_id, PayloadBuilder& payload);
 
+  /**
+   * @brief Publishes an NCMD message and reports its delivery through a callback.
+   *
+   * Lets callers pipeline commands without waiting for each acknowledgement. Each command holds
+   * a slot of the publish window until Paho reports completion (PUBACK at the default QoS 1);
+   * when Config::publish_window slots are outstanding the call blocks for up to
+   * Config::publish_window_timeout_ms and then fails.
+   *
+   * @param group_id The Sparkplug group ID containing the target Edge Node
+   * @param target_edge_node_id The target Edge Node identifier
+   * @param payload PayloadBuilder containing command metrics
+   * @param on_complete Called on the MQTT thread once the command is delivered or fails
+   *
+   * @return void if the command was queued, error message otherwise (on_complete is then not
+   *         called)
+   *
+   * @par Example Usage
+   * @code
+   * for (const auto& node : nodes) {
+   *   sparkplug::PayloadBuilder cmd;
+   *   cmd.add_metric("Node Control/Rebirth", true);
+   *   (void)host_app.publish_node_command_async("Energy", node, cmd, [node](auto result) {
+   *     if (!result) std::cerr << node << ": " << result.error() << "\n";
+   *   });
+   * }
+   * (void)host_app.wait_for_publishes(std::chrono::seconds(5));
+   * @endcode
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_node_command_async(std::string_view group_id, std::string_view target_edge_node_id,
+                             PayloadBuilder& payload, PublishCallback on_complete);
+
+  /**
+   * @brief Publishes a DCMD message and reports its delivery through a callback.
+   *
+   * @param group_id The Sparkplug group ID containing the target Edge Node
+   * @param target_edge_node_id The target Edge Node identifier
+   * @param target_device_id The target device identifier
+   * @param payload PayloadBuilder containing command metrics
+   * @param on_complete Called on the MQTT thread once the command is delivered or fails
+   *
+   * @return void if the command was queued, error message otherwise
+   *
+   * @see publish_node_command_async() for the publish window semantics
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_device_command_async(std::string_view group_id, std::string_view target_edge_node_id,
+                               std::string_view target_device_id, PayloadBuilder& payload,
+                               PublishCallback on_complete);
+
+  /**
+   * @brief Returns the number of async commands still awaiting completion.
+   */
+  [[nodiscard]] size_t in_flight_publishes() const noexcept;
+
+  /**
+   * @brief Blocks until every async command has completed.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return true if nothing is in flight any more, false on timeout
+   */
+  [[nodiscard]] bool wait_for_publishes(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Returns a snapshot of the message counters and latency histograms.
+   *
+   * Counts every message received (per type, with bytes and decode failures), the sequence
+   * gaps and bdSeq mismatches found by sequence validation, the time spent in the message
+   * callback, and every STATE and command published with the latency of async commands.
+   * in_flight is the number of messages still pending in the MQTT client.
+   *
+   * @note Cheap enough to poll from a metrics exporter; recording never takes a lock.
+   */
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * @brief Feeds one raw message to the host as if it had arrived from the broker.
+   *
+   * The message goes through the same path as broker traffic: topic parsing, payload
+   * decoding, sequence validation, state tracking and the message callback. Use it to replay
+   * captured traffic, bridge another transport, or measure ingest without a broker.
+   *
+   * @param topic MQTT topic name
+   * @param payload_data Encoded Sparkplug B payload
+   *
+   * @note Runs on the calling thread unless Config::dispatch_threads started a worker pool on
+   *       connect(), in which case the message is queued like broker traffic.
+   */
+  void inject_message(std::string_view topic, std::span<const uint8_t> payload_data);
+
   /**
    * @brief Internal logging method accessible from C bindings.
    *
@@ -466,6 +796,13 @@ public:
    */
   void log(LogLevel level, std::string_view message) const noexcept;
 
+  /**
+   * @brief Returns true if a message at @p level would reach the log callback.
+   *
+   * Check this before formatting a message so filtered levels cost nothing.
+   */
+  [[nodiscard]] bool should_log(LogLevel level) const noexcept;
+
 private:
   Config config_;
   MQTTAsyncHandle client_;
@@ -474,10 +811,15 @@ private:
   // MQTT connection options that must outlive async operations
   MQTTAsync_SSLOptions ssl_opts_{};
 
+  // Group, node, device and metric names of all node state, stored once and capped at
+  // Config::max_name_bytes. Declared before the shards so the handles they hold never outlive
+  // it; not moved (like the shards).
+  StringInterner names_;
+
   // Node state tracking
   struct NodeKey {
-    std::string group_id;
-    std::string edge_node_id;
+    InternedString group_id;
+    InternedString edge_node_id;
 
     [[nodiscard]] bool operator==(const NodeKey& other) const noexcept {
       return group_id == other.group_id && edge_node_id == other.edge_node_id;
@@ -486,16 +828,22 @@ private:
 
   struct NodeKeyHash {
     using is_transparent = void;
+
+    // 64-bit boost::hash_combine: mixes h1 into the result so structure shared by the two ids
+    // (e.g. "Site01"/"Node01" naming schemes) does not cancel out as with a plain xor-shift
+    [[nodiscard]] static constexpr size_t combine(size_t h1, size_t h2) noexcept {
+      return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 12) + (h1 >> 4));
+    }
+
+    // Interned handles carry the hash of their text, so keys are not rehashed on lookup
     [[nodiscard]] size_t operator()(const NodeKey& key) const noexcept {
-      size_t h1 = std::hash<std::string>{}(key.group_id);
-      size_t h2 = std::hash<std::string>{}(key.edge_node_id);
-      return h1 ^ (h2 << 1);
+      return combine(key.group_id.hash(), key.edge_node_id.hash());
     }
     [[nodiscard]] size_t
     operator()(std::pair<std::string_view, std::string_view> key) const noexcept {
       size_t h1 = std::hash<std::string_view>{}(key.first);
       size_t h2 = std::hash<std::string_view>{}(key.second);
-      return h1 ^ (h2 << 1);
+      return combine(h1, h2);
     }
   };
 
@@ -515,25 +863,181 @@ private:
     }
   };
 
-  std::unordered_map<NodeKey, NodeState, NodeKeyHash, NodeKeyEqual> node_states_;
+  // Node state is split into independently locked shards so ingest threads and API readers
+  // only contend when they touch nodes in the same shard
+  static constexpr size_t NODE_STATE_SHARDS = 16;
+
+  // Sequence validation warnings, rate limited per node and kind
+  enum class ValidationIssue : uint8_t {
+    NONE,
+    INVALID_BIRTH_SEQ,
+    MISSING_BD_SEQ,
+    BD_SEQ_MISMATCH,
+    BEFORE_NODE_BIRTH,
+    BEFORE_DEVICE_BIRTH,
+    SEQ_GAP,
+    RESTORED_MISMATCH,
+    NAME_LIMIT,
+  };
+  static constexpr size_t VALIDATION_ISSUES = std::to_underlying(ValidationIssue::NAME_LIMIT) + 1;
+
+  // Coalescing window of one ValidationIssue (Config::log_coalesce_interval_ms)
+  struct WarningWindow {
+    std::chrono::steady_clock::time_point last_logged{};
+    uint64_t suppressed{0};
+  };
+
+  // Decided under the shard lock, formatted and logged after it is released
+  struct ValidationWarning {
+    ValidationIssue issue{ValidationIssue::NONE};
+    uint64_t got{0};
+    uint64_t expected{0};
+    uint64_t suppressed{0}; // Occurrences coalesced into this one
+  };
+
+  // Config::rebirth_recovery, decided under the shard lock and acted on after it is released
+  struct RecoveryDecision {
+    bool drop{false};            // The node awaits a rebirth: neither deliver nor track
+    bool request_rebirth{false}; // Send Node Control/Rebirth to the node
+  };
+
+  struct NodeEntry {
+    NodeState state;
+    std::array<WarningWindow, VALIDATION_ISSUES> warnings{};
+    bool awaiting_birth{false}; // State lost; data is dropped until the next NBIRTH
+    std::chrono::steady_clock::time_point last_rebirth_request{};
+    bool restored{false};   // Loaded from a snapshot; data is checked against it until NBIRTH
+    bool resync_seq{false}; // The next seq is taken as is (traffic was missed while down)
+  };
+
+  struct NodeStateShard {
+    mutable std::mutex mutex;
+    std::unordered_map<NodeKey, NodeEntry, NodeKeyHash, NodeKeyEqual> nodes;
+  };
+
+  std::array<NodeStateShard, NODE_STATE_SHARDS> node_state_shards_;
+
+  [[nodiscard]] static size_t node_state_shard_index(std::string_view group_id,
+                                                     std::string_view edge_node_id) noexcept;
 
-  // Mutex for thread-safe access to all mutable state
+  // Mutex for connection and configuration state (node state is guarded per shard)
   mutable std::mutex mutex_;
 
   [[nodiscard]] std::expected<void, std::string>
   publish_raw_message(std::string_view topic, std::span<const uint8_t> payload_data, int qos,
                       bool retain);
 
+  // Build and send an NCMD/DCMD (device id empty for NCMD); async when on_complete is set
   [[nodiscard]] std::expected<void, std::string>
-  publish_command_message(std::string_view topic, std::span<const uint8_t> payload_data);
+  publish_command(MessageType type, std::string_view group_id,
+                  std::string_view target_edge_node_id, std::string_view target_device_id,
+                  PayloadBuilder& payload, PublishCallback on_complete);
 
-  bool validate_message(const Topic& topic, const org::eclipse::tahu::protobuf::Payload& payload);
+  // Subscribe and remember the filter for automatic reconnect
+  [[nodiscard]] std::expected<void, std::string> subscribe_topic(std::string topic);
+
+  // One Config::reconnect attempt: connect, re-subscribe and republish an online STATE
+  [[nodiscard]] std::expected<void, std::string> reconnect_and_replay();
+
+  [[nodiscard]] std::expected<void, std::string>
+  publish_command_message(MessageType type, std::string_view topic,
+                          std::span<const uint8_t> payload_data,
+                          PublishCallback on_complete = {});
+
+  // Bounds publish_*_command_async(); shared with the completion contexts queued in Paho
+  std::shared_ptr<PublishWindow> publish_window_;
+
+  // Counters behind stats(); shared with the completion contexts queued in Paho
+  std::shared_ptr<detail::StatsRecorder> stats_;
+
+  // Replayed by automatic reconnect (guarded by mutex_)
+  std::vector<std::string> subscriptions_;
+  bool state_online_{false}; // Last STATE published was online
+
+  // Background retry loop for Config::reconnect (stopped before the host is torn down)
+  std::unique_ptr<detail::Reconnector> reconnector_;
+
+  // Tracks node state; false if the message is dropped because its node awaits a rebirth
+  bool validate_message(const TopicView& topic, org::eclipse::tahu::protobuf::Payload& payload);
+
+  // Updates node state under the shard lock; a warning to log is returned through @p warning
+  bool update_node_state(const TopicView& topic, org::eclipse::tahu::protobuf::Payload& payload,
+                         ValidationWarning& warning, RecoveryDecision& recovery);
+
+  // Marks a node as awaiting rebirth and decides whether to ask for it now (shard lock held)
+  void lose_node_state(NodeEntry& entry, RecoveryDecision& recovery);
+
+  // Send Node Control/Rebirth to the node of topic
+  void request_rebirth(const TopicView& topic);
+
+  // Config::rebirth_recovery budget shared by all nodes (rebirth_mutex_ guards it)
+  std::mutex rebirth_mutex_;
+  TokenBucket rebirth_budget_{0, 0};
+
+  // Config::snapshot: restored once by the first connect(), saved periodically and on
+  // disconnect(); snapshot_mutex_ serializes saves and guards the flags. Until a restore or a
+  // connect succeeded there is no state worth saving, and the file is left alone.
+  mutable std::mutex snapshot_mutex_;
+  bool snapshot_restored_{false};
+  bool snapshot_has_state_{false};
+  std::unique_ptr<detail::PeriodicTask> snapshot_task_;
+  void restore_configured_snapshot();
+  void save_configured_snapshot() const;
+
+  void log_validation_warning(const TopicView& topic, const ValidationWarning& warning) const;
+
+  // Logs and resets the warnings every node still has suppressed (on disconnect and destruction)
+  void flush_suppressed_warnings();
+  [[nodiscard]] static std::string_view validation_issue_name(ValidationIssue issue) noexcept;
+
+  // Parse, validate and deliver one raw MQTT message (MQTT thread or dispatch worker)
+  void handle_message(std::string_view topic_str, std::span<const uint8_t> payload_data);
+
+  // Type callback if set, else the general message callback (may be empty)
+  [[nodiscard]] const MessageCallback& callback_for(MessageType type) const noexcept;
+
+  // True if the message is delivered, i.e. has a callback and passes the filter
+  [[nodiscard]] bool should_deliver(const TopicView& topic) const;
+
+  // True if state tracking needs the full payload of an undelivered message of this type
+  [[nodiscard]] bool needs_payload_for_state(MessageType type) const noexcept;
+
+  // Reads the header of an undelivered payload; false if there is nothing left to validate.
+  // header.compressed means the payload must be decoded in full after all.
+  bool scan_undelivered(const TopicView& topic, std::span<const uint8_t> payload_data,
+                        detail::wire::PayloadHeader& header);
+
+  // Sequence validation of a message from its scanned header alone
+  void validate_scanned(const TopicView& topic, const detail::wire::PayloadHeader& header);
 
   // Static MQTT callback for message arrived
   static int on_message_arrived(void* context, char* topicName, int topicLen,
                                 MQTTAsync_message* message);
 
   static void on_connection_lost(void* context, char* cause);
+
+  // connect_async() state handed to Paho with its completion callbacks
+  struct ConnectContext;
+  static void on_connect_success(void* context, MQTTAsync_successData* response);
+  static void on_connect_failure(void* context, MQTTAsync_failureData* response);
+
+  // The attempt of the last connect_async() (guarded by mutex_), and how it is given up
+  std::shared_ptr<detail::ConnectAttempt<HostApplication>> connect_attempt_;
+  void abandon_connect();
+
+  // Optional worker pool (Config::dispatch_threads). Declared last so it is joined before the
+  // state its workers touch is destroyed. inject_message() reads dispatcher_ on the MQTT thread
+  // of whichever client is delivering, so it is swapped under a unique lock of dispatch_mutex_
+  // and read under a shared one.
+  class DispatchPool;
+  mutable std::shared_mutex dispatch_mutex_;
+  std::unique_ptr<DispatchPool> dispatcher_;
+
+  // Create dispatcher_ with Config::dispatch_threads workers that call back into this host
+  void start_dispatcher();
+
+  // Join and remove dispatcher_; returns true if there was one
+  bool stop_dispatcher();
 };
 
 } // namespace sparkplug
@@ -0,0 +1,229 @@
+// include/sparkplug/metric_frame.hpp
+#pragma once
+
+#include "payload_builder.hpp"
+#include "wire_format.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sparkplug {
+
+/// Metric types with a fixed-size encoding, which a MetricFrame can patch in place
+template <typename T>
+concept SparkplugScalar = SparkplugNumeric<T> || SparkplugBoolean<T>;
+
+namespace detail {
+
+// Wire encoding of a scalar value field, matching set_metric_value(). Varints are written at
+// the widest size the type can need so a value can be overwritten without moving bytes.
+template <SparkplugScalar T>
+struct FrameValue {
+  using BaseT = std::remove_cvref_t<T>;
+
+  static constexpr uint64_t field = [] {
+    if constexpr (std::is_same_v<BaseT, int64_t> || std::is_same_v<BaseT, uint64_t>)
+      return wire::METRIC_LONG_VALUE_FIELD;
+    else if constexpr (std::is_same_v<BaseT, float>)
+      return wire::METRIC_FLOAT_VALUE_FIELD;
+    else if constexpr (std::is_same_v<BaseT, double>)
+      return wire::METRIC_DOUBLE_VALUE_FIELD;
+    else if constexpr (std::is_same_v<BaseT, bool>)
+      return wire::METRIC_BOOLEAN_VALUE_FIELD;
+    else
+      return wire::METRIC_INT_VALUE_FIELD;
+  }();
+
+  static constexpr uint64_t wire_type = std::is_same_v<BaseT, float>    ? wire::WIRE_FIXED32
+                                        : std::is_same_v<BaseT, double> ? wire::WIRE_FIXED64
+                                                                        : wire::WIRE_VARINT;
+
+  static constexpr size_t width = [] {
+    if constexpr (std::is_same_v<BaseT, int64_t> || std::is_same_v<BaseT, uint64_t>)
+      return wire::MAX_VARINT_SIZE;
+    else if constexpr (std::is_same_v<BaseT, float>)
+      return size_t{4};
+    else if constexpr (std::is_same_v<BaseT, double>)
+      return size_t{8};
+    else if constexpr (std::is_same_v<BaseT, bool> || std::is_same_v<BaseT, uint8_t>)
+      return wire::varint_size(std::numeric_limits<BaseT>::max());
+    else if constexpr (std::is_same_v<BaseT, uint16_t>)
+      return wire::varint_size(std::numeric_limits<uint16_t>::max());
+    else
+      return wire::varint_size(std::numeric_limits<uint32_t>::max()); // Negative int32 casts
+  }();
+
+  static void write(uint8_t* out, BaseT value) noexcept {
+    if constexpr (std::is_same_v<BaseT, float> || std::is_same_v<BaseT, double>) {
+      // Fixed-width fields are little-endian regardless of the host byte order
+      auto bits = std::bit_cast<std::conditional_t<sizeof(BaseT) == 4, uint32_t, uint64_t>>(value);
+      for (size_t i = 0; i < sizeof(BaseT); i++) {
+        out[i] = static_cast<uint8_t>(bits >> (8 * i));
+      }
+    } else if constexpr (std::is_same_v<BaseT, int64_t> || std::is_same_v<BaseT, uint64_t>) {
+      wire::write_padded_varint(out, static_cast<uint64_t>(value), width);
+    } else if constexpr (std::is_same_v<BaseT, bool>) {
+      out[0] = value ? 1 : 0;
+    } else {
+      wire::write_padded_varint(out, static_cast<uint32_t>(value), width);
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Typed handle to one metric of a MetricFrame, returned by add_metric_by_alias().
+ *
+ * Holds byte offsets only, so it stays valid for copies of the frame it came from.
+ */
+template <SparkplugScalar T>
+class FrameSlot {
+public:
+  FrameSlot() = default;
+
+private:
+  friend class MetricFrame;
+  FrameSlot(size_t value_offset, size_t timestamp_offset)
+      : value_offset_(value_offset), timestamp_offset_(timestamp_offset) {}
+
+  size_t value_offset_{0};
+  size_t timestamp_offset_{0};
+};
+
+/**
+ * @brief Pre-encoded NDATA/DDATA payload for a fixed set of aliased scalar metrics.
+ *
+ * The frame is laid out once, in Sparkplug B protobuf wire format, when the metrics are
+ * added. Afterwards set(), set_timestamp() and set_seq() overwrite their bytes in place, so a
+ * scan costs a few stores per metric instead of building and serializing a protobuf
+ * message. Varint fields are padded to the widest size their type can need, which makes a
+ * frame up to 4 bytes per metric timestamp larger than the same payload from
+ * PayloadBuilder::build(); any protobuf decoder reads both identically.
+ *
+ * @par Example
+ * @code
+ * sparkplug::MetricFrame frame;
+ * auto temperature = frame.add_metric_by_alias(1, 20.5);
+ * auto running = frame.add_metric_by_alias(2, true);
+ *
+ * while (scanning) {
+ *   frame.set(temperature, read_temperature());
+ *   frame.set(running, motor_running());
+ *   frame.set_timestamp(now_ms);  // Payload and every metric
+ *   edge_node.publish_data(frame); // Assigns the seq
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe; use one frame per producer thread.
+ */
+class MetricFrame {
+public:
+  /**
+   * @brief Creates a frame without metrics, stamped with the current time and seq 0.
+   */
+  MetricFrame();
+
+  /**
+   * @brief Appends an alias-only metric and returns the handle used to update it.
+   *
+   * @tparam T Value type (deduced; fixes the metric's datatype for the life of the frame)
+   * @param alias Metric alias (must be established in the NBIRTH/DBIRTH)
+   * @param value Initial value
+   *
+   * @return Handle for set()
+   *
+   * @note The metric timestamp starts as the frame's current payload timestamp.
+   */
+  template <SparkplugScalar T>
+  FrameSlot<std::remove_cvref_t<T>> add_metric_by_alias(uint64_t alias, T&& value) {
+    using Value = detail::FrameValue<T>;
+    auto [value_offset, timestamp_offset] =
+        append_metric(alias, std::to_underlying(detail::get_datatype<T>()),
+                      detail::wire::make_tag(Value::field, Value::wire_type), Value::width);
+    FrameSlot<std::remove_cvref_t<T>> slot(value_offset, timestamp_offset);
+    set(slot, value);
+    return slot;
+  }
+
+  /**
+   * @brief Overwrites the value of a metric.
+   *
+   * @param slot Handle returned by add_metric_by_alias() on this frame (or a copy of it)
+   * @param value New value, converted to the slot's type
+   */
+  template <SparkplugScalar T>
+  void set(FrameSlot<T> slot, std::type_identity_t<T> value) noexcept {
+    detail::FrameValue<T>::write(bytes_.data() + slot.value_offset_, value);
+  }
+
+  /**
+   * @brief Overwrites the value and timestamp of a metric.
+   *
+   * @param slot Handle returned by add_metric_by_alias() on this frame (or a copy of it)
+   * @param value New value, converted to the slot's type
+   * @param timestamp_ms Metric timestamp in milliseconds since Unix epoch
+   */
+  template <SparkplugScalar T>
+  void set(FrameSlot<T> slot, std::type_identity_t<T> value, uint64_t timestamp_ms) noexcept {
+    set(slot, value);
+    detail::wire::write_padded_varint(bytes_.data() + slot.timestamp_offset_, timestamp_ms,
+                                      detail::wire::MAX_VARINT_SIZE);
+  }
+
+  /**
+   * @brief Sets the payload timestamp and the timestamp of every metric.
+   *
+   * @param timestamp_ms Timestamp in milliseconds since Unix epoch
+   */
+  void set_timestamp(uint64_t timestamp_ms) noexcept;
+
+  /**
+   * @brief Sets the sequence number.
+   *
+   * @param seq Sequence number (0-255)
+   *
+   * @note EdgeNode::publish_data() and publish_device_data() assign it for you.
+   */
+  void set_seq(uint64_t seq) noexcept;
+
+  [[nodiscard]] size_t metric_count() const noexcept {
+    return timestamp_offsets_.size();
+  }
+
+  /**
+   * @brief Returns the serialized payload; valid until the frame is modified or destroyed.
+   */
+  [[nodiscard]] std::span<const uint8_t> bytes() const noexcept {
+    return bytes_;
+  }
+
+  /**
+   * @brief Copies the serialized payload into a caller-provided buffer.
+   *
+   * @param buffer Destination buffer (must hold at least bytes().size() bytes)
+   *
+   * @return Number of bytes written on success, error message if the buffer is too small
+   */
+  [[nodiscard]] std::expected<size_t, std::string> build_into(std::span<uint8_t> buffer) const;
+
+private:
+  // Encodes a metric ahead of the trailing seq field, leaving value_width bytes for the value;
+  // returns the offsets of its value and timestamp in bytes_
+  std::pair<size_t, size_t> append_metric(uint64_t alias, uint64_t datatype, uint64_t value_tag,
+                                          size_t value_width);
+
+  std::vector<uint8_t> bytes_;
+  std::vector<size_t> timestamp_offsets_; // Metric timestamps, patched by set_timestamp()
+  uint64_t timestamp_ms_{0};              // Payload timestamp, given to new metrics
+};
+
+} // namespace sparkplug
@@ -0,0 +1,128 @@
+// include/sparkplug/metric_value.hpp
+#pragma once
+
+#include "datatype.hpp"
+#include "sparkplug_b.pb.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace sparkplug {
+
+/**
+ * @brief Compact typed copy of a scalar Sparkplug B metric value.
+ *
+ * Signed integer types are sign-extended into int64_t, unsigned types and DateTime are held as
+ * uint64_t, and String/Text/UUID as std::string. std::monostate represents a null metric or a
+ * value type that is not tracked (DataSet, Template, Bytes, ...).
+ */
+using MetricValue =
+    std::variant<std::monostate, int64_t, uint64_t, float, double, bool, std::string>;
+
+/**
+ * @brief Extracts the value of a protobuf metric into a MetricValue.
+ *
+ * @param metric Protobuf metric to read
+ * @param hint Datatype to assume when the metric does not carry one (e.g. the datatype
+ *             declared for its alias in the birth certificate)
+ *
+ * @return Typed value, or std::monostate if the metric is null or not a scalar
+ */
+[[nodiscard]] inline MetricValue
+metric_value_from_proto(const org::eclipse::tahu::protobuf::Payload::Metric& metric,
+                        DataType hint = DataType::Unknown) {
+  using Metric = org::eclipse::tahu::protobuf::Payload::Metric;
+
+  if (metric.has_is_null() && metric.is_null()) {
+    return std::monostate{};
+  }
+
+  auto type = metric.has_datatype() ? static_cast<DataType>(metric.datatype()) : hint;
+  switch (type) {
+  case DataType::Int8:
+    return static_cast<int64_t>(static_cast<int8_t>(metric.int_value()));
+  case DataType::Int16:
+    return static_cast<int64_t>(static_cast<int16_t>(metric.int_value()));
+  case DataType::Int32:
+    return static_cast<int64_t>(static_cast<int32_t>(metric.int_value()));
+  case DataType::Int64:
+    return static_cast<int64_t>(metric.long_value());
+  case DataType::UInt8:
+  case DataType::UInt16:
+  case DataType::UInt32:
+    return static_cast<uint64_t>(metric.int_value());
+  case DataType::UInt64:
+  case DataType::DateTime:
+    return static_cast<uint64_t>(metric.long_value());
+  case DataType::Float:
+    return metric.float_value();
+  case DataType::Double:
+    return metric.double_value();
+  case DataType::Boolean:
+    return metric.boolean_value();
+  case DataType::String:
+  case DataType::Text:
+  case DataType::UUID:
+    return metric.string_value();
+  default:
+    break;
+  }
+
+  // No usable datatype: fall back to whichever oneof member is set
+  switch (metric.value_case()) {
+  case Metric::kIntValue:
+    return static_cast<uint64_t>(metric.int_value());
+  case Metric::kLongValue:
+    return static_cast<uint64_t>(metric.long_value());
+  case Metric::kFloatValue:
+    return metric.float_value();
+  case Metric::kDoubleValue:
+    return metric.double_value();
+  case Metric::kBooleanValue:
+    return metric.boolean_value();
+  case Metric::kStringValue:
+    return metric.string_value();
+  default:
+    return std::monostate{};
+  }
+}
+
+/**
+ * @brief Writes a MetricValue into a protobuf metric, the inverse of metric_value_from_proto().
+ *
+ * @param value Value to store; std::monostate sets is_null
+ * @param datatype Datatype of the metric, which selects int_value or long_value for integers
+ * @param metric Protobuf metric to fill (the datatype field itself is not set)
+ */
+inline void metric_value_to_proto(const MetricValue& value, DataType datatype,
+                                  org::eclipse::tahu::protobuf::Payload::Metric* metric) {
+  std::visit(
+      [&](const auto& typed) {
+        using T = std::decay_t<decltype(typed)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+          metric->set_is_null(true);
+        } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+          bool is_long = datatype == DataType::Int64 || datatype == DataType::UInt64 ||
+                         datatype == DataType::DateTime;
+          if (is_long) {
+            metric->set_long_value(static_cast<uint64_t>(typed));
+          } else {
+            metric->set_int_value(static_cast<uint32_t>(typed));
+          }
+        } else if constexpr (std::is_same_v<T, float>) {
+          metric->set_float_value(typed);
+        } else if constexpr (std::is_same_v<T, double>) {
+          metric->set_double_value(typed);
+        } else if constexpr (std::is_same_v<T, bool>) {
+          metric->set_boolean_value(typed);
+        } else {
+          metric->set_string_value(typed);
+        }
+      },
+      value);
+}
+
+} // namespace sparkplug
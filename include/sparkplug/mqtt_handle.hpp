@@ -1,10 +1,24 @@
 // include/sparkplug/mqtt_handle.hpp
 #pragma once
 
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <string>
+
 typedef void* MQTTAsync;
 
 namespace sparkplug {
 
+/**
+ * @brief Completion callback for connect_async().
+ *
+ * Receives void once the session is fully established, or an error message.
+ *
+ * @note Invoked on the MQTT client thread.
+ */
+using ConnectCallback = std::function<void(std::expected<void, std::string>)>;
+
 // RAII wrapper for MQTTAsync client handle
 class MQTTAsyncHandle {
 public:
@@ -56,4 +70,28 @@ private:
   MQTTAsync client_;
 };
 
+namespace detail {
+
+/**
+ * @brief Link from a connect_async() attempt still owned by Paho back to its client.
+ *
+ * The completion callbacks only use owner while holding mutex. The client clears it when it
+ * gives up on the attempt (connect() timed out, a newer attempt started, or the client was
+ * moved or destroyed), so a late callback finds nullptr instead of a dangling pointer.
+ */
+template <typename Owner> struct ConnectAttempt {
+  explicit ConnectAttempt(Owner* attempt_owner) noexcept : owner(attempt_owner) {
+  }
+
+  void abandon() {
+    std::lock_guard<std::mutex> lock(mutex);
+    owner = nullptr;
+  }
+
+  std::mutex mutex;
+  Owner* owner;
+};
+
+} // namespace detail
+
 } // namespace sparkplug
@@ -0,0 +1,66 @@
+// include/sparkplug/parse_arena.hpp
+#pragma once
+
+#include "sparkplug_b.pb.h"
+
+#include <cstddef>
+#include <memory>
+
+#include <google/protobuf/arena.h>
+
+namespace sparkplug::detail {
+
+/**
+ * @brief Per-thread protobuf arena for parsing received payloads.
+ *
+ * The initial block is owned here and handed to the arena, so Reset() keeps it and
+ * steady-state parsing of typical payloads never touches malloc.
+ */
+struct ParseArena {
+  std::unique_ptr<char[]> block;
+  size_t block_size{0};
+  std::unique_ptr<google::protobuf::Arena> arena;
+
+  google::protobuf::Arena& get(size_t requested_size) {
+    if (!arena || requested_size > block_size) {
+      arena.reset();
+      block_size = requested_size;
+      block = std::make_unique<char[]>(block_size);
+      google::protobuf::ArenaOptions options;
+      options.initial_block = block.get();
+      options.initial_block_size = block_size;
+      arena = std::make_unique<google::protobuf::Arena>(options);
+    }
+    return *arena;
+  }
+};
+
+/**
+ * @brief Resets the thread-local arena when the message has been fully delivered.
+ *
+ * @warning Payloads created through a lease must not outlive it.
+ */
+class ArenaLease {
+public:
+  explicit ArenaLease(size_t block_size) : arena_(thread_arena().get(block_size)) {
+  }
+  ~ArenaLease() {
+    arena_.Reset();
+  }
+  ArenaLease(const ArenaLease&) = delete;
+  ArenaLease& operator=(const ArenaLease&) = delete;
+
+  [[nodiscard]] org::eclipse::tahu::protobuf::Payload* create_payload() {
+    return google::protobuf::Arena::CreateMessage<org::eclipse::tahu::protobuf::Payload>(&arena_);
+  }
+
+private:
+  static ParseArena& thread_arena() {
+    thread_local ParseArena parse_arena;
+    return parse_arena;
+  }
+
+  google::protobuf::Arena& arena_;
+};
+
+} // namespace sparkplug::detail
@@ -4,14 +4,21 @@
 #include "datatype.hpp"
 #include "sparkplug_b.pb.h"
 
+#include <algorithm>
 #include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <initializer_list>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace sparkplug {
@@ -112,13 +119,11 @@ void set_metric_value(org::eclipse::tahu::protobuf::Payload::Metric* metric, T&&
 }
 
 template <SparkplugMetricType T>
-void add_metric_to_payload(org::eclipse::tahu::protobuf::Payload& payload, std::string_view name,
-                           T&& value, std::optional<uint64_t> alias,
-                           std::optional<uint64_t> timestamp_ms) {
-  auto* metric = payload.add_metrics();
-
+void fill_metric(org::eclipse::tahu::protobuf::Payload::Metric* metric, std::string_view name,
+                 T&& value, std::optional<uint64_t> alias) {
   if (!name.empty()) {
-    metric->set_name(std::string(name));
+    // assign() reuses the capacity of a metric recycled by PayloadBuilder::reset()
+    metric->mutable_name()->assign(name);
   }
   if (alias.has_value()) {
     metric->set_alias(*alias);
@@ -126,20 +131,210 @@ void add_metric_to_payload(org::eclipse::tahu::protobuf::Payload& payload, std::
 
   metric->set_datatype(std::to_underlying(get_datatype<T>()));
   set_metric_value(metric, std::forward<T>(value));
+}
 
-  // Use provided timestamp or current time
-  uint64_t ts;
-  if (timestamp_ms.has_value()) {
-    ts = *timestamp_ms;
+template <SparkplugMetricType T>
+void add_metric_to_payload(org::eclipse::tahu::protobuf::Payload& payload, std::string_view name,
+                           T&& value, std::optional<uint64_t> alias, uint64_t timestamp_ms) {
+  auto* metric = payload.add_metrics();
+  fill_metric(metric, name, std::forward<T>(value), alias);
+  metric->set_timestamp(timestamp_ms);
+}
+
+template <SparkplugMetricType T>
+void set_parameter_value(org::eclipse::tahu::protobuf::Payload::Template::Parameter* parameter,
+                         T&& value) {
+  using BaseT = std::remove_cvref_t<T>;
+
+  parameter->set_type(std::to_underlying(get_datatype<T>()));
+  if constexpr (std::is_same_v<BaseT, int64_t> || std::is_same_v<BaseT, uint64_t>) {
+    parameter->set_long_value(value);
+  } else if constexpr (SparkplugInteger<BaseT>) {
+    parameter->set_int_value(value);
+  } else if constexpr (std::is_same_v<BaseT, float>) {
+    parameter->set_float_value(value);
+  } else if constexpr (std::is_same_v<BaseT, double>) {
+    parameter->set_double_value(value);
+  } else if constexpr (std::is_same_v<BaseT, bool>) {
+    parameter->set_boolean_value(value);
   } else {
-    auto now = std::chrono::system_clock::now();
-    ts = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    parameter->set_string_value(std::string(value));
   }
-  metric->set_timestamp(ts);
 }
 
 } // namespace detail
 
+/**
+ * @brief Source of wall-clock timestamps in milliseconds since Unix epoch.
+ *
+ * A plain function pointer, so reading a custom clock costs one indirect call.
+ */
+using TimestampClock = uint64_t (*)() noexcept;
+
+/**
+ * @brief Reads std::chrono::system_clock (the default TimestampClock).
+ */
+[[nodiscard]] uint64_t system_clock_ms() noexcept;
+
+/**
+ * @brief Reads a coarse real-time clock, cheaper than system_clock_ms().
+ *
+ * Uses CLOCK_REALTIME_COARSE where available (Linux; resolution of one scheduler tick,
+ * typically 1-4 ms) and falls back to system_clock_ms() elsewhere.
+ */
+[[nodiscard]] uint64_t coarse_clock_ms() noexcept;
+
+/**
+ * @brief How PayloadBuilder stamps metrics added without an explicit timestamp.
+ */
+enum class TimestampMode {
+  PerMetric,  ///< Read the clock for every metric as it is added (default)
+  PerPayload, ///< Reuse the payload timestamp, so the clock is read once per payload
+};
+
+/**
+ * @brief One typed column of a DataSet metric, viewing caller-owned values.
+ *
+ * A column does not copy its values; the range it was made from must outlive the
+ * PayloadBuilder::add_dataset() call that consumes it.
+ *
+ * @par Supported Types
+ * The numeric and boolean metric types, std::string and std::string_view.
+ */
+class DataSetColumn {
+public:
+  using Values =
+      std::variant<std::span<const int8_t>, std::span<const int16_t>, std::span<const int32_t>,
+                   std::span<const int64_t>, std::span<const uint8_t>, std::span<const uint16_t>,
+                   std::span<const uint32_t>, std::span<const uint64_t>, std::span<const float>,
+                   std::span<const double>, std::span<const bool>, std::span<const std::string>,
+                   std::span<const std::string_view>>;
+
+  /**
+   * @brief Views a contiguous range (vector, array, span) as a named column.
+   *
+   * @param name Column name
+   * @param values Column values, one per row; the datatype follows the element type
+   */
+  template <std::ranges::contiguous_range R>
+    requires std::constructible_from<Values,
+                                     std::span<const std::ranges::range_value_t<R>>>
+  DataSetColumn(std::string_view name, const R& values)
+      : name_(name), values_(std::span<const std::ranges::range_value_t<R>>(values)),
+        type_(detail::get_datatype<std::ranges::range_value_t<R>>()) {}
+
+  [[nodiscard]] std::string_view name() const noexcept {
+    return name_;
+  }
+  [[nodiscard]] DataType type() const noexcept {
+    return type_;
+  }
+  [[nodiscard]] size_t size() const noexcept {
+    return std::visit([](auto values) { return values.size(); }, values_);
+  }
+  [[nodiscard]] const Values& values() const noexcept {
+    return values_;
+  }
+
+private:
+  std::string_view name_;
+  Values values_;
+  DataType type_;
+};
+
+/**
+ * @brief Builder for the members and parameters of a Sparkplug Template.
+ *
+ * The same builder serves as a definition (PayloadBuilder::add_template_definition(), in
+ * NBIRTH) and, by member values, as an instance (PayloadBuilder::add_template()). Build a
+ * template once and keep it: set() overwrites member values in place, so publishing an
+ * instance every scan copies the cached layout instead of rebuilding names and types.
+ *
+ * @par Example
+ * @code
+ * sparkplug::TemplateBuilder motor("1.0");
+ * motor.add_metric("Speed", 0.0).add_metric("Running", false).add_parameter("Poles", 4);
+ *
+ * sparkplug::PayloadBuilder birth;
+ * birth.add_template_definition("Motor", motor);
+ * birth.add_template_with_alias("Motor01", 10, "Motor", motor);
+ *
+ * // Later, per scan
+ * motor.set(0, read_speed()).set(1, motor_running());
+ * data.add_template_by_alias(10, "Motor", motor);
+ * @endcode
+ */
+class TemplateBuilder {
+public:
+  /**
+   * @brief Creates an empty template.
+   *
+   * @param version Optional template version, rejected by hosts on mismatch
+   */
+  explicit TemplateBuilder(std::string_view version = {});
+
+  /**
+   * @brief Appends a member metric.
+   *
+   * @tparam T Value type (automatically deduced, must satisfy SparkplugMetricType)
+   * @param name Member name
+   * @param value Member value (the default value in a definition)
+   *
+   * @return Reference to this builder for method chaining
+   */
+  template <SparkplugMetricType T>
+  TemplateBuilder& add_metric(std::string_view name, T&& value) {
+    detail::fill_metric(template_.add_metrics(), name, std::forward<T>(value), std::nullopt);
+    return *this;
+  }
+
+  /**
+   * @brief Overwrites the value of the member at an index.
+   *
+   * @param index Member index, in add_metric() order (ignored if out of range)
+   * @param value New value; sets the member's datatype from its type
+   *
+   * @return Reference to this builder for method chaining
+   */
+  template <SparkplugMetricType T>
+  TemplateBuilder& set(size_t index, T&& value) {
+    if (index < static_cast<size_t>(template_.metrics_size())) {
+      auto* metric = template_.mutable_metrics(static_cast<int>(index));
+      metric->set_datatype(std::to_underlying(detail::get_datatype<T>()));
+      detail::set_metric_value(metric, std::forward<T>(value));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Appends a template parameter.
+   *
+   * @tparam T Value type (automatically deduced, must satisfy SparkplugMetricType)
+   * @param name Parameter name
+   * @param value Parameter value
+   *
+   * @return Reference to this builder for method chaining
+   */
+  template <SparkplugMetricType T>
+  TemplateBuilder& add_parameter(std::string_view name, T&& value) {
+    auto* parameter = template_.add_parameters();
+    parameter->set_name(std::string(name));
+    detail::set_parameter_value(parameter, std::forward<T>(value));
+    return *this;
+  }
+
+  [[nodiscard]] size_t metric_count() const noexcept {
+    return static_cast<size_t>(template_.metrics_size());
+  }
+
+  [[nodiscard]] const org::eclipse::tahu::protobuf::Payload::Template& get() const noexcept {
+    return template_;
+  }
+
+private:
+  org::eclipse::tahu::protobuf::Payload::Template template_;
+};
+
 /**
  * @brief Type-safe builder for Sparkplug B payloads with automatic type detection.
  *
@@ -184,6 +379,27 @@ public:
    */
   PayloadBuilder();
 
+  /**
+   * @brief Constructs an empty payload with a timestamping policy and clock.
+   *
+   * @param mode How metrics without an explicit timestamp are stamped
+   * @param clock Clock read for the payload timestamp and, in PerMetric mode, for metrics
+   *
+   * @par Example
+   * @code
+   * // One clock read per scan; every metric carries the scan timestamp
+   * sparkplug::PayloadBuilder data(sparkplug::TimestampMode::PerPayload,
+   *                                sparkplug::coarse_clock_ms);
+   * for (const auto& tag : tags) {
+   *   data.add_metric_by_alias(tag.alias, tag.value);
+   * }
+   * @endcode
+   *
+   * @note In PerPayload mode metrics take the payload timestamp current when they are added,
+   *       so call set_timestamp() first to stamp a whole scan with a time of your choosing.
+   */
+  explicit PayloadBuilder(TimestampMode mode, TimestampClock clock = system_clock_ms);
+
   /**
    * @brief Adds a metric by name only (for NBIRTH without aliases).
    *
@@ -193,12 +409,12 @@ public:
    *
    * @return Reference to this builder for method chaining
    *
-   * @note Timestamp is automatically generated.
+   * @note Timestamp is automatically generated (see TimestampMode).
    */
   template <SparkplugMetricType T>
   PayloadBuilder& add_metric(std::string_view name, T&& value) {
     detail::add_metric_to_payload(payload_, name, std::forward<T>(value), std::nullopt,
-                                  std::nullopt);
+                                  metric_timestamp());
     return *this;
   }
 
@@ -235,7 +451,8 @@ public:
    */
   template <SparkplugMetricType T>
   PayloadBuilder& add_metric_with_alias(std::string_view name, uint64_t alias, T&& value) {
-    detail::add_metric_to_payload(payload_, name, std::forward<T>(value), alias, std::nullopt);
+    detail::add_metric_to_payload(payload_, name, std::forward<T>(value), alias,
+                                  metric_timestamp());
     return *this;
   }
 
@@ -253,7 +470,8 @@ public:
    */
   template <SparkplugMetricType T>
   PayloadBuilder& add_metric_by_alias(uint64_t alias, T&& value) {
-    detail::add_metric_to_payload(payload_, "", std::forward<T>(value), alias, std::nullopt);
+    detail::add_metric_to_payload(payload_, "", std::forward<T>(value), alias,
+                                  metric_timestamp());
     return *this;
   }
 
@@ -275,6 +493,50 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Adds a batch of alias-only metrics of one type that share a timestamp.
+   *
+   * Equivalent to calling add_metric_by_alias(aliases[i], values[i], timestamp_ms) for each
+   * index, with the metric storage reserved up front.
+   *
+   * @tparam T Value type (give it explicitly when passing containers, e.g. <double>)
+   * @param aliases Metric aliases (must be established in NBIRTH)
+   * @param values Values; values[i] is reported under aliases[i]
+   * @param timestamp_ms Timestamp of every metric in milliseconds since Unix epoch
+   *
+   * @return Reference to this builder for method chaining
+   *
+   * @note Only the first min(aliases.size(), values.size()) pairs are added.
+   */
+  template <SparkplugMetricType T>
+  PayloadBuilder& add_metrics_by_alias(std::span<const uint64_t> aliases,
+                                       std::span<const T> values, uint64_t timestamp_ms) {
+    size_t count = std::min(aliases.size(), values.size());
+    auto* metrics = payload_.mutable_metrics();
+    metrics->Reserve(metrics->size() + static_cast<int>(count));
+    for (size_t i = 0; i < count; i++) {
+      detail::add_metric_to_payload(payload_, "", values[i], aliases[i], timestamp_ms);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Adds a batch of alias-only metrics stamped with one clock read (or the payload
+   *        timestamp in TimestampMode::PerPayload).
+   *
+   * @par Example
+   * @code
+   * std::vector<uint64_t> aliases = {1, 2, 3};
+   * std::vector<double> values = {20.5, 101.3, 45.0};
+   * data.add_metrics_by_alias<double>(aliases, values);
+   * @endcode
+   */
+  template <SparkplugMetricType T>
+  PayloadBuilder& add_metrics_by_alias(std::span<const uint64_t> aliases,
+                                       std::span<const T> values) {
+    return add_metrics_by_alias(aliases, values, metric_timestamp());
+  }
+
   /**
    * @brief Sets the payload-level timestamp.
    *
@@ -305,6 +567,136 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Drops the seq set by set_seq() or by an earlier publish.
+   *
+   * @return Reference to this builder for method chaining
+   *
+   * @note The next publish then assigns the next sequence number.
+   */
+  PayloadBuilder& clear_seq() {
+    payload_.clear_seq();
+    seq_explicitly_set_ = false;
+    return *this;
+  }
+
+  /**
+   * @brief Clears the payload for the next scan while keeping its memory.
+   *
+   * Metrics, seq and the explicit timestamp flags are cleared and the payload is restamped
+   * from the builder's clock. The cleared metric objects and their name strings stay
+   * allocated and are reused by the next add_metric*() calls, so a builder reset every scan
+   * stops allocating once it has held its largest payload.
+   *
+   * @return Reference to this builder for method chaining
+   *
+   * @par Example
+   * @code
+   * sparkplug::PayloadBuilder data;
+   * while (running) {
+   *   data.reset();
+   *   data.add_metric_by_alias(1, read_temperature());
+   *   edge_node.publish_data(data);
+   * }
+   * @endcode
+   *
+   * @note Required before reusing a builder that was published: publishing stores the
+   *       assigned seq in the builder, and has_seq() would otherwise keep it.
+   */
+  PayloadBuilder& reset();
+
+  /**
+   * @brief Adds a DataSet metric by name, encoded row by row from typed columns.
+   *
+   * The DataSet's rows and their elements are reserved up front and filled in one pass over
+   * the columns, so a table costs one allocation per row and per element instead of growing
+   * every repeated field through mutable_payload().
+   *
+   * @param name Metric name
+   * @param columns Columns in order; each contributes its name, datatype and values
+   *
+   * @return Reference to this builder for method chaining
+   *
+   * @par Example
+   * @code
+   * std::vector<uint64_t> t = capture_times();
+   * std::vector<float> volts = capture_samples();
+   * builder.add_dataset("Waveform", {{"t", t}, {"volts", volts}});
+   * @endcode
+   *
+   * @note The DataSet has min(column sizes) rows.
+   */
+  PayloadBuilder& add_dataset(std::string_view name, std::span<const DataSetColumn> columns);
+  PayloadBuilder& add_dataset(std::string_view name,
+                              std::initializer_list<DataSetColumn> columns) {
+    return add_dataset(name, std::span<const DataSetColumn>(columns.begin(), columns.size()));
+  }
+
+  /**
+   * @brief Adds a DataSet metric with both name and alias (for NBIRTH messages).
+   *
+   * @see add_dataset()
+   */
+  PayloadBuilder& add_dataset_with_alias(std::string_view name, uint64_t alias,
+                                         std::span<const DataSetColumn> columns);
+  PayloadBuilder& add_dataset_with_alias(std::string_view name, uint64_t alias,
+                                         std::initializer_list<DataSetColumn> columns) {
+    return add_dataset_with_alias(
+        name, alias, std::span<const DataSetColumn>(columns.begin(), columns.size()));
+  }
+
+  /**
+   * @brief Adds a DataSet metric by alias only (for NDATA messages).
+   *
+   * @see add_dataset()
+   */
+  PayloadBuilder& add_dataset_by_alias(uint64_t alias, std::span<const DataSetColumn> columns);
+  PayloadBuilder& add_dataset_by_alias(uint64_t alias,
+                                       std::initializer_list<DataSetColumn> columns) {
+    return add_dataset_by_alias(alias,
+                                std::span<const DataSetColumn>(columns.begin(), columns.size()));
+  }
+
+  /**
+   * @brief Adds a Template definition (for NBIRTH messages).
+   *
+   * @param name Template type name; instances refer to it as their template_ref
+   * @param definition Members (with default values), parameters and version
+   *
+   * @return Reference to this builder for method chaining
+   */
+  PayloadBuilder& add_template_definition(std::string_view name,
+                                          const TemplateBuilder& definition);
+
+  /**
+   * @brief Adds a Template instance metric by name.
+   *
+   * @param name Metric name
+   * @param template_ref Name of the definition this instance follows
+   * @param instance Member values and parameters (copied)
+   *
+   * @return Reference to this builder for method chaining
+   */
+  PayloadBuilder& add_template(std::string_view name, std::string_view template_ref,
+                               const TemplateBuilder& instance);
+
+  /**
+   * @brief Adds a Template instance metric with both name and alias (for NBIRTH messages).
+   *
+   * @see add_template()
+   */
+  PayloadBuilder& add_template_with_alias(std::string_view name, uint64_t alias,
+                                          std::string_view template_ref,
+                                          const TemplateBuilder& instance);
+
+  /**
+   * @brief Adds a Template instance metric by alias only (for NDATA messages).
+   *
+   * @see add_template()
+   */
+  PayloadBuilder& add_template_by_alias(uint64_t alias, std::string_view template_ref,
+                                        const TemplateBuilder& instance);
+
   // Add Node Control metrics (convenience methods for NBIRTH)
   PayloadBuilder& add_node_control_rebirth(bool value = false) {
     add_metric("Node Control/Rebirth", value);
@@ -336,13 +728,59 @@ public:
 
   // Build and access
   [[nodiscard]] std::vector<uint8_t> build() const;
+
+  /**
+   * @brief Returns the number of bytes build() would produce.
+   *
+   * @note Use this to size the buffer passed to build_into(std::span<uint8_t>).
+   */
+  [[nodiscard]] size_t serialized_size() const;
+
+  /**
+   * @brief Serializes the payload directly into a caller-provided buffer.
+   *
+   * @param buffer Destination buffer (must hold at least serialized_size() bytes)
+   *
+   * @return Number of bytes written on success, error message if the buffer is too small
+   *
+   * @note The payload is serialized in place; no copy of the protobuf message is made.
+   */
+  [[nodiscard]] std::expected<size_t, std::string> build_into(std::span<uint8_t> buffer) const;
+
+  /**
+   * @brief Serializes the payload into a reusable buffer.
+   *
+   * The buffer is resized to the serialized size. Its capacity is kept, so reusing the
+   * same vector across publishes avoids a heap allocation once it has grown large enough.
+   *
+   * @param buffer Destination buffer (contents are replaced)
+   *
+   * @return Number of bytes written
+   */
+  size_t build_into(std::vector<uint8_t>& buffer) const;
+
   [[nodiscard]] const org::eclipse::tahu::protobuf::Payload& payload() const noexcept;
   [[nodiscard]] org::eclipse::tahu::protobuf::Payload& mutable_payload() noexcept {
     return payload_;
   }
 
 private:
+  [[nodiscard]] const org::eclipse::tahu::protobuf::Payload&
+  serializable_payload(org::eclipse::tahu::protobuf::Payload& scratch) const;
+
+  PayloadBuilder& add_dataset_metric(std::string_view name, std::optional<uint64_t> alias,
+                                     std::span<const DataSetColumn> columns);
+  PayloadBuilder& add_template_metric(std::string_view name, std::optional<uint64_t> alias,
+                                      std::string_view template_ref,
+                                      const TemplateBuilder& source, bool is_definition);
+
+  [[nodiscard]] uint64_t metric_timestamp() const noexcept {
+    return mode_ == TimestampMode::PerPayload ? payload_.timestamp() : clock_();
+  }
+
   org::eclipse::tahu::protobuf::Payload payload_;
+  TimestampMode mode_{TimestampMode::PerMetric};
+  TimestampClock clock_{system_clock_ms};
   bool seq_explicitly_set_{false};
   bool timestamp_explicitly_set_{false};
 };
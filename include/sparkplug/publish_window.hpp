@@ -0,0 +1,166 @@
+// include/sparkplug/publish_window.hpp
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+
+#include <MQTTAsync.h>
+
+namespace sparkplug {
+
+namespace detail {
+class StatsRecorder;
+} // namespace detail
+
+/**
+ * @brief Completion callback for asynchronous publishes.
+ *
+ * Receives void once the MQTT client reports the message as delivered (PUBACK for QoS 1,
+ * PUBCOMP for QoS 2, written to the socket for QoS 0), or an error message if delivery failed.
+ *
+ * @note Invoked on the MQTT client thread, or on the thread that destroys the client if the
+ *       message was still queued then. Do not block waiting for other completions inside it.
+ */
+using PublishCallback = std::function<void(std::expected<void, std::string>)>;
+
+/**
+ * @brief Bounded count of asynchronous publishes awaiting completion.
+ *
+ * Producers acquire a Slot before sending and the slot is released when Paho invokes the
+ * completion callback. When every slot is taken, acquire() blocks, which gives pipelining
+ * producers backpressure instead of an unbounded Paho command queue.
+ *
+ * @note Must be owned by a std::shared_ptr: slots keep the window alive until released.
+ * @note Thread-safe.
+ */
+class PublishWindow : public std::enable_shared_from_this<PublishWindow> {
+public:
+  /**
+   * @brief One reserved place in the window; released on destruction.
+   */
+  class Slot {
+  public:
+    Slot() noexcept = default;
+    ~Slot() noexcept {
+      reset();
+    }
+
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+    Slot(Slot&& other) noexcept : window_(std::move(other.window_)) {
+    }
+    Slot& operator=(Slot&& other) noexcept {
+      if (this != &other) {
+        reset();
+        window_ = std::move(other.window_);
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Returns the slot to its window early.
+     */
+    void reset() noexcept {
+      if (window_) {
+        window_->release();
+        window_.reset();
+      }
+    }
+
+  private:
+    friend class PublishWindow;
+    explicit Slot(std::shared_ptr<PublishWindow> window) noexcept : window_(std::move(window)) {
+    }
+
+    std::shared_ptr<PublishWindow> window_;
+  };
+
+  /**
+   * @brief Creates a window.
+   *
+   * @param capacity Maximum number of outstanding slots (0 = unlimited)
+   */
+  explicit PublishWindow(size_t capacity) noexcept : capacity_(capacity) {
+  }
+
+  /**
+   * @brief Reserves a slot, blocking while the window is full.
+   *
+   * @param timeout Maximum time to wait for a free slot
+   *
+   * @return The slot, or an error message if the window stayed full for the whole timeout
+   */
+  [[nodiscard]] std::expected<Slot, std::string> acquire(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Blocks until no slots are outstanding.
+   *
+   * @param timeout Maximum time to wait
+   *
+   * @return true if the window drained, false on timeout
+   */
+  [[nodiscard]] bool wait_idle(std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Returns the number of outstanding slots.
+   */
+  [[nodiscard]] size_t in_flight() const noexcept;
+
+  [[nodiscard]] size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+private:
+  void release() noexcept;
+
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t in_flight_{0};
+};
+
+namespace detail {
+
+/**
+ * @brief Queues a message on a Paho client with completion wired to a callback.
+ *
+ * The slot and callback are handed to Paho's onSuccess/onFailure context. The slot is released
+ * before on_complete runs, so the callback may itself publish. When stats is set, the time to
+ * completion is recorded as publish latency and a failed delivery as a publish failure.
+ *
+ * @return void if the message was queued (on_complete will be called exactly once), or an error
+ *         if MQTTAsync_sendMessage rejected it (on_complete is not called, the slot is released)
+ */
+[[nodiscard]] std::expected<void, std::string>
+send_message_async(MQTTAsync client, const char* topic, std::span<const uint8_t> payload_data,
+                   int qos, bool retain, PublishWindow::Slot slot, PublishCallback on_complete,
+                   std::shared_ptr<StatsRecorder> stats = {});
+
+/**
+ * @brief Completes the send_message_async() messages of a destroyed client with an error.
+ *
+ * Paho may free queued messages without invoking their callbacks, which would otherwise keep
+ * their slots (and PublishWindow::wait_idle()) taken forever. Called by MQTTAsyncHandle after
+ * MQTTAsync_destroy().
+ */
+void abandon_async_publishes(MQTTAsync client) noexcept;
+
+/**
+ * @brief Returns the number of messages Paho has queued or in flight for a client.
+ *
+ * Covers every publish (with or without a completion callback) that has not completed yet.
+ */
+[[nodiscard]] size_t pending_token_count(MQTTAsync client) noexcept;
+
+} // namespace detail
+
+} // namespace sparkplug
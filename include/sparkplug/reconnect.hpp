@@ -0,0 +1,96 @@
+// include/sparkplug/reconnect.hpp
+#pragma once
+
+#include "worker_thread.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <string>
+
+namespace sparkplug {
+
+/**
+ * @brief Automatic reconnect settings shared by EdgeNode and HostApplication.
+ *
+ * After an unexpected connection loss, attempt n (starting at 0) waits
+ * min(max_delay_ms, initial_delay_ms * multiplier^n), of which a random fraction of up to
+ * `jitter` is taken off. The jitter spreads a fleet of clients out after a broker failover
+ * instead of having all of them reconnect at the same instant.
+ *
+ * @par Example
+ * @code
+ * config.reconnect = {.enabled = true, .initial_delay_ms = 500, .max_delay_ms = 30000};
+ * @endcode
+ */
+struct ReconnectPolicy {
+  bool enabled = false;          ///< Reconnect automatically after an unexpected connection loss
+  int initial_delay_ms = 1000;   ///< Delay before the first attempt
+  int max_delay_ms = 60000;      ///< Upper bound for the delay between attempts
+  double multiplier = 2.0;       ///< Growth factor applied after each failed attempt
+  double jitter = 0.5;           ///< Randomized fraction of each delay (0 = none, 1 = full)
+  size_t max_attempts = 0;       ///< Give up after this many failed attempts (0 = never)
+
+  /**
+   * @brief Computes the delay before a reconnect attempt.
+   *
+   * @param attempt Zero-based attempt number
+   * @param random Uniform random value in [0, 1)
+   *
+   * @return Delay to wait before the attempt
+   */
+  [[nodiscard]] std::chrono::milliseconds delay_for_attempt(size_t attempt, double random) const;
+};
+
+namespace detail {
+
+/**
+ * @brief Runs reconnect attempts on a background thread following a ReconnectPolicy.
+ *
+ * start() launches the retry loop (unless it is already running); the loop sleeps for the
+ * policy delay, calls the attempt function, and stops at the first success, after
+ * max_attempts failures, or when stop() is called.
+ */
+class Reconnector {
+public:
+  /// One reconnect attempt; any error schedules the next one
+  using Attempt = std::function<std::expected<void, std::string>()>;
+  /// Called after every failed attempt with the attempt number and error
+  using FailureHook = std::function<void(size_t attempt, const std::string& error)>;
+
+  explicit Reconnector(ReconnectPolicy policy) noexcept : policy_(policy) {
+  }
+  ~Reconnector();
+
+  Reconnector(const Reconnector&) = delete;
+  Reconnector& operator=(const Reconnector&) = delete;
+
+  /**
+   * @brief Starts the retry loop if it is not already running.
+   *
+   * @note Safe to call from MQTT client callbacks.
+   */
+  void start(Attempt attempt, FailureHook on_failure = {});
+
+  /**
+   * @brief Cancels a pending retry and waits for the loop to exit.
+   *
+   * @note Detaches instead when called from inside the attempt function; the loop then exits
+   *       as soon as the attempt returns. start() may be called again afterwards.
+   */
+  void stop();
+
+  [[nodiscard]] bool running() const noexcept;
+
+private:
+  void run(const WorkerThread::Run& worker, const Attempt& attempt,
+           const FailureHook& on_failure);
+
+  const ReconnectPolicy policy_;
+  WorkerThread thread_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
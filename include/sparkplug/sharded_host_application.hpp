@@ -0,0 +1,208 @@
+// include/sparkplug/sharded_host_application.hpp
+#pragma once
+
+#include "host_application.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Host Application spread over several MQTT connections, split by Sparkplug group.
+ *
+ * One HostApplication ingests through one Paho connection and its callback thread. This facade
+ * opens Config::connections HostApplications and gives each group to exactly one of them, so
+ * ingest scales with the number of connections while every node's messages still arrive in
+ * order on a single connection. Node state stays in the connection that owns the group; the
+ * query functions route to it, so callers see one host.
+ *
+ * The first connection is the primary: it alone publishes STATE birth and death for
+ * Config::host.host_id and subscribes to other hosts' STATE, so Edge Nodes see one Host
+ * Application exactly as with a plain HostApplication.
+ *
+ * @par Partitioning
+ * A group is owned by connection `hash(group_id) % connections`, and subscribe_group() issues
+ * `spBv1.0/{group_id}/#` on that connection only. MQTT shared subscriptions (`$share/...`) are
+ * not used: the broker may hand consecutive messages of one node to different sessions, which
+ * breaks sequence validation and per-node ordering.
+ *
+ * @par Thread Safety
+ * The message and log callbacks of Config::host are copied into every connection and run
+ * concurrently on their client threads (or dispatch workers), each for its own groups.
+ *
+ * @par Example
+ * @code
+ * sparkplug::ShardedHostApplication host({
+ *     .host = {.broker_url = "tcp://localhost:1883",
+ *              .client_id = "scada",
+ *              .host_id = "SCADA01",
+ *              .message_callback = on_message},
+ *     .connections = 4,
+ *     .groups = {"Energy", "Water", "Gas", "Steam"}});
+ *
+ * host.connect();         // Connects all four and subscribes each group on its connection
+ * host.publish_state_birth(now_ms);
+ * auto state = host.get_node_state("Water", "Pump01");
+ * @endcode
+ */
+class ShardedHostApplication {
+public:
+  /**
+   * @brief Configuration of a sharded Host Application.
+   */
+  struct Config {
+    HostApplication::Config host; ///< Settings for every connection; client ids get "-<index>"
+                                  ///< and snapshot paths ".<index>" (restore needs the same
+                                  ///< number of connections as the run that saved them)
+    size_t connections = 2;       ///< MQTT connections to open (at least 1)
+    std::vector<std::string> groups{}; ///< Groups subscribed by connect(), each on its owner
+  };
+
+  /**
+   * @brief Creates the connections without connecting them.
+   *
+   * @param config Sharded host configuration (moved)
+   */
+  explicit ShardedHostApplication(Config config);
+
+  ShardedHostApplication(const ShardedHostApplication&) = delete;
+  ShardedHostApplication& operator=(const ShardedHostApplication&) = delete;
+  ShardedHostApplication(ShardedHostApplication&&) noexcept = default;
+  ShardedHostApplication& operator=(ShardedHostApplication&&) noexcept = default;
+
+  [[nodiscard]] size_t connection_count() const noexcept {
+    return shards_.size();
+  }
+
+  /**
+   * @brief Returns the index of the connection that owns a group.
+   */
+  [[nodiscard]] size_t shard_index(std::string_view group_id) const noexcept;
+
+  /**
+   * @brief Returns the connection that owns a group, for HostApplication calls not mirrored
+   * here (subscribe_node(), visit_node_values(), async commands, ...).
+   */
+  [[nodiscard]] HostApplication& shard_for(std::string_view group_id) noexcept;
+  [[nodiscard]] const HostApplication& shard_for(std::string_view group_id) const noexcept;
+
+  /**
+   * @brief Returns the primary connection, which carries this host's STATE.
+   */
+  [[nodiscard]] HostApplication& primary() noexcept {
+    return *shards_.front();
+  }
+
+  /**
+   * @brief Connects every connection, then subscribes each of Config::groups on its owner.
+   *
+   * @return void on success; on failure the connections already opened are disconnected
+   *
+   * @note Call publish_state_birth() afterwards, once every subscription is in place.
+   */
+  [[nodiscard]] std::expected<void, std::string> connect();
+
+  /**
+   * @brief Disconnects every connection.
+   *
+   * @return void on success, the first error otherwise (all connections are still attempted)
+   */
+  [[nodiscard]] std::expected<void, std::string> disconnect();
+
+  /**
+   * @brief Subscribes to a group on the connection that owns it.
+   *
+   * @param group_id The group ID to subscribe to
+   *
+   * @return void on success, error message on failure
+   */
+  [[nodiscard]] std::expected<void, std::string> subscribe_group(std::string_view group_id);
+
+  /**
+   * @brief Subscribes to another host's STATE on the primary connection.
+   *
+   * @see HostApplication::subscribe_state()
+   */
+  [[nodiscard]] std::expected<void, std::string> subscribe_state(std::string_view host_id);
+
+  /**
+   * @brief Publishes STATE birth on the primary connection.
+   *
+   * @see HostApplication::publish_state_birth()
+   */
+  [[nodiscard]] std::expected<void, std::string> publish_state_birth(uint64_t timestamp);
+
+  /**
+   * @brief Publishes STATE death on the primary connection.
+   *
+   * @see HostApplication::publish_state_death()
+   */
+  [[nodiscard]] std::expected<void, std::string> publish_state_death(uint64_t timestamp);
+
+  /**
+   * @brief Publishes an NCMD through the connection that owns the group.
+   *
+   * @see HostApplication::publish_node_command()
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_node_command(std::string_view group_id, std::string_view target_edge_node_id,
+                       PayloadBuilder& payload);
+
+  /**
+   * @brief Publishes a DCMD through the connection that owns the group.
+   *
+   * @see HostApplication::publish_device_command()
+   */
+  [[nodiscard]] std::expected<void, std::string>
+  publish_device_command(std::string_view group_id, std::string_view target_edge_node_id,
+                         std::string_view target_device_id, PayloadBuilder& payload);
+
+  /// @see HostApplication::get_node_state()
+  [[nodiscard]] std::optional<std::reference_wrapper<const HostApplication::NodeState>>
+  get_node_state(std::string_view group_id, std::string_view edge_node_id) const;
+
+  /// @see HostApplication::get_metric_name()
+  [[nodiscard]] std::optional<std::string_view> get_metric_name(std::string_view group_id,
+                                                                std::string_view edge_node_id,
+                                                                std::string_view device_id,
+                                                                uint64_t alias) const;
+
+  /// @see HostApplication::get_metric_value()
+  [[nodiscard]] std::optional<ValueStore::OwnedEntry>
+  get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                   std::string_view device_id, std::string_view metric_name) const;
+
+  /// @see HostApplication::snapshot_node_values()
+  [[nodiscard]] std::optional<std::vector<HostApplication::MetricSnapshot>>
+  snapshot_node_values(std::string_view group_id, std::string_view edge_node_id) const;
+
+  /**
+   * @brief Returns the counters of all connections added together.
+   */
+  [[nodiscard]] Stats stats() const;
+
+  /**
+   * @brief Feeds one raw message to the connection that owns its group.
+   *
+   * STATE topics go to the primary connection.
+   *
+   * @see HostApplication::inject_message()
+   */
+  void inject_message(std::string_view topic, std::span<const uint8_t> payload_data);
+
+private:
+  // unique_ptr keeps each HostApplication at a fixed address, which Paho holds as context
+  std::vector<std::unique_ptr<HostApplication>> shards_;
+  std::vector<std::string> groups_;
+};
+
+} // namespace sparkplug
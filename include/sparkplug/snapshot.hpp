@@ -0,0 +1,67 @@
+// include/sparkplug/snapshot.hpp
+#pragma once
+
+#include "worker_thread.hpp"
+
+#include <chrono>
+#include <expected>
+#include <functional>
+#include <string>
+
+namespace sparkplug {
+
+/**
+ * @brief Persistence of HostApplication node state across restarts.
+ *
+ * With a path set, connect() restores the node and device state, alias maps and last values
+ * saved by a previous run, so restarted hosts resume validation without a fleet-wide rebirth.
+ * The snapshot is rewritten every interval_ms while connected and once more by disconnect().
+ * The first message of a restored node re-bases its seq; data that uses an alias unknown to
+ * the restored birth marks the node as lost (see RebirthRecoveryPolicy).
+ *
+ * @par Example
+ * @code
+ * config.snapshot = {.path = "/var/lib/scada/host.snap", .interval_ms = 30000};
+ * config.rebirth_recovery = {.enabled = true};
+ * @endcode
+ */
+struct SnapshotConfig {
+  std::string path{};  ///< Snapshot file (empty = disabled)
+  int interval_ms = 0; ///< Save period while connected (0 = only on disconnect())
+};
+
+namespace detail {
+
+/**
+ * @brief Calls a task on a background thread at a fixed interval until stopped.
+ */
+class PeriodicTask {
+public:
+  /// Work done every interval; errors are left to the task to report
+  using Task = std::function<void()>;
+
+  PeriodicTask() = default;
+  ~PeriodicTask();
+
+  PeriodicTask(const PeriodicTask&) = delete;
+  PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+  /**
+   * @brief Starts calling task every interval, unless the thread is already running.
+   */
+  void start(std::chrono::milliseconds interval, Task task);
+
+  /**
+   * @brief Cancels the next run and waits for the thread to exit.
+   *
+   * @note A run in progress completes first.
+   */
+  void stop();
+
+private:
+  WorkerThread thread_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -54,6 +54,9 @@ typedef struct sparkplug_subscriber sparkplug_subscriber_t;
 /** @brief Opaque handle to a Sparkplug payload builder. */
 typedef struct sparkplug_payload sparkplug_payload_t;
 
+/** @brief Opaque, read-only handle to a received payload, borrowed for one callback. */
+typedef struct sparkplug_payload_view sparkplug_payload_view_t;
+
 /**
  * @brief Log severity levels for library diagnostics.
  */
@@ -129,6 +132,23 @@ typedef void (*sparkplug_message_callback_t)(const char* topic, const uint8_t* p
 typedef void (*sparkplug_command_callback_t)(const char* topic, const uint8_t* payload_data,
                                              size_t payload_len, void* user_data);
 
+/**
+ * @brief Callback function type for receiving already-parsed Sparkplug messages.
+ *
+ * Unlike sparkplug_message_callback_t, the payload is not re-serialized for the callback and
+ * does not need to be parsed again: read it with the sparkplug_payload_view_* functions.
+ *
+ * @param topic MQTT topic string (valid only during callback)
+ * @param payload Borrowed payload (valid only during callback)
+ * @param user_data User-provided context pointer
+ *
+ * @warning The topic and payload pointers, and every pointer read from the payload, are only
+ * valid during the callback. Copy the data if needed after the callback returns.
+ */
+typedef void (*sparkplug_payload_callback_t)(const char* topic,
+                                             const sparkplug_payload_view_t* payload,
+                                             void* user_data);
+
 /* ============================================================================
  * Publisher API
  * ========================================================================= */
@@ -246,6 +266,42 @@ int sparkplug_publisher_publish_birth(sparkplug_publisher_t* pub, const uint8_t*
 int sparkplug_publisher_publish_data(sparkplug_publisher_t* pub, const uint8_t* payload_data,
                                      size_t payload_len);
 
+/**
+ * @brief Publishes an NBIRTH from a payload builder, without serializing it first.
+ *
+ * @param pub Publisher handle
+ * @param payload Payload handle; its seq is set to 0 and a bdSeq metric added if missing
+ *
+ * @return 0 on success, -1 on failure
+ *
+ * @see sparkplug_publisher_publish_birth()
+ */
+int sparkplug_publisher_publish_birth_payload(sparkplug_publisher_t* pub,
+                                              sparkplug_payload_t* payload);
+
+/**
+ * @brief Publishes an NDATA from a payload builder, without serializing it first.
+ *
+ * Skips the serialize and re-parse round trip of sparkplug_publisher_publish_data().
+ *
+ * @param pub Publisher handle
+ * @param payload Payload handle; its seq is overwritten with the next sequence number
+ *
+ * @return 0 on success, -1 on failure
+ *
+ * @par Example
+ * @code
+ * sparkplug_payload_t* data = sparkplug_payload_create();
+ * for (;;) {
+ *   sparkplug_payload_reset(data);
+ *   sparkplug_payload_add_double_by_alias(data, 1, read_temperature());
+ *   sparkplug_publisher_publish_data_payload(pub, data);
+ * }
+ * @endcode
+ */
+int sparkplug_publisher_publish_data_payload(sparkplug_publisher_t* pub,
+                                             sparkplug_payload_t* payload);
+
 /**
  * @brief Publishes an NDEATH (Node Death) message.
  *
@@ -264,6 +320,16 @@ int sparkplug_publisher_publish_death(sparkplug_publisher_t* pub);
  */
 int sparkplug_publisher_rebirth(sparkplug_publisher_t* pub);
 
+/**
+ * @brief Republishes NBIRTH and all DBIRTHs on the current connection (no reconnect).
+ *
+ * bdSeq stays the same; seq restarts at 0 for the NBIRTH.
+ *
+ * @param pub Publisher handle
+ * @return 0 on success, -1 on failure
+ */
+int sparkplug_publisher_rebirth_in_session(sparkplug_publisher_t* pub);
+
 /**
  * @brief Gets the current message sequence number.
  *
@@ -310,6 +376,32 @@ int sparkplug_publisher_publish_device_birth(sparkplug_publisher_t* pub, const c
 int sparkplug_publisher_publish_device_data(sparkplug_publisher_t* pub, const char* device_id,
                                             const uint8_t* payload_data, size_t payload_len);
 
+/**
+ * @brief Publishes a DBIRTH from a payload builder, without serializing it first.
+ *
+ * @param pub Publisher handle
+ * @param device_id Device identifier
+ * @param payload Payload handle; its seq is overwritten with the next sequence number
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sparkplug_publisher_publish_device_birth_payload(sparkplug_publisher_t* pub,
+                                                     const char* device_id,
+                                                     sparkplug_payload_t* payload);
+
+/**
+ * @brief Publishes a DDATA from a payload builder, without serializing it first.
+ *
+ * @param pub Publisher handle
+ * @param device_id Device identifier
+ * @param payload Payload handle; its seq is overwritten with the next sequence number
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sparkplug_publisher_publish_device_data_payload(sparkplug_publisher_t* pub,
+                                                    const char* device_id,
+                                                    sparkplug_payload_t* payload);
+
 /**
  * @brief Publishes a DDEATH (Device Death) message for a device.
  *
@@ -534,6 +626,25 @@ int sparkplug_host_application_set_message_callback(sparkplug_host_application_t
                                                     sparkplug_message_callback_t callback,
                                                     void* user_data);
 
+/**
+ * @brief Sets a callback that receives each message as a borrowed, already-parsed payload.
+ *
+ * Avoids the re-serialization done for sparkplug_host_application_set_message_callback() and
+ * the second parse by sparkplug_payload_parse().
+ *
+ * @param host Host Application handle
+ * @param callback Function to call for each received message (may be NULL to clear)
+ * @param user_data User context pointer passed to callback
+ * @return 0 on success, -1 on failure
+ *
+ * @note The Host Application has a single message callback: this replaces one set with
+ * sparkplug_host_application_set_message_callback(), and vice versa.
+ * @note Must be called before sparkplug_host_application_connect().
+ */
+int sparkplug_host_application_set_payload_callback(sparkplug_host_application_t* host,
+                                                    sparkplug_payload_callback_t callback,
+                                                    void* user_data);
+
 /**
  * @brief Sets a log callback for receiving library log messages including MQTT errors.
  *
@@ -788,6 +899,21 @@ void sparkplug_subscriber_set_command_callback(sparkplug_subscriber_t* sub,
                                                sparkplug_command_callback_t callback,
                                                void* user_data);
 
+/**
+ * @brief Sets a callback that receives messages as borrowed, already-parsed payloads.
+ *
+ * While set, it is invoked instead of the message callback given to
+ * sparkplug_subscriber_create(), without re-serializing the payload. Commands still go to the
+ * command callback when one is set.
+ *
+ * @param sub Subscriber handle
+ * @param callback Callback function (NULL to go back to the message callback)
+ * @param user_data User-provided context pointer passed to callback
+ */
+void sparkplug_subscriber_set_payload_callback(sparkplug_subscriber_t* sub,
+                                               sparkplug_payload_callback_t callback,
+                                               void* user_data);
+
 /**
  * @brief Resolves a metric alias to its name for a specific node or device.
  *
@@ -823,6 +949,115 @@ int sparkplug_subscriber_get_metric_name(sparkplug_subscriber_t* sub, const char
                                          const char* edge_node_id, const char* device_id,
                                          uint64_t alias, char* name_buffer, size_t buffer_size);
 
+/* ============================================================================
+ * Statistics API
+ * ========================================================================= */
+
+/** @brief Number of entries in sparkplug_stats_t::messages_in/messages_out. */
+#define SPARKPLUG_MESSAGE_TYPE_COUNT 9
+
+/** @brief Number of buckets in sparkplug_histogram_t. */
+#define SPARKPLUG_HISTOGRAM_BUCKETS 24
+
+/**
+ * @brief Sparkplug message types, used to index the per-type message counters.
+ */
+typedef enum {
+  SPARKPLUG_MESSAGE_TYPE_NBIRTH = 0,
+  SPARKPLUG_MESSAGE_TYPE_NDEATH = 1,
+  SPARKPLUG_MESSAGE_TYPE_DBIRTH = 2,
+  SPARKPLUG_MESSAGE_TYPE_DDEATH = 3,
+  SPARKPLUG_MESSAGE_TYPE_NDATA = 4,
+  SPARKPLUG_MESSAGE_TYPE_DDATA = 5,
+  SPARKPLUG_MESSAGE_TYPE_NCMD = 6,
+  SPARKPLUG_MESSAGE_TYPE_DCMD = 7,
+  SPARKPLUG_MESSAGE_TYPE_STATE = 8,
+} sparkplug_message_type_t;
+
+/**
+ * @brief Latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket i counts samples below sparkplug_histogram_bucket_upper_bound_us(i) and at or above
+ * the bound of bucket i - 1. Buckets are not cumulative.
+ */
+typedef struct {
+  uint64_t buckets[SPARKPLUG_HISTOGRAM_BUCKETS]; /** Samples per bucket */
+  uint64_t count;                                /** Total number of samples */
+  uint64_t sum_ns;                               /** Sum of all samples in nanoseconds */
+  uint64_t max_ns;                               /** Largest sample in nanoseconds */
+} sparkplug_histogram_t;
+
+/**
+ * @brief Counters of a publisher, subscriber or host application.
+ *
+ * @note seq_gaps, bd_seq_mismatches, payloads_skipped, rebirth_requests and
+ * dropped_awaiting_birth are only counted by subscribers and host applications.
+ */
+typedef struct {
+  uint64_t messages_in[SPARKPLUG_MESSAGE_TYPE_COUNT];  /** Received, by sparkplug_message_type_t */
+  uint64_t messages_out[SPARKPLUG_MESSAGE_TYPE_COUNT]; /** Published, by sparkplug_message_type_t */
+  uint64_t bytes_in;                      /** Payload bytes received */
+  uint64_t bytes_out;                     /** Payload bytes published */
+  uint64_t parse_failures;                /** Received payloads that failed to decode */
+  uint64_t publish_failures;              /** Publishes rejected or failed on delivery */
+  uint64_t seq_gaps;                      /** Out-of-order sequence numbers seen */
+  uint64_t bd_seq_mismatches;             /** NDEATH bdSeq values not matching the NBIRTH */
+  uint64_t payloads_skipped;              /** Received payloads no callback wanted decoded */
+  uint64_t in_flight;                     /** Messages pending in the MQTT client */
+  sparkplug_histogram_t publish_latency;  /** Send to completion of async publishes */
+  sparkplug_histogram_t callback_duration; /** Time spent in message/command callbacks */
+  uint64_t rebirth_requests;              /** Rebirths requested automatically */
+  uint64_t dropped_awaiting_birth;        /** Data dropped while its node awaited a rebirth */
+} sparkplug_stats_t;
+
+/**
+ * @brief Returns the exclusive upper bound of a histogram bucket in microseconds.
+ *
+ * @return Bound in microseconds, or UINT64_MAX for the last (overflow) bucket
+ */
+uint64_t sparkplug_histogram_bucket_upper_bound_us(size_t bucket);
+
+/**
+ * @brief Copies the counters of a publisher.
+ *
+ * @param pub Publisher handle
+ * @param out_stats Receives the counters
+ *
+ * @return 0 on success, -1 on failure
+ *
+ * @par Example Usage (Prometheus text format)
+ * @code
+ * sparkplug_stats_t stats;
+ * if (sparkplug_publisher_get_stats(pub, &stats) == 0) {
+ *   printf("sparkplug_messages_out_total{type=\"NDATA\"} %llu\n",
+ *          (unsigned long long)stats.messages_out[SPARKPLUG_MESSAGE_TYPE_NDATA]);
+ * }
+ * @endcode
+ */
+int sparkplug_publisher_get_stats(const sparkplug_publisher_t* pub, sparkplug_stats_t* out_stats);
+
+/**
+ * @brief Copies the counters of a subscriber.
+ *
+ * @param sub Subscriber handle
+ * @param out_stats Receives the counters
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sparkplug_subscriber_get_stats(const sparkplug_subscriber_t* sub,
+                                   sparkplug_stats_t* out_stats);
+
+/**
+ * @brief Copies the counters of a host application.
+ *
+ * @param host Host application handle
+ * @param out_stats Receives the counters
+ *
+ * @return 0 on success, -1 on failure
+ */
+int sparkplug_host_application_get_stats(const sparkplug_host_application_t* host,
+                                         sparkplug_stats_t* out_stats);
+
 /* ============================================================================
  * Payload Builder API
  * ========================================================================= */
@@ -843,6 +1078,28 @@ sparkplug_payload_t* sparkplug_payload_create(void);
  */
 void sparkplug_payload_destroy(sparkplug_payload_t* payload);
 
+/**
+ * @brief Clears a payload builder for reuse while keeping its allocated memory.
+ *
+ * Removes all metrics, clears the sequence number and restamps the payload timestamp. The
+ * cleared metrics are reused by the next add calls, so a scan loop that resets one payload
+ * instead of creating and destroying one per scan stops allocating once warm.
+ *
+ * @param payload Payload handle (may be NULL)
+ *
+ * @par Example
+ * @code
+ * sparkplug_payload_t* data = sparkplug_payload_create();
+ * for (;;) {
+ *   sparkplug_payload_reset(data);
+ *   sparkplug_payload_add_double_by_alias(data, 1, read_temperature());
+ *   sparkplug_publisher_publish_data_payload(pub, data);
+ * }
+ * sparkplug_payload_destroy(data);
+ * @endcode
+ */
+void sparkplug_payload_reset(sparkplug_payload_t* payload);
+
 /**
  * @brief Sets the payload-level timestamp.
  *
@@ -936,14 +1193,82 @@ void sparkplug_payload_add_double_by_alias(sparkplug_payload_t* payload, uint64_
 /** @brief Adds a boolean metric by alias only (for NDATA). */
 void sparkplug_payload_add_bool_by_alias(sparkplug_payload_t* payload, uint64_t alias, bool value);
 
+/* Bulk metric functions by alias only */
+
+/**
+ * @brief Adds count aliased double metrics from parallel arrays (for NDATA).
+ *
+ * One call replaces count sparkplug_payload_add_double_by_alias() calls: the datatype is
+ * resolved once, no clock is read, and every metric carries the same timestamp.
+ *
+ * @param payload Payload handle
+ * @param aliases Array of count metric aliases
+ * @param values Array of count values; values[i] is reported under aliases[i]
+ * @param count Number of metrics to add
+ * @param timestamp Timestamp for every metric in milliseconds since Unix epoch, or 0 to use
+ *                  the payload timestamp
+ *
+ * @par Example
+ * @code
+ * uint64_t aliases[2000];
+ * double values[2000];
+ * // ... fill from the PLC image ...
+ * sparkplug_payload_reset(data);
+ * sparkplug_payload_add_double_array_by_alias(data, aliases, values, 2000, 0);
+ * @endcode
+ *
+ * @note Does nothing if payload, aliases or values is NULL.
+ */
+void sparkplug_payload_add_double_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const double* values,
+                                                 size_t count, uint64_t timestamp);
+/** @brief Adds count aliased int32_t metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_int32_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const int32_t* values,
+                                                size_t count, uint64_t timestamp);
+/** @brief Adds count aliased int64_t metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_int64_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const int64_t* values,
+                                                size_t count, uint64_t timestamp);
+/** @brief Adds count aliased uint32_t metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_uint32_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const uint32_t* values,
+                                                 size_t count, uint64_t timestamp);
+/** @brief Adds count aliased uint64_t metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_uint64_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const uint64_t* values,
+                                                 size_t count, uint64_t timestamp);
+/** @brief Adds count aliased float metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_float_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const float* values,
+                                                size_t count, uint64_t timestamp);
+/** @brief Adds count aliased boolean metrics (see sparkplug_payload_add_double_array_by_alias). */
+void sparkplug_payload_add_bool_array_by_alias(sparkplug_payload_t* payload,
+                                               const uint64_t* aliases, const bool* values,
+                                               size_t count, uint64_t timestamp);
+
+/**
+ * @brief Returns the number of bytes sparkplug_payload_serialize() will write.
+ *
+ * Computed from the message without serializing it, so a caller can size its buffer first.
+ *
+ * @param payload Payload handle
+ *
+ * @return Serialized size in bytes (0 if payload is NULL)
+ */
+size_t sparkplug_payload_serialized_size(const sparkplug_payload_t* payload);
+
 /**
  * @brief Serializes the payload to a binary Protocol Buffers format.
  *
+ * Writes directly into buffer; nothing is allocated.
+ *
  * @param payload Payload handle
  * @param buffer Output buffer
  * @param buffer_size Size of output buffer in bytes
  *
- * @return Number of bytes written on success, 0 on failure
+ * @return Number of bytes written on success, 0 on failure (including a buffer smaller than
+ * sparkplug_payload_serialized_size())
  *
  * @note The serialized data can be passed to publish_birth() or publish_data().
  */
@@ -1097,6 +1422,78 @@ typedef struct {
 bool sparkplug_payload_get_metric_at(const sparkplug_payload_t* payload, size_t index,
                                      sparkplug_metric_t* out_metric);
 
+/* ============================================================================
+ * Borrowed Payload View API
+ * ========================================================================= */
+
+/**
+ * @brief Gets the payload-level timestamp of a borrowed payload.
+ *
+ * @param payload Payload passed to a sparkplug_payload_callback_t
+ * @param out_timestamp Pointer to receive timestamp value
+ *
+ * @return true if timestamp is present, false otherwise
+ */
+bool sparkplug_payload_view_get_timestamp(const sparkplug_payload_view_t* payload,
+                                          uint64_t* out_timestamp);
+
+/**
+ * @brief Gets the payload-level sequence number of a borrowed payload.
+ *
+ * @param payload Payload passed to a sparkplug_payload_callback_t
+ * @param out_seq Pointer to receive sequence value
+ *
+ * @return true if sequence is present, false otherwise
+ */
+bool sparkplug_payload_view_get_seq(const sparkplug_payload_view_t* payload, uint64_t* out_seq);
+
+/**
+ * @brief Gets the UUID of a borrowed payload.
+ *
+ * @param payload Payload passed to a sparkplug_payload_callback_t
+ *
+ * @return UUID string (valid only during the callback), or NULL if not present
+ */
+const char* sparkplug_payload_view_get_uuid(const sparkplug_payload_view_t* payload);
+
+/**
+ * @brief Gets the number of metrics in a borrowed payload.
+ *
+ * @param payload Payload passed to a sparkplug_payload_callback_t
+ *
+ * @return Number of metrics (0 if payload is NULL)
+ */
+size_t sparkplug_payload_view_get_metric_count(const sparkplug_payload_view_t* payload);
+
+/**
+ * @brief Gets information about a metric of a borrowed payload.
+ *
+ * @param payload Payload passed to a sparkplug_payload_callback_t
+ * @param index Metric index (0 to metric_count - 1)
+ * @param out_metric Pointer to receive metric information
+ *
+ * @return true on success, false if index is out of bounds or payload is NULL
+ *
+ * @note The returned pointers in out_metric are only valid during the callback.
+ *
+ * @par Example
+ * @code
+ * void on_payload(const char* topic, const sparkplug_payload_view_t* payload, void* ctx) {
+ *     size_t count = sparkplug_payload_view_get_metric_count(payload);
+ *     for (size_t i = 0; i < count; i++) {
+ *         sparkplug_metric_t metric;
+ *         if (sparkplug_payload_view_get_metric_at(payload, i, &metric) &&
+ *             metric.datatype == SPARKPLUG_DATA_TYPE_DOUBLE && !metric.is_null) {
+ *             printf("%s alias %llu = %f\n", topic, (unsigned long long)metric.alias,
+ *                    metric.value.double_value);
+ *         }
+ *     }
+ * }
+ * @endcode
+ */
+bool sparkplug_payload_view_get_metric_at(const sparkplug_payload_view_t* payload, size_t index,
+                                          sparkplug_metric_t* out_metric);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,241 @@
+// include/sparkplug/stats.hpp
+#pragma once
+
+#include "topic.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace sparkplug {
+
+/// Number of MessageType values; arrays in Stats are indexed by std::to_underlying(type)
+inline constexpr size_t MESSAGE_TYPE_COUNT = std::to_underlying(MessageType::STATE) + 1;
+
+/**
+ * @brief Snapshot of a latency histogram with power-of-two microsecond buckets.
+ *
+ * Bucket 0 counts samples below 1 us and bucket i (0 < i < BUCKETS - 1) samples in
+ * [2^(i-1), 2^i) us. The last bucket counts everything from 2^(BUCKETS-2) us (about 4 s) up.
+ * Buckets are not cumulative; sum them up to upper_bound_us() for a Prometheus "le" series.
+ */
+struct LatencyHistogram {
+  static constexpr size_t BUCKETS = 24;
+
+  std::array<uint64_t, BUCKETS> buckets{}; ///< Samples per bucket
+  uint64_t count{0};                       ///< Total number of samples
+  uint64_t sum_ns{0};                      ///< Sum of all samples in nanoseconds
+  uint64_t max_ns{0};                      ///< Largest sample in nanoseconds
+
+  /**
+   * @brief Returns the exclusive upper bound of a bucket in microseconds (UINT64_MAX for the
+   *        last bucket).
+   */
+  [[nodiscard]] static constexpr uint64_t upper_bound_us(size_t bucket) noexcept {
+    return bucket + 1 >= BUCKETS ? UINT64_MAX : uint64_t{1} << bucket;
+  }
+
+  [[nodiscard]] uint64_t mean_ns() const noexcept {
+    return count ? sum_ns / count : 0;
+  }
+
+  /**
+   * @brief Adds the samples of another histogram to this one.
+   */
+  void merge(const LatencyHistogram& other) noexcept {
+    for (size_t i = 0; i < BUCKETS; i++) {
+      buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    sum_ns += other.sum_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+  }
+};
+
+/**
+ * @brief Point-in-time copy of the counters of an EdgeNode or HostApplication.
+ *
+ * Counters start at zero when the instance is constructed and only grow. Incoming messages
+ * are counted once the topic is recognized; outgoing ones once the MQTT client accepted them.
+ *
+ * @par Example
+ * @code
+ * auto stats = host.stats();
+ * auto ndata = stats.messages_in[std::to_underlying(sparkplug::MessageType::NDATA)];
+ * std::cout << ndata << " NDATA, " << stats.seq_gaps << " seq gaps, mean callback "
+ *           << stats.callback_duration.mean_ns() << " ns\n";
+ * @endcode
+ */
+struct Stats {
+  std::array<uint64_t, MESSAGE_TYPE_COUNT> messages_in{};  ///< Received messages per type
+  std::array<uint64_t, MESSAGE_TYPE_COUNT> messages_out{}; ///< Published messages per type
+  uint64_t bytes_in{0};          ///< Payload bytes of received messages
+  uint64_t bytes_out{0};         ///< Payload bytes of published messages
+  uint64_t parse_failures{0};    ///< Received payloads that failed to decode
+  uint64_t publish_failures{0};  ///< Publishes rejected by the client or failed on delivery
+  uint64_t seq_gaps{0};          ///< Out-of-order seq numbers seen (HostApplication only)
+  uint64_t bd_seq_mismatches{0}; ///< NDEATH bdSeq not matching the NBIRTH (HostApplication only)
+  uint64_t payloads_skipped{0};  ///< Received payloads not fully decoded because no callback
+                                 ///< wanted them (HostApplication only)
+  uint64_t rebirth_requests{0};  ///< Rebirths requested by rebirth_recovery (HostApplication only)
+  uint64_t dropped_awaiting_birth{0}; ///< NDATA/DBIRTH/DDATA dropped while their node awaited a
+                                      ///< requested rebirth (HostApplication only)
+  uint64_t in_flight{0};         ///< Messages queued in the MQTT client and not yet completed
+  LatencyHistogram publish_latency;   ///< Send to delivery completion of async publishes
+  LatencyHistogram callback_duration; ///< Time spent in the message or command callback
+
+  /**
+   * @brief Adds the counters and histograms of another instance to this one.
+   */
+  void merge(const Stats& other) noexcept {
+    for (size_t i = 0; i < MESSAGE_TYPE_COUNT; i++) {
+      messages_in[i] += other.messages_in[i];
+      messages_out[i] += other.messages_out[i];
+    }
+    bytes_in += other.bytes_in;
+    bytes_out += other.bytes_out;
+    parse_failures += other.parse_failures;
+    publish_failures += other.publish_failures;
+    seq_gaps += other.seq_gaps;
+    bd_seq_mismatches += other.bd_seq_mismatches;
+    payloads_skipped += other.payloads_skipped;
+    rebirth_requests += other.rebirth_requests;
+    dropped_awaiting_birth += other.dropped_awaiting_birth;
+    in_flight += other.in_flight;
+    publish_latency.merge(other.publish_latency);
+    callback_duration.merge(other.callback_duration);
+  }
+};
+
+namespace detail {
+
+/// Alignment that keeps counters written by different threads on separate cache lines
+#ifdef __cpp_lib_hardware_interference_size
+inline constexpr size_t COUNTER_ALIGNMENT = std::hardware_destructive_interference_size;
+#else
+inline constexpr size_t COUNTER_ALIGNMENT = 64;
+#endif
+
+/**
+ * @brief Lock-free recorder behind Stats.
+ *
+ * Every update is a relaxed atomic add, so recording never blocks the MQTT or dispatch
+ * threads; snapshot() may therefore see counters from slightly different instants. Counters
+ * of received messages (MQTT and dispatch threads), of published messages (caller threads)
+ * and each histogram start on their own cache line, so those writers do not contend.
+ */
+class StatsRecorder {
+public:
+  /**
+   * @brief Recorder handed to an EdgeNode or HostApplication that was moved from.
+   *
+   * It has static storage and no control block, so a noexcept move can install it without
+   * allocating; what it counts is unspecified.
+   */
+  [[nodiscard]] static std::shared_ptr<StatsRecorder> detached() noexcept;
+
+  void record_in(MessageType type, size_t bytes) noexcept {
+    messages_in_[std::to_underlying(type)].fetch_add(1, std::memory_order_relaxed);
+    bytes_in_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void record_out(MessageType type, size_t bytes) noexcept {
+    messages_out_[std::to_underlying(type)].fetch_add(1, std::memory_order_relaxed);
+    bytes_out_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void record_parse_failure() noexcept {
+    parse_failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_publish_failure() noexcept {
+    publish_failures_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_seq_gap() noexcept {
+    seq_gaps_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_bd_seq_mismatch() noexcept {
+    bd_seq_mismatches_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_payload_skipped() noexcept {
+    payloads_skipped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_rebirth_request() noexcept {
+    rebirth_requests_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_dropped_awaiting_birth() noexcept {
+    dropped_awaiting_birth_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void record_publish_latency(std::chrono::steady_clock::duration elapsed) noexcept {
+    publish_latency_.record(elapsed);
+  }
+
+  void record_callback_duration(std::chrono::steady_clock::duration elapsed) noexcept {
+    callback_duration_.record(elapsed);
+  }
+
+  /**
+   * @brief Copies all counters; in_flight is left for the owner to fill in.
+   */
+  [[nodiscard]] Stats snapshot() const noexcept;
+
+private:
+  class Histogram {
+  public:
+    void record(std::chrono::steady_clock::duration elapsed) noexcept {
+      auto ns = static_cast<uint64_t>(
+          std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                                   .count()));
+      size_t bucket = std::min<size_t>(std::bit_width(ns / 1000), LatencyHistogram::BUCKETS - 1);
+      buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+      count_.fetch_add(1, std::memory_order_relaxed);
+      sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+      uint64_t max = max_ns_.load(std::memory_order_relaxed);
+      while (ns > max && !max_ns_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+      }
+    }
+
+    [[nodiscard]] LatencyHistogram snapshot() const noexcept;
+
+  private:
+    std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+  };
+
+  // Received messages
+  alignas(COUNTER_ALIGNMENT) std::array<std::atomic<uint64_t>, MESSAGE_TYPE_COUNT> messages_in_{};
+  std::atomic<uint64_t> bytes_in_{0};
+  std::atomic<uint64_t> parse_failures_{0};
+  std::atomic<uint64_t> seq_gaps_{0};
+  std::atomic<uint64_t> bd_seq_mismatches_{0};
+  std::atomic<uint64_t> payloads_skipped_{0};
+  std::atomic<uint64_t> rebirth_requests_{0};
+  std::atomic<uint64_t> dropped_awaiting_birth_{0};
+
+  // Published messages
+  alignas(COUNTER_ALIGNMENT) std::array<std::atomic<uint64_t>, MESSAGE_TYPE_COUNT> messages_out_{};
+  std::atomic<uint64_t> bytes_out_{0};
+  std::atomic<uint64_t> publish_failures_{0};
+
+  alignas(COUNTER_ALIGNMENT) Histogram publish_latency_;
+  alignas(COUNTER_ALIGNMENT) Histogram callback_duration_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,219 @@
+// include/sparkplug/store_forward.hpp
+#pragma once
+
+#include "worker_thread.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Store-and-forward settings for EdgeNode.
+ *
+ * While the broker is unreachable, NDATA/DDATA frames are kept in memory up to
+ * memory_limit_bytes. Older frames then spill to a memory-mapped segment file of
+ * spill_limit_bytes; when that is full too, the oldest frames are dropped. After the session
+ * is re-established and the births are replayed, frames are republished oldest first with the
+ * historical flag set on every metric.
+ *
+ * @par Example
+ * @code
+ * config.store_forward = {.enabled = true,
+ *                         .memory_limit_bytes = 8 * 1024 * 1024,
+ *                         .spill_path = "/var/lib/gateway/sparkplug.spill",
+ *                         .drain_rate = 200};
+ * @endcode
+ */
+struct StoreForwardConfig {
+  bool enabled = false;                        ///< Buffer NDATA/DDATA while disconnected
+  size_t memory_limit_bytes = 4 * 1024 * 1024; ///< In-memory budget for serialized frames
+  std::string spill_path{};                    ///< Segment file for overflow (empty = no spill)
+  size_t spill_limit_bytes = 256 * 1024 * 1024; ///< Size of the segment file
+  size_t drain_rate = 100; ///< Frames per second republished after reconnect (0 = unpaced)
+};
+
+/**
+ * @brief FIFO of serialized data frames with bounded memory and an mmap spill file.
+ *
+ * The newest frames stay in memory; when the memory budget is exceeded the oldest in-memory
+ * frames are appended to the spill file, so frames on disk are always older than those in
+ * memory and front() reads the file first.
+ *
+ * @note The spill file is scratch space: it is truncated when the buffer is created and
+ *       removed when it is destroyed.
+ * @note Not thread-safe; detail::ForwardQueue serializes access for EdgeNode.
+ */
+class StoreForwardBuffer {
+public:
+  /**
+   * @brief One buffered message.
+   */
+  struct Frame {
+    std::string device_id;        ///< Target device, empty for NDATA
+    std::vector<uint8_t> payload; ///< Serialized payload (seq assigned when republished)
+  };
+
+  /**
+   * @brief Creates a buffer, creating and mapping the spill file if one is configured.
+   *
+   * @return The buffer, or an error if the spill file cannot be created or mapped
+   */
+  [[nodiscard]] static std::expected<StoreForwardBuffer, std::string>
+  create(const StoreForwardConfig& config);
+
+  ~StoreForwardBuffer();
+
+  StoreForwardBuffer(const StoreForwardBuffer&) = delete;
+  StoreForwardBuffer& operator=(const StoreForwardBuffer&) = delete;
+  StoreForwardBuffer(StoreForwardBuffer&& other) noexcept;
+  StoreForwardBuffer& operator=(StoreForwardBuffer&& other) noexcept;
+
+  /**
+   * @brief Appends a frame, spilling or dropping the oldest frames to stay within budget.
+   */
+  void push(std::string_view device_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief Returns a copy of the oldest frame, or std::nullopt if the buffer is empty.
+   */
+  [[nodiscard]] std::optional<Frame> front() const;
+
+  /**
+   * @brief Removes the oldest frame.
+   */
+  void pop_front();
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Returns the number of buffered frames (memory and spill file).
+   */
+  [[nodiscard]] size_t size() const noexcept {
+    return memory_.size() + spill_count_;
+  }
+
+  /**
+   * @brief Returns how many frames were discarded because both tiers were full.
+   */
+  [[nodiscard]] uint64_t dropped() const noexcept {
+    return dropped_;
+  }
+
+  /**
+   * @brief Returns a counter bumped whenever the oldest frame is removed, by pop_front() or by
+   *        an overflow; front() returns the same frame for as long as it is unchanged.
+   */
+  [[nodiscard]] uint64_t front_generation() const noexcept {
+    return front_generation_;
+  }
+
+  [[nodiscard]] size_t memory_bytes() const noexcept {
+    return memory_bytes_;
+  }
+
+  [[nodiscard]] size_t spill_bytes() const noexcept {
+    return spill_tail_ - spill_head_;
+  }
+
+private:
+  StoreForwardBuffer() = default;
+
+  // Appends a frame to the spill file; false if the file is missing or cannot fit it
+  bool spill(const Frame& frame);
+  // Slides live records to the start of the file if the tail lacks `needed` bytes
+  void compact_spill(size_t needed) noexcept;
+  // Reads the frame at head of the spill file; record_size receives its encoded size
+  [[nodiscard]] Frame read_spilled(size_t& record_size) const;
+  void drop_spilled_front();
+  void close_spill() noexcept;
+
+  size_t memory_limit_{0};
+  std::deque<Frame> memory_;
+  size_t memory_bytes_{0};
+
+  std::string spill_path_;
+  int spill_fd_{-1};
+  uint8_t* spill_base_{nullptr};
+  size_t spill_capacity_{0};
+  size_t spill_head_{0}; // Offset of the oldest record
+  size_t spill_tail_{0}; // Offset one past the newest record
+  size_t spill_count_{0};
+
+  uint64_t dropped_{0};
+  uint64_t front_generation_{0};
+};
+
+namespace detail {
+
+/**
+ * @brief Thread-safe StoreForwardBuffer plus the thread that drains it after a reconnect.
+ *
+ * The buffer itself is created by open(), so a bad spill path is reported by connect()
+ * rather than by the constructor. start_drain() republishes frames oldest first at
+ * StoreForwardConfig::drain_rate until the buffer is empty, a send fails (the frame is kept
+ * for the next session), or stop() is called.
+ */
+class ForwardQueue {
+public:
+  /// Republishes one frame; on error the frame stays queued and draining stops
+  using Send = std::function<std::expected<void, std::string>(const StoreForwardBuffer::Frame&)>;
+
+  explicit ForwardQueue(StoreForwardConfig config) : config_(std::move(config)) {
+  }
+  ~ForwardQueue();
+
+  ForwardQueue(const ForwardQueue&) = delete;
+  ForwardQueue& operator=(const ForwardQueue&) = delete;
+
+  /**
+   * @brief Creates the buffer (and spill file) unless it already exists.
+   */
+  [[nodiscard]] std::expected<void, std::string> open();
+
+  /**
+   * @brief Queues a frame.
+   *
+   * @return false if open() has not succeeded yet
+   */
+  bool push(std::string_view device_id, std::span<const uint8_t> payload);
+
+  /**
+   * @brief Starts the drain thread if frames are queued and it is not already running.
+   */
+  void start_drain(Send send);
+
+  /**
+   * @brief Stops the drain thread and waits for it to exit.
+   *
+   * @warning Must not be called from inside the send function.
+   */
+  void stop();
+
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] uint64_t dropped() const;
+
+private:
+  void drain(const WorkerThread::Run& worker, const Send& send);
+
+  const StoreForwardConfig config_;
+  mutable std::mutex mutex_; // Guards buffer_
+  std::optional<StoreForwardBuffer> buffer_;
+  WorkerThread thread_;
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,182 @@
+// include/sparkplug/string_interner.hpp
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace sparkplug {
+
+class StringInterner;
+
+/**
+ * @brief Handle to a string owned by a StringInterner.
+ *
+ * A handle is one pointer wide, copies for free, and carries the precomputed hash of its
+ * text. Two handles from the same interner are equal exactly when they point at the same
+ * entry; handles from different interners fall back to comparing text.
+ *
+ * @note The handle is valid for as long as the interner that produced it.
+ */
+class InternedString {
+public:
+  constexpr InternedString() noexcept = default;
+
+  [[nodiscard]] std::string_view view() const noexcept {
+    return rep_ ? std::string_view(rep_->text) : std::string_view{};
+  }
+
+  operator std::string_view() const noexcept {
+    return view();
+  }
+
+  [[nodiscard]] const char* data() const noexcept {
+    return view().data();
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return view().size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Returns std::hash<std::string_view> of the text (computed once when interned).
+   */
+  [[nodiscard]] size_t hash() const noexcept {
+    return rep_ ? rep_->hash : std::hash<std::string_view>{}({});
+  }
+
+  [[nodiscard]] friend bool operator==(InternedString lhs, InternedString rhs) noexcept {
+    return lhs.rep_ == rhs.rep_ || lhs.view() == rhs.view();
+  }
+
+  [[nodiscard]] friend bool operator==(InternedString lhs, std::string_view rhs) noexcept {
+    return lhs.view() == rhs;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, InternedString str) {
+    return os << str.view();
+  }
+
+private:
+  friend class StringInterner;
+
+  struct Rep {
+    std::string text;
+    size_t hash;
+  };
+
+  explicit InternedString(const Rep* rep) noexcept : rep_(rep) {
+  }
+
+  const Rep* rep_{nullptr};
+};
+
+/**
+ * @brief Hash for containers keyed by InternedString that also accepts std::string_view.
+ *
+ * Both overloads produce the same value for the same text, so maps can be probed with a view
+ * without interning it first.
+ */
+struct InternedStringHash {
+  using is_transparent = void;
+  [[nodiscard]] size_t operator()(InternedString str) const noexcept {
+    return str.hash();
+  }
+  [[nodiscard]] size_t operator()(std::string_view str) const noexcept {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+/**
+ * @brief Thread-safe, grow-only pool of unique strings.
+ *
+ * Group, edge node, device and metric names repeat across thousands of nodes; interning
+ * them stores each distinct name once and turns string keys into pointer-sized handles.
+ * Lookups of names that are already interned take a shared lock and do not allocate.
+ *
+ * Names taken from the wire are admitted with try_intern() (or checked against available()
+ * first), so a byte limit caps what peers can make the pool hold.
+ *
+ * @par Example
+ * @code
+ * sparkplug::StringInterner names;
+ * auto a = names.intern("Temperature");
+ * auto b = names.intern(std::string("Temperature"));
+ * assert(a == b && a.data() == b.data());
+ * @endcode
+ *
+ * @note Strings are never released before the interner is destroyed, and handles must not
+ *       outlive it: an interner is owned by whatever holds its handles (e.g. a HostApplication).
+ */
+class StringInterner {
+public:
+  /**
+   * @param max_bytes Total length of pooled strings past which try_intern() refuses new ones
+   *                  (0 = unlimited)
+   */
+  explicit StringInterner(size_t max_bytes = 0) noexcept : max_bytes_(max_bytes) {
+  }
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  /**
+   * @brief Returns the handle for text, adding it to the pool on first use.
+   *
+   * @note Ignores the byte limit; use try_intern() for untrusted text.
+   */
+  [[nodiscard]] InternedString intern(std::string_view text);
+
+  /**
+   * @brief Like intern(), but returns std::nullopt instead of growing the pool past its limit.
+   */
+  [[nodiscard]] std::optional<InternedString> try_intern(std::string_view text);
+
+  /**
+   * @brief Returns the handle for text if it has been interned, without adding it.
+   */
+  [[nodiscard]] std::optional<InternedString> find(std::string_view text) const;
+
+  /**
+   * @brief Returns the number of distinct strings in the pool.
+   */
+  [[nodiscard]] size_t size() const;
+
+  /**
+   * @brief Returns the total length of the pooled strings in bytes.
+   */
+  [[nodiscard]] size_t bytes() const;
+
+  /**
+   * @brief Returns how many more bytes of new strings fit under the limit (SIZE_MAX if unlimited).
+   */
+  [[nodiscard]] size_t available() const;
+
+  /**
+   * @brief Changes the byte limit; strings already pooled are kept even if they exceed it.
+   */
+  void set_max_bytes(size_t max_bytes);
+
+private:
+  // nullopt only if bounded and text is new and does not fit
+  [[nodiscard]] std::optional<InternedString> lookup_or_add(std::string_view text, bool bounded);
+
+  mutable std::shared_mutex mutex_;
+  std::deque<InternedString::Rep> storage_; // Stable addresses for handles and index keys
+  std::unordered_map<std::string_view, const InternedString::Rep*, InternedStringHash,
+                     std::equal_to<>>
+      index_;
+  size_t bytes_{0};
+  size_t max_bytes_{0};
+};
+
+} // namespace sparkplug
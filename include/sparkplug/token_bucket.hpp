@@ -0,0 +1,70 @@
+// include/sparkplug/token_bucket.hpp
+#pragma once
+
+#include <chrono>
+
+namespace sparkplug {
+
+/**
+ * @brief Token-bucket rate limiter for pacing publishes by bytes or messages.
+ *
+ * Tokens accrue at rate_per_second up to burst. acquire() always takes the tokens, going into
+ * debt if needed, and returns how long the caller must wait before acting, so a cost larger
+ * than the burst is paced rather than refused.
+ *
+ * @par Example
+ * @code
+ * sparkplug::TokenBucket budget(1024 * 1024, 64 * 1024); // 1 MiB/s, 64 KiB burst
+ * std::this_thread::sleep_for(budget.acquire(payload.size()));
+ * publish(payload);
+ * @endcode
+ *
+ * @note Not thread-safe.
+ */
+class TokenBucket {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Creates a full bucket.
+   *
+   * @param rate_per_second Tokens added per second (0 or less = unlimited)
+   * @param burst Maximum tokens held
+   */
+  TokenBucket(double rate_per_second, double burst) noexcept;
+
+  /**
+   * @brief Takes tokens.
+   *
+   * @param cost Tokens to take
+   * @param now Current time
+   *
+   * @return Time to wait before acting; zero if the tokens were available or the bucket is
+   *         unlimited
+   */
+  [[nodiscard]] Clock::duration acquire(double cost, Clock::time_point now = Clock::now());
+
+  /**
+   * @brief Takes tokens only if they are available, never going into debt.
+   *
+   * @param cost Tokens to take
+   * @param now Current time
+   *
+   * @return true if the tokens were taken or the bucket is unlimited
+   */
+  [[nodiscard]] bool try_acquire(double cost, Clock::time_point now = Clock::now());
+
+  [[nodiscard]] bool unlimited() const noexcept {
+    return rate_ <= 0;
+  }
+
+private:
+  void refill(Clock::time_point now) noexcept;
+
+  double rate_;
+  double burst_;
+  double tokens_;
+  Clock::time_point last_;
+};
+
+} // namespace sparkplug
@@ -75,4 +75,42 @@ struct Topic {
   [[nodiscard]] static std::expected<Topic, std::string> parse(std::string_view topic_str);
 };
 
+/**
+ * @brief Non-owning view of a parsed Sparkplug B MQTT topic.
+ *
+ * All fields are string_views into the string passed to parse(), so the view is only valid
+ * while that buffer is alive. Use to_topic() to obtain an owned Topic.
+ *
+ * @par Example
+ * @code
+ * auto view = sparkplug::TopicView::parse(mqtt_topic_name);
+ * if (view && view->message_type == sparkplug::MessageType::NDATA) {
+ *   handle_data(view->group_id, view->edge_node_id);
+ * }
+ * @endcode
+ */
+struct TopicView {
+  std::string_view group_id;     ///< Group ID (empty for STATE)
+  MessageType message_type;      ///< Message type (NBIRTH, NDATA, etc.)
+  std::string_view edge_node_id; ///< Edge node identifier (host_id for STATE)
+  std::string_view device_id;    ///< Device identifier (empty for node-level messages)
+
+  /**
+   * @brief Copies the viewed fields into an owned Topic.
+   */
+  [[nodiscard]] Topic to_topic() const;
+
+  /**
+   * @brief Parses a Sparkplug B topic string without allocating.
+   *
+   * @param topic_str Topic string to parse (must outlive the returned view)
+   *
+   * @return Parsed TopicView on success, static error description on failure
+   *
+   * @note Accepts exactly the topics accepted by Topic::parse().
+   */
+  [[nodiscard]] static std::expected<TopicView, std::string_view>
+  parse(std::string_view topic_str) noexcept;
+};
+
 } // namespace sparkplug
\ No newline at end of file
@@ -0,0 +1,149 @@
+// include/sparkplug/value_store.hpp
+#pragma once
+
+#include "datatype.hpp"
+#include "metric_value.hpp"
+#include "sparkplug_b.pb.h"
+#include "string_interner.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sparkplug {
+
+/**
+ * @brief Last known value of every metric declared in one NBIRTH or DBIRTH.
+ *
+ * rebuild() lays the birth metrics out in a flat vector of typed entries; update() applies an
+ * NDATA/DDATA to it, matching each metric by alias (when it has one) or by name. Both lookups
+ * are O(1): names through a hash index of interned handles, aliases through a dense
+ * alias-indexed table (or a hash map when the aliases of the birth are too sparse, as decided
+ * by AliasRegistry::use_dense_layout()).
+ *
+ * @par Example
+ * @code
+ * sparkplug::StringInterner names;
+ * sparkplug::ValueStore store;
+ * store.rebuild(dbirth_payload, names);
+ * store.update(ddata_payload);
+ * if (const auto* entry = store.find("Temperature")) {
+ *   double celsius = std::get<double>(entry->value);
+ * }
+ * @endcode
+ *
+ * @note Not thread-safe; HostApplication guards each store with its node-state shard lock.
+ */
+class ValueStore {
+public:
+  /// Marks an entry index slot that is not in use
+  static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+
+  /**
+   * @brief Information recorded for one metric.
+   */
+  struct Entry {
+    InternedString name;                  ///< Metric name from the birth certificate
+    uint64_t alias{0};                    ///< Alias from the birth (valid if has_alias)
+    DataType datatype{DataType::Unknown}; ///< Datatype declared in the birth certificate
+    bool has_alias{false};                ///< True if the birth declared an alias
+    bool is_historical{false};            ///< True if the last value was flagged historical
+    uint64_t timestamp{0};                ///< Metric (or payload) timestamp of the last value
+    MetricValue value{};                  ///< Last known value (std::monostate if null)
+  };
+
+  /**
+   * @brief Copy of an Entry that owns its name, so it stays valid after the interner is gone.
+   */
+  struct OwnedEntry {
+    std::string name;                     ///< Metric name from the birth certificate
+    uint64_t alias{0};                    ///< Alias from the birth (valid if has_alias)
+    DataType datatype{DataType::Unknown}; ///< Datatype declared in the birth certificate
+    bool has_alias{false};                ///< True if the birth declared an alias
+    bool is_historical{false};            ///< True if the last value was flagged historical
+    uint64_t timestamp{0};                ///< Metric (or payload) timestamp of the last value
+    MetricValue value{};                  ///< Last known value (std::monostate if null)
+
+    [[nodiscard]] static OwnedEntry copy_of(const Entry& entry) {
+      return OwnedEntry{.name = std::string(entry.name.view()),
+                        .alias = entry.alias,
+                        .datatype = entry.datatype,
+                        .has_alias = entry.has_alias,
+                        .is_historical = entry.is_historical,
+                        .timestamp = entry.timestamp,
+                        .value = entry.value};
+    }
+  };
+
+  /**
+   * @brief Replaces all entries with the metrics of a birth payload.
+   *
+   * @param birth NBIRTH or DBIRTH payload; metrics without a name are ignored
+   * @param names Interner that owns the entry names (must outlive the store and its entries)
+   */
+  void rebuild(const org::eclipse::tahu::protobuf::Payload& birth, StringInterner& names);
+
+  /**
+   * @brief Stores the values carried by a data payload.
+   *
+   * @param data NDATA or DDATA payload; metrics not declared in the birth are ignored
+   *
+   * @return Number of entries updated
+   *
+   * @note A metric flagged is_historical is only stored if it is not older than the current
+   *       value, so replayed store-and-forward data never hides a newer live value.
+   */
+  size_t update(const org::eclipse::tahu::protobuf::Payload& data);
+
+  /**
+   * @brief Looks up a metric by name.
+   *
+   * @return Pointer to the entry, or nullptr if the birth did not declare the metric
+   *
+   * @note Pointers are invalidated by rebuild() and clear().
+   */
+  [[nodiscard]] const Entry* find(std::string_view name) const noexcept;
+
+  /**
+   * @brief Looks up a metric by alias.
+   *
+   * @return Pointer to the entry, or nullptr if the birth did not declare the alias
+   */
+  [[nodiscard]] const Entry* find(uint64_t alias) const noexcept;
+
+  /**
+   * @brief Returns all entries in birth order.
+   */
+  [[nodiscard]] std::span<const Entry> entries() const noexcept {
+    return entries_;
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return entries_.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return entries_.empty();
+  }
+
+  /**
+   * @brief Removes all entries.
+   */
+  void clear() noexcept;
+
+private:
+  [[nodiscard]] uint32_t index_of(const org::eclipse::tahu::protobuf::Payload::Metric& metric)
+      const noexcept;
+  [[nodiscard]] uint32_t alias_index(uint64_t alias) const noexcept;
+
+  std::vector<Entry> entries_;
+  std::unordered_map<InternedString, uint32_t, InternedStringHash, std::equal_to<>> by_name_;
+  std::vector<uint32_t> dense_aliases_; // alias -> entry index (NO_ENTRY if unused)
+  std::unordered_map<uint64_t, uint32_t> sparse_aliases_;
+};
+
+} // namespace sparkplug
@@ -0,0 +1,227 @@
+// include/sparkplug/wire_format.hpp
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Minimal protobuf wire-format primitives for the Sparkplug B payload.
+ *
+ * Used where the library reads or writes serialized payloads without going through the
+ * generated protobuf classes (patching cached births, MetricFrame, scanning received payloads
+ * that are not delivered).
+ */
+namespace sparkplug::detail::wire {
+
+constexpr uint64_t WIRE_VARINT = 0;
+constexpr uint64_t WIRE_FIXED64 = 1;
+constexpr uint64_t WIRE_LENGTH = 2;
+constexpr uint64_t WIRE_FIXED32 = 5;
+
+// Field numbers from sparkplug_b.proto
+constexpr uint64_t PAYLOAD_TIMESTAMP_FIELD = 1;
+constexpr uint64_t PAYLOAD_METRICS_FIELD = 2;
+constexpr uint64_t PAYLOAD_SEQ_FIELD = 3;
+constexpr uint64_t PAYLOAD_UUID_FIELD = 4;
+constexpr uint64_t METRIC_NAME_FIELD = 1;
+constexpr uint64_t METRIC_ALIAS_FIELD = 2;
+constexpr uint64_t METRIC_TIMESTAMP_FIELD = 3;
+constexpr uint64_t METRIC_DATATYPE_FIELD = 4;
+constexpr uint64_t METRIC_INT_VALUE_FIELD = 10;
+constexpr uint64_t METRIC_LONG_VALUE_FIELD = 11;
+constexpr uint64_t METRIC_FLOAT_VALUE_FIELD = 12;
+constexpr uint64_t METRIC_DOUBLE_VALUE_FIELD = 13;
+constexpr uint64_t METRIC_BOOLEAN_VALUE_FIELD = 14;
+
+/// uuid marking a payload whose body is a compressed payload (see compression.hpp)
+constexpr std::string_view COMPRESSED_PAYLOAD_UUID = "SPBV1.0_COMPRESSED";
+
+/// Longest encoding of a 64-bit varint
+constexpr size_t MAX_VARINT_SIZE = 10;
+
+[[nodiscard]] constexpr uint64_t make_tag(uint64_t field, uint64_t wire_type) noexcept {
+  return (field << 3) | wire_type;
+}
+
+[[nodiscard]] constexpr size_t varint_size(uint64_t value) noexcept {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+inline bool read_varint(std::span<const uint8_t> data, size_t& pos, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+    uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void append_varint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+inline void append_bytes(std::vector<uint8_t>& out, std::span<const uint8_t> bytes) {
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+/**
+ * @brief Writes value as a varint of exactly width bytes.
+ *
+ * Continuation bits are kept on the leading bytes, so values shorter than width decode the
+ * same as their minimal encoding. The value must fit in 7 * width bits.
+ */
+inline void write_padded_varint(uint8_t* out, uint64_t value, size_t width) noexcept {
+  for (size_t i = 0; i + 1 < width; i++) {
+    out[i] = static_cast<uint8_t>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out[width - 1] = static_cast<uint8_t>(value & 0x7F);
+}
+
+// Advances pos past the value of a field with the given wire type
+inline bool skip_field(std::span<const uint8_t> data, size_t& pos, uint64_t wire_type) {
+  uint64_t length = 0;
+  switch (wire_type) {
+  case WIRE_VARINT:
+    return read_varint(data, pos, length);
+  case WIRE_FIXED64:
+    length = 8;
+    break;
+  case WIRE_LENGTH:
+    if (!read_varint(data, pos, length)) {
+      return false;
+    }
+    break;
+  case WIRE_FIXED32:
+    length = 4;
+    break;
+  default:
+    return false;
+  }
+  if (length > data.size() - pos) {
+    return false;
+  }
+  pos += length;
+  return true;
+}
+
+/// Payload fields read by scan_payload()
+struct PayloadHeader {
+  std::optional<uint64_t> timestamp;
+  std::optional<uint64_t> seq;
+  std::optional<uint64_t> bd_seq; ///< long_value of the first metric named "bdSeq"
+  bool compressed{false};         ///< uuid is COMPRESSED_PAYLOAD_UUID; metrics are in the body
+};
+
+// Looks for a bdSeq metric in one encoded Metric message
+inline bool scan_bd_seq_metric(std::span<const uint8_t> metric, PayloadHeader& header) {
+  constexpr std::string_view BD_SEQ = "bdSeq";
+  bool is_bd_seq = false;
+  std::optional<uint64_t> long_value;
+  size_t pos = 0;
+  while (pos < metric.size()) {
+    uint64_t tag = 0;
+    if (!read_varint(metric, pos, tag)) {
+      return false;
+    }
+    if (tag == make_tag(METRIC_NAME_FIELD, WIRE_LENGTH)) {
+      uint64_t length = 0;
+      if (!read_varint(metric, pos, length) || length > metric.size() - pos) {
+        return false;
+      }
+      is_bd_seq = length == BD_SEQ.size() &&
+                  std::equal(BD_SEQ.begin(), BD_SEQ.end(), metric.begin() + pos);
+      pos += length;
+    } else if (tag == make_tag(METRIC_LONG_VALUE_FIELD, WIRE_VARINT)) {
+      uint64_t value = 0;
+      if (!read_varint(metric, pos, value)) {
+        return false;
+      }
+      long_value = value;
+    } else if ((tag >> 3) == 0 || !skip_field(metric, pos, tag & 0x7)) {
+      return false;
+    }
+  }
+  if (is_bd_seq) {
+    header.bd_seq = long_value.value_or(0);
+  }
+  return true;
+}
+
+/**
+ * @brief Reads the payload timestamp and seq, and optionally the bdSeq metric, without
+ * decoding the metrics.
+ *
+ * Metrics are skipped by their length, so the cost grows with the number of metrics rather
+ * than with their contents. As in a full parse, the last timestamp or seq field wins.
+ *
+ * @param data Serialized Sparkplug B payload
+ * @param header Receives the fields present in the payload
+ * @param find_bd_seq Also look into metrics for bdSeq (NBIRTH/NDEATH)
+ *
+ * @return false if the payload is malformed
+ */
+inline bool scan_payload(std::span<const uint8_t> data, PayloadHeader& header,
+                         bool find_bd_seq = false) {
+  size_t pos = 0;
+  while (pos < data.size()) {
+    uint64_t tag = 0;
+    if (!read_varint(data, pos, tag)) {
+      return false;
+    }
+    if (tag == make_tag(PAYLOAD_TIMESTAMP_FIELD, WIRE_VARINT)) {
+      uint64_t value = 0;
+      if (!read_varint(data, pos, value)) {
+        return false;
+      }
+      header.timestamp = value;
+    } else if (tag == make_tag(PAYLOAD_SEQ_FIELD, WIRE_VARINT)) {
+      uint64_t value = 0;
+      if (!read_varint(data, pos, value)) {
+        return false;
+      }
+      header.seq = value;
+    } else if (tag == make_tag(PAYLOAD_UUID_FIELD, WIRE_LENGTH)) {
+      uint64_t length = 0;
+      if (!read_varint(data, pos, length) || length > data.size() - pos) {
+        return false;
+      }
+      header.compressed = length == COMPRESSED_PAYLOAD_UUID.size() &&
+                          std::equal(COMPRESSED_PAYLOAD_UUID.begin(),
+                                     COMPRESSED_PAYLOAD_UUID.end(), data.begin() + pos);
+      pos += length;
+    } else if (find_bd_seq && !header.bd_seq &&
+               tag == make_tag(PAYLOAD_METRICS_FIELD, WIRE_LENGTH)) {
+      uint64_t length = 0;
+      if (!read_varint(data, pos, length) || length > data.size() - pos) {
+        return false;
+      }
+      if (!scan_bd_seq_metric(data.subspan(pos, length), header)) {
+        return false;
+      }
+      pos += length;
+    } else if ((tag >> 3) == 0 || !skip_field(data, pos, tag & 0x7)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace sparkplug::detail::wire
@@ -0,0 +1,104 @@
+// include/sparkplug/worker_thread.hpp
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sparkplug {
+
+namespace detail {
+
+/**
+ * @brief A background thread that can be started, stopped and started again.
+ *
+ * The background loops of EdgeNode and HostApplication (reconnects, DBIRTH replay, the
+ * store-and-forward drain, snapshots, node control) are bodies run by a WorkerThread. A body
+ * learns from its Run that stop() was called, either by polling stopped() or from the waits,
+ * which stop() interrupts. State the body waits for is changed through notify(), under the
+ * same mutex as the waits.
+ *
+ * stop() joins the thread, or detaches it when called from the body itself; the detached body
+ * sees the stop at its next check. The mutex and flags live in a control block shared with the
+ * thread, so a detached body may outlive the WorkerThread. start() is refused while a body
+ * runs, detached or not, or a stop() is in progress, and accepted again afterwards.
+ */
+class WorkerThread {
+public:
+private:
+  // Shared by the WorkerThread and its thread
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t generation{0}; // Bumped by stop(); a body's run is stopped once it differs
+    bool running{false};    // From start() until the body returns
+    bool stopping{false};
+  };
+
+public:
+  /// Handle through which a running body observes stop()
+  class Run {
+  public:
+    /// True once stop() has been called for this run
+    [[nodiscard]] bool stopped() const;
+
+    /// Waits up to timeout; true if stopped
+    bool wait_for(std::chrono::steady_clock::duration timeout) const;
+
+    /// Waits until ready() returns true (called under the mutex of notify()); true if stopped
+    bool wait(const std::function<bool()>& ready) const;
+
+  private:
+    friend class WorkerThread;
+
+    Run(State& state, uint64_t generation) noexcept : state_(state), generation_(generation) {
+    }
+
+    State& state_; // Kept alive by the thread
+    const uint64_t generation_;
+  };
+
+  using Body = std::function<void(const Run&)>;
+
+  WorkerThread() = default;
+  ~WorkerThread();
+
+  WorkerThread(const WorkerThread&) = delete;
+  WorkerThread& operator=(const WorkerThread&) = delete;
+
+  /**
+   * @brief Runs body on a new thread.
+   *
+   * @return false (and body is dropped) while an earlier body runs or stop() is in progress
+   *
+   * @note Safe to call from MQTT client callbacks.
+   */
+  bool start(Body body);
+
+  /**
+   * @brief Interrupts the body and waits for it to return.
+   *
+   * @note Detaches instead when called from the body itself.
+   */
+  void stop();
+
+  /// True from start() until the body returns
+  [[nodiscard]] bool running() const;
+
+  /**
+   * @brief Calls update under the mutex that Run::wait() holds, then wakes the body.
+   */
+  void notify(const std::function<void()>& update);
+
+private:
+  const std::shared_ptr<State> state_ = std::make_shared<State>();
+  std::thread thread_; // Guarded by state_->mutex
+};
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,113 @@
+// src/alias_registry.cpp
+#include "sparkplug/alias_registry.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sparkplug {
+
+namespace {
+
+bool is_registrable(const org::eclipse::tahu::protobuf::Payload::Metric& metric) {
+  return metric.has_alias() && metric.has_name();
+}
+
+} // namespace
+
+void AliasRegistry::rebuild(const org::eclipse::tahu::protobuf::Payload& birth,
+                            StringInterner& names) {
+  clear();
+
+  uint64_t count = 0;
+  uint64_t max_alias = 0;
+  for (const auto& metric : birth.metrics()) {
+    if (is_registrable(metric)) {
+      count++;
+      max_alias = std::max(max_alias, metric.alias());
+    }
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  bool dense = use_dense_layout(count, max_alias);
+
+  if (dense) {
+    dense_.resize(max_alias + 1);
+  } else {
+    sparse_.reserve(count);
+  }
+
+  for (const auto& metric : birth.metrics()) {
+    if (!is_registrable(metric)) {
+      continue;
+    }
+
+    auto datatype = static_cast<DataType>(metric.datatype());
+    Entry entry{.name = names.intern(metric.name()),
+                .datatype = datatype,
+                .value = metric_value_from_proto(metric, datatype)};
+
+    if (dense) {
+      auto& slot = dense_[metric.alias()];
+      if (!slot.used) {
+        size_++;
+      }
+      slot.used = true;
+      slot.entry = std::move(entry);
+    } else {
+      auto [it, inserted] = sparse_.insert_or_assign(metric.alias(), std::move(entry));
+      if (inserted) {
+        size_++;
+      }
+    }
+  }
+}
+
+size_t AliasRegistry::update_values(const org::eclipse::tahu::protobuf::Payload& data) {
+  size_t updated = 0;
+  for (const auto& metric : data.metrics()) {
+    if (!metric.has_alias()) {
+      continue;
+    }
+    if (auto* entry = find(metric.alias())) {
+      entry->value = metric_value_from_proto(metric, entry->datatype);
+      updated++;
+    }
+  }
+  return updated;
+}
+
+const AliasRegistry::Entry* AliasRegistry::find(uint64_t alias) const noexcept {
+  if (!dense_.empty()) {
+    if (alias < dense_.size() && dense_[alias].used) {
+      return &dense_[alias].entry;
+    }
+    return nullptr;
+  }
+
+  auto it = sparse_.find(alias);
+  return it != sparse_.end() ? &it->second : nullptr;
+}
+
+AliasRegistry::Entry* AliasRegistry::find(uint64_t alias) noexcept {
+  return const_cast<Entry*>(std::as_const(*this).find(alias));
+}
+
+void AliasRegistry::reset_values() noexcept {
+  for (auto& slot : dense_) {
+    slot.entry.value = std::monostate{};
+  }
+  for (auto& [alias, entry] : sparse_) {
+    entry.value = std::monostate{};
+  }
+}
+
+void AliasRegistry::clear() noexcept {
+  dense_.clear();
+  sparse_.clear();
+  size_ = 0;
+}
+
+} // namespace sparkplug
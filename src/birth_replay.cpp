@@ -0,0 +1,51 @@
+// src/birth_replay.cpp
+#include "sparkplug/birth_replay.hpp"
+
+#include "sparkplug/token_bucket.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sparkplug::detail {
+
+BirthReplayer::~BirthReplayer() {
+  stop();
+}
+
+void BirthReplayer::start(size_t births, SendNext send_next) {
+  stop();
+  if (births == 0) {
+    return;
+  }
+
+  thread_.start(
+      [this, births, send_next = std::move(send_next)](const WorkerThread::Run& worker) {
+        run(worker, births, send_next);
+      });
+}
+
+void BirthReplayer::stop() {
+  thread_.stop();
+}
+
+void BirthReplayer::run(const WorkerThread::Run& worker, size_t births,
+                        const SendNext& send_next) {
+  // Whatever the burst does not cover is spread evenly over the window
+  std::chrono::duration<double> window = config_.window;
+  double rate = static_cast<double>(births) / std::max(window.count(), 1e-3);
+  TokenBucket budget(rate, static_cast<double>(std::max<size_t>(config_.burst, 1)));
+
+  while (true) {
+    if (worker.wait_for(budget.acquire(1.0))) {
+      return;
+    }
+
+    auto send_lock = lock_sends();
+    auto sent = send_next();
+    if (!sent || !*sent) {
+      return;
+    }
+  }
+}
+
+} // namespace sparkplug::detail
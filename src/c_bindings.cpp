@@ -4,9 +4,12 @@
 #include "sparkplug/payload_builder.hpp"
 #include "sparkplug/sparkplug_c.h"
 
+#include <algorithm>
 #include <cstring>
 #include <format>
 #include <memory>
+#include <span>
+#include <utility>
 
 struct sparkplug_publisher {
   sparkplug::EdgeNode impl;
@@ -17,9 +20,11 @@ struct sparkplug_subscriber {
   std::string default_group_id;
   sparkplug_message_callback_t callback;
   sparkplug_command_callback_t command_callback;
+  sparkplug_payload_callback_t payload_callback;
   sparkplug_log_callback_t log_callback;
   void* user_data;
   void* command_user_data;
+  void* payload_user_data;
   void* log_user_data;
   std::mutex callback_mutex;
 };
@@ -32,6 +37,136 @@ struct sparkplug_host_application {
   sparkplug::HostApplication impl;
 };
 
+// sparkplug_payload_view_t is never defined: a view is the address of the borrowed Payload
+static const sparkplug_payload_view_t*
+as_view(const org::eclipse::tahu::protobuf::Payload& payload) {
+  return reinterpret_cast<const sparkplug_payload_view_t*>(&payload);
+}
+
+static const org::eclipse::tahu::protobuf::Payload&
+from_view(const sparkplug_payload_view_t* view) {
+  return *reinterpret_cast<const org::eclipse::tahu::protobuf::Payload*>(view);
+}
+
+// Backs the sparkplug_payload_add_*_array_by_alias() family (timestamp 0 = payload timestamp)
+template <sparkplug::SparkplugMetricType T>
+static void add_metric_array_by_alias(sparkplug_payload_t* payload, const uint64_t* aliases,
+                                      const T* values, size_t count, uint64_t timestamp) {
+  if (!payload || count == 0 || !aliases || !values) {
+    return;
+  }
+  std::span<const uint64_t> alias_span(aliases, count);
+  std::span<const T> value_span(values, count);
+  if (timestamp != 0) {
+    payload->impl.add_metrics_by_alias(alias_span, value_span, timestamp);
+  } else {
+    payload->impl.add_metrics_by_alias(alias_span, value_span,
+                                       payload->impl.payload().timestamp());
+  }
+}
+
+// Readers shared by the sparkplug_payload_get_* and sparkplug_payload_view_get_* functions
+static bool get_payload_timestamp(const org::eclipse::tahu::protobuf::Payload& payload,
+                                  uint64_t* out_timestamp) {
+  if (payload.has_timestamp()) {
+    *out_timestamp = payload.timestamp();
+    return true;
+  }
+  return false;
+}
+
+static bool get_payload_seq(const org::eclipse::tahu::protobuf::Payload& payload,
+                            uint64_t* out_seq) {
+  if (payload.has_seq()) {
+    *out_seq = payload.seq();
+    return true;
+  }
+  return false;
+}
+
+static const char* get_payload_uuid(const org::eclipse::tahu::protobuf::Payload& payload) {
+  return payload.has_uuid() ? payload.uuid().c_str() : nullptr;
+}
+
+static bool get_payload_metric_at(const org::eclipse::tahu::protobuf::Payload& payload,
+                                  size_t index, sparkplug_metric_t* out_metric) {
+  if (index >= static_cast<size_t>(payload.metrics_size())) {
+    return false;
+  }
+
+  const auto& metric = payload.metrics(static_cast<int>(index));
+
+  // Clear the output struct
+  std::memset(out_metric, 0, sizeof(sparkplug_metric_t));
+
+  // Set name
+  out_metric->has_name = metric.has_name();
+  out_metric->name = out_metric->has_name ? metric.name().c_str() : nullptr;
+
+  // Set alias
+  out_metric->has_alias = metric.has_alias();
+  out_metric->alias = out_metric->has_alias ? metric.alias() : 0;
+
+  // Set timestamp
+  out_metric->has_timestamp = metric.has_timestamp();
+  out_metric->timestamp = out_metric->has_timestamp ? metric.timestamp() : 0;
+
+  // Set is_null
+  out_metric->is_null = metric.has_is_null() ? metric.is_null() : false;
+
+  // Set datatype
+  out_metric->datatype =
+      static_cast<sparkplug_data_type_t>(metric.has_datatype() ? metric.datatype() : 0);
+
+  // Set value based on datatype (only if not null)
+  if (!out_metric->is_null) {
+    switch (out_metric->datatype) {
+    case SPARKPLUG_DATA_TYPE_INT8:
+    case SPARKPLUG_DATA_TYPE_INT16:
+    case SPARKPLUG_DATA_TYPE_INT32:
+      out_metric->value.int32_value = static_cast<int32_t>(metric.int_value());
+      break;
+
+    case SPARKPLUG_DATA_TYPE_INT64:
+      out_metric->value.int64_value = static_cast<int64_t>(metric.long_value());
+      break;
+
+    case SPARKPLUG_DATA_TYPE_UINT8:
+    case SPARKPLUG_DATA_TYPE_UINT16:
+    case SPARKPLUG_DATA_TYPE_UINT32:
+      out_metric->value.uint32_value = static_cast<uint32_t>(metric.int_value());
+      break;
+
+    case SPARKPLUG_DATA_TYPE_UINT64:
+      out_metric->value.uint64_value = static_cast<uint64_t>(metric.long_value());
+      break;
+
+    case SPARKPLUG_DATA_TYPE_FLOAT:
+      out_metric->value.float_value = metric.float_value();
+      break;
+
+    case SPARKPLUG_DATA_TYPE_DOUBLE:
+      out_metric->value.double_value = metric.double_value();
+      break;
+
+    case SPARKPLUG_DATA_TYPE_BOOLEAN:
+      out_metric->value.boolean_value = metric.boolean_value();
+      break;
+
+    case SPARKPLUG_DATA_TYPE_STRING:
+    case SPARKPLUG_DATA_TYPE_TEXT:
+      out_metric->value.string_value = metric.string_value().c_str();
+      break;
+
+    default:
+      // Unsupported type - leave value uninitialized
+      break;
+    }
+  }
+
+  return true;
+}
+
 static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
                                     const org::eclipse::tahu::protobuf::Payload& proto_payload,
                                     bool copy_seq = true) {
@@ -54,7 +189,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
     case sparkplug::DataType::Int8:
     case sparkplug::DataType::Int16:
     case sparkplug::DataType::Int32:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, static_cast<int32_t>(metric.int_value()));
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, static_cast<int32_t>(metric.int_value()));
@@ -64,7 +199,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
       break;
 
     case sparkplug::DataType::Int64:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, metric.long_value());
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, metric.long_value());
@@ -76,7 +211,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
     case sparkplug::DataType::UInt8:
     case sparkplug::DataType::UInt16:
     case sparkplug::DataType::UInt32:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, static_cast<uint32_t>(metric.int_value()));
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, static_cast<uint32_t>(metric.int_value()));
@@ -86,7 +221,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
       break;
 
     case sparkplug::DataType::UInt64:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, static_cast<uint64_t>(metric.long_value()));
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, static_cast<uint64_t>(metric.long_value()));
@@ -96,7 +231,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
       break;
 
     case sparkplug::DataType::Float:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, metric.float_value());
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, metric.float_value());
@@ -106,7 +241,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
       break;
 
     case sparkplug::DataType::Double:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, metric.double_value());
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, metric.double_value());
@@ -116,7 +251,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
       break;
 
     case sparkplug::DataType::Boolean:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, metric.boolean_value());
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, metric.boolean_value());
@@ -127,7 +262,7 @@ static void copy_metrics_to_builder(sparkplug::PayloadBuilder& builder,
 
     case sparkplug::DataType::String:
     case sparkplug::DataType::Text:
-      if (alias.has_value() && std::string(name).empty()) {
+      if (alias.has_value() && name[0] == '\0') {
         builder.add_metric_by_alias(*alias, metric.string_value());
       } else if (alias.has_value()) {
         builder.add_metric_with_alias(name, *alias, metric.string_value());
@@ -240,6 +375,22 @@ int sparkplug_publisher_publish_data(sparkplug_publisher_t* pub, const uint8_t*
   return pub->impl.publish_data(builder).has_value() ? 0 : -1;
 }
 
+int sparkplug_publisher_publish_birth_payload(sparkplug_publisher_t* pub,
+                                              sparkplug_payload_t* payload) {
+  if (!pub || !payload)
+    return -1;
+  return pub->impl.publish_birth(payload->impl).has_value() ? 0 : -1;
+}
+
+int sparkplug_publisher_publish_data_payload(sparkplug_publisher_t* pub,
+                                             sparkplug_payload_t* payload) {
+  if (!pub || !payload)
+    return -1;
+  // Like the serialized variant, a seq already in the payload is replaced
+  payload->impl.clear_seq();
+  return pub->impl.publish_data(payload->impl).has_value() ? 0 : -1;
+}
+
 int sparkplug_publisher_publish_death(sparkplug_publisher_t* pub) {
   if (!pub)
     return -1;
@@ -252,6 +403,12 @@ int sparkplug_publisher_rebirth(sparkplug_publisher_t* pub) {
   return pub->impl.rebirth().has_value() ? 0 : -1;
 }
 
+int sparkplug_publisher_rebirth_in_session(sparkplug_publisher_t* pub) {
+  if (!pub)
+    return -1;
+  return pub->impl.rebirth(sparkplug::RebirthMode::InSession).has_value() ? 0 : -1;
+}
+
 uint64_t sparkplug_publisher_get_seq(const sparkplug_publisher_t* pub) {
   if (!pub)
     return 0;
@@ -296,6 +453,23 @@ int sparkplug_publisher_publish_device_data(sparkplug_publisher_t* pub, const ch
   return pub->impl.publish_device_data(device_id, builder).has_value() ? 0 : -1;
 }
 
+int sparkplug_publisher_publish_device_birth_payload(sparkplug_publisher_t* pub,
+                                                     const char* device_id,
+                                                     sparkplug_payload_t* payload) {
+  if (!pub || !device_id || !payload)
+    return -1;
+  return pub->impl.publish_device_birth(device_id, payload->impl).has_value() ? 0 : -1;
+}
+
+int sparkplug_publisher_publish_device_data_payload(sparkplug_publisher_t* pub,
+                                                    const char* device_id,
+                                                    sparkplug_payload_t* payload) {
+  if (!pub || !device_id || !payload)
+    return -1;
+  payload->impl.clear_seq();
+  return pub->impl.publish_device_data(device_id, payload->impl).has_value() ? 0 : -1;
+}
+
 int sparkplug_publisher_publish_device_death(sparkplug_publisher_t* pub, const char* device_id) {
   if (!pub || !device_id)
     return -1;
@@ -356,9 +530,11 @@ sparkplug_subscriber_t* sparkplug_subscriber_create(const char* broker_url, cons
   sub->default_group_id = group_id;
   sub->callback = callback;
   sub->command_callback = nullptr;
+  sub->payload_callback = nullptr;
   sub->log_callback = nullptr;
   sub->user_data = user_data;
   sub->command_user_data = nullptr;
+  sub->payload_user_data = nullptr;
   sub->log_user_data = nullptr;
 
   sparkplug::LogCallback log_wrapper = [sub](sparkplug::LogLevel level, std::string_view message) {
@@ -371,15 +547,20 @@ sparkplug_subscriber_t* sparkplug_subscriber_create(const char* broker_url, cons
 
   sparkplug::MessageCallback message_handler =
       [sub](const sparkplug::Topic& topic, const org::eclipse::tahu::protobuf::Payload& payload) {
-        std::vector<uint8_t> data(payload.ByteSizeLong());
-        payload.SerializeToArray(data.data(), static_cast<int>(data.size()));
-
         auto topic_str = topic.to_string();
 
         std::lock_guard<std::mutex> lock(sub->callback_mutex);
-        if ((topic.message_type == sparkplug::MessageType::NCMD ||
-             topic.message_type == sparkplug::MessageType::DCMD) &&
-            sub->command_callback) {
+        bool is_command = (topic.message_type == sparkplug::MessageType::NCMD ||
+                           topic.message_type == sparkplug::MessageType::DCMD) &&
+                          sub->command_callback;
+        if (!is_command && sub->payload_callback) {
+          sub->payload_callback(topic_str.c_str(), as_view(payload), sub->payload_user_data);
+          return;
+        }
+
+        std::vector<uint8_t> data(payload.ByteSizeLong());
+        payload.SerializeToArray(data.data(), static_cast<int>(data.size()));
+        if (is_command) {
           sub->command_callback(topic_str.c_str(), data.data(), data.size(),
                                 sub->command_user_data);
         } else {
@@ -496,6 +677,18 @@ void sparkplug_subscriber_set_command_callback(sparkplug_subscriber_t* sub,
   sub->command_user_data = user_data;
 }
 
+void sparkplug_subscriber_set_payload_callback(sparkplug_subscriber_t* sub,
+                                               sparkplug_payload_callback_t callback,
+                                               void* user_data) {
+  if (!sub || !sub->impl) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(sub->callback_mutex);
+  sub->payload_callback = callback;
+  sub->payload_user_data = user_data;
+}
+
 int sparkplug_subscriber_get_metric_name(sparkplug_subscriber_t* sub, const char* group_id,
                                          const char* edge_node_id, const char* device_id,
                                          uint64_t alias, char* name_buffer, size_t buffer_size) {
@@ -525,6 +718,69 @@ int sparkplug_subscriber_get_metric_name(sparkplug_subscriber_t* sub, const char
   return static_cast<int>(name->size() + 1);
 }
 
+// ============================================================================
+// Statistics Functions
+// ============================================================================
+
+static_assert(SPARKPLUG_MESSAGE_TYPE_COUNT == sparkplug::MESSAGE_TYPE_COUNT);
+static_assert(SPARKPLUG_HISTOGRAM_BUCKETS == sparkplug::LatencyHistogram::BUCKETS);
+static_assert(SPARKPLUG_MESSAGE_TYPE_STATE == std::to_underlying(sparkplug::MessageType::STATE));
+
+static void copy_histogram(const sparkplug::LatencyHistogram& histogram,
+                           sparkplug_histogram_t& out) {
+  std::copy(histogram.buckets.begin(), histogram.buckets.end(), out.buckets);
+  out.count = histogram.count;
+  out.sum_ns = histogram.sum_ns;
+  out.max_ns = histogram.max_ns;
+}
+
+static void copy_stats(const sparkplug::Stats& stats, sparkplug_stats_t& out) {
+  std::copy(stats.messages_in.begin(), stats.messages_in.end(), out.messages_in);
+  std::copy(stats.messages_out.begin(), stats.messages_out.end(), out.messages_out);
+  out.bytes_in = stats.bytes_in;
+  out.bytes_out = stats.bytes_out;
+  out.parse_failures = stats.parse_failures;
+  out.publish_failures = stats.publish_failures;
+  out.seq_gaps = stats.seq_gaps;
+  out.bd_seq_mismatches = stats.bd_seq_mismatches;
+  out.payloads_skipped = stats.payloads_skipped;
+  out.in_flight = stats.in_flight;
+  out.rebirth_requests = stats.rebirth_requests;
+  out.dropped_awaiting_birth = stats.dropped_awaiting_birth;
+  copy_histogram(stats.publish_latency, out.publish_latency);
+  copy_histogram(stats.callback_duration, out.callback_duration);
+}
+
+uint64_t sparkplug_histogram_bucket_upper_bound_us(size_t bucket) {
+  return sparkplug::LatencyHistogram::upper_bound_us(bucket);
+}
+
+int sparkplug_publisher_get_stats(const sparkplug_publisher_t* pub, sparkplug_stats_t* out_stats) {
+  if (!pub || !out_stats) {
+    return -1;
+  }
+  copy_stats(pub->impl.stats(), *out_stats);
+  return 0;
+}
+
+int sparkplug_subscriber_get_stats(const sparkplug_subscriber_t* sub,
+                                   sparkplug_stats_t* out_stats) {
+  if (!sub || !sub->impl || !out_stats) {
+    return -1;
+  }
+  copy_stats(sub->impl->stats(), *out_stats);
+  return 0;
+}
+
+int sparkplug_host_application_get_stats(const sparkplug_host_application_t* host,
+                                         sparkplug_stats_t* out_stats) {
+  if (!host || !out_stats) {
+    return -1;
+  }
+  copy_stats(host->impl.stats(), *out_stats);
+  return 0;
+}
+
 // ============================================================================
 // Payload Functions
 // ============================================================================
@@ -537,6 +793,12 @@ void sparkplug_payload_destroy(sparkplug_payload_t* payload) {
   delete payload;
 }
 
+void sparkplug_payload_reset(sparkplug_payload_t* payload) {
+  if (payload) {
+    payload->impl.reset();
+  }
+}
+
 void sparkplug_payload_set_timestamp(sparkplug_payload_t* payload, uint64_t ts) {
   if (payload) {
     payload->impl.set_timestamp(ts);
@@ -696,18 +958,63 @@ void sparkplug_payload_add_bool_by_alias(sparkplug_payload_t* payload, uint64_t
     payload->impl.add_metric_by_alias(alias, value);
 }
 
+// Bulk metric functions by alias only
+
+void sparkplug_payload_add_int32_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const int32_t* values,
+                                                size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_int64_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const int64_t* values,
+                                                size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_uint32_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const uint32_t* values,
+                                                 size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_uint64_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const uint64_t* values,
+                                                 size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_float_array_by_alias(sparkplug_payload_t* payload,
+                                                const uint64_t* aliases, const float* values,
+                                                size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_double_array_by_alias(sparkplug_payload_t* payload,
+                                                 const uint64_t* aliases, const double* values,
+                                                 size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+void sparkplug_payload_add_bool_array_by_alias(sparkplug_payload_t* payload,
+                                               const uint64_t* aliases, const bool* values,
+                                               size_t count, uint64_t timestamp) {
+  add_metric_array_by_alias(payload, aliases, values, count, timestamp);
+}
+
+size_t sparkplug_payload_serialized_size(const sparkplug_payload_t* payload) {
+  if (!payload)
+    return 0;
+  return payload->impl.serialized_size();
+}
+
 size_t sparkplug_payload_serialize(const sparkplug_payload_t* payload, uint8_t* buffer,
                                    size_t buffer_size) {
   if (!payload || !buffer)
     return 0;
 
-  auto data = payload->impl.build();
-  if (data.size() > buffer_size) {
-    return 0;
-  }
-
-  std::memcpy(buffer, data.data(), data.size());
-  return data.size();
+  auto written = payload->impl.build_into(std::span<uint8_t>(buffer, buffer_size));
+  return written ? *written : 0;
 }
 
 // ============================================================================
@@ -718,14 +1025,21 @@ sparkplug_payload_t* sparkplug_payload_parse(const uint8_t* data, size_t data_le
   if (!data || data_len == 0)
     return nullptr;
 
-  org::eclipse::tahu::protobuf::Payload proto_payload;
+  // Parse in place rather than copying metric by metric, which loses metric timestamps
+  auto* payload = new sparkplug_payload{sparkplug::PayloadBuilder()};
+  auto& proto_payload = payload->impl.mutable_payload();
   if (!proto_payload.ParseFromArray(data, static_cast<int>(data_len))) {
+    delete payload;
     return nullptr;
   }
 
-  // Create a new payload and copy the parsed data
-  auto* payload = new sparkplug_payload{sparkplug::PayloadBuilder()};
-  copy_metrics_to_builder(payload->impl, proto_payload);
+  // Keep the builder's explicitly-set flags in line with the parsed fields
+  if (proto_payload.has_timestamp()) {
+    payload->impl.set_timestamp(proto_payload.timestamp());
+  }
+  if (proto_payload.has_seq()) {
+    payload->impl.set_seq(proto_payload.seq());
+  }
 
   return payload;
 }
@@ -733,130 +1047,64 @@ sparkplug_payload_t* sparkplug_payload_parse(const uint8_t* data, size_t data_le
 bool sparkplug_payload_get_timestamp(const sparkplug_payload_t* payload, uint64_t* out_timestamp) {
   if (!payload || !out_timestamp)
     return false;
-
-  auto& proto_payload = const_cast<sparkplug_payload_t*>(payload)->impl.mutable_payload();
-  if (proto_payload.has_timestamp()) {
-    *out_timestamp = proto_payload.timestamp();
-    return true;
-  }
-
-  return false;
+  return get_payload_timestamp(payload->impl.payload(), out_timestamp);
 }
 
 bool sparkplug_payload_get_seq(const sparkplug_payload_t* payload, uint64_t* out_seq) {
   if (!payload || !out_seq)
     return false;
-
-  auto& proto_payload = const_cast<sparkplug_payload_t*>(payload)->impl.mutable_payload();
-  if (proto_payload.has_seq()) {
-    *out_seq = proto_payload.seq();
-    return true;
-  }
-
-  return false;
+  return get_payload_seq(payload->impl.payload(), out_seq);
 }
 
 const char* sparkplug_payload_get_uuid(const sparkplug_payload_t* payload) {
   if (!payload)
     return nullptr;
-
-  auto& proto_payload = const_cast<sparkplug_payload_t*>(payload)->impl.mutable_payload();
-  if (proto_payload.has_uuid()) {
-    return proto_payload.uuid().c_str();
-  }
-
-  return nullptr;
+  return get_payload_uuid(payload->impl.payload());
 }
 
 size_t sparkplug_payload_get_metric_count(const sparkplug_payload_t* payload) {
   if (!payload)
     return 0;
-
-  auto& proto_payload = const_cast<sparkplug_payload_t*>(payload)->impl.mutable_payload();
-  return static_cast<size_t>(proto_payload.metrics_size());
+  return static_cast<size_t>(payload->impl.payload().metrics_size());
 }
 
 bool sparkplug_payload_get_metric_at(const sparkplug_payload_t* payload, size_t index,
                                      sparkplug_metric_t* out_metric) {
   if (!payload || !out_metric)
     return false;
+  return get_payload_metric_at(payload->impl.payload(), index, out_metric);
+}
 
-  auto& proto_payload = const_cast<sparkplug_payload_t*>(payload)->impl.mutable_payload();
-  if (index >= static_cast<size_t>(proto_payload.metrics_size())) {
+bool sparkplug_payload_view_get_timestamp(const sparkplug_payload_view_t* payload,
+                                          uint64_t* out_timestamp) {
+  if (!payload || !out_timestamp)
     return false;
-  }
-
-  const auto& metric = proto_payload.metrics(static_cast<int>(index));
-
-  // Clear the output struct
-  std::memset(out_metric, 0, sizeof(sparkplug_metric_t));
-
-  // Set name
-  out_metric->has_name = metric.has_name();
-  out_metric->name = out_metric->has_name ? metric.name().c_str() : nullptr;
-
-  // Set alias
-  out_metric->has_alias = metric.has_alias();
-  out_metric->alias = out_metric->has_alias ? metric.alias() : 0;
-
-  // Set timestamp
-  out_metric->has_timestamp = metric.has_timestamp();
-  out_metric->timestamp = out_metric->has_timestamp ? metric.timestamp() : 0;
-
-  // Set is_null
-  out_metric->is_null = metric.has_is_null() ? metric.is_null() : false;
-
-  // Set datatype
-  out_metric->datatype =
-      static_cast<sparkplug_data_type_t>(metric.has_datatype() ? metric.datatype() : 0);
-
-  // Set value based on datatype (only if not null)
-  if (!out_metric->is_null) {
-    switch (out_metric->datatype) {
-    case SPARKPLUG_DATA_TYPE_INT8:
-    case SPARKPLUG_DATA_TYPE_INT16:
-    case SPARKPLUG_DATA_TYPE_INT32:
-      out_metric->value.int32_value = static_cast<int32_t>(metric.int_value());
-      break;
-
-    case SPARKPLUG_DATA_TYPE_INT64:
-      out_metric->value.int64_value = static_cast<int64_t>(metric.long_value());
-      break;
-
-    case SPARKPLUG_DATA_TYPE_UINT8:
-    case SPARKPLUG_DATA_TYPE_UINT16:
-    case SPARKPLUG_DATA_TYPE_UINT32:
-      out_metric->value.uint32_value = static_cast<uint32_t>(metric.int_value());
-      break;
-
-    case SPARKPLUG_DATA_TYPE_UINT64:
-      out_metric->value.uint64_value = static_cast<uint64_t>(metric.long_value());
-      break;
-
-    case SPARKPLUG_DATA_TYPE_FLOAT:
-      out_metric->value.float_value = metric.float_value();
-      break;
-
-    case SPARKPLUG_DATA_TYPE_DOUBLE:
-      out_metric->value.double_value = metric.double_value();
-      break;
+  return get_payload_timestamp(from_view(payload), out_timestamp);
+}
 
-    case SPARKPLUG_DATA_TYPE_BOOLEAN:
-      out_metric->value.boolean_value = metric.boolean_value();
-      break;
+bool sparkplug_payload_view_get_seq(const sparkplug_payload_view_t* payload, uint64_t* out_seq) {
+  if (!payload || !out_seq)
+    return false;
+  return get_payload_seq(from_view(payload), out_seq);
+}
 
-    case SPARKPLUG_DATA_TYPE_STRING:
-    case SPARKPLUG_DATA_TYPE_TEXT:
-      out_metric->value.string_value = metric.string_value().c_str();
-      break;
+const char* sparkplug_payload_view_get_uuid(const sparkplug_payload_view_t* payload) {
+  if (!payload)
+    return nullptr;
+  return get_payload_uuid(from_view(payload));
+}
 
-    default:
-      // Unsupported type - leave value uninitialized
-      break;
-    }
-  }
+size_t sparkplug_payload_view_get_metric_count(const sparkplug_payload_view_t* payload) {
+  if (!payload)
+    return 0;
+  return static_cast<size_t>(from_view(payload).metrics_size());
+}
 
-  return true;
+bool sparkplug_payload_view_get_metric_at(const sparkplug_payload_view_t* payload, size_t index,
+                                          sparkplug_metric_t* out_metric) {
+  if (!payload || !out_metric)
+    return false;
+  return get_payload_metric_at(from_view(payload), index, out_metric);
 }
 
 /* ============================================================================
@@ -1041,6 +1289,32 @@ int sparkplug_host_application_set_message_callback(sparkplug_host_application_t
   }
 }
 
+int sparkplug_host_application_set_payload_callback(sparkplug_host_application_t* host,
+                                                    sparkplug_payload_callback_t callback,
+                                                    void* user_data) {
+  if (!host) {
+    return -1;
+  }
+
+  try {
+    if (callback) {
+      auto cpp_callback = [callback,
+                           user_data](const sparkplug::Topic& topic,
+                                      const org::eclipse::tahu::protobuf::Payload& payload) {
+        std::string topic_str = topic.to_string();
+        callback(topic_str.c_str(), as_view(payload), user_data);
+      };
+
+      host->impl.set_message_callback(std::move(cpp_callback));
+    } else {
+      host->impl.set_message_callback({});
+    }
+    return 0;
+  } catch (...) {
+    return -1;
+  }
+}
+
 void sparkplug_host_application_set_log_callback(sparkplug_host_application_t* host,
                                                  sparkplug_log_callback_t callback,
                                                  void* user_data) {
@@ -0,0 +1,218 @@
+// src/columnar.cpp
+#include "sparkplug/columnar.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace sparkplug {
+
+namespace {
+
+using Payload = org::eclipse::tahu::protobuf::Payload;
+using DataSetValue = Payload::DataSet::DataSetValue;
+
+constexpr double NULL_VALUE = std::numeric_limits<double>::quiet_NaN();
+
+enum class ColumnKind { Numeric, String, Other };
+
+ColumnKind column_kind(DataType type) {
+  switch (type) {
+  case DataType::Int8:
+  case DataType::Int16:
+  case DataType::Int32:
+  case DataType::Int64:
+  case DataType::UInt8:
+  case DataType::UInt16:
+  case DataType::UInt32:
+  case DataType::UInt64:
+  case DataType::Float:
+  case DataType::Double:
+  case DataType::Boolean:
+  case DataType::DateTime:
+    return ColumnKind::Numeric;
+  case DataType::String:
+  case DataType::Text:
+  case DataType::UUID:
+    return ColumnKind::String;
+  default:
+    return ColumnKind::Other;
+  }
+}
+
+// Signed types are sign-extended from the 32-bit int_value, as metric_value_from_proto() does
+double dataset_value_as_double(const DataSetValue& element, DataType type) {
+  switch (element.value_case()) {
+  case DataSetValue::kIntValue:
+    switch (type) {
+    case DataType::Int8:
+      return static_cast<int8_t>(element.int_value());
+    case DataType::Int16:
+      return static_cast<int16_t>(element.int_value());
+    case DataType::Int32:
+      return static_cast<int32_t>(element.int_value());
+    default:
+      return element.int_value();
+    }
+  case DataSetValue::kLongValue:
+    return type == DataType::Int64 ? static_cast<double>(static_cast<int64_t>(element.long_value()))
+                                   : static_cast<double>(element.long_value());
+  case DataSetValue::kFloatValue:
+    return element.float_value();
+  case DataSetValue::kDoubleValue:
+    return element.double_value();
+  case DataSetValue::kBooleanValue:
+    return element.boolean_value() ? 1.0 : 0.0;
+  default:
+    return NULL_VALUE;
+  }
+}
+
+// Returns false for metrics that have no numeric value (strings, DataSets, Templates, ...)
+bool metric_as_double(const Payload::Metric& metric, double& out) {
+  auto type = metric.has_datatype() ? static_cast<DataType>(metric.datatype()) : DataType::Unknown;
+  if (metric.has_is_null() && metric.is_null()) {
+    out = NULL_VALUE;
+    return type == DataType::Unknown || column_kind(type) == ColumnKind::Numeric;
+  }
+
+  switch (metric.value_case()) {
+  case Payload::Metric::kIntValue:
+    switch (type) {
+    case DataType::Int8:
+      out = static_cast<int8_t>(metric.int_value());
+      break;
+    case DataType::Int16:
+      out = static_cast<int16_t>(metric.int_value());
+      break;
+    case DataType::Int32:
+      out = static_cast<int32_t>(metric.int_value());
+      break;
+    default:
+      out = metric.int_value();
+      break;
+    }
+    return true;
+  case Payload::Metric::kLongValue:
+    out = type == DataType::Int64 ? static_cast<double>(static_cast<int64_t>(metric.long_value()))
+                                  : static_cast<double>(metric.long_value());
+    return true;
+  case Payload::Metric::kFloatValue:
+    out = metric.float_value();
+    return true;
+  case Payload::Metric::kDoubleValue:
+    out = metric.double_value();
+    return true;
+  case Payload::Metric::kBooleanValue:
+    out = metric.boolean_value() ? 1.0 : 0.0;
+    return true;
+  default:
+    return false;
+  }
+}
+
+int32_t metric_quality(const Payload::Metric& metric, bool is_null) {
+  if (metric.has_properties()) {
+    const auto& properties = metric.properties();
+    for (int i = 0; i < properties.keys_size() && i < properties.values_size(); i++) {
+      if (properties.keys(i) == "Quality" && properties.values(i).has_int_value()) {
+        return static_cast<int32_t>(properties.values(i).int_value());
+      }
+    }
+  }
+  return is_null ? QUALITY_BAD : QUALITY_GOOD;
+}
+
+// Makes room for extra more entries, at least doubling the capacity when it has to grow, so
+// appending many payloads to one batch stays amortized linear
+template <typename T> void reserve_additional(std::vector<T>& column, size_t extra) {
+  auto needed = column.size() + extra;
+  if (needed > column.capacity()) {
+    column.reserve(std::max(needed, 2 * column.capacity()));
+  }
+}
+
+} // namespace
+
+std::expected<void, std::string> decode_dataset(const Payload::DataSet& dataset,
+                                                DecodedDataSet& out) {
+  auto column_count = std::max<size_t>(dataset.num_of_columns(), dataset.columns_size());
+  const auto& rows = dataset.rows();
+  out.row_count = static_cast<size_t>(rows.size());
+
+  out.columns.resize(column_count);
+  for (size_t c = 0; c < column_count; c++) {
+    auto& column = out.columns[c];
+    auto index = static_cast<int>(c);
+    if (index < dataset.columns_size()) {
+      column.name.assign(dataset.columns(index));
+    } else {
+      column.name.clear();
+    }
+    column.type = index < dataset.types_size() ? static_cast<DataType>(dataset.types(index))
+                                               : DataType::Unknown;
+    column.values.clear();
+    column.strings.clear();
+    switch (column_kind(column.type)) {
+    case ColumnKind::Numeric:
+      column.values.resize(out.row_count);
+      break;
+    case ColumnKind::String:
+      column.strings.resize(out.row_count);
+      break;
+    case ColumnKind::Other:
+      break;
+    }
+  }
+
+  for (int r = 0; r < rows.size(); r++) {
+    const auto& elements = rows[r].elements();
+    if (static_cast<size_t>(elements.size()) != column_count) {
+      return std::unexpected(std::format("DataSet row {} has {} elements, expected {}", r,
+                                         elements.size(), column_count));
+    }
+    for (size_t c = 0; c < column_count; c++) {
+      auto& column = out.columns[c];
+      const auto& element = elements[static_cast<int>(c)];
+      switch (column_kind(column.type)) {
+      case ColumnKind::Numeric:
+        if (element.has_string_value()) {
+          return std::unexpected(
+              std::format("DataSet row {} holds a string in numeric column '{}'", r, column.name));
+        }
+        column.values[r] = dataset_value_as_double(element, column.type);
+        break;
+      case ColumnKind::String:
+        column.strings[r].assign(element.string_value());
+        break;
+      case ColumnKind::Other:
+        break;
+      }
+    }
+  }
+  return {};
+}
+
+size_t decode_metrics(const Payload& payload, MetricColumns& out) {
+  auto before = out.size();
+  auto extra = static_cast<size_t>(payload.metrics_size());
+  reserve_additional(out.aliases, extra);
+  reserve_additional(out.timestamps, extra);
+  reserve_additional(out.values, extra);
+  reserve_additional(out.quality, extra);
+
+  for (const auto& metric : payload.metrics()) {
+    double value;
+    if (!metric.has_alias() || !metric_as_double(metric, value)) {
+      continue;
+    }
+    bool is_null = metric.has_is_null() && metric.is_null();
+    out.aliases.push_back(metric.alias());
+    out.timestamps.push_back(metric.has_timestamp() ? metric.timestamp() : payload.timestamp());
+    out.values.push_back(value);
+    out.quality.push_back(metric_quality(metric, is_null));
+  }
+  return out.size() - before;
+}
+
+} // namespace sparkplug
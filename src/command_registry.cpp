@@ -0,0 +1,85 @@
+// src/command_registry.cpp
+#include "sparkplug/command_registry.hpp"
+
+namespace sparkplug::detail {
+
+size_t CommandRegistry::store(std::optional<size_t> existing, CommandHandler handler) {
+  if (existing) {
+    handlers_[*existing] = std::move(handler);
+    return *existing;
+  }
+  handlers_.push_back(std::move(handler));
+  return handlers_.size() - 1;
+}
+
+void CommandRegistry::add(std::string_view name, CommandHandler handler) {
+  auto index = store(find(name), std::move(handler));
+  by_name_.insert_or_assign(std::string(name), index);
+}
+
+void CommandRegistry::add(uint64_t alias, CommandHandler handler) {
+  by_alias_[alias] = store(find(alias), std::move(handler));
+}
+
+std::optional<size_t> CommandRegistry::find(std::string_view name) const noexcept {
+  auto it = by_name_.find(name);
+  if (it == by_name_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::optional<size_t> CommandRegistry::find(uint64_t alias) const noexcept {
+  auto it = by_alias_.find(alias);
+  if (it == by_alias_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void CommandRegistry::resolve(const org::eclipse::tahu::protobuf::Payload& birth,
+                              CommandAliases& aliases) const {
+  aliases.clear();
+  if (by_name_.empty()) {
+    return;
+  }
+  for (const auto& metric : birth.metrics()) {
+    if (!metric.has_name() || !metric.has_alias()) {
+      continue;
+    }
+    if (auto index = find(metric.name())) {
+      aliases[metric.alias()] = *index;
+    }
+  }
+}
+
+SignalledTask::~SignalledTask() {
+  stop();
+}
+
+void SignalledTask::signal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  thread_.notify([this] { pending_ = true; });
+  // Already running after the first signal, which then just picks up pending_
+  thread_.start([this](const WorkerThread::Run& worker) { run(worker); });
+}
+
+void SignalledTask::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  thread_.notify([this] { pending_ = false; });
+  thread_.stop();
+}
+
+void SignalledTask::run(const WorkerThread::Run& worker) {
+  while (!worker.wait([this] { return std::exchange(pending_, false); })) {
+    task_();
+  }
+}
+
+} // namespace sparkplug::detail
@@ -0,0 +1,146 @@
+// src/compression.cpp
+#include "sparkplug/compression.hpp"
+
+#include "sparkplug/datatype.hpp"
+#include "sparkplug/wire_format.hpp"
+
+#include <algorithm>
+#include <format>
+#include <utility>
+
+#include <zlib.h>
+
+namespace sparkplug {
+
+namespace {
+
+constexpr std::string_view ALGORITHM_METRIC = "algorithm";
+
+// zlib windowBits selecting the stream format: 15 = zlib header, 16 + 15 = gzip header
+int window_bits(CompressionAlgorithm algorithm) {
+  return algorithm == CompressionAlgorithm::Gzip ? 16 + MAX_WBITS : MAX_WBITS;
+}
+
+std::string_view algorithm_name(CompressionAlgorithm algorithm) {
+  return algorithm == CompressionAlgorithm::Gzip ? "GZIP" : "DEFLATE";
+}
+
+std::expected<std::string, std::string> deflate_bytes(std::span<const uint8_t> input,
+                                                      CompressionAlgorithm algorithm, int level) {
+  z_stream stream{};
+  if (deflateInit2(&stream, level, Z_DEFLATED, window_bits(algorithm), 8, Z_DEFAULT_STRATEGY) !=
+      Z_OK) {
+    return std::unexpected("Failed to initialize compressor");
+  }
+
+  std::string output(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+  stream.next_in = const_cast<Bytef*>(input.data());
+  stream.avail_in = static_cast<uInt>(input.size());
+  stream.next_out = reinterpret_cast<Bytef*>(output.data());
+  stream.avail_out = static_cast<uInt>(output.size());
+
+  int rc = deflate(&stream, Z_FINISH);
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (rc != Z_STREAM_END) {
+    return std::unexpected(std::format("Compression failed: {}", rc));
+  }
+  return output;
+}
+
+} // namespace
+
+std::expected<void, std::string> compress_payload(std::span<const uint8_t> payload,
+                                                  CompressionAlgorithm algorithm,
+                                                  std::vector<uint8_t>& out, int level) {
+  if (algorithm == CompressionAlgorithm::None) {
+    return std::unexpected("No compression algorithm selected");
+  }
+
+  // The wrapper repeats timestamp and seq so hosts can track sequence without inflating it
+  detail::wire::PayloadHeader header;
+  if (!detail::wire::scan_payload(payload, header)) {
+    return std::unexpected("Invalid Sparkplug B payload");
+  }
+
+  auto body = deflate_bytes(payload, algorithm, level);
+  if (!body) {
+    return std::unexpected(std::move(body.error()));
+  }
+
+  org::eclipse::tahu::protobuf::Payload wrapper;
+  if (header.timestamp) {
+    wrapper.set_timestamp(*header.timestamp);
+  }
+  if (header.seq) {
+    wrapper.set_seq(*header.seq);
+  }
+  wrapper.set_uuid(std::string(COMPRESSED_PAYLOAD_UUID));
+  auto* metric = wrapper.add_metrics();
+  metric->set_name(std::string(ALGORITHM_METRIC));
+  metric->set_datatype(std::to_underlying(DataType::String));
+  metric->set_string_value(std::string(algorithm_name(algorithm)));
+  wrapper.set_body(std::move(*body));
+
+  out.resize(wrapper.ByteSizeLong());
+  wrapper.SerializeWithCachedSizesToArray(out.data());
+  return {};
+}
+
+std::expected<void, std::string>
+decompress_payload(const org::eclipse::tahu::protobuf::Payload& wrapper, std::vector<uint8_t>& out,
+                   size_t max_size) {
+  auto algorithm = CompressionAlgorithm::Deflate;
+  for (const auto& metric : wrapper.metrics()) {
+    if (metric.name() != ALGORITHM_METRIC) {
+      continue;
+    }
+    if (metric.string_value() == "GZIP") {
+      algorithm = CompressionAlgorithm::Gzip;
+    } else if (metric.string_value() != "DEFLATE") {
+      return std::unexpected(
+          std::format("Unsupported compression algorithm '{}'", metric.string_value()));
+    }
+    break;
+  }
+
+  z_stream stream{};
+  if (inflateInit2(&stream, window_bits(algorithm)) != Z_OK) {
+    return std::unexpected("Failed to initialize decompressor");
+  }
+
+  const auto& body = wrapper.body();
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(body.data()));
+  stream.avail_in = static_cast<uInt>(body.size());
+
+  // Grow geometrically from a guess of 4x, never past max_size + 1 (to detect overflow)
+  out.resize(std::min(max_size + 1, std::max<size_t>(body.size() * 4, 256)));
+  int rc = Z_OK;
+  while (true) {
+    stream.next_out = out.data() + stream.total_out;
+    stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+    rc = inflate(&stream, Z_NO_FLUSH);
+    if (rc != Z_OK || stream.total_out > max_size) {
+      break;
+    }
+    if (stream.avail_out == 0) {
+      if (out.size() > max_size) {
+        break;
+      }
+      out.resize(std::min(max_size + 1, out.size() * 2));
+    }
+  }
+  size_t produced = stream.total_out;
+  inflateEnd(&stream);
+
+  if (produced > max_size) {
+    return std::unexpected(std::format("Decompressed payload exceeds {} bytes", max_size));
+  }
+  if (rc != Z_STREAM_END) {
+    return std::unexpected(std::format("Decompression failed: {}", rc));
+  }
+  out.resize(produced);
+  return {};
+}
+
+} // namespace sparkplug
@@ -1,11 +1,15 @@
 // src/edge_node.cpp
 #include "sparkplug/edge_node.hpp"
+#include "sparkplug/parse_arena.hpp"
+#include "sparkplug/wire_format.hpp"
 
+#include <cmath>
 #include <cstring>
 #include <format>
 #include <future>
 #include <thread>
 #include <utility>
+#include <variant>
 
 #include <MQTTAsync.h>
 
@@ -17,39 +21,210 @@ constexpr int DISCONNECT_TIMEOUT_MS = 11000;
 constexpr int SUBSCRIBE_TIMEOUT_MS = 5000;
 constexpr uint64_t SEQ_NUMBER_MAX = 256;
 
-void on_connect_success(void* context, MQTTAsync_successData* response) {
-  (void)response;
-  auto* promise = static_cast<std::promise<void>*>(context);
-  promise->set_value();
+// Initial block of the per-thread arena that received NCMD/DCMD payloads are parsed into
+constexpr size_t COMMAND_ARENA_BLOCK_SIZE = 16 * 1024;
+
+// Node controls answered by the library with Config::handle_node_control
+constexpr std::string_view REBIRTH_METRIC = "Node Control/Rebirth";
+constexpr std::string_view SCAN_RATE_METRIC = "Node Control/Scan Rate";
+
+// Rate in ms carried by a Scan Rate metric (Int64 by convention, Int32 accepted)
+int64_t command_rate(const org::eclipse::tahu::protobuf::Payload::Metric& metric) {
+  return metric.has_long_value() ? static_cast<int64_t>(metric.long_value())
+                                 : static_cast<int32_t>(metric.int_value());
 }
 
-void on_connect_failure(void* context, MQTTAsync_failureData* response) {
-  auto* promise = static_cast<std::promise<void>*>(context);
-  auto error = std::format("Connection failed: code={}", response ? response->code : -1);
-  promise->set_exception(std::make_exception_ptr(std::runtime_error(error)));
+// Upper bound on the payload timestamp and seq fields of a backfill NDATA/DDATA
+constexpr size_t BACKFILL_HEADER_BYTES = 2 * (1 + detail::wire::MAX_VARINT_SIZE);
+
+// Per-thread serialization buffer for NDATA/DDATA. Paho copies the payload when the
+// message is queued, so the capacity can be reused by the next publish on this thread.
+std::vector<uint8_t>& publish_scratch_buffer() {
+  thread_local std::vector<uint8_t> buffer;
+  return buffer;
 }
 
-void on_disconnect_success(void* context, MQTTAsync_successData* response) {
-  (void)response;
-  auto* promise = static_cast<std::promise<void>*>(context);
-  promise->set_value();
+// Per-thread buffer for compressed payloads, reused like publish_scratch_buffer()
+std::vector<uint8_t>& compress_scratch_buffer() {
+  thread_local std::vector<uint8_t> buffer;
+  return buffer;
 }
 
-void on_disconnect_failure(void* context, MQTTAsync_failureData* response) {
-  auto* promise = static_cast<std::promise<void>*>(context);
-  auto error = std::format("Disconnect failed: code={}", response ? response->code : -1);
-  promise->set_exception(std::make_exception_ptr(std::runtime_error(error)));
+// True if current differs from previous by more than the deadband (Float/Double only)
+bool value_changed(const MetricValue& previous, const MetricValue& current, double deadband) {
+  if (deadband > 0.0) {
+    if (const auto* prev = std::get_if<double>(&previous)) {
+      if (const auto* cur = std::get_if<double>(&current)) {
+        return std::abs(*cur - *prev) > deadband;
+      }
+    }
+    if (const auto* prev = std::get_if<float>(&previous)) {
+      if (const auto* cur = std::get_if<float>(&current)) {
+        return std::abs(static_cast<double>(*cur) - static_cast<double>(*prev)) > deadband;
+      }
+    }
+  }
+  return previous != current;
+}
+
+using ValueUpdates = std::vector<std::pair<uint64_t, MetricValue>>;
+
+// Copies the metrics of snapshot that differ from the published cache into delta. The new
+// values are returned so the cache can be updated once the publish has succeeded.
+ValueUpdates select_changed_metrics(const AliasRegistry& published,
+                                    const std::unordered_map<uint64_t, double>& deadbands,
+                                    const org::eclipse::tahu::protobuf::Payload& snapshot,
+                                    org::eclipse::tahu::protobuf::Payload& delta) {
+  ValueUpdates updates;
+  for (const auto& metric : snapshot.metrics()) {
+    const AliasRegistry::Entry* entry =
+        metric.has_alias() ? published.find(metric.alias()) : nullptr;
+    if (!entry) {
+      *delta.add_metrics() = metric;
+      continue;
+    }
+
+    auto value = metric_value_from_proto(metric, entry->datatype);
+    auto deadband_it = deadbands.find(metric.alias());
+    double deadband = deadband_it != deadbands.end() ? deadband_it->second : 0.0;
+    if (value_changed(entry->value, value, deadband)) {
+      *delta.add_metrics() = metric;
+      updates.emplace_back(metric.alias(), std::move(value));
+    }
+  }
+  return updates;
+}
+
+void apply_value_updates(AliasRegistry& published, ValueUpdates&& updates) {
+  for (auto& [alias, value] : updates) {
+    if (auto* entry = published.find(alias)) {
+      entry->value = std::move(value);
+    }
+  }
+}
+
+// Per-thread copy of a device's DDATA topic, taken while the device table is locked
+std::string& publish_scratch_topic() {
+  thread_local std::string topic;
+  return topic;
+}
+
+// Cached birth certificates are patched on the wire, without a parse/serialize round trip
+using namespace detail::wire;
+
+// Writes metric to patched with its long_value replaced, if it is the bdSeq metric
+bool patch_bdseq_metric(std::span<const uint8_t> metric, uint64_t bd_seq,
+                        std::vector<uint8_t>& patched) {
+  bool is_bdseq = false;
+  size_t value_begin = 0;
+  size_t value_end = 0;
+
+  size_t pos = 0;
+  while (pos < metric.size()) {
+    uint64_t tag = 0;
+    if (!read_varint(metric, pos, tag)) {
+      return false;
+    }
+    size_t field_begin = pos;
+    if (!skip_field(metric, pos, tag & 7)) {
+      return false;
+    }
+    if (tag == ((METRIC_NAME_FIELD << 3) | WIRE_LENGTH)) {
+      size_t name_pos = field_begin;
+      uint64_t length = 0;
+      read_varint(metric, name_pos, length);
+      auto name = metric.subspan(name_pos, length);
+      is_bdseq = std::string_view(reinterpret_cast<const char*>(name.data()), name.size()) ==
+                 "bdSeq";
+    } else if (tag == ((METRIC_LONG_VALUE_FIELD << 3) | WIRE_VARINT)) {
+      value_begin = field_begin;
+      value_end = pos;
+    }
+  }
+
+  if (!is_bdseq || value_end == 0) {
+    return false;
+  }
+
+  patched.clear();
+  append_bytes(patched, metric.first(value_begin));
+  append_varint(patched, bd_seq);
+  append_bytes(patched, metric.subspan(value_end));
+  return true;
+}
+
+struct PayloadPatch {
+  std::optional<uint64_t> timestamp; // Kept as serialized when unset
+  std::optional<uint64_t> seq;
+  std::optional<uint64_t> bd_seq; // NBIRTH only
+};
+
+// Copies a serialized payload into out with timestamp, seq and bdSeq replaced where set.
+// Fields are copied verbatim otherwise; returns false if the bytes are not a valid payload.
+bool patch_payload(std::span<const uint8_t> payload, const PayloadPatch& patch,
+                   std::vector<uint8_t>& out) {
+  out.clear();
+  out.reserve(payload.size() + 16);
+  std::vector<uint8_t> metric_scratch;
+
+  size_t pos = 0;
+  while (pos < payload.size()) {
+    size_t field_begin = pos;
+    uint64_t tag = 0;
+    if (!read_varint(payload, pos, tag)) {
+      return false;
+    }
+
+    if ((patch.timestamp && tag == ((PAYLOAD_TIMESTAMP_FIELD << 3) | WIRE_VARINT)) ||
+        (patch.seq && tag == ((PAYLOAD_SEQ_FIELD << 3) | WIRE_VARINT))) {
+      // Dropped here and re-appended below; protobuf accepts fields in any order
+      if (!skip_field(payload, pos, WIRE_VARINT)) {
+        return false;
+      }
+      continue;
+    }
+
+    if (!skip_field(payload, pos, tag & 7)) {
+      return false;
+    }
+
+    if (patch.bd_seq && tag == ((PAYLOAD_METRICS_FIELD << 3) | WIRE_LENGTH)) {
+      size_t metric_pos = field_begin;
+      uint64_t unused = 0;
+      read_varint(payload, metric_pos, unused); // tag
+      read_varint(payload, metric_pos, unused); // length
+      auto metric = payload.subspan(metric_pos, pos - metric_pos);
+      if (patch_bdseq_metric(metric, *patch.bd_seq, metric_scratch)) {
+        append_varint(out, tag);
+        append_varint(out, metric_scratch.size());
+        append_bytes(out, metric_scratch);
+        continue;
+      }
+    }
+
+    append_bytes(out, payload.subspan(field_begin, pos - field_begin));
+  }
+
+  if (patch.timestamp) {
+    append_varint(out, (PAYLOAD_TIMESTAMP_FIELD << 3) | WIRE_VARINT);
+    append_varint(out, *patch.timestamp);
+  }
+  if (patch.seq) {
+    append_varint(out, (PAYLOAD_SEQ_FIELD << 3) | WIRE_VARINT);
+    append_varint(out, *patch.seq);
+  }
+  return true;
 }
 
-void on_subscribe_success(void* context, MQTTAsync_successData* response) {
+void on_disconnect_success(void* context, MQTTAsync_successData* response) {
   (void)response;
   auto* promise = static_cast<std::promise<void>*>(context);
   promise->set_value();
 }
 
-void on_subscribe_failure(void* context, MQTTAsync_failureData* response) {
+void on_disconnect_failure(void* context, MQTTAsync_failureData* response) {
   auto* promise = static_cast<std::promise<void>*>(context);
-  auto error = std::format("Subscribe failed: code={}", response ? response->code : -1);
+  auto error = std::format("Disconnect failed: code={}", response ? response->code : -1);
   promise->set_exception(std::make_exception_ptr(std::runtime_error(error)));
 }
 
@@ -61,53 +236,134 @@ void EdgeNode::on_connection_lost(void* context, char* cause) {
     return;
   }
 
+  bool was_connected = false;
   {
     std::lock_guard<std::mutex> lock(edge_node->mutex_);
-    edge_node->is_connected_ = false;
+    was_connected = edge_node->is_connected_.exchange(false);
+  }
+
+  if (was_connected && edge_node->connection_lost_hook_) {
+    edge_node->connection_lost_hook_();
+  } else if (was_connected && edge_node->config_.reconnect.enabled && edge_node->reconnector_) {
+    edge_node->reconnector_->start([edge_node]() { return edge_node->reconnect_and_replay(); });
   }
 
   (void)cause;
 }
 
+std::expected<void, std::string> EdgeNode::reconnect_and_replay() {
+  auto result = connect();
+  if (!result) {
+    return result;
+  }
+
+  bool has_birth = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    has_birth = !last_birth_payload_.empty();
+  }
+
+  // connect() started a new session with a new bdSeq, which the replayed NBIRTH must carry
+  return has_birth ? rebirth_in_session() : result;
+}
+
 MQTTAsyncHandle::~MQTTAsyncHandle() noexcept {
   reset();
 }
 
 void MQTTAsyncHandle::reset() noexcept {
   if (client_) {
+    MQTTAsync client = client_;
     MQTTAsync_destroy(&client_);
     client_ = nullptr;
+    detail::abandon_async_publishes(client);
   }
 }
 
 EdgeNode::EdgeNode(Config config) : config_(std::move(config)) {
   will_opts_ = MQTTAsync_willOptions_initializer;
+
+  auto node_topic = [this](MessageType type) {
+    return Topic{.group_id = config_.group_id,
+                 .message_type = type,
+                 .edge_node_id = config_.edge_node_id,
+                 .device_id = ""}
+        .to_string();
+  };
+  birth_topic_str_ = node_topic(MessageType::NBIRTH);
+  data_topic_str_ = node_topic(MessageType::NDATA);
+  death_topic_str_ = node_topic(MessageType::NDEATH);
+
+  publish_window_ = std::make_shared<PublishWindow>(config_.publish_window);
+  stats_ = std::make_shared<detail::StatsRecorder>();
+  names_ = std::make_shared<StringInterner>();
+  reconnector_ = std::make_unique<detail::Reconnector>(config_.reconnect);
+  if (config_.store_forward.enabled) {
+    store_forward_ = std::make_unique<detail::ForwardQueue>(config_.store_forward);
+  }
+  // One full payload of burst, so an idle link starts a backfill without waiting
+  backfill_budget_ = TokenBucket(static_cast<double>(config_.backfill.bytes_per_second),
+                                 static_cast<double>(config_.backfill.max_payload_bytes));
+  if (config_.birth_replay.window.count() > 0) {
+    birth_replay_ = std::make_unique<detail::BirthReplayer>(config_.birth_replay);
+  }
+  if (config_.handle_node_control) {
+    node_control_ = std::make_unique<detail::SignalledTask>([this] { run_node_control(); });
+  }
+}
+
+EdgeNode::DeviceTopics EdgeNode::make_device_topics(std::string_view device_id) const {
+  auto device_topic = [this, device_id](MessageType type) {
+    return Topic{.group_id = config_.group_id,
+                 .message_type = type,
+                 .edge_node_id = config_.edge_node_id,
+                 .device_id = std::string(device_id)}
+        .to_string();
+  };
+  return DeviceTopics{.birth = device_topic(MessageType::DBIRTH),
+                      .data = device_topic(MessageType::DDATA),
+                      .death = device_topic(MessageType::DDEATH)};
 }
 
 int EdgeNode::on_message_arrived(void* context, char* topicName, int topicLen,
                                  MQTTAsync_message* message) {
   auto* edge_node = static_cast<EdgeNode*>(context);
 
-  std::string topic_str;
-  if (topicLen > 0) {
-    topic_str = std::string(topicName, static_cast<size_t>(topicLen));
-  } else {
-    topic_str = std::string(topicName);
-  }
+  std::string_view topic_str = topicLen > 0
+                                   ? std::string_view(topicName, static_cast<size_t>(topicLen))
+                                   : std::string_view(topicName);
 
-  auto topic_result = Topic::parse(topic_str);
-  if (!topic_result) {
+  auto topic_view = TopicView::parse(topic_str);
+  if (!topic_view) {
     MQTTAsync_freeMessage(&message);
     MQTTAsync_free(topicName);
     return 1;
   }
 
-  const auto& topic = topic_result.value();
-
-  if (topic.message_type == MessageType::NCMD && edge_node->config_.command_callback) {
-    org::eclipse::tahu::protobuf::Payload payload;
-    if (payload.ParseFromArray(message->payload, message->payloadlen)) {
-      edge_node->config_.command_callback.value()(topic, payload);
+  auto& stats = *edge_node->stats_;
+  stats.record_in(topic_view->message_type, static_cast<size_t>(message->payloadlen));
+
+  bool is_ncmd = topic_view->message_type == MessageType::NCMD;
+  bool is_dcmd = topic_view->message_type == MessageType::DCMD;
+  bool has_callback = is_ncmd && edge_node->config_.command_callback;
+  bool has_handlers = is_dcmd || (is_ncmd && (!edge_node->node_commands_.empty() ||
+                                              edge_node->config_.handle_node_control));
+  if (has_callback || has_handlers) {
+    detail::ArenaLease arena_lease(COMMAND_ARENA_BLOCK_SIZE);
+    auto* payload = arena_lease.create_payload();
+    if (payload->ParseFromArray(message->payload, message->payloadlen)) {
+      auto started = std::chrono::steady_clock::now();
+      if (has_handlers) {
+        edge_node->dispatch_commands(is_dcmd ? topic_view->device_id : std::string_view{},
+                                     *payload);
+      }
+      // Only the legacy callback needs an owning Topic
+      if (has_callback) {
+        edge_node->config_.command_callback.value()(topic_view->to_topic(), *payload);
+      }
+      stats.record_callback_duration(std::chrono::steady_clock::now() - started);
+    } else {
+      stats.record_parse_failure();
     }
   }
 
@@ -117,6 +373,19 @@ int EdgeNode::on_message_arrived(void* context, char* topicName, int topicLen,
 }
 
 EdgeNode::~EdgeNode() {
+  abandon_connect();
+  if (node_control_) {
+    node_control_->stop();
+  }
+  if (reconnector_) {
+    reconnector_->stop();
+  }
+  if (store_forward_) {
+    store_forward_->stop();
+  }
+  if (birth_replay_) {
+    birth_replay_->stop();
+  }
   if (client_ && is_connected_) {
     (void)disconnect();
   } else if (client_) {
@@ -126,32 +395,128 @@ EdgeNode::~EdgeNode() {
 
 EdgeNode::EdgeNode(EdgeNode&& other) noexcept
     : config_(std::move(other.config_)), client_(std::move(other.client_)),
-      seq_num_(other.seq_num_), bd_seq_num_(other.bd_seq_num_),
+      published_client_(other.published_client_.exchange(nullptr, std::memory_order_acq_rel)),
+      seq_num_(other.seq_num_.load()), bd_seq_num_(other.bd_seq_num_.load()),
+      birth_topic_str_(std::move(other.birth_topic_str_)),
+      data_topic_str_(std::move(other.data_topic_str_)),
       death_payload_data_(std::move(other.death_payload_data_)),
-      last_birth_payload_(std::move(other.last_birth_payload_)),
-      device_states_(std::move(other.device_states_)), is_connected_(other.is_connected_)
-// mutex_ is default-constructed (mutexes are not moveable)
+      death_topic_str_(std::move(other.death_topic_str_)),
+      last_birth_payload_(std::move(other.last_birth_payload_)), names_(other.names_),
+      published_values_(std::move(other.published_values_)),
+      deadbands_(std::move(other.deadbands_)),
+      publish_window_(std::move(other.publish_window_)),
+      stats_(std::exchange(other.stats_, detail::StatsRecorder::detached())),
+      device_states_(std::move(other.device_states_)),
+      pending_births_(std::move(other.pending_births_)), is_connected_(other.is_connected_.load()),
+      reconnector_(std::make_unique<detail::Reconnector>(config_.reconnect)),
+      store_forward_(std::move(other.store_forward_)), backfill_budget_(other.backfill_budget_),
+      node_commands_(std::move(other.node_commands_)),
+      device_commands_(std::move(other.device_commands_)),
+      node_command_aliases_(std::move(other.node_command_aliases_)),
+      rebirth_alias_(other.rebirth_alias_), scan_rate_alias_(other.scan_rate_alias_),
+      scan_rate_ms_(other.scan_rate_ms_.load())
+// mutex_ and backfill_mutex_ are default-constructed (mutexes are not moveable)
 {
+  // A pending connect, retry, drain or birth replay of other refers to other, so it is
+  // cancelled rather than moved. Buffered frames move with the queue and are drained after this
+  // node's next birth; queued DBIRTHs are sent ahead of their device's next DDATA.
+  other.abandon_connect();
+  if (other.reconnector_) {
+    other.reconnector_->stop();
+  }
+  if (other.birth_replay_) {
+    other.birth_replay_->stop();
+  }
+  if (other.node_control_) {
+    other.node_control_->stop();
+  }
+  if (config_.birth_replay.window.count() > 0) {
+    birth_replay_ = std::make_unique<detail::BirthReplayer>(config_.birth_replay);
+  }
+  if (config_.handle_node_control) {
+    node_control_ = std::make_unique<detail::SignalledTask>([this] { run_node_control(); });
+  }
+  if (store_forward_) {
+    store_forward_->stop();
+  }
   std::lock_guard<std::mutex> lock(other.mutex_);
   other.is_connected_ = false;
 }
 
 EdgeNode& EdgeNode::operator=(EdgeNode&& other) noexcept {
   if (this != &other) {
+    abandon_connect();
+    other.abandon_connect();
+    if (reconnector_) {
+      reconnector_->stop();
+    }
+    if (other.reconnector_) {
+      other.reconnector_->stop();
+    }
+    if (store_forward_) {
+      store_forward_->stop();
+    }
+    if (other.store_forward_) {
+      other.store_forward_->stop();
+    }
+    if (birth_replay_) {
+      birth_replay_->stop();
+    }
+    if (other.birth_replay_) {
+      other.birth_replay_->stop();
+    }
+    if (node_control_) {
+      node_control_->stop();
+    }
+    if (other.node_control_) {
+      other.node_control_->stop();
+    }
+
+    MQTTAsyncHandle previous; // Destroyed once both locks are released
+
     // Lock both mutexes in consistent order to avoid deadlock
     std::lock(mutex_, other.mutex_);
     std::lock_guard<std::mutex> lock1(mutex_, std::adopt_lock);
     std::lock_guard<std::mutex> lock2(other.mutex_, std::adopt_lock);
 
     config_ = std::move(other.config_);
-    client_ = std::move(other.client_);
-    seq_num_ = other.seq_num_;
-    bd_seq_num_ = other.bd_seq_num_;
+    previous = std::exchange(client_, std::move(other.client_));
+    published_client_.store(client_.get(), std::memory_order_release);
+    other.published_client_.store(nullptr, std::memory_order_release);
+    seq_num_ = other.seq_num_.load();
+    bd_seq_num_ = other.bd_seq_num_.load();
+    birth_topic_str_ = std::move(other.birth_topic_str_);
+    data_topic_str_ = std::move(other.data_topic_str_);
     death_payload_data_ = std::move(other.death_payload_data_);
+    death_topic_str_ = std::move(other.death_topic_str_);
     last_birth_payload_ = std::move(other.last_birth_payload_);
+    published_values_ = std::move(other.published_values_);
+    deadbands_ = std::move(other.deadbands_);
+    publish_window_ = std::move(other.publish_window_);
+    stats_ = std::exchange(other.stats_, detail::StatsRecorder::detached());
     device_states_ = std::move(other.device_states_);
-    is_connected_ = other.is_connected_;
+    names_ = other.names_; // After every entry holding handles into the old pool is replaced
+    pending_births_ = std::move(other.pending_births_);
+    is_connected_ = other.is_connected_.load();
     other.is_connected_ = false;
+    reconnector_ = std::make_unique<detail::Reconnector>(config_.reconnect);
+    store_forward_ = std::move(other.store_forward_);
+    backfill_budget_ = other.backfill_budget_;
+    birth_replay_ = config_.birth_replay.window.count() > 0
+                        ? std::make_unique<detail::BirthReplayer>(config_.birth_replay)
+                        : nullptr;
+    node_commands_ = std::move(other.node_commands_);
+    device_commands_ = std::move(other.device_commands_);
+    node_command_aliases_ = std::move(other.node_command_aliases_);
+    rebirth_alias_ = other.rebirth_alias_;
+    scan_rate_alias_ = other.scan_rate_alias_;
+    scan_rate_ms_ = other.scan_rate_ms_.load();
+    rebirth_requested_ = false;
+    scan_rate_changed_ = false;
+    node_control_ =
+        config_.handle_node_control
+            ? std::make_unique<detail::SignalledTask>([this] { run_node_control(); })
+            : nullptr;
   }
   return *this;
 }
@@ -168,7 +533,67 @@ void EdgeNode::set_tls(std::optional<TlsOptions> tls) {
   config_.tls = std::move(tls);
 }
 
+// Owned by Paho from MQTTAsync_connect until the session is established or fails
+struct EdgeNode::ConnectContext {
+  std::shared_ptr<detail::ConnectAttempt<EdgeNode>> attempt;
+  ConnectCallback on_complete;
+  bool dcmd_pending{false}; // DCMD is subscribed after NCMD
+};
+
+void EdgeNode::abandon_connect() {
+  std::shared_ptr<detail::ConnectAttempt<EdgeNode>> attempt;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    attempt = std::move(connect_attempt_);
+  }
+  if (attempt) {
+    attempt->abandon();
+  }
+}
+
 std::expected<void, std::string> EdgeNode::connect() {
+  // Shared with the completion callback, which may still run after a timeout here
+  auto promise = std::make_shared<std::promise<std::expected<void, std::string>>>();
+  auto future = promise->get_future();
+
+  auto started = connect_async([promise](std::expected<void, std::string> result) {
+    promise->set_value(std::move(result));
+  });
+  if (!started) {
+    return started;
+  }
+
+  auto status =
+      future.wait_for(std::chrono::milliseconds(CONNECTION_TIMEOUT_MS + SUBSCRIBE_TIMEOUT_MS));
+  if (status == std::future_status::timeout) {
+    // A late answer must not mark the node connected after the caller was told it failed
+    abandon_connect();
+    return std::unexpected("Connection timeout");
+  }
+
+  return future.get();
+}
+
+std::expected<void, std::string> EdgeNode::connect_async(ConnectCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
+  }
+
+  // Created on the first connect so a bad spill path is reported here
+  if (store_forward_) {
+    if (auto result = store_forward_->open(); !result) {
+      return result;
+    }
+  }
+
+  // An earlier attempt still waiting for the broker is superseded by this one
+  abandon_connect();
+
+  // A replaced client is destroyed after the lock is released: async completions of its
+  // abandoned messages may publish again
+  MQTTAsyncHandle previous;
+
+  // Held only while the client and options are prepared, never while the broker answers
   std::lock_guard<std::mutex> lock(mutex_);
 
   MQTTAsync raw_client = nullptr;
@@ -177,7 +602,8 @@ std::expected<void, std::string> EdgeNode::connect() {
   if (rc != MQTTASYNC_SUCCESS) {
     return std::unexpected(std::format("Failed to create client: {}", rc));
   }
-  client_ = MQTTAsyncHandle(raw_client);
+  previous = std::exchange(client_, MQTTAsyncHandle(raw_client));
+  published_client_.store(raw_client, std::memory_order_release);
 
   // Set callbacks (MUST be called after creating client but before connecting)
   // Note: Paho requires message_arrived callback to be non-null, so always pass it
@@ -191,7 +617,7 @@ std::expected<void, std::string> EdgeNode::connect() {
 
   // Prepare NDEATH payload BEFORE connecting
   PayloadBuilder death_payload;
-  death_payload.add_metric("bdSeq", bd_seq_num_);
+  death_payload.add_metric("bdSeq", bd_seq_num_.load());
   death_payload_data_ = death_payload.build();
 
   MQTTAsync_connectOptions conn_opts = MQTTAsync_connectOptions_initializer;
@@ -223,13 +649,7 @@ std::expected<void, std::string> EdgeNode::connect() {
   // Initialize will options as member variable (must outlive async connect)
   will_opts_ = MQTTAsync_willOptions_initializer;
 
-  Topic death_topic{.group_id = config_.group_id,
-                    .message_type = MessageType::NDEATH,
-                    .edge_node_id = config_.edge_node_id,
-                    .device_id = ""};
-
-  // Store as member variable to keep string alive for async MQTT operations
-  death_topic_str_ = death_topic.to_string();
+  // death_topic_str_ is a member, so it outlives the async connect
   will_opts_.topicName = death_topic_str_.c_str();
 
   // Use payload.data/len for binary protobuf data
@@ -240,10 +660,11 @@ std::expected<void, std::string> EdgeNode::connect() {
 
   conn_opts.will = &will_opts_;
 
-  std::promise<void> connect_promise;
-  auto connect_future = connect_promise.get_future();
+  connect_attempt_ = std::make_shared<detail::ConnectAttempt<EdgeNode>>(this);
+  auto ctx = std::make_unique<ConnectContext>(
+      ConnectContext{.attempt = connect_attempt_, .on_complete = std::move(on_complete)});
 
-  conn_opts.context = &connect_promise;
+  conn_opts.context = ctx.get();
   conn_opts.onSuccess = on_connect_success;
   conn_opts.onFailure = on_connect_failure;
 
@@ -252,56 +673,116 @@ std::expected<void, std::string> EdgeNode::connect() {
     return std::unexpected(std::format("Failed to connect: {}", rc));
   }
 
-  auto status = connect_future.wait_for(std::chrono::milliseconds(CONNECTION_TIMEOUT_MS));
-  if (status == std::future_status::timeout) {
-    return std::unexpected("Connection timeout");
-  }
+  // Paho now owns the context and frees it through the completion callbacks
+  (void)ctx.release();
+  return {};
+}
 
-  try {
-    connect_future.get();
-  } catch (const std::exception& e) {
-    return std::unexpected(e.what());
+void EdgeNode::on_connect_success(void* context, MQTTAsync_successData* response) {
+  (void)response;
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  // Kept here: once the subscription is queued, Paho may free ctx before the lock is released
+  auto attempt = ctx->attempt;
+  std::expected<void, std::string> result;
+  {
+    std::lock_guard<std::mutex> lock(attempt->mutex);
+    auto* node = attempt->owner;
+    if (!node) {
+      result = std::unexpected("Connection attempt abandoned");
+    } else {
+      bool ncmd = node->config_.command_callback.has_value() || !node->node_commands_.empty() ||
+                  node->config_.handle_node_control;
+      ctx->dcmd_pending = !node->device_commands_.empty();
+      if (!ncmd && !ctx->dcmd_pending) {
+        node->is_connected_.store(true, std::memory_order_release);
+      } else {
+        result = subscribe_commands(*node, *ctx, ncmd ? MessageType::NCMD : MessageType::DCMD);
+        if (result) {
+          (void)ctx.release();
+          return;
+        }
+      }
+    }
   }
+  // Outside the lock, so the callback may destroy the node or start another connect
+  ctx->on_complete(std::move(result));
+}
 
-  is_connected_ = true;
-
-  if (config_.command_callback.has_value()) {
-    Topic ncmd_topic{.group_id = config_.group_id,
-                     .message_type = MessageType::NCMD,
-                     .edge_node_id = config_.edge_node_id,
-                     .device_id = ""};
-
-    auto ncmd_topic_str = ncmd_topic.to_string();
+std::expected<void, std::string>
+EdgeNode::subscribe_commands(EdgeNode& node, ConnectContext& ctx, MessageType type) {
+  if (type == MessageType::DCMD) {
+    ctx.dcmd_pending = false;
+  }
 
-    std::promise<void> subscribe_promise;
-    auto subscribe_future = subscribe_promise.get_future();
+  // DCMD is subscribed for every device of this node with a single-level wildcard
+  Topic topic{.group_id = node.config_.group_id,
+              .message_type = type,
+              .edge_node_id = node.config_.edge_node_id,
+              .device_id = type == MessageType::DCMD ? "+" : ""};
+  auto topic_str = topic.to_string();
 
-    MQTTAsync_responseOptions sub_opts = MQTTAsync_responseOptions_initializer;
-    sub_opts.context = &subscribe_promise;
-    sub_opts.onSuccess = on_subscribe_success;
-    sub_opts.onFailure = on_subscribe_failure;
+  // The session is only reported as established once commands are subscribed (before NBIRTH)
+  MQTTAsync_responseOptions sub_opts = MQTTAsync_responseOptions_initializer;
+  sub_opts.context = &ctx;
+  sub_opts.onSuccess = on_subscribe_success;
+  sub_opts.onFailure = on_subscribe_failure;
 
-    rc = MQTTAsync_subscribe(client_.get(), ncmd_topic_str.c_str(), 1, &sub_opts);
-    if (rc != MQTTASYNC_SUCCESS) {
-      return std::unexpected(std::format("Failed to subscribe to NCMD: {}", rc));
-    }
+  int rc = MQTTAsync_subscribe(node.current_client(), topic_str.c_str(), 1, &sub_opts);
+  if (rc != MQTTASYNC_SUCCESS) {
+    return std::unexpected(std::format("Failed to subscribe to {}: {}",
+                                       type == MessageType::DCMD ? "DCMD" : "NCMD", rc));
+  }
+  return {};
+}
 
-    auto sub_status = subscribe_future.wait_for(std::chrono::milliseconds(SUBSCRIBE_TIMEOUT_MS));
-    if (sub_status == std::future_status::timeout) {
-      return std::unexpected("NCMD subscription timeout");
-    }
+void EdgeNode::on_connect_failure(void* context, MQTTAsync_failureData* response) {
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  ctx->on_complete(
+      std::unexpected(std::format("Connection failed: code={}", response ? response->code : -1)));
+}
 
-    try {
-      subscribe_future.get();
-    } catch (const std::exception& e) {
-      return std::unexpected(std::format("NCMD subscription failed: {}", e.what()));
+void EdgeNode::on_subscribe_success(void* context, MQTTAsync_successData* response) {
+  (void)response;
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  auto attempt = ctx->attempt;
+  std::expected<void, std::string> result;
+  {
+    std::lock_guard<std::mutex> lock(attempt->mutex);
+    auto* node = attempt->owner;
+    if (!node) {
+      result = std::unexpected("Connection attempt abandoned");
+    } else if (ctx->dcmd_pending) {
+      result = subscribe_commands(*node, *ctx, MessageType::DCMD);
+      if (result) {
+        (void)ctx.release();
+        return;
+      }
+    } else {
+      // Publishers only see the session once every command subscription is in place
+      node->is_connected_.store(true, std::memory_order_release);
     }
   }
+  ctx->on_complete(std::move(result));
+}
 
-  return {};
+void EdgeNode::on_subscribe_failure(void* context, MQTTAsync_failureData* response) {
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  ctx->on_complete(std::unexpected(std::format("Command subscription failed: code={}",
+                                               response ? response->code : -1)));
 }
 
 std::expected<void, std::string> EdgeNode::disconnect() {
+  // An explicit disconnect cancels any pending automatic reconnect, drain and birth replay
+  if (reconnector_) {
+    reconnector_->stop();
+  }
+  if (store_forward_) {
+    store_forward_->stop();
+  }
+  if (birth_replay_) {
+    birth_replay_->stop();
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
 
   if (!client_) {
@@ -337,13 +818,29 @@ std::expected<void, std::string> EdgeNode::disconnect() {
   return {};
 }
 
-std::expected<void, std::string> EdgeNode::publish_message(MQTTAsync client,
+std::span<const uint8_t> EdgeNode::compress_for_publish(std::span<const uint8_t> payload_data) {
+  const auto& compression = config_.compression;
+  if (compression.algorithm == CompressionAlgorithm::None ||
+      payload_data.size() < compression.min_payload_bytes) {
+    return payload_data;
+  }
+
+  auto& compressed = compress_scratch_buffer();
+  if (!compress_payload(payload_data, compression.algorithm, compressed, compression.level) ||
+      compressed.size() >= payload_data.size()) {
+    return payload_data; // Incompressible: the original is smaller
+  }
+  return compressed;
+}
+
+std::expected<void, std::string> EdgeNode::publish_message(MessageType type, MQTTAsync client,
                                                            const std::string& topic_str,
                                                            std::span<const uint8_t> payload_data,
                                                            int qos, bool retain) {
   if (!client) {
     return std::unexpected("Not connected");
   }
+  payload_data = compress_for_publish(payload_data);
 
   MQTTAsync_message msg = MQTTAsync_message_initializer;
   msg.payload = const_cast<void*>(reinterpret_cast<const void*>(payload_data.data()));
@@ -355,9 +852,11 @@ std::expected<void, std::string> EdgeNode::publish_message(MQTTAsync client,
 
   int rc = MQTTAsync_sendMessage(client, topic_str.c_str(), &msg, &opts);
   if (rc != MQTTASYNC_SUCCESS) {
+    stats_->record_publish_failure();
     return std::unexpected(std::format("Failed to publish: {}", rc));
   }
 
+  stats_->record_out(type, payload_data.size());
   return {};
 }
 
@@ -390,21 +889,16 @@ std::expected<void, std::string> EdgeNode::publish_birth(PayloadBuilder& payload
       auto* metric = proto_payload.add_metrics();
       metric->set_name("bdSeq");
       metric->set_datatype(std::to_underlying(DataType::UInt64));
-      metric->set_long_value(bd_seq_num_);
+      metric->set_long_value(bd_seq_num_.load());
     }
 
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::NBIRTH,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = ""};
-
-    topic_str = topic.to_string();
+    topic_str = birth_topic_str_;
     payload_data = payload.build();
     client = client_.get();
     qos = config_.data_qos;
   }
 
-  auto result = publish_message(client, topic_str, payload_data, qos, false);
+  auto result = publish_message(MessageType::NBIRTH, client, topic_str, payload_data, qos, false);
   if (!result) {
     return result;
   }
@@ -412,92 +906,365 @@ std::expected<void, std::string> EdgeNode::publish_birth(PayloadBuilder& payload
   {
     std::lock_guard<std::mutex> lock(mutex_);
     last_birth_payload_ = std::move(payload_data);
+    published_values_.rebuild(payload.payload(), *names_);
+    resolve_node_commands(payload.payload());
     seq_num_ = 0;
+
+    // A new NBIRTH starts a new session for the devices too: each needs a new DBIRTH before
+    // its DDATA, including the DDATA buffered while the node was offline
+    pending_births_.clear();
+    for (auto& [device_id, device] : device_states_) {
+      device.awaiting_birth = device.is_online;
+      device.is_online = false;
+      device.birth_pending = false;
+    }
   }
 
+  // Buffered NDATA goes out now, buffered DDATA once its device has been born again
+  start_forwarding();
   return {};
 }
 
+uint64_t EdgeNode::next_seq() noexcept {
+  uint64_t current = seq_num_.load(std::memory_order_relaxed);
+  uint64_t next = 0;
+  do {
+    next = (current + 1) % SEQ_NUMBER_MAX;
+  } while (!seq_num_.compare_exchange_weak(current, next, std::memory_order_relaxed));
+  return next;
+}
+
+MQTTAsync EdgeNode::current_client() const noexcept {
+  return published_client_.load(std::memory_order_acquire);
+}
+
 std::expected<void, std::string> EdgeNode::publish_data(PayloadBuilder& payload) {
-  MQTTAsync client = nullptr;
-  std::string topic_str;
-  std::vector<uint8_t> payload_data;
-  int qos = 0;
+  // The client handle is read from its atomic copy and group/edge node ids never change, so
+  // producers only share seq_num_.
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    return store_data_message({}, payload);
+  }
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
+  auto send_lock = lock_replay_sends();
+  return send_data_message(MessageType::NDATA, current_client(), data_topic_str_, payload, {},
+                           {});
+}
 
-    if (!is_connected_) {
-      return std::unexpected("Not connected");
-    }
+std::expected<void, std::string> EdgeNode::publish_data(MetricFrame& frame) {
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    return store_data_message({}, frame);
+  }
 
-    seq_num_ = (seq_num_ + 1) % SEQ_NUMBER_MAX;
+  auto send_lock = lock_replay_sends();
+  MQTTAsync client = current_client();
+  frame.set_seq(next_seq());
+  return publish_message(MessageType::NDATA, client, data_topic_str_, frame.bytes(),
+                         config_.data_qos, false);
+}
 
-    if (!payload.has_seq()) {
-      payload.set_seq(seq_num_);
-    }
+std::expected<void, std::string> EdgeNode::publish_data_async(PayloadBuilder& payload,
+                                                              PublishCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
+  }
+  // A moved-from node has no window
+  if (!publish_window_ || !is_connected_.load(std::memory_order_acquire)) {
+    return std::unexpected("Not connected");
+  }
 
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::NDATA,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = ""};
+  // Wait for a slot before reserving a seq, so a timeout does not leave a gap
+  auto slot =
+      publish_window_->acquire(std::chrono::milliseconds(config_.publish_window_timeout_ms));
+  if (!slot) {
+    return std::unexpected(slot.error());
+  }
 
-    topic_str = topic.to_string();
-    payload_data = payload.build();
-    client = client_.get();
-    qos = config_.data_qos;
+  auto send_lock = lock_replay_sends();
+  return send_data_message(MessageType::NDATA, current_client(), data_topic_str_, payload,
+                           std::move(*slot), std::move(on_complete));
+}
+
+std::expected<void, std::string>
+EdgeNode::send_data_message(MessageType type, MQTTAsync client, const std::string& topic_str,
+                            PayloadBuilder& payload, PublishWindow::Slot slot,
+                            PublishCallback on_complete) {
+  uint64_t seq = next_seq();
+  if (!payload.has_seq()) {
+    payload.set_seq(seq);
   }
 
-  return publish_message(client, topic_str, payload_data, qos, false);
+  auto& payload_data = publish_scratch_buffer();
+  payload.build_into(payload_data);
+
+  if (!on_complete) {
+    return publish_message(type, client, topic_str, payload_data, config_.data_qos, false);
+  }
+  auto wire_data = compress_for_publish(payload_data);
+  auto result = detail::send_message_async(client, topic_str.c_str(), wire_data,
+                                           config_.data_qos, false, std::move(slot),
+                                           std::move(on_complete), stats_);
+  if (result) {
+    stats_->record_out(type, wire_data.size());
+  }
+  return result;
 }
 
-std::expected<void, std::string> EdgeNode::publish_death() {
-  MQTTAsync client = nullptr;
-  std::string topic_str;
-  std::vector<uint8_t> payload_data;
-  int qos = 0;
+std::expected<void, std::string> EdgeNode::store_data_message(std::string_view device_id,
+                                                               const PayloadBuilder& payload) {
+  auto& payload_data = publish_scratch_buffer();
+  payload.build_into(payload_data);
+  return store_serialized_message(device_id, payload_data);
+}
+
+std::expected<void, std::string> EdgeNode::store_data_message(std::string_view device_id,
+                                                               const MetricFrame& frame) {
+  return store_serialized_message(device_id, frame.bytes());
+}
+
+// Cold path: the payload is decoded so a copy can be flagged historical, leaving the caller's
+// builder or frame as it was
+std::expected<void, std::string>
+EdgeNode::store_serialized_message(std::string_view device_id,
+                                   std::span<const uint8_t> payload_data) {
+  if (!store_forward_) {
+    return std::unexpected("Not connected");
+  }
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!is_connected_) {
+    // Frames are only worth keeping if a birth will be replayed ahead of them
+    if (last_birth_payload_.empty()) {
       return std::unexpected("Not connected");
     }
-
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::NDEATH,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = ""};
-
-    topic_str = topic.to_string();
-    payload_data = death_payload_data_;
-    client = client_.get();
-    qos = config_.data_qos;
+    if (!device_id.empty()) {
+      auto it = device_states_.find(device_id);
+      if (it == device_states_.end() || !it->second.is_online) {
+        return std::unexpected(
+            std::format("Must publish DBIRTH for device '{}' before DDATA", device_id));
+      }
+    }
   }
 
-  auto result = publish_message(client, topic_str, payload_data, qos, false);
-  if (!result) {
-    return result;
+  org::eclipse::tahu::protobuf::Payload stored;
+  if (!stored.ParseFromArray(payload_data.data(), static_cast<int>(payload_data.size()))) {
+    return std::unexpected("Invalid payload");
   }
+  for (auto& metric : *stored.mutable_metrics()) {
+    metric.set_is_historical(true);
+  }
+  // The seq is assigned when the frame is forwarded
+  stored.clear_seq();
 
-  return disconnect();
+  std::vector<uint8_t> stored_data(stored.ByteSizeLong());
+  stored.SerializeToArray(stored_data.data(), static_cast<int>(stored_data.size()));
+  if (!store_forward_->push(device_id, stored_data)) {
+    return std::unexpected("Not connected");
+  }
+  return {};
 }
 
-std::expected<void, std::string> EdgeNode::rebirth() {
-  std::vector<uint8_t> payload_data;
-  std::string topic_str;
-  int qos = 0;
+std::expected<void, std::string>
+EdgeNode::forward_stored_message(const StoreForwardBuffer::Frame& frame) {
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    return std::unexpected("Not connected");
+  }
 
-  {
+  auto send_lock = lock_replay_sends();
+  auto& topic_str = publish_scratch_topic();
+  MQTTAsync client = nullptr;
+  if (frame.device_id.empty()) {
+    topic_str.assign(data_topic_str_);
+    client = current_client();
+  } else if (auto online = device_data_topic(frame.device_id, topic_str, client); !online) {
+    // Kept (and the drain paused) until the device is born in this session; data of a device
+    // that died after the frame was stored is discarded
     std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!is_connected_) {
-      return std::unexpected("Not connected");
+    auto it = device_states_.find(frame.device_id);
+    if (it != device_states_.end() && it->second.awaiting_birth) {
+      return std::unexpected(std::move(online.error()));
     }
+    return {};
+  }
 
-    if (last_birth_payload_.empty()) {
-      return std::unexpected("No previous birth payload stored");
-    }
+  auto& payload_data = publish_scratch_buffer();
+  if (!patch_payload(frame.payload,
+                     {.timestamp = std::nullopt, .seq = next_seq(), .bd_seq = std::nullopt},
+                     payload_data)) {
+    // An unreadable frame is skipped rather than stalling the rest of the queue
+    return {};
+  }
+  auto type = frame.device_id.empty() ? MessageType::NDATA : MessageType::DDATA;
+  return publish_message(type, client, topic_str, payload_data, config_.data_qos, false);
+}
+
+void EdgeNode::start_forwarding() {
+  if (store_forward_) {
+    store_forward_->start_drain(
+        [this](const StoreForwardBuffer::Frame& frame) { return forward_stored_message(frame); });
+  }
+}
+
+std::expected<size_t, std::string>
+EdgeNode::append_backfill_metric(std::string_view device_id, BackfillBatch& batch,
+                                 org::eclipse::tahu::protobuf::Payload::Metric& metric) {
+  size_t metric_size = metric.ByteSizeLong();
+  size_t field_size = 1 + detail::wire::varint_size(metric_size) + metric_size;
+
+  size_t published = 0;
+  if (batch.bytes != 0 && batch.bytes + field_size > config_.backfill.max_payload_bytes) {
+    auto sent = flush_backfill(device_id, batch);
+    if (!sent) {
+      return sent;
+    }
+    published = *sent;
+  }
+
+  if (batch.bytes == 0) {
+    batch.bytes = BACKFILL_HEADER_BYTES;
+  }
+  batch.bytes += field_size;
+  batch.payload.mutable_payload().add_metrics()->Swap(&metric);
+  return published;
+}
+
+std::expected<size_t, std::string> EdgeNode::flush_backfill(std::string_view device_id,
+                                                            BackfillBatch& batch) {
+  if (batch.bytes == 0) {
+    return 0;
+  }
+
+  // Buffered payloads never reach the link, so only live sends spend the budget
+  if (is_connected_.load(std::memory_order_acquire) && !backfill_budget_.unlimited()) {
+    auto wait = backfill_budget_.acquire(static_cast<double>(batch.payload.serialized_size()));
+    if (wait > std::chrono::steady_clock::duration::zero()) {
+      std::this_thread::sleep_for(wait);
+    }
+  }
+
+  auto result = device_id.empty() ? publish_data(batch.payload)
+                                  : publish_device_data(device_id, batch.payload);
+  batch.payload.reset();
+  batch.bytes = 0;
+  if (!result) {
+    return std::unexpected(std::move(result.error()));
+  }
+  return 1;
+}
+
+size_t EdgeNode::stored_messages() const {
+  return store_forward_ ? store_forward_->size() : 0;
+}
+
+uint64_t EdgeNode::dropped_stored_messages() const {
+  return store_forward_ ? store_forward_->dropped() : 0;
+}
+
+Stats EdgeNode::stats() const {
+  auto stats = stats_->snapshot();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (client_) {
+    stats.in_flight = detail::pending_token_count(client_.get());
+  }
+  return stats;
+}
+
+size_t EdgeNode::in_flight_publishes() const noexcept {
+  return publish_window_ ? publish_window_->in_flight() : 0;
+}
+
+bool EdgeNode::wait_for_publishes(std::chrono::milliseconds timeout) {
+  return !publish_window_ || publish_window_->wait_idle(timeout);
+}
+
+std::expected<size_t, std::string> EdgeNode::publish_changed_data(PayloadBuilder& snapshot) {
+  PayloadBuilder delta;
+  ValueUpdates updates;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (last_birth_payload_.empty()) {
+      return std::unexpected("Must publish NBIRTH before NDATA");
+    }
+    updates = select_changed_metrics(published_values_, deadbands_, snapshot.payload(),
+                                     delta.mutable_payload());
+  }
+
+  size_t changed = static_cast<size_t>(delta.payload().metrics_size());
+  if (changed == 0) {
+    return 0;
+  }
+
+  // Keep the acquisition time of the snapshot rather than the time the delta was built
+  if (snapshot.payload().has_timestamp()) {
+    delta.set_timestamp(snapshot.payload().timestamp());
+  }
+
+  auto result = publish_data(delta);
+  if (!result) {
+    return std::unexpected(result.error());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    apply_value_updates(published_values_, std::move(updates));
+  }
+  return changed;
+}
+
+void EdgeNode::set_deadband(uint64_t alias, double deadband) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (deadband > 0.0) {
+    deadbands_[alias] = deadband;
+  } else {
+    deadbands_.erase(alias);
+  }
+}
+
+std::expected<void, std::string> EdgeNode::publish_death() {
+  MQTTAsync client = nullptr;
+  std::string topic_str;
+  std::vector<uint8_t> payload_data;
+  int qos = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!is_connected_) {
+      return std::unexpected("Not connected");
+    }
+
+    topic_str = death_topic_str_;
+    payload_data = death_payload_data_;
+    client = client_.get();
+    qos = config_.data_qos;
+  }
+
+  auto result = publish_message(MessageType::NDEATH, client, topic_str, payload_data, qos, false);
+  if (!result) {
+    return result;
+  }
+
+  return disconnect();
+}
+
+std::expected<void, std::string> EdgeNode::rebirth(RebirthMode mode) {
+  if (mode == RebirthMode::InSession) {
+    return rebirth_in_session();
+  }
+
+  std::vector<uint8_t> payload_data;
+  std::string topic_str;
+  int qos = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!is_connected_) {
+      return std::unexpected("Not connected");
+    }
+
+    if (last_birth_payload_.empty()) {
+      return std::unexpected("No previous birth payload stored");
+    }
 
     org::eclipse::tahu::protobuf::Payload proto_payload;
     if (!proto_payload.ParseFromArray(last_birth_payload_.data(),
@@ -519,13 +1286,9 @@ std::expected<void, std::string> EdgeNode::rebirth() {
     payload_data.resize(proto_payload.ByteSizeLong());
     proto_payload.SerializeToArray(payload_data.data(), static_cast<int>(payload_data.size()));
     last_birth_payload_ = payload_data;
+    published_values_.rebuild(proto_payload, *names_);
 
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::NBIRTH,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = ""};
-
-    topic_str = topic.to_string();
+    topic_str = birth_topic_str_;
     qos = config_.data_qos;
   }
 
@@ -537,7 +1300,8 @@ std::expected<void, std::string> EdgeNode::rebirth() {
                         std::lock_guard<std::mutex> lock(mutex_);
                         client = client_.get();
                       }
-                      return publish_message(client, topic_str, payload_data, qos, false);
+                      return publish_message(MessageType::NBIRTH, client, topic_str, payload_data,
+                                             qos, false);
                     });
 
   if (!result) {
@@ -552,12 +1316,164 @@ std::expected<void, std::string> EdgeNode::rebirth() {
   return {};
 }
 
+std::expected<void, std::string> EdgeNode::rebirth_in_session() {
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> births;
+  MQTTAsync client = nullptr;
+  int qos = 0;
+  size_t queued = 0;
+
+  // DBIRTHs still queued from an earlier rebirth are patched and queued again below
+  if (birth_replay_) {
+    birth_replay_->stop();
+  }
+
+  // No data publisher may take a seq between the reset and the births that start from it
+  auto send_lock = lock_replay_sends();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!is_connected_) {
+      return std::unexpected("Not connected");
+    }
+
+    if (last_birth_payload_.empty()) {
+      return std::unexpected("No previous birth payload stored");
+    }
+
+    auto timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                               std::chrono::system_clock::now().time_since_epoch())
+                                               .count());
+
+    // The session (and its NDEATH Will) is unchanged, so bdSeq is set to the current value
+    std::vector<uint8_t> patched;
+    if (!patch_payload(last_birth_payload_,
+                       {.timestamp = timestamp, .seq = 0, .bd_seq = bd_seq_num_.load()},
+                       patched)) {
+      return std::unexpected("Failed to patch stored birth payload");
+    }
+    last_birth_payload_.swap(patched);
+    births.emplace_back(birth_topic_str_, last_birth_payload_);
+
+    // The republished births carry their original values, so the report-by-exception caches
+    // are invalidated and the next publish_changed_*() sends every metric
+    published_values_.reset_values();
+
+    // DBIRTHs take seq 1..n after the NBIRTH, or the next seq whenever the paced replay
+    // reaches them
+    seq_num_ = 0;
+    pending_births_.clear();
+    for (auto& [device_id, device] : device_states_) {
+      device.birth_pending = false;
+      if (!device.is_online || device.last_birth_payload.empty()) {
+        continue;
+      }
+      PayloadPatch patch{.timestamp = timestamp, .seq = std::nullopt, .bd_seq = std::nullopt};
+      if (!birth_replay_) {
+        patch.seq = next_seq();
+      }
+      if (!patch_payload(device.last_birth_payload, patch, patched)) {
+        return std::unexpected(
+            std::format("Failed to patch stored DBIRTH for device '{}'", device_id));
+      }
+      device.last_birth_payload.swap(patched);
+      device.published_values.reset_values();
+      if (birth_replay_) {
+        device.birth_pending = true;
+        pending_births_.push_back(device_id);
+      } else {
+        births.emplace_back(device.topics.birth, device.last_birth_payload);
+      }
+    }
+    queued = pending_births_.size();
+
+    client = client_.get();
+    qos = config_.data_qos;
+  }
+
+  // births[0] is the NBIRTH, the rest are DBIRTHs
+  for (size_t i = 0; i < births.size(); i++) {
+    auto type = i == 0 ? MessageType::NBIRTH : MessageType::DBIRTH;
+    auto result = publish_message(type, client, births[i].first, births[i].second, qos, false);
+    if (!result) {
+      return result;
+    }
+  }
+
+  if (birth_replay_) {
+    send_lock.unlock();
+    birth_replay_->start(queued, [this]() { return send_pending_birth({}); });
+  }
+  start_forwarding();
+  return {};
+}
+
+std::expected<bool, std::string> EdgeNode::send_pending_birth(std::string_view device_id) {
+  std::string topic_str;
+  MQTTAsync client = nullptr;
+  int qos = 0;
+  auto& payload_data = publish_scratch_buffer();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    DeviceState* device = nullptr;
+    if (device_id.empty()) {
+      while (device == nullptr && !pending_births_.empty()) {
+        auto it = device_states_.find(pending_births_.front());
+        if (it != device_states_.end() && it->second.birth_pending) {
+          device = &it->second;
+        }
+        pending_births_.pop_front();
+      }
+    } else if (auto it = device_states_.find(device_id);
+               it != device_states_.end() && it->second.birth_pending) {
+      device = &it->second;
+    }
+    if (device == nullptr) {
+      return false;
+    }
+
+    device->birth_pending = false;
+    if (!patch_payload(device->last_birth_payload,
+                       {.timestamp = std::nullopt, .seq = next_seq(), .bd_seq = std::nullopt},
+                       payload_data)) {
+      return std::unexpected("Failed to patch stored DBIRTH");
+    }
+    device->last_birth_payload.assign(payload_data.begin(), payload_data.end());
+    topic_str = device->topics.birth;
+    client = client_.get();
+    qos = config_.data_qos;
+  }
+
+  return publish_message(MessageType::DBIRTH, client, topic_str, payload_data, qos, false)
+      .transform([]() { return true; });
+}
+
+std::unique_lock<std::mutex> EdgeNode::lock_replay_sends() {
+  if (!birth_replay_) {
+    return {};
+  }
+  return birth_replay_->lock_sends();
+}
+
+std::expected<void, std::string> EdgeNode::preempt_pending_birth(std::string_view device_id) {
+  // Checked even once the replay has ended: a replay that gave up leaves DBIRTHs queued
+  if (!birth_replay_) {
+    return {};
+  }
+  return send_pending_birth(device_id).transform([](bool) {});
+}
+
 std::expected<void, std::string> EdgeNode::publish_device_birth(std::string_view device_id,
                                                                 PayloadBuilder& payload) {
   MQTTAsync client = nullptr;
   std::string topic_str;
   std::vector<uint8_t> payload_data;
   int qos = 0;
+  DeviceTopics new_topics;
+
+  // A replayed DBIRTH must not be sent after the one that replaces it
+  auto send_lock = lock_replay_sends();
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -570,21 +1486,24 @@ std::expected<void, std::string> EdgeNode::publish_device_birth(std::string_view
       return std::unexpected("Must publish NBIRTH before DBIRTH");
     }
 
-    seq_num_ = (seq_num_ + 1) % SEQ_NUMBER_MAX;
-    payload.set_seq(seq_num_);
-
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::DBIRTH,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = std::string(device_id)};
+    payload.set_seq(next_seq());
 
-    topic_str = topic.to_string();
+    auto it = device_states_.find(device_id);
+    if (it != device_states_.end()) {
+      it->second.birth_pending = false;
+    }
+    if (it != device_states_.end() && !it->second.topics.birth.empty()) {
+      topic_str = it->second.topics.birth;
+    } else {
+      new_topics = make_device_topics(device_id);
+      topic_str = new_topics.birth;
+    }
     payload_data = payload.build();
     client = client_.get();
     qos = config_.data_qos;
   }
 
-  auto result = publish_message(client, topic_str, payload_data, qos, false);
+  auto result = publish_message(MessageType::DBIRTH, client, topic_str, payload_data, qos, false);
   if (!result) {
     return result;
   }
@@ -594,49 +1513,215 @@ std::expected<void, std::string> EdgeNode::publish_device_birth(std::string_view
     auto& device_state = device_states_[std::string(device_id)];
     device_state.last_birth_payload = std::move(payload_data);
     device_state.is_online = true;
+    device_state.awaiting_birth = false;
+    if (device_state.topics.birth.empty()) {
+      device_state.topics = std::move(new_topics);
+    }
+    device_state.published_values.rebuild(payload.payload(), *names_);
+    device_commands_.resolve(payload.payload(), device_state.command_aliases);
+  }
+
+  // Resume a drain that was waiting for this device
+  start_forwarding();
+  return {};
+}
+
+std::expected<void, std::string> EdgeNode::device_data_topic(std::string_view device_id,
+                                                             std::string& topic_str,
+                                                             MQTTAsync& client) {
+  // The DBIRTH must reach the host before the data it describes
+  if (auto result = preempt_pending_birth(device_id); !result) {
+    return result;
   }
 
+  // Only the device table needs the mutex; serialization happens after it is released
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = device_states_.find(device_id);
+  if (it == device_states_.end() || !it->second.is_online) {
+    return std::unexpected(
+        std::format("Must publish DBIRTH for device '{}' before DDATA", device_id));
+  }
+  topic_str.assign(it->second.topics.data);
+  client = client_.get();
   return {};
 }
 
 std::expected<void, std::string> EdgeNode::publish_device_data(std::string_view device_id,
                                                                PayloadBuilder& payload) {
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    return store_data_message(device_id, payload);
+  }
+
+  // assign() into the thread-local string reuses its capacity, so no allocation once warm
+  auto send_lock = lock_replay_sends();
+  auto& topic_str = publish_scratch_topic();
   MQTTAsync client = nullptr;
-  std::string topic_str;
-  std::vector<uint8_t> payload_data;
-  int qos = 0;
+  if (auto result = device_data_topic(device_id, topic_str, client); !result) {
+    return result;
+  }
+
+  return send_data_message(MessageType::DDATA, client, topic_str, payload, {}, {});
+}
+
+std::expected<void, std::string> EdgeNode::publish_device_data(std::string_view device_id,
+                                                               MetricFrame& frame) {
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    return store_data_message(device_id, frame);
+  }
 
+  auto send_lock = lock_replay_sends();
+  auto& topic_str = publish_scratch_topic();
+  MQTTAsync client = nullptr;
+  if (auto result = device_data_topic(device_id, topic_str, client); !result) {
+    return result;
+  }
+
+  frame.set_seq(next_seq());
+  return publish_message(MessageType::DDATA, client, topic_str, frame.bytes(),
+                         config_.data_qos, false);
+}
+
+std::expected<void, std::string>
+EdgeNode::publish_device_data_async(std::string_view device_id, PayloadBuilder& payload,
+                                    PublishCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
+  }
+  if (!publish_window_ || !is_connected_.load(std::memory_order_acquire)) {
+    return std::unexpected("Not connected");
+  }
+
+  auto slot =
+      publish_window_->acquire(std::chrono::milliseconds(config_.publish_window_timeout_ms));
+  if (!slot) {
+    return std::unexpected(slot.error());
+  }
+
+  auto send_lock = lock_replay_sends();
+  auto& topic_str = publish_scratch_topic();
+  MQTTAsync client = nullptr;
+  if (auto result = device_data_topic(device_id, topic_str, client); !result) {
+    return result;
+  }
+
+  return send_data_message(MessageType::DDATA, client, topic_str, payload, std::move(*slot),
+                           std::move(on_complete));
+}
+
+std::expected<void, std::string>
+EdgeNode::publish_device_data_batch(std::span<const DeviceData> batch) {
+  if (batch.empty()) {
+    return {};
+  }
+
+  if (!is_connected_.load(std::memory_order_acquire)) {
+    for (const auto& entry : batch) {
+      if (auto result = store_data_message(entry.device_id, entry.payload); !result) {
+        return result;
+      }
+    }
+    return {};
+  }
+
+  auto send_lock = lock_replay_sends();
+  for (const auto& entry : batch) {
+    if (auto result = preempt_pending_birth(entry.device_id); !result) {
+      return result;
+    }
+  }
+
+  // Per-thread scratch so steady-state scans reuse topic capacity
+  thread_local std::vector<std::string> topics;
+  if (topics.size() < batch.size()) {
+    topics.resize(batch.size());
+  }
+
+  MQTTAsync client = nullptr;
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto it = device_states_.find(batch[i].device_id);
+      if (it == device_states_.end() || !it->second.is_online) {
+        return std::unexpected(std::format("Must publish DBIRTH for device '{}' before DDATA",
+                                           batch[i].device_id));
+      }
+      topics[i].assign(it->second.topics.data);
+    }
+    client = client_.get();
+  }
 
-    if (!is_connected_) {
-      return std::unexpected("Not connected");
+  // A seq is reserved as each message is sent, so a rejected message leaves no unsent seqs
+  // behind it
+  auto& payload_data = publish_scratch_buffer();
+  for (size_t i = 0; i < batch.size(); i++) {
+    auto& payload = batch[i].payload;
+    uint64_t seq = next_seq();
+    if (!payload.has_seq()) {
+      payload.set_seq(seq);
+    }
+    payload.build_into(payload_data);
+    auto result = publish_message(MessageType::DDATA, client, topics[i], payload_data,
+                                  config_.data_qos, false);
+    if (!result) {
+      return std::unexpected(std::format("DDATA for device '{}' failed ({} of {} sent): {}",
+                                         batch[i].device_id, i, batch.size(), result.error()));
     }
+  }
 
+  return {};
+}
+
+std::expected<size_t, std::string>
+EdgeNode::publish_changed_device_data(std::string_view device_id, PayloadBuilder& snapshot) {
+  PayloadBuilder delta;
+  ValueUpdates updates;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto it = device_states_.find(device_id);
     if (it == device_states_.end() || !it->second.is_online) {
       return std::unexpected(
           std::format("Must publish DBIRTH for device '{}' before DDATA", device_id));
     }
+    updates = select_changed_metrics(it->second.published_values, it->second.deadbands,
+                                     snapshot.payload(), delta.mutable_payload());
+  }
 
-    seq_num_ = (seq_num_ + 1) % SEQ_NUMBER_MAX;
+  size_t changed = static_cast<size_t>(delta.payload().metrics_size());
+  if (changed == 0) {
+    return 0;
+  }
 
-    if (!payload.has_seq()) {
-      payload.set_seq(seq_num_);
-    }
+  // Keep the acquisition time of the snapshot rather than the time the delta was built
+  if (snapshot.payload().has_timestamp()) {
+    delta.set_timestamp(snapshot.payload().timestamp());
+  }
 
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::DDATA,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = std::string(device_id)};
+  auto result = publish_device_data(device_id, delta);
+  if (!result) {
+    return std::unexpected(result.error());
+  }
 
-    topic_str = topic.to_string();
-    payload_data = payload.build();
-    client = client_.get();
-    qos = config_.data_qos;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = device_states_.find(device_id);
+    if (it != device_states_.end()) {
+      apply_value_updates(it->second.published_values, std::move(updates));
+    }
   }
+  return changed;
+}
 
-  return publish_message(client, topic_str, payload_data, qos, false);
+void EdgeNode::set_device_deadband(std::string_view device_id, uint64_t alias, double deadband) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = device_states_.find(device_id);
+  if (it == device_states_.end()) {
+    it = device_states_.emplace(std::string(device_id), DeviceState{}).first;
+  }
+  if (deadband > 0.0) {
+    it->second.deadbands[alias] = deadband;
+  } else {
+    it->second.deadbands.erase(alias);
+  }
 }
 
 std::expected<void, std::string> EdgeNode::publish_device_death(std::string_view device_id) {
@@ -645,6 +1730,9 @@ std::expected<void, std::string> EdgeNode::publish_device_death(std::string_view
   std::vector<uint8_t> payload_data;
   int qos = 0;
 
+  // A replayed DBIRTH must not be sent after the DDEATH
+  auto send_lock = lock_replay_sends();
+
   {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -656,21 +1744,17 @@ std::expected<void, std::string> EdgeNode::publish_device_death(std::string_view
     if (it == device_states_.end()) {
       return std::unexpected(std::format("Unknown device: '{}'", device_id));
     }
+    it->second.birth_pending = false;
 
     PayloadBuilder death_payload;
 
-    Topic topic{.group_id = config_.group_id,
-                .message_type = MessageType::DDEATH,
-                .edge_node_id = config_.edge_node_id,
-                .device_id = std::string(device_id)};
-
-    topic_str = topic.to_string();
+    topic_str = it->second.topics.death;
     payload_data = death_payload.build();
     client = client_.get();
     qos = config_.data_qos;
   }
 
-  auto result = publish_message(client, topic_str, payload_data, qos, false);
+  auto result = publish_message(MessageType::DDEATH, client, topic_str, payload_data, qos, false);
   if (!result) {
     return result;
   }
@@ -680,9 +1764,12 @@ std::expected<void, std::string> EdgeNode::publish_device_death(std::string_view
     auto it = device_states_.find(device_id);
     if (it != device_states_.end()) {
       it->second.is_online = false;
+      it->second.awaiting_birth = false;
     }
   }
 
+  // Resume a drain that was waiting for this device; its buffered data is discarded
+  start_forwarding();
   return {};
 }
 
@@ -711,7 +1798,7 @@ EdgeNode::publish_node_command(std::string_view target_edge_node_id, PayloadBuil
     qos = config_.data_qos;
   }
 
-  return publish_message(client, topic_str, payload_data, qos, false);
+  return publish_message(MessageType::NCMD, client, topic_str, payload_data, qos, false);
 }
 
 std::expected<void, std::string>
@@ -740,7 +1827,145 @@ EdgeNode::publish_device_command(std::string_view target_edge_node_id,
     qos = config_.data_qos;
   }
 
-  return publish_message(client, topic_str, payload_data, qos, false);
+  return publish_message(MessageType::DCMD, client, topic_str, payload_data, qos, false);
+}
+
+std::expected<void, std::string> EdgeNode::register_command(std::string_view name,
+                                                            CommandHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_connected_) {
+    return std::unexpected("Command handlers must be registered before connect()");
+  }
+  node_commands_.add(name, std::move(handler));
+  return {};
+}
+
+std::expected<void, std::string> EdgeNode::register_command(uint64_t alias,
+                                                            CommandHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_connected_) {
+    return std::unexpected("Command handlers must be registered before connect()");
+  }
+  node_commands_.add(alias, std::move(handler));
+  return {};
+}
+
+std::expected<void, std::string> EdgeNode::register_device_command(std::string_view name,
+                                                                   CommandHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_connected_) {
+    return std::unexpected("Command handlers must be registered before connect()");
+  }
+  device_commands_.add(name, std::move(handler));
+  return {};
+}
+
+std::expected<void, std::string> EdgeNode::register_device_command(uint64_t alias,
+                                                                   CommandHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_connected_) {
+    return std::unexpected("Command handlers must be registered before connect()");
+  }
+  device_commands_.add(alias, std::move(handler));
+  return {};
+}
+
+void EdgeNode::resolve_node_commands(const org::eclipse::tahu::protobuf::Payload& birth) {
+  node_commands_.resolve(birth, node_command_aliases_);
+  if (!config_.handle_node_control) {
+    return;
+  }
+
+  rebirth_alias_.reset();
+  scan_rate_alias_.reset();
+  for (const auto& metric : birth.metrics()) {
+    if (metric.name() == REBIRTH_METRIC && metric.has_alias()) {
+      rebirth_alias_ = metric.alias();
+    } else if (metric.name() == SCAN_RATE_METRIC) {
+      if (metric.has_alias()) {
+        scan_rate_alias_ = metric.alias();
+      }
+      // A rate already commanded by a host wins over the one declared in the birth
+      if (metric.has_long_value() || metric.has_int_value()) {
+        int64_t unset = 0;
+        scan_rate_ms_.compare_exchange_strong(unset, command_rate(metric),
+                                              std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+void EdgeNode::dispatch_commands(std::string_view device_id,
+                                 const org::eclipse::tahu::protobuf::Payload& payload) {
+  bool is_device = !device_id.empty();
+  const auto& registry = is_device ? device_commands_ : node_commands_;
+  bool controls = !is_device && config_.handle_node_control;
+
+  for (const auto& metric : payload.metrics()) {
+    std::optional<size_t> handler;
+    bool rebirth = false;
+    bool scan_rate = false;
+
+    if (metric.has_name()) {
+      std::string_view name = metric.name();
+      handler = registry.find(name);
+      rebirth = controls && name == REBIRTH_METRIC;
+      scan_rate = controls && name == SCAN_RATE_METRIC;
+    } else if (metric.has_alias()) {
+      uint64_t alias = metric.alias();
+      handler = registry.find(alias);
+
+      // Aliases resolved from the births change with every NBIRTH/DBIRTH
+      std::lock_guard<std::mutex> lock(mutex_);
+      const detail::CommandAliases* aliases = &node_command_aliases_;
+      if (is_device) {
+        auto it = device_states_.find(device_id);
+        aliases = it != device_states_.end() ? &it->second.command_aliases : nullptr;
+      }
+      if (!handler && aliases) {
+        if (auto it = aliases->find(alias); it != aliases->end()) {
+          handler = it->second;
+        }
+      }
+      rebirth = controls && rebirth_alias_ == alias;
+      scan_rate = controls && scan_rate_alias_ == alias;
+    }
+
+    if (rebirth && metric.boolean_value()) {
+      rebirth_requested_ = true;
+      node_control_->signal();
+    } else if (scan_rate && command_rate(metric) > 0) {
+      scan_rate_ms_.store(command_rate(metric), std::memory_order_relaxed);
+      scan_rate_changed_ = true;
+      node_control_->signal();
+    }
+
+    if (handler) {
+      registry.invoke(*handler, device_id, metric);
+    }
+  }
+}
+
+void EdgeNode::run_node_control() {
+  // Publishing may block on the publish window, so none of this runs on the MQTT thread
+  if (rebirth_requested_.exchange(false)) {
+    (void)rebirth(RebirthMode::InSession);
+  }
+
+  if (scan_rate_changed_.exchange(false)) {
+    std::optional<uint64_t> alias;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      alias = scan_rate_alias_;
+    }
+    PayloadBuilder confirmation;
+    if (alias) {
+      confirmation.add_metric_by_alias(*alias, scan_rate_ms());
+    } else {
+      confirmation.add_metric(SCAN_RATE_METRIC, scan_rate_ms());
+    }
+    (void)publish_data(confirmation);
+  }
 }
 
 } // namespace sparkplug
\ No newline at end of file
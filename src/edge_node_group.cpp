@@ -0,0 +1,236 @@
+// src/edge_node_group.cpp
+#include "sparkplug/edge_node_group.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <latch>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace sparkplug {
+
+// Worker threads sharing one queue of tasks ordered by due time
+class EdgeNodeGroup::Scheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Task = std::function<void()>;
+
+  explicit Scheduler(size_t threads) {
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      threads_.emplace_back(&Scheduler::run, this);
+    }
+  }
+
+  ~Scheduler() {
+    stop();
+  }
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  void schedule(Clock::time_point due, Task task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_) {
+        return;
+      }
+      queue_.push_back(Entry{.due = due, .order = next_order_++, .task = std::move(task)});
+      std::ranges::push_heap(queue_, later);
+    }
+    // Workers may be waiting for a later task, so all of them re-check the head
+    cv_.notify_all();
+  }
+
+  // Drops tasks that are not yet due and joins the workers
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      queue_.clear();
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    threads_.clear();
+  }
+
+  // Uniform random value in [0, 1) for reconnect jitter
+  double random() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unit_(rng_);
+  }
+
+private:
+  struct Entry {
+    Clock::time_point due;
+    uint64_t order; // Keeps tasks due at the same time in submission order
+    Task task;
+  };
+
+  // Heap comparator putting the earliest task at the front
+  static bool later(const Entry& lhs, const Entry& rhs) noexcept {
+    return lhs.due != rhs.due ? lhs.due > rhs.due : lhs.order > rhs.order;
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      auto due = queue_.front().due;
+      if (due > Clock::now()) {
+        cv_.wait_until(lock, due);
+        continue;
+      }
+
+      std::ranges::pop_heap(queue_, later);
+      auto task = std::move(queue_.back().task);
+      queue_.pop_back();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Entry> queue_;
+  uint64_t next_order_{0};
+  bool stopping_{false};
+  std::mt19937_64 rng_{std::random_device{}()};
+  std::uniform_real_distribution<double> unit_{0.0, 1.0};
+  std::vector<std::thread> threads_;
+};
+
+EdgeNodeGroup::EdgeNodeGroup(Config config)
+    : reconnect_(config.node.reconnect), members_(config.edge_node_ids.size()),
+      scheduler_(std::make_unique<Scheduler>(std::max<size_t>(config.workers, 1))) {
+  for (size_t i = 0; i < members_.size(); i++) {
+    auto node_config = config.node;
+    node_config.edge_node_id = config.edge_node_ids[i];
+    node_config.client_id = std::format("{}-{}", config.node.client_id, config.edge_node_ids[i]);
+    auto& member = members_[i];
+    member.node = std::make_unique<EdgeNode>(std::move(node_config));
+    if (reconnect_.enabled) {
+      member.node->connection_lost_hook_ = [this, i] { schedule_reconnect(i, 0); };
+    }
+  }
+}
+
+EdgeNodeGroup::~EdgeNodeGroup() {
+  for (auto& member : members_) {
+    member.auto_reconnect = false;
+  }
+  // No reconnect may run while the nodes disconnect in their destructors
+  scheduler_->stop();
+}
+
+EdgeNode* EdgeNodeGroup::find(std::string_view edge_node_id) noexcept {
+  auto it = std::ranges::find_if(members_, [edge_node_id](const Member& member) {
+    return member.node->config_.edge_node_id == edge_node_id;
+  });
+  return it != members_.end() ? it->node.get() : nullptr;
+}
+
+std::vector<std::expected<void, std::string>>
+EdgeNodeGroup::run_on_all(const std::function<std::expected<void, std::string>(Member&)>& task) {
+  std::vector<std::expected<void, std::string>> results(members_.size());
+  std::latch done(static_cast<std::ptrdiff_t>(members_.size()));
+  auto now = Scheduler::Clock::now();
+  for (size_t i = 0; i < members_.size(); i++) {
+    scheduler_->schedule(now, [&, i] {
+      results[i] = task(members_[i]);
+      done.count_down();
+    });
+  }
+  done.wait();
+  return results;
+}
+
+std::expected<void, std::string> EdgeNodeGroup::connect() {
+  auto results = run_on_all([](Member& member) {
+    auto result = member.node->connect();
+    member.auto_reconnect = result.has_value();
+    return result;
+  });
+
+  auto failed = std::ranges::find_if(results, [](const auto& result) { return !result; });
+  if (failed == results.end()) {
+    return {};
+  }
+  auto index = static_cast<size_t>(failed - results.begin());
+  auto error = std::format("Node '{}' failed to connect: {}",
+                           members_[index].node->config_.edge_node_id, failed->error());
+  (void)disconnect();
+  return std::unexpected(std::move(error));
+}
+
+std::expected<void, std::string> EdgeNodeGroup::disconnect() {
+  for (auto& member : members_) {
+    member.auto_reconnect = false;
+  }
+
+  auto results = run_on_all([](Member& member) -> std::expected<void, std::string> {
+    if (!member.node->is_connected()) {
+      return {};
+    }
+    return member.node->disconnect();
+  });
+  for (auto& result : results) {
+    if (!result) {
+      return std::unexpected(std::move(result.error()));
+    }
+  }
+  return {};
+}
+
+std::expected<void, std::string> EdgeNodeGroup::for_each(const NodeTask& task) {
+  auto results = run_on_all([&task](Member& member) { return task(*member.node); });
+  for (size_t i = 0; i < results.size(); i++) {
+    if (!results[i]) {
+      return std::unexpected(std::format("Node '{}': {}", members_[i].node->config_.edge_node_id,
+                                         results[i].error()));
+    }
+  }
+  return {};
+}
+
+Stats EdgeNodeGroup::stats() const {
+  Stats total;
+  for (const auto& member : members_) {
+    total.merge(member.node->stats());
+  }
+  return total;
+}
+
+void EdgeNodeGroup::schedule_reconnect(size_t index, size_t attempt) {
+  if (!members_[index].auto_reconnect) {
+    return;
+  }
+  if (reconnect_.max_attempts > 0 && attempt >= reconnect_.max_attempts) {
+    return;
+  }
+
+  auto delay = reconnect_.delay_for_attempt(attempt, scheduler_->random());
+  scheduler_->schedule(Scheduler::Clock::now() + delay, [this, index, attempt] {
+    auto& member = members_[index];
+    if (!member.auto_reconnect) {
+      return;
+    }
+    if (!member.node->reconnect_and_replay()) {
+      schedule_reconnect(index, attempt + 1);
+    }
+  });
+}
+
+} // namespace sparkplug
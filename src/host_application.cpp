@@ -1,13 +1,21 @@
 // src/host_application.cpp
 #include "sparkplug/host_application.hpp"
 
+#include "sparkplug/compression.hpp"
+#include "sparkplug/parse_arena.hpp"
 #include "sparkplug/topic.hpp"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <format>
 #include <future>
+#include <limits>
+#include <memory>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <MQTTAsync.h>
 
@@ -18,22 +26,55 @@ constexpr int CONNECTION_TIMEOUT_MS = 10000; // Increased from 5s to 10s
 constexpr int DISCONNECT_TIMEOUT_MS = 11000;
 constexpr uint64_t SEQ_NUMBER_MAX = 256;
 
-void on_connect_success(void* context, MQTTAsync_successData* response) {
-  (void)response;
-  auto* promise = static_cast<std::promise<void>*>(context);
-  promise->set_value();
+// Fills in the name and datatype of metrics that only carry an alias
+void resolve_metric_aliases(const AliasRegistry& aliases,
+                            org::eclipse::tahu::protobuf::Payload& payload) {
+  for (auto& metric : *payload.mutable_metrics()) {
+    if (!metric.has_alias() || metric.has_name()) {
+      continue;
+    }
+    if (const auto* entry = aliases.find(metric.alias())) {
+      metric.mutable_name()->assign(entry->name.view());
+      if (!metric.has_datatype()) {
+        metric.set_datatype(std::to_underlying(entry->datatype));
+      }
+    }
+  }
 }
 
-void on_connect_failure(void* context, MQTTAsync_failureData* response) {
-  auto* promise = static_cast<std::promise<void>*>(context);
-  std::string error;
-  if (response) {
-    error = std::format("Connection failed: code={}, message={}", response->code,
-                        response->message ? response->message : "none");
-  } else {
-    error = "Connection failed: no response data";
+// True if the names a birth would add to the pool (with device_id, for a DBIRTH) fit in it.
+// Names repeated within the birth are counted each time, so this errs on the safe side.
+bool birth_names_fit(const StringInterner& names, std::string_view device_id,
+                     const org::eclipse::tahu::protobuf::Payload& birth) {
+  size_t available = names.available();
+  if (available == SIZE_MAX) {
+    return true;
   }
-  promise->set_exception(std::make_exception_ptr(std::runtime_error(error)));
+  size_t needed = 0;
+  auto add = [&](std::string_view name) {
+    if (!names.find(name)) {
+      needed += name.size();
+    }
+  };
+  add(device_id);
+  for (const auto& metric : birth.metrics()) {
+    if (metric.has_name()) {
+      add(metric.name());
+    }
+  }
+  return needed <= available;
+}
+
+// The compressed wrapper repeats timestamp and seq, so only the bdSeq of an NDEATH is left in
+// the body: that is the one undelivered message still inflated for sequence tracking
+bool needs_inflating(MessageType type, const detail::wire::PayloadHeader& header) noexcept {
+  return header.compressed && type == MessageType::NDEATH;
+}
+
+// Per-thread buffer for decompressed payloads; its capacity is reused by the next message
+std::vector<uint8_t>& inflate_scratch_buffer() {
+  thread_local std::vector<uint8_t> buffer;
+  return buffer;
 }
 
 void on_disconnect_success(void* context, MQTTAsync_successData* response) {
@@ -50,34 +91,189 @@ void on_disconnect_failure(void* context, MQTTAsync_failureData* response) {
 
 } // namespace
 
-HostApplication::HostApplication(Config config) : config_(std::move(config)) {
+// Runs message handling off the MQTT thread. Every message is routed to the worker chosen by
+// its (group_id, edge_node_id), so a node's messages are validated and delivered in order.
+class HostApplication::DispatchPool {
+public:
+  struct Message {
+    std::string topic;
+    std::vector<uint8_t> payload;
+    std::optional<detail::wire::PayloadHeader> header; // Scanned on the MQTT thread; no payload
+  };
+
+  using Handler = std::function<void(const Message&)>;
+
+  DispatchPool(size_t threads, size_t queue_capacity, Handler handler)
+      : queue_capacity_(std::max<size_t>(queue_capacity, 1)), handler_(std::move(handler)) {
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+    for (auto& worker : workers_) {
+      worker->thread = std::thread([this, w = worker.get()]() { run(*w); });
+    }
+  }
+
+  // Delivers everything already queued, then joins the workers
+  ~DispatchPool() {
+    for (auto& worker : workers_) {
+      {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->stopping = true;
+      }
+      worker->not_empty.notify_one();
+    }
+    for (auto& worker : workers_) {
+      worker->thread.join();
+    }
+  }
+
+  DispatchPool(const DispatchPool&) = delete;
+  DispatchPool& operator=(const DispatchPool&) = delete;
+
+  void submit(size_t shard_key, Message&& message) {
+    auto& worker = *workers_[shard_key % workers_.size()];
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      worker.not_full.wait(lock, [&]() { return worker.queue.size() < queue_capacity_; });
+      worker.queue.push_back(std::move(message));
+    }
+    worker.not_empty.notify_one();
+  }
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::deque<Message> queue;
+    bool stopping{false};
+    std::thread thread;
+  };
+
+  void run(Worker& worker) {
+    for (;;) {
+      Message message;
+      {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        worker.not_empty.wait(lock, [&]() { return worker.stopping || !worker.queue.empty(); });
+        if (worker.queue.empty()) {
+          return;
+        }
+        message = std::move(worker.queue.front());
+        worker.queue.pop_front();
+      }
+      worker.not_full.notify_one();
+      handler_(message);
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  size_t queue_capacity_;
+  Handler handler_;
+};
+
+HostApplication::HostApplication(Config config)
+    : config_(std::move(config)),
+      names_(config_.max_name_bytes),
+      publish_window_(std::make_shared<PublishWindow>(config_.publish_window)),
+      stats_(std::make_shared<detail::StatsRecorder>()),
+      reconnector_(std::make_unique<detail::Reconnector>(config_.reconnect)),
+      rebirth_budget_(config_.rebirth_recovery.max_requests_per_second,
+                      static_cast<double>(config_.rebirth_recovery.burst)),
+      snapshot_task_(std::make_unique<detail::PeriodicTask>()) {
 }
 
 HostApplication::~HostApplication() {
+  abandon_connect();
+  if (reconnector_) {
+    reconnector_->stop();
+  }
+  if (snapshot_task_) {
+    snapshot_task_->stop();
+  }
   if (client_ && is_connected_) {
     (void)disconnect();
   } else if (client_) {
     MQTTAsync_setCallbacks(client_.get(), nullptr, nullptr, nullptr, nullptr);
   }
+  stop_dispatcher();
+  // After the workers are joined, so nothing is counted once the counts are reported
+  flush_suppressed_warnings();
 }
 
 HostApplication::HostApplication(HostApplication&& other) noexcept
     : config_(std::move(other.config_)), client_(std::move(other.client_)),
-      is_connected_(other.is_connected_) {
+      is_connected_(other.is_connected_), names_(config_.max_name_bytes),
+      publish_window_(std::move(other.publish_window_)),
+      stats_(std::exchange(other.stats_, detail::StatsRecorder::detached())),
+      subscriptions_(std::move(other.subscriptions_)), state_online_(other.state_online_),
+      reconnector_(std::make_unique<detail::Reconnector>(config_.reconnect)),
+      rebirth_budget_(config_.rebirth_recovery.max_requests_per_second,
+                      static_cast<double>(config_.rebirth_recovery.burst)),
+      snapshot_restored_(other.snapshot_restored_),
+      snapshot_has_state_(other.snapshot_has_state_),
+      snapshot_task_(std::make_unique<detail::PeriodicTask>()) {
+  // A pending connect, retry or save of other refers to other, so it is cancelled rather than
+  // moved
+  other.abandon_connect();
+  if (other.reconnector_) {
+    other.reconnector_->stop();
+  }
+  if (other.snapshot_task_) {
+    other.snapshot_task_->stop();
+  }
+  // The workers of other call back into other, so they are joined and a pool for this started
+  if (other.stop_dispatcher()) {
+    start_dispatcher();
+  }
   std::lock_guard<std::mutex> lock(other.mutex_);
   other.is_connected_ = false;
 }
 
 HostApplication& HostApplication::operator=(HostApplication&& other) noexcept {
   if (this != &other) {
+    abandon_connect();
+    other.abandon_connect();
+    if (reconnector_) {
+      reconnector_->stop();
+    }
+    if (other.reconnector_) {
+      other.reconnector_->stop();
+    }
+    if (snapshot_task_) {
+      snapshot_task_->stop();
+    }
+    if (other.snapshot_task_) {
+      other.snapshot_task_->stop();
+    }
+    // As in the move constructor; a pool this had started is rebuilt by the next connect
+    stop_dispatcher();
+    bool dispatching = other.stop_dispatcher();
+
+    MQTTAsyncHandle previous; // Destroyed once both locks are released
     std::lock(mutex_, other.mutex_);
     std::lock_guard<std::mutex> lock1(mutex_, std::adopt_lock);
     std::lock_guard<std::mutex> lock2(other.mutex_, std::adopt_lock);
 
     config_ = std::move(other.config_);
-    client_ = std::move(other.client_);
+    previous = std::exchange(client_, std::move(other.client_));
     is_connected_ = other.is_connected_;
     other.is_connected_ = false;
+    names_.set_max_bytes(config_.max_name_bytes);
+    publish_window_ = std::move(other.publish_window_);
+    stats_ = std::exchange(other.stats_, detail::StatsRecorder::detached());
+    subscriptions_ = std::move(other.subscriptions_);
+    state_online_ = other.state_online_;
+    reconnector_ = std::make_unique<detail::Reconnector>(config_.reconnect);
+    rebirth_budget_ = TokenBucket(config_.rebirth_recovery.max_requests_per_second,
+                                  static_cast<double>(config_.rebirth_recovery.burst));
+    snapshot_restored_ = other.snapshot_restored_;
+    snapshot_has_state_ = other.snapshot_has_state_;
+    snapshot_task_ = std::make_unique<detail::PeriodicTask>();
+    if (dispatching) {
+      start_dispatcher();
+    }
   }
   return *this;
 }
@@ -99,12 +295,84 @@ void HostApplication::set_message_callback(MessageCallback callback) {
   config_.message_callback = std::move(callback);
 }
 
+void HostApplication::set_message_callback(MessageType type, MessageCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_.type_callbacks[std::to_underlying(type)] = std::move(callback);
+}
+
+void HostApplication::set_message_filter(MessageFilter filter) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_.message_filter = std::move(filter);
+}
+
 void HostApplication::set_log_callback(LogCallback callback) {
   std::lock_guard<std::mutex> lock(mutex_);
   config_.log_callback = std::move(callback);
 }
 
+// Owned by Paho from MQTTAsync_connect until the connection succeeds or fails
+struct HostApplication::ConnectContext {
+  std::shared_ptr<detail::ConnectAttempt<HostApplication>> attempt;
+  ConnectCallback on_complete;
+};
+
+void HostApplication::abandon_connect() {
+  std::shared_ptr<detail::ConnectAttempt<HostApplication>> attempt;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    attempt = std::move(connect_attempt_);
+  }
+  if (attempt) {
+    attempt->abandon();
+  }
+}
+
 std::expected<void, std::string> HostApplication::connect() {
+  // Shared with the completion callback, which may still run after a timeout here
+  auto promise = std::make_shared<std::promise<std::expected<void, std::string>>>();
+  auto future = promise->get_future();
+
+  auto started = connect_async([promise](std::expected<void, std::string> result) {
+    promise->set_value(std::move(result));
+  });
+  if (!started) {
+    return started;
+  }
+
+  auto status = future.wait_for(std::chrono::milliseconds(CONNECTION_TIMEOUT_MS));
+  if (status == std::future_status::timeout) {
+    abandon_connect();
+    std::lock_guard<std::mutex> lock(mutex_);
+    MQTTAsync_setCallbacks(client_.get(), nullptr, nullptr, nullptr, nullptr);
+    MQTTAsync_disconnectOptions disc_opts = MQTTAsync_disconnectOptions_initializer;
+    disc_opts.timeout = 1000;
+    MQTTAsync_disconnect(client_.get(), &disc_opts);
+    return std::unexpected("Connection timeout");
+  }
+
+  return future.get();
+}
+
+std::expected<void, std::string> HostApplication::connect_async(ConnectCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
+  }
+
+  // An earlier attempt still waiting for the broker is superseded by this one
+  abandon_connect();
+
+  // Node state from the previous run, before any broker traffic can arrive
+  restore_configured_snapshot();
+  if (!config_.snapshot.path.empty() && config_.snapshot.interval_ms > 0) {
+    snapshot_task_->start(std::chrono::milliseconds(config_.snapshot.interval_ms),
+                          [this] { save_configured_snapshot(); });
+  }
+
+  // A replaced client is destroyed after the lock is released: async completions of its
+  // abandoned messages may publish again
+  MQTTAsyncHandle previous;
+
+  // Held only while the client and options are prepared, never while the broker answers
   std::lock_guard<std::mutex> lock(mutex_);
 
   MQTTAsync raw_client = nullptr;
@@ -113,7 +381,11 @@ std::expected<void, std::string> HostApplication::connect() {
   if (rc != MQTTASYNC_SUCCESS) {
     return std::unexpected(std::format("Failed to create client: {}", rc));
   }
-  client_ = MQTTAsyncHandle(raw_client);
+  previous = std::exchange(client_, MQTTAsyncHandle(raw_client));
+
+  if (config_.dispatch_threads > 0 && !dispatcher_) {
+    start_dispatcher();
+  }
 
   rc = MQTTAsync_setCallbacks(client_.get(), this, on_connection_lost, on_message_arrived, nullptr);
   if (rc != MQTTASYNC_SUCCESS) {
@@ -146,10 +418,11 @@ std::expected<void, std::string> HostApplication::connect() {
     conn_opts.ssl = &ssl_opts_;
   }
 
-  std::promise<void> connect_promise;
-  auto connect_future = connect_promise.get_future();
+  connect_attempt_ = std::make_shared<detail::ConnectAttempt<HostApplication>>(this);
+  auto ctx = std::make_unique<ConnectContext>(
+      ConnectContext{.attempt = connect_attempt_, .on_complete = std::move(on_complete)});
 
-  conn_opts.context = &connect_promise;
+  conn_opts.context = ctx.get();
   conn_opts.onSuccess = on_connect_success;
   conn_opts.onFailure = on_connect_failure;
 
@@ -159,27 +432,89 @@ std::expected<void, std::string> HostApplication::connect() {
     return std::unexpected(std::format("Failed to connect: {}", rc));
   }
 
-  auto status = connect_future.wait_for(std::chrono::milliseconds(CONNECTION_TIMEOUT_MS));
-  if (status == std::future_status::timeout) {
-    MQTTAsync_setCallbacks(client_.get(), nullptr, nullptr, nullptr, nullptr);
-    MQTTAsync_disconnectOptions disc_opts = MQTTAsync_disconnectOptions_initializer;
-    disc_opts.timeout = 1000;
-    MQTTAsync_disconnect(client_.get(), &disc_opts);
-    return std::unexpected("Connection timeout");
+  // Paho now owns the context and frees it through the completion callbacks
+  (void)ctx.release();
+  return {};
+}
+
+void HostApplication::start_dispatcher() {
+  auto dispatcher = std::make_unique<DispatchPool>(
+      config_.dispatch_threads, config_.dispatch_queue_capacity,
+      [this](const DispatchPool::Message& message) {
+        if (!message.header) {
+          handle_message(message.topic, message.payload);
+        } else if (auto view = TopicView::parse(message.topic)) {
+          validate_scanned(*view, *message.header);
+        }
+      });
+  std::unique_lock<std::shared_mutex> lock(dispatch_mutex_);
+  dispatcher_ = std::move(dispatcher);
+}
+
+bool HostApplication::stop_dispatcher() {
+  std::unique_ptr<DispatchPool> dispatcher;
+  {
+    // Waits for a submit in progress; the workers are joined after the lock is released
+    std::unique_lock<std::shared_mutex> lock(dispatch_mutex_);
+    dispatcher = std::move(dispatcher_);
   }
+  return dispatcher != nullptr;
+}
 
-  try {
-    connect_future.get();
-  } catch (const std::exception& e) {
-    MQTTAsync_setCallbacks(client_.get(), nullptr, nullptr, nullptr, nullptr);
-    return std::unexpected(e.what());
+void HostApplication::on_connect_success(void* context, MQTTAsync_successData* response) {
+  (void)response;
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  bool abandoned = false;
+  {
+    std::lock_guard<std::mutex> attempt_lock(ctx->attempt->mutex);
+    if (auto* host = ctx->attempt->owner) {
+      {
+        std::lock_guard<std::mutex> lock(host->mutex_);
+        host->is_connected_ = true;
+      }
+      std::lock_guard<std::mutex> snapshot_lock(host->snapshot_mutex_);
+      host->snapshot_has_state_ = true;
+    } else {
+      abandoned = true;
+    }
   }
+  if (abandoned) {
+    ctx->on_complete(std::unexpected("Connection attempt abandoned"));
+    return;
+  }
+  ctx->on_complete({});
+}
 
-  is_connected_ = true;
-  return {};
+void HostApplication::on_connect_failure(void* context, MQTTAsync_failureData* response) {
+  std::unique_ptr<ConnectContext> ctx(static_cast<ConnectContext*>(context));
+  std::string error;
+  if (response) {
+    error = std::format("Connection failed: code={}, message={}", response->code,
+                        response->message ? response->message : "none");
+  } else {
+    error = "Connection failed: no response data";
+  }
+  {
+    std::lock_guard<std::mutex> attempt_lock(ctx->attempt->mutex);
+    if (auto* host = ctx->attempt->owner) {
+      std::lock_guard<std::mutex> lock(host->mutex_);
+      MQTTAsync_setCallbacks(host->client_.get(), nullptr, nullptr, nullptr, nullptr);
+    }
+  }
+  ctx->on_complete(std::unexpected(std::move(error)));
 }
 
 std::expected<void, std::string> HostApplication::disconnect() {
+  // An explicit disconnect cancels any pending automatic reconnect
+  if (reconnector_) {
+    reconnector_->stop();
+  }
+  if (snapshot_task_) {
+    snapshot_task_->stop();
+  }
+  save_configured_snapshot();
+  flush_suppressed_warnings();
+
   std::lock_guard<std::mutex> lock(mutex_);
 
   if (!client_) {
@@ -228,7 +563,11 @@ std::expected<void, std::string> HostApplication::publish_state_birth(uint64_t t
 
   std::vector<uint8_t> payload_data(json_payload.begin(), json_payload.end());
 
-  return publish_raw_message(topic, payload_data, config_.qos, true);
+  auto result = publish_raw_message(topic, payload_data, config_.qos, true);
+  if (result) {
+    state_online_ = true;
+  }
+  return result;
 }
 
 std::expected<void, std::string> HostApplication::publish_state_death(uint64_t timestamp) {
@@ -244,35 +583,50 @@ std::expected<void, std::string> HostApplication::publish_state_death(uint64_t t
 
   std::vector<uint8_t> payload_data(json_payload.begin(), json_payload.end());
 
-  return publish_raw_message(topic, payload_data, config_.qos, true);
+  auto result = publish_raw_message(topic, payload_data, config_.qos, true);
+  if (result) {
+    state_online_ = false;
+  }
+  return result;
 }
 
 std::expected<void, std::string> HostApplication::publish_node_command(
     std::string_view group_id, std::string_view target_edge_node_id, PayloadBuilder& payload) {
-  std::string topic_str;
-  std::vector<uint8_t> payload_data;
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!is_connected_) {
-      return std::unexpected("Not connected");
-    }
+  return publish_command(MessageType::NCMD, group_id, target_edge_node_id, "", payload, {});
+}
 
-    Topic topic{.group_id = std::string(group_id),
-                .message_type = MessageType::NCMD,
-                .edge_node_id = std::string(target_edge_node_id),
-                .device_id = ""};
+std::expected<void, std::string> HostApplication::publish_device_command(
+    std::string_view group_id, std::string_view target_edge_node_id,
+    std::string_view target_device_id, PayloadBuilder& payload) {
+  return publish_command(MessageType::DCMD, group_id, target_edge_node_id, target_device_id,
+                         payload, {});
+}
 
-    topic_str = topic.to_string();
-    payload_data = payload.build();
+std::expected<void, std::string> HostApplication::publish_node_command_async(
+    std::string_view group_id, std::string_view target_edge_node_id, PayloadBuilder& payload,
+    PublishCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
   }
-
-  return publish_command_message(topic_str, payload_data);
+  return publish_command(MessageType::NCMD, group_id, target_edge_node_id, "", payload,
+                         std::move(on_complete));
 }
 
-std::expected<void, std::string> HostApplication::publish_device_command(
+std::expected<void, std::string> HostApplication::publish_device_command_async(
     std::string_view group_id, std::string_view target_edge_node_id,
-    std::string_view target_device_id, PayloadBuilder& payload) {
+    std::string_view target_device_id, PayloadBuilder& payload, PublishCallback on_complete) {
+  if (!on_complete) {
+    return std::unexpected("Completion callback is required");
+  }
+  return publish_command(MessageType::DCMD, group_id, target_edge_node_id, target_device_id,
+                         payload, std::move(on_complete));
+}
+
+std::expected<void, std::string>
+HostApplication::publish_command(MessageType type, std::string_view group_id,
+                                 std::string_view target_edge_node_id,
+                                 std::string_view target_device_id, PayloadBuilder& payload,
+                                 PublishCallback on_complete) {
   std::string topic_str;
   std::vector<uint8_t> payload_data;
   {
@@ -283,7 +637,7 @@ std::expected<void, std::string> HostApplication::publish_device_command(
     }
 
     Topic topic{.group_id = std::string(group_id),
-                .message_type = MessageType::DCMD,
+                .message_type = type,
                 .edge_node_id = std::string(target_edge_node_id),
                 .device_id = std::string(target_device_id)};
 
@@ -291,7 +645,7 @@ std::expected<void, std::string> HostApplication::publish_device_command(
     payload_data = payload.build();
   }
 
-  return publish_command_message(topic_str, payload_data);
+  return publish_command_message(type, topic_str, payload_data, std::move(on_complete));
 }
 
 std::expected<void, std::string>
@@ -311,19 +665,38 @@ HostApplication::publish_raw_message(std::string_view topic, std::span<const uin
 
   int rc = MQTTAsync_sendMessage(client_.get(), std::string(topic).c_str(), &msg, &opts);
   if (rc != MQTTASYNC_SUCCESS) {
+    stats_->record_publish_failure();
     return std::unexpected(std::format("Failed to publish: {}", rc));
   }
 
+  stats_->record_out(MessageType::STATE, payload_data.size());
   return {};
 }
 
 std::expected<void, std::string>
-HostApplication::publish_command_message(std::string_view topic,
-                                         std::span<const uint8_t> payload_data) {
+HostApplication::publish_command_message(MessageType type, std::string_view topic,
+                                         std::span<const uint8_t> payload_data,
+                                         PublishCallback on_complete) {
   if (!client_ || !is_connected_) {
     return std::unexpected("Not connected");
   }
 
+  if (on_complete) {
+    // Commands carry no seq, so the slot can be taken after the payload is built
+    auto slot =
+        publish_window_->acquire(std::chrono::milliseconds(config_.publish_window_timeout_ms));
+    if (!slot) {
+      return std::unexpected(slot.error());
+    }
+    auto result = detail::send_message_async(client_.get(), std::string(topic).c_str(),
+                                             payload_data, config_.qos, false, std::move(*slot),
+                                             std::move(on_complete), stats_);
+    if (result) {
+      stats_->record_out(type, payload_data.size());
+    }
+    return result;
+  }
+
   MQTTAsync_message msg = MQTTAsync_message_initializer;
   msg.payload = const_cast<void*>(reinterpret_cast<const void*>(payload_data.data()));
   msg.payloadlen = static_cast<int>(payload_data.size());
@@ -334,40 +707,38 @@ HostApplication::publish_command_message(std::string_view topic,
 
   int rc = MQTTAsync_sendMessage(client_.get(), std::string(topic).c_str(), &msg, &opts);
   if (rc != MQTTASYNC_SUCCESS) {
+    stats_->record_publish_failure();
     return std::unexpected(std::format("Failed to publish: {}", rc));
   }
 
+  stats_->record_out(type, payload_data.size());
   return {};
 }
 
-std::expected<void, std::string> HostApplication::subscribe_all_groups() {
+Stats HostApplication::stats() const {
+  auto stats = stats_->snapshot();
   std::lock_guard<std::mutex> lock(mutex_);
-
-  if (!client_) {
-    return std::unexpected("Not connected");
+  if (client_) {
+    stats.in_flight = detail::pending_token_count(client_.get());
   }
+  return stats;
+}
 
-  std::string topic = "spBv1.0/#";
-
-  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
-
-  int rc = MQTTAsync_subscribe(client_.get(), topic.c_str(), config_.qos, &opts);
-  if (rc != MQTTASYNC_SUCCESS) {
-    return std::unexpected(std::format("Failed to subscribe: {}", rc));
-  }
+size_t HostApplication::in_flight_publishes() const noexcept {
+  return publish_window_ ? publish_window_->in_flight() : 0;
+}
 
-  return {};
+bool HostApplication::wait_for_publishes(std::chrono::milliseconds timeout) {
+  return !publish_window_ || publish_window_->wait_idle(timeout);
 }
 
-std::expected<void, std::string> HostApplication::subscribe_group(std::string_view group_id) {
+std::expected<void, std::string> HostApplication::subscribe_topic(std::string topic) {
   std::lock_guard<std::mutex> lock(mutex_);
 
   if (!client_) {
     return std::unexpected("Not connected");
   }
 
-  std::string topic = std::format("spBv1.0/{}/#", group_id);
-
   MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
 
   int rc = MQTTAsync_subscribe(client_.get(), topic.c_str(), config_.qos, &opts);
@@ -375,55 +746,46 @@ std::expected<void, std::string> HostApplication::subscribe_group(std::string_vi
     return std::unexpected(std::format("Failed to subscribe: {}", rc));
   }
 
-  return {};
-}
-
-std::expected<void, std::string> HostApplication::subscribe_node(std::string_view group_id,
-                                                                 std::string_view edge_node_id) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (!client_) {
-    return std::unexpected("Not connected");
-  }
-
-  std::string topic = std::format("spBv1.0/{}/+/{}/#", group_id, edge_node_id);
-
-  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
-
-  int rc = MQTTAsync_subscribe(client_.get(), topic.c_str(), config_.qos, &opts);
-  if (rc != MQTTASYNC_SUCCESS) {
-    return std::unexpected(std::format("Failed to subscribe: {}", rc));
+  // Remembered so an automatic reconnect can re-issue it
+  if (std::ranges::find(subscriptions_, topic) == subscriptions_.end()) {
+    subscriptions_.push_back(std::move(topic));
   }
 
   return {};
 }
 
-std::expected<void, std::string> HostApplication::subscribe_state(std::string_view host_id) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (!client_) {
-    return std::unexpected("Not connected");
-  }
+std::expected<void, std::string> HostApplication::subscribe_all_groups() {
+  return subscribe_topic("spBv1.0/#");
+}
 
-  std::string topic = std::format("spBv1.0/STATE/{}", host_id);
+std::expected<void, std::string> HostApplication::subscribe_group(std::string_view group_id) {
+  return subscribe_topic(std::format("spBv1.0/{}/#", group_id));
+}
 
-  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
+std::expected<void, std::string> HostApplication::subscribe_node(std::string_view group_id,
+                                                                 std::string_view edge_node_id) {
+  return subscribe_topic(std::format("spBv1.0/{}/+/{}/#", group_id, edge_node_id));
+}
 
-  int rc = MQTTAsync_subscribe(client_.get(), topic.c_str(), config_.qos, &opts);
-  if (rc != MQTTASYNC_SUCCESS) {
-    return std::unexpected(std::format("Failed to subscribe: {}", rc));
-  }
+std::expected<void, std::string> HostApplication::subscribe_state(std::string_view host_id) {
+  return subscribe_topic(std::format("spBv1.0/STATE/{}", host_id));
+}
 
-  return {};
+size_t HostApplication::node_state_shard_index(std::string_view group_id,
+                                               std::string_view edge_node_id) noexcept {
+  // Use the high bits: the low bits also pick the bucket inside the shard's map
+  size_t hash = NodeKeyHash{}(std::pair{group_id, edge_node_id});
+  return (hash >> (std::numeric_limits<size_t>::digits - 8)) % NODE_STATE_SHARDS;
 }
 
 std::optional<std::reference_wrapper<const HostApplication::NodeState>>
 HostApplication::get_node_state(std::string_view group_id, std::string_view edge_node_id) const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& shard = node_state_shards_[node_state_shard_index(group_id, edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  auto it = node_states_.find(std::make_pair(group_id, edge_node_id));
-  if (it != node_states_.end()) {
-    return std::cref(it->second);
+  auto it = shard.nodes.find(std::make_pair(group_id, edge_node_id));
+  if (it != shard.nodes.end()) {
+    return std::cref(it->second.state);
   }
   return std::nullopt;
 }
@@ -432,14 +794,15 @@ std::optional<std::string_view> HostApplication::get_metric_name(std::string_vie
                                                                  std::string_view edge_node_id,
                                                                  std::string_view device_id,
                                                                  uint64_t alias) const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& shard = node_state_shards_[node_state_shard_index(group_id, edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  auto it = node_states_.find(std::make_pair(group_id, edge_node_id));
-  if (it == node_states_.end()) {
+  auto it = shard.nodes.find(std::make_pair(group_id, edge_node_id));
+  if (it == shard.nodes.end()) {
     return std::nullopt;
   }
 
-  const auto& node_state = it->second;
+  const auto& node_state = it->second.state;
 
   if (!device_id.empty()) {
     auto device_it = node_state.devices.find(device_id);
@@ -447,42 +810,381 @@ std::optional<std::string_view> HostApplication::get_metric_name(std::string_vie
       return std::nullopt;
     }
 
-    const auto& device_state = device_it->second;
-    auto alias_it = device_state.alias_map.find(alias);
-    if (alias_it != device_state.alias_map.end()) {
-      return std::string_view(alias_it->second);
+    if (const auto* entry = device_it->second.aliases.find(alias)) {
+      return std::string_view(entry->name);
     }
     return std::nullopt;
   }
 
-  auto alias_it = node_state.alias_map.find(alias);
-  if (alias_it != node_state.alias_map.end()) {
-    return std::string_view(alias_it->second);
+  if (const auto* entry = node_state.aliases.find(alias)) {
+    return std::string_view(entry->name);
   }
   return std::nullopt;
 }
 
+namespace {
+
+// Node or device value store addressed by a (possibly empty) device id
+const ValueStore* find_value_store(const HostApplication::NodeState& node_state,
+                                   std::string_view device_id) {
+  if (device_id.empty()) {
+    return &node_state.values;
+  }
+  auto device_it = node_state.devices.find(device_id);
+  return device_it != node_state.devices.end() ? &device_it->second.values : nullptr;
+}
+
+} // namespace
+
+std::optional<ValueStore::OwnedEntry>
+HostApplication::get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                                  std::string_view device_id,
+                                  std::string_view metric_name) const {
+  const auto& shard = node_state_shards_[node_state_shard_index(group_id, edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.nodes.find(std::make_pair(group_id, edge_node_id));
+  if (it == shard.nodes.end()) {
+    return std::nullopt;
+  }
+  const auto* store = find_value_store(it->second.state, device_id);
+  const auto* entry = store ? store->find(metric_name) : nullptr;
+  if (!entry) {
+    return std::nullopt;
+  }
+  return ValueStore::OwnedEntry::copy_of(*entry);
+}
+
+std::optional<ValueStore::OwnedEntry>
+HostApplication::get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                                  std::string_view device_id, uint64_t alias) const {
+  const auto& shard = node_state_shards_[node_state_shard_index(group_id, edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.nodes.find(std::make_pair(group_id, edge_node_id));
+  if (it == shard.nodes.end()) {
+    return std::nullopt;
+  }
+  const auto* store = find_value_store(it->second.state, device_id);
+  const auto* entry = store ? store->find(alias) : nullptr;
+  if (!entry) {
+    return std::nullopt;
+  }
+  return ValueStore::OwnedEntry::copy_of(*entry);
+}
+
+std::optional<std::vector<HostApplication::MetricSnapshot>>
+HostApplication::snapshot_node_values(std::string_view group_id,
+                                      std::string_view edge_node_id) const {
+  std::vector<MetricSnapshot> snapshot;
+  bool found = visit_node_values(
+      group_id, edge_node_id, [&](std::string_view device_id, const ValueStore::Entry& metric) {
+        snapshot.push_back(MetricSnapshot{.device_id = std::string(device_id),
+                                          .metric = ValueStore::OwnedEntry::copy_of(metric)});
+      });
+  if (!found) {
+    return std::nullopt;
+  }
+  return snapshot;
+}
+
+bool HostApplication::visit_node_values(std::string_view group_id,
+                                        std::string_view edge_node_id,
+                                        const MetricVisitor& visitor) const {
+  const auto& shard = node_state_shards_[node_state_shard_index(group_id, edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.nodes.find(std::make_pair(group_id, edge_node_id));
+  if (it == shard.nodes.end()) {
+    return false;
+  }
+
+  const auto& node_state = it->second.state;
+  for (const auto& metric : node_state.values.entries()) {
+    visitor({}, metric);
+  }
+  for (const auto& [device_id, device_state] : node_state.devices) {
+    for (const auto& metric : device_state.values.entries()) {
+      visitor(device_id, metric);
+    }
+  }
+  return true;
+}
+
+bool HostApplication::should_log(LogLevel level) const noexcept {
+  return config_.log_callback && level >= config_.log_level;
+}
+
 void HostApplication::log(LogLevel level, std::string_view message) const noexcept {
-  if (config_.log_callback) {
+  if (should_log(level)) {
     config_.log_callback(level, message);
   }
 }
 
-bool HostApplication::validate_message(const Topic& topic,
-                                       const org::eclipse::tahu::protobuf::Payload& payload) {
+bool HostApplication::validate_message(const TopicView& topic,
+                                       org::eclipse::tahu::protobuf::Payload& payload) {
   if (!config_.validate_sequence) {
     return true;
   }
 
-  NodeKey key{topic.group_id, topic.edge_node_id};
-  auto& state = node_states_[key];
-  const std::string node_id = topic.group_id + "/" + topic.edge_node_id;
+  ValidationWarning warning;
+  RecoveryDecision recovery;
+  update_node_state(topic, payload, warning, recovery);
+  if (warning.issue != ValidationIssue::NONE) {
+    log_validation_warning(topic, warning);
+  }
+  if (recovery.request_rebirth) {
+    request_rebirth(topic);
+  }
+  if (recovery.drop) {
+    stats_->record_dropped_awaiting_birth();
+  }
+  return !recovery.drop;
+}
+
+void HostApplication::lose_node_state(NodeEntry& entry, RecoveryDecision& recovery) {
+  const auto& policy = config_.rebirth_recovery;
+  if (!policy.enabled) {
+    return;
+  }
+  entry.awaiting_birth = true;
+  recovery.drop = policy.drop_until_birth;
+
+  // One request per node and interval; the shared budget spreads out mass losses
+  auto now = std::chrono::steady_clock::now();
+  if (entry.last_rebirth_request != std::chrono::steady_clock::time_point{} &&
+      now - entry.last_rebirth_request < std::chrono::milliseconds(policy.min_interval_ms)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(rebirth_mutex_);
+  if (rebirth_budget_.try_acquire(1.0, now)) {
+    entry.last_rebirth_request = now;
+    recovery.request_rebirth = true;
+  }
+}
+
+void HostApplication::request_rebirth(const TopicView& topic) {
+  PayloadBuilder command;
+  command.add_metric("Node Control/Rebirth", true);
+  auto result = publish_node_command(topic.group_id, topic.edge_node_id, command);
+  if (!result) {
+    log(LogLevel::WARN, std::format("Rebirth request to {}/{} failed: {}", topic.group_id,
+                                    topic.edge_node_id, result.error()));
+    return;
+  }
+  stats_->record_rebirth_request();
+  if (should_log(LogLevel::INFO)) {
+    log(LogLevel::INFO,
+        std::format("Requested rebirth of {}/{}", topic.group_id, topic.edge_node_id));
+  }
+}
+
+void HostApplication::log_validation_warning(const TopicView& topic,
+                                             const ValidationWarning& warning) const {
+  auto node_id = std::format("{}/{}", topic.group_id, topic.edge_node_id);
+  std::string message;
+  switch (warning.issue) {
+  case ValidationIssue::NONE:
+    return;
+  case ValidationIssue::INVALID_BIRTH_SEQ:
+    message =
+        std::format("NBIRTH for {} has invalid seq: {} (expected 0)", node_id, warning.got);
+    break;
+  case ValidationIssue::MISSING_BD_SEQ:
+    message = std::format("NBIRTH for {} missing required bdSeq metric", node_id);
+    break;
+  case ValidationIssue::BD_SEQ_MISMATCH:
+    message = std::format("NDEATH bdSeq mismatch for {} (NDEATH: {}, NBIRTH: {})", node_id,
+                          warning.got, warning.expected);
+    break;
+  case ValidationIssue::BEFORE_NODE_BIRTH:
+    if (topic.message_type == MessageType::NDATA) {
+      message = std::format("Received NDATA for {} before NBIRTH", node_id);
+    } else if (topic.message_type == MessageType::DBIRTH) {
+      message = std::format("Received DBIRTH for device on {} before node NBIRTH", node_id);
+    } else {
+      message = std::format("Received DDATA for device '{}' on {} before node NBIRTH",
+                            topic.device_id, node_id);
+    }
+    break;
+  case ValidationIssue::BEFORE_DEVICE_BIRTH:
+    message = std::format("Received DDATA for device '{}' on {} before DBIRTH", topic.device_id,
+                          node_id);
+    break;
+  case ValidationIssue::SEQ_GAP:
+    if (topic.message_type == MessageType::NDATA) {
+      message = std::format("Sequence number gap for {} (got {}, expected {})", node_id,
+                            warning.got, warning.expected);
+    } else if (topic.message_type == MessageType::DBIRTH) {
+      message =
+          std::format("Sequence number gap for DBIRTH device '{}' on {} (got {}, expected {})",
+                      topic.device_id, node_id, warning.got, warning.expected);
+    } else {
+      message = std::format("Sequence number gap for device '{}' on {} (got {}, expected {})",
+                            topic.device_id, node_id, warning.got, warning.expected);
+    }
+    break;
+  case ValidationIssue::RESTORED_MISMATCH:
+    message = std::format("Restored state of {} does not know alias {}; the node has rebirthed "
+                          "since the snapshot",
+                          node_id, warning.got);
+    break;
+  case ValidationIssue::NAME_LIMIT:
+    if (topic.message_type == MessageType::NBIRTH) {
+      message = std::format("NBIRTH for {} exceeds Config::max_name_bytes; not tracked", node_id);
+    } else if (topic.message_type == MessageType::DBIRTH) {
+      message = std::format("DBIRTH for device '{}' on {} exceeds Config::max_name_bytes; not "
+                            "tracked",
+                            topic.device_id, node_id);
+    } else {
+      message = std::format("New node {} exceeds Config::max_name_bytes; not tracked", node_id);
+    }
+    break;
+  }
+  if (warning.suppressed > 0) {
+    message += std::format(" [{} similar suppressed since the last report]", warning.suppressed);
+  }
+  log(LogLevel::WARN, message);
+}
+
+std::string_view HostApplication::validation_issue_name(ValidationIssue issue) noexcept {
+  switch (issue) {
+  case ValidationIssue::NONE:
+    return "no";
+  case ValidationIssue::INVALID_BIRTH_SEQ:
+    return "NBIRTH seq";
+  case ValidationIssue::MISSING_BD_SEQ:
+    return "missing bdSeq";
+  case ValidationIssue::BD_SEQ_MISMATCH:
+    return "bdSeq mismatch";
+  case ValidationIssue::BEFORE_NODE_BIRTH:
+    return "before NBIRTH";
+  case ValidationIssue::BEFORE_DEVICE_BIRTH:
+    return "before DBIRTH";
+  case ValidationIssue::SEQ_GAP:
+    return "sequence gap";
+  case ValidationIssue::RESTORED_MISMATCH:
+    return "restored state mismatch";
+  case ValidationIssue::NAME_LIMIT:
+    return "name limit";
+  }
+  std::unreachable();
+}
+
+void HostApplication::flush_suppressed_warnings() {
+  if (!should_log(LogLevel::WARN) || config_.log_coalesce_interval_ms <= 0) {
+    return;
+  }
+
+  std::vector<std::string> messages;
+  for (auto& shard : node_state_shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& [key, entry] : shard.nodes) {
+      for (size_t i = 0; i < VALIDATION_ISSUES; i++) {
+        if (auto suppressed = std::exchange(entry.warnings[i].suppressed, 0)) {
+          messages.push_back(std::format(
+              "{} suppressed {} warnings for {}/{} since the last report", suppressed,
+              validation_issue_name(static_cast<ValidationIssue>(i)), key.group_id.view(),
+              key.edge_node_id.view()));
+        }
+      }
+    }
+  }
+  for (const auto& message : messages) {
+    log(LogLevel::WARN, message);
+  }
+}
+
+bool HostApplication::update_node_state(const TopicView& topic,
+                                        org::eclipse::tahu::protobuf::Payload& payload,
+                                        ValidationWarning& warning, RecoveryDecision& recovery) {
+  auto& shard = node_state_shards_[node_state_shard_index(topic.group_id, topic.edge_node_id)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // Probe with the topic's views; the key is only interned for the first message of a node
+  auto node_it = shard.nodes.find(std::make_pair(topic.group_id, topic.edge_node_id));
+  if (node_it == shard.nodes.end()) {
+    auto group_id = names_.try_intern(topic.group_id);
+    auto edge_node_id = group_id ? names_.try_intern(topic.edge_node_id) : std::nullopt;
+    if (!edge_node_id) {
+      // Not coalesced: a node that is not tracked has no warning windows
+      warning = {.issue = ValidationIssue::NAME_LIMIT, .got = 0, .expected = 0, .suppressed = 0};
+      return false;
+    }
+    node_it = shard.nodes.try_emplace(NodeKey{*group_id, *edge_node_id}).first;
+  }
+  auto& state = node_it->second.state;
+  // Only decides whether to log; formatting happens in log_validation_warning() after unlocking
+  auto warn = [this, &entry = node_it->second, &warning](ValidationIssue issue, uint64_t got = 0,
+                                                         uint64_t expected = 0) {
+    if (!should_log(LogLevel::WARN)) {
+      return;
+    }
+    auto& window = entry.warnings[std::to_underlying(issue)];
+    if (config_.log_coalesce_interval_ms > 0) {
+      auto now = std::chrono::steady_clock::now();
+      auto interval = std::chrono::milliseconds(config_.log_coalesce_interval_ms);
+      if (window.last_logged != std::chrono::steady_clock::time_point{} &&
+          now - window.last_logged < interval) {
+        window.suppressed++;
+        return;
+      }
+      window.last_logged = now;
+    }
+    warning = {.issue = issue,
+               .got = got,
+               .expected = expected,
+               .suppressed = std::exchange(window.suppressed, 0)};
+  };
+
+  // Data of a node awaiting rebirth describes a session the host can no longer follow
+  auto& entry = node_it->second;
+  if (entry.awaiting_birth && (topic.message_type == MessageType::NDATA ||
+                               topic.message_type == MessageType::DBIRTH ||
+                               topic.message_type == MessageType::DDATA)) {
+    lose_node_state(entry, recovery);
+    if (recovery.drop) {
+      return false;
+    }
+  }
+
+  // A node restored from a snapshot resumes a session whose traffic went by while the host was
+  // down: its next seq is the new baseline, and data must match the aliases of the saved birth
+  if (entry.restored && topic.message_type != MessageType::NBIRTH) {
+    bool carries_seq = topic.message_type == MessageType::NDATA ||
+                       topic.message_type == MessageType::DBIRTH ||
+                       topic.message_type == MessageType::DDATA;
+    if (entry.resync_seq && carries_seq && payload.has_seq()) {
+      state.last_seq = (payload.seq() + SEQ_NUMBER_MAX - 1) % SEQ_NUMBER_MAX;
+      entry.resync_seq = false;
+    }
+
+    const AliasRegistry* aliases = nullptr;
+    if (topic.message_type == MessageType::NDATA) {
+      aliases = &state.aliases;
+    } else if (topic.message_type == MessageType::DDATA) {
+      auto device_it = state.devices.find(topic.device_id);
+      aliases = device_it != state.devices.end() ? &device_it->second.aliases : nullptr;
+    }
+    if (aliases) {
+      auto unknown = std::ranges::find_if(payload.metrics(), [aliases](const auto& metric) {
+        return metric.has_alias() && aliases->find(metric.alias()) == nullptr;
+      });
+      if (unknown != payload.metrics().end()) {
+        warn(ValidationIssue::RESTORED_MISMATCH, unknown->alias());
+        entry.restored = false;
+        lose_node_state(entry, recovery);
+        if (recovery.drop) {
+          return false;
+        }
+      }
+    }
+  }
 
   switch (topic.message_type) {
   case MessageType::NBIRTH: {
     if (payload.has_seq() && payload.seq() != 0) {
-      log(LogLevel::WARN,
-          std::format("NBIRTH for {} has invalid seq: {} (expected 0)", node_id, payload.seq()));
+      warn(ValidationIssue::INVALID_BIRTH_SEQ, payload.seq());
       return false;
     }
 
@@ -497,7 +1199,12 @@ bool HostApplication::validate_message(const Topic& topic,
     }
 
     if (!has_bdseq) {
-      log(LogLevel::WARN, std::format("NBIRTH for {} missing required bdSeq metric", node_id));
+      warn(ValidationIssue::MISSING_BD_SEQ);
+      return false;
+    }
+
+    if (!birth_names_fit(names_, {}, payload)) {
+      warn(ValidationIssue::NAME_LIMIT);
       return false;
     }
 
@@ -505,13 +1212,14 @@ bool HostApplication::validate_message(const Topic& topic,
     state.last_seq = 0;
     state.is_online = true;
     state.birth_received = true;
+    entry.awaiting_birth = false;
+    entry.restored = false;
+    entry.resync_seq = false;
     state.birth_timestamp = payload.timestamp();
 
-    state.alias_map.clear();
-    for (const auto& metric : payload.metrics()) {
-      if (metric.has_alias() && metric.has_name()) {
-        state.alias_map[metric.alias()] = metric.name();
-      }
+    state.aliases.rebuild(payload, names_);
+    if (config_.track_values) {
+      state.values.rebuild(payload, names_);
     }
 
     return true;
@@ -527,8 +1235,8 @@ bool HostApplication::validate_message(const Topic& topic,
     }
 
     if (state.birth_received && bd_seq != state.bd_seq) {
-      log(LogLevel::WARN, std::format("NDEATH bdSeq mismatch for {} (NDEATH: {}, NBIRTH: {})",
-                                      node_id, bd_seq, state.bd_seq));
+      stats_->record_bd_seq_mismatch();
+      warn(ValidationIssue::BD_SEQ_MISMATCH, bd_seq, state.bd_seq);
     }
 
     state.is_online = false;
@@ -537,7 +1245,8 @@ bool HostApplication::validate_message(const Topic& topic,
 
   case MessageType::NDATA: {
     if (!state.birth_received) {
-      log(LogLevel::WARN, std::format("Received NDATA for {} before NBIRTH", node_id));
+      warn(ValidationIssue::BEFORE_NODE_BIRTH);
+      lose_node_state(entry, recovery);
       return false;
     }
 
@@ -546,11 +1255,22 @@ bool HostApplication::validate_message(const Topic& topic,
       uint64_t expected_seq = (state.last_seq + 1) % SEQ_NUMBER_MAX;
 
       if (seq != expected_seq) {
-        log(LogLevel::WARN, std::format("Sequence number gap for {} (got {}, expected {})", node_id,
-                                        seq, expected_seq));
+        stats_->record_seq_gap();
+        warn(ValidationIssue::SEQ_GAP, seq, expected_seq);
+        lose_node_state(entry, recovery);
       }
 
       state.last_seq = seq;
+      if (recovery.drop) {
+        return false;
+      }
+    }
+
+    if (config_.track_values) {
+      state.values.update(payload);
+    }
+    if (config_.resolve_aliases) {
+      resolve_metric_aliases(state.aliases, payload);
     }
 
     return true;
@@ -558,8 +1278,8 @@ bool HostApplication::validate_message(const Topic& topic,
 
   case MessageType::DBIRTH: {
     if (!state.birth_received) {
-      log(LogLevel::WARN,
-          std::format("Received DBIRTH for device on {} before node NBIRTH", node_id));
+      warn(ValidationIssue::BEFORE_NODE_BIRTH);
+      lose_node_state(entry, recovery);
       return false;
     }
 
@@ -568,23 +1288,33 @@ bool HostApplication::validate_message(const Topic& topic,
       uint64_t expected_seq = (state.last_seq + 1) % SEQ_NUMBER_MAX;
 
       if (seq != expected_seq) {
-        log(LogLevel::WARN,
-            std::format("Sequence number gap for DBIRTH device '{}' on {} (got {}, expected {})",
-                        topic.device_id, node_id, seq, expected_seq));
+        stats_->record_seq_gap();
+        warn(ValidationIssue::SEQ_GAP, seq, expected_seq);
+        lose_node_state(entry, recovery);
       }
 
       state.last_seq = seq;
+      if (recovery.drop) {
+        return false;
+      }
     }
 
-    auto& device_state = state.devices[topic.device_id];
+    auto device_it = state.devices.find(topic.device_id);
+    if (!birth_names_fit(names_, device_it == state.devices.end() ? topic.device_id : "",
+                         payload)) {
+      warn(ValidationIssue::NAME_LIMIT);
+      return false;
+    }
+    if (device_it == state.devices.end()) {
+      device_it = state.devices.try_emplace(names_.intern(topic.device_id)).first;
+    }
+    auto& device_state = device_it->second;
     device_state.is_online = true;
     device_state.birth_received = true;
 
-    device_state.alias_map.clear();
-    for (const auto& metric : payload.metrics()) {
-      if (metric.has_alias() && metric.has_name()) {
-        device_state.alias_map[metric.alias()] = metric.name();
-      }
+    device_state.aliases.rebuild(payload, names_);
+    if (config_.track_values) {
+      device_state.values.rebuild(payload, names_);
     }
 
     return true;
@@ -592,15 +1322,15 @@ bool HostApplication::validate_message(const Topic& topic,
 
   case MessageType::DDATA: {
     if (!state.birth_received) {
-      log(LogLevel::WARN, std::format("Received DDATA for device '{}' on {} before node NBIRTH",
-                                      topic.device_id, node_id));
+      warn(ValidationIssue::BEFORE_NODE_BIRTH);
+      lose_node_state(entry, recovery);
       return false;
     }
 
     auto device_it = state.devices.find(topic.device_id);
     if (device_it == state.devices.end() || !device_it->second.birth_received) {
-      log(LogLevel::WARN, std::format("Received DDATA for device '{}' on {} before DBIRTH",
-                                      topic.device_id, node_id));
+      warn(ValidationIssue::BEFORE_DEVICE_BIRTH);
+      lose_node_state(entry, recovery);
       return false;
     }
 
@@ -609,12 +1339,22 @@ bool HostApplication::validate_message(const Topic& topic,
       uint64_t expected_seq = (state.last_seq + 1) % SEQ_NUMBER_MAX;
 
       if (seq != expected_seq) {
-        log(LogLevel::WARN,
-            std::format("Sequence number gap for device '{}' on {} (got {}, expected {})",
-                        topic.device_id, node_id, seq, expected_seq));
+        stats_->record_seq_gap();
+        warn(ValidationIssue::SEQ_GAP, seq, expected_seq);
+        lose_node_state(entry, recovery);
       }
 
       state.last_seq = seq;
+      if (recovery.drop) {
+        return false;
+      }
+    }
+
+    if (config_.track_values) {
+      device_it->second.values.update(payload);
+    }
+    if (config_.resolve_aliases) {
+      resolve_metric_aliases(device_it->second.aliases, payload);
     }
 
     return true;
@@ -648,62 +1388,216 @@ int HostApplication::on_message_arrived(void* context, char* topicName, int topi
     return 1;
   }
 
-  std::string topic_str(topicName, topicLen > 0 ? topicLen : strlen(topicName));
+  std::string_view topic_str(topicName,
+                             topicLen > 0 ? static_cast<size_t>(topicLen) : strlen(topicName));
+  std::span<const uint8_t> payload_data(static_cast<const uint8_t*>(message->payload),
+                                        static_cast<size_t>(message->payloadlen));
+
+  host_app->inject_message(topic_str, payload_data);
+
+  MQTTAsync_freeMessage(&message);
+  MQTTAsync_free(topicName);
+  return 1;
+}
+
+void HostApplication::inject_message(std::string_view topic,
+                                     std::span<const uint8_t> payload_data) {
+  std::shared_lock<std::shared_mutex> dispatch_lock(dispatch_mutex_);
+  if (!dispatcher_) {
+    dispatch_lock.unlock();
+    handle_message(topic, payload_data);
+    return;
+  }
+
+  // Shard on the node so each node's messages stay ordered on one worker
+  size_t shard_key = 0;
+  auto view = TopicView::parse(topic);
+  if (view) {
+    shard_key = NodeKeyHash{}(std::pair{view->group_id, view->edge_node_id});
+  }
+
+  // A payload nobody receives is scanned here and only its header is queued, so the worker
+  // does no decoding and the payload is never copied
+  if (view && view->message_type != MessageType::STATE && !should_deliver(*view) &&
+      !needs_payload_for_state(view->message_type)) {
+    detail::wire::PayloadHeader header;
+    bool scanned = scan_undelivered(*view, payload_data, header);
+    if (!needs_inflating(view->message_type, header)) {
+      stats_->record_in(view->message_type, payload_data.size());
+      if (scanned) {
+        dispatcher_->submit(shard_key, DispatchPool::Message{.topic = std::string(topic),
+                                                             .payload = {},
+                                                             .header = header});
+      }
+      return;
+    }
+    // Queued whole for the worker to inflate: a compressed NDEATH keeps its bdSeq in the body
+  }
+  dispatcher_->submit(shard_key,
+                      DispatchPool::Message{.topic = std::string(topic),
+                                            .payload = std::vector<uint8_t>(payload_data.begin(),
+                                                                            payload_data.end()),
+                                            .header = std::nullopt});
+}
+
+const MessageCallback& HostApplication::callback_for(MessageType type) const noexcept {
+  const auto& callback = config_.type_callbacks[std::to_underlying(type)];
+  return callback ? callback : config_.message_callback;
+}
+
+bool HostApplication::should_deliver(const TopicView& topic) const {
+  return callback_for(topic.message_type) &&
+         (!config_.message_filter || config_.message_filter(topic));
+}
+
+bool HostApplication::needs_payload_for_state(MessageType type) const noexcept {
+  if (!config_.validate_sequence) {
+    return false;
+  }
+  switch (type) {
+  case MessageType::NBIRTH:
+  case MessageType::DBIRTH:
+    return true; // Alias and value registries come from the metrics
+  case MessageType::NDATA:
+  case MessageType::DDATA:
+    return config_.track_values;
+  case MessageType::NDEATH: // bdSeq is found by the scan
+  case MessageType::DDEATH:
+  case MessageType::NCMD:
+  case MessageType::DCMD:
+  case MessageType::STATE:
+    return false;
+  }
+  std::unreachable();
+}
+
+bool HostApplication::scan_undelivered(const TopicView& topic,
+                                       std::span<const uint8_t> payload_data,
+                                       detail::wire::PayloadHeader& header) {
+  // Nobody reads the metrics: only what sequence tracking needs is decoded
+  if (!config_.validate_sequence) {
+    stats_->record_payload_skipped();
+    return false;
+  }
+  if (!detail::wire::scan_payload(payload_data, header,
+                                  topic.message_type == MessageType::NDEATH)) {
+    stats_->record_payload_skipped();
+    stats_->record_parse_failure();
+    log(LogLevel::ERROR, "Failed to parse Sparkplug B payload");
+    return false;
+  }
+  // A compressed NDEATH is not skipped: the caller decodes it in full
+  if (!needs_inflating(topic.message_type, header)) {
+    stats_->record_payload_skipped();
+  }
+  return true;
+}
+
+void HostApplication::validate_scanned(const TopicView& topic,
+                                       const detail::wire::PayloadHeader& header) {
+  // A stand-in payload with just the fields update_node_state() reads for these types
+  org::eclipse::tahu::protobuf::Payload payload;
+  if (header.timestamp) {
+    payload.set_timestamp(*header.timestamp);
+  }
+  if (header.seq) {
+    payload.set_seq(*header.seq);
+  }
+  if (header.bd_seq) {
+    auto* metric = payload.add_metrics();
+    metric->set_name("bdSeq");
+    metric->set_long_value(*header.bd_seq);
+  }
+  validate_message(topic, payload);
+}
 
+void HostApplication::handle_message(std::string_view topic_str,
+                                     std::span<const uint8_t> payload_data) {
   if (topic_str.starts_with("spBv1.0/STATE/")) {
-    std::string state_value(static_cast<char*>(message->payload), message->payloadlen);
+    stats_->record_in(MessageType::STATE, payload_data.size());
+    TopicView state_view{.group_id = {},
+                         .message_type = MessageType::STATE,
+                         .edge_node_id = topic_str.substr(14), // After "spBv1.0/STATE/"
+                         .device_id = {}};
+    if (!should_deliver(state_view)) {
+      return;
+    }
 
     org::eclipse::tahu::protobuf::Payload dummy_payload;
+    auto started = std::chrono::steady_clock::now();
+    try {
+      callback_for(MessageType::STATE)(state_view.to_topic(), dummy_payload);
+    } catch (...) {
+    }
+    stats_->record_callback_duration(std::chrono::steady_clock::now() - started);
+    return;
+  }
 
-    Topic state_topic{.group_id = "",
-                      .message_type = MessageType::STATE,
-                      .edge_node_id = topic_str.substr(14), // After "spBv1.0/STATE/"
-                      .device_id = ""};
+  auto topic_view = TopicView::parse(topic_str);
 
-    if (host_app->config_.message_callback) {
-      try {
-        host_app->config_.message_callback(state_topic, dummy_payload);
-      } catch (...) {
-      }
+  if (!topic_view) {
+    if (should_log(LogLevel::DEBUG)) {
+      log(LogLevel::DEBUG, std::format("Ignoring non-Sparkplug topic: {}", topic_str));
     }
+    return;
+  }
+  stats_->record_in(topic_view->message_type, payload_data.size());
 
-    MQTTAsync_freeMessage(&message);
-    MQTTAsync_free(topicName);
-    return 1;
+  bool deliver = should_deliver(*topic_view);
+  if (!deliver && !needs_payload_for_state(topic_view->message_type)) {
+    detail::wire::PayloadHeader header;
+    if (!scan_undelivered(*topic_view, payload_data, header)) {
+      return;
+    }
+    if (!needs_inflating(topic_view->message_type, header)) {
+      validate_scanned(*topic_view, header);
+      return;
+    }
+    // A compressed NDEATH carries its bdSeq inside the body, so it is decoded in full
   }
 
-  auto topic_result = Topic::parse(topic_str);
+  std::optional<detail::ArenaLease> arena_lease;
+  org::eclipse::tahu::protobuf::Payload heap_payload;
+  org::eclipse::tahu::protobuf::Payload* payload = &heap_payload;
+  if (config_.use_arena) {
+    arena_lease.emplace(config_.arena_block_size);
+    payload = arena_lease->create_payload();
+  }
 
-  if (!topic_result) {
-    host_app->log(LogLevel::DEBUG, std::format("Ignoring non-Sparkplug topic: {}", topic_str));
-    MQTTAsync_freeMessage(&message);
-    MQTTAsync_free(topicName);
-    return 1;
+  if (!payload->ParseFromArray(payload_data.data(), static_cast<int>(payload_data.size()))) {
+    stats_->record_parse_failure();
+    log(LogLevel::ERROR, "Failed to parse Sparkplug B payload");
+    return;
   }
 
-  org::eclipse::tahu::protobuf::Payload payload;
-  if (!payload.ParseFromArray(message->payload, message->payloadlen)) {
-    host_app->log(LogLevel::ERROR, "Failed to parse Sparkplug B payload");
-    MQTTAsync_freeMessage(&message);
-    MQTTAsync_free(topicName);
-    return 1;
+  // Compressed payloads are unwrapped here, so validation and callbacks see the original
+  std::optional<org::eclipse::tahu::protobuf::Payload> heap_inflated;
+  if (is_compressed_payload(*payload)) {
+    auto& inflated = inflate_scratch_buffer();
+    auto result = decompress_payload(*payload, inflated);
+    payload = arena_lease ? arena_lease->create_payload() : &heap_inflated.emplace();
+    if (!result ||
+        !payload->ParseFromArray(inflated.data(), static_cast<int>(inflated.size()))) {
+      stats_->record_parse_failure();
+      log(LogLevel::ERROR,
+          std::format("Failed to decompress Sparkplug B payload: {}",
+                      result ? "invalid inner payload" : result.error()));
+      return;
+    }
   }
 
-  {
-    std::lock_guard<std::mutex> lock(host_app->mutex_);
-    host_app->validate_message(*topic_result, payload);
+  if (!validate_message(*topic_view, *payload)) {
+    return;
   }
 
-  if (host_app->config_.message_callback) {
+  if (deliver) {
+    auto started = std::chrono::steady_clock::now();
     try {
-      host_app->config_.message_callback(*topic_result, payload);
+      callback_for(topic_view->message_type)(topic_view->to_topic(), *payload);
     } catch (...) {
     }
+    stats_->record_callback_duration(std::chrono::steady_clock::now() - started);
   }
-
-  MQTTAsync_freeMessage(&message);
-  MQTTAsync_free(topicName);
-  return 1;
 }
 
 void HostApplication::on_connection_lost(void* context, char* cause) {
@@ -712,9 +1606,10 @@ void HostApplication::on_connection_lost(void* context, char* cause) {
     return;
   }
 
+  bool was_connected = false;
   {
     std::lock_guard<std::mutex> lock(host_app->mutex_);
-    host_app->is_connected_ = false;
+    was_connected = std::exchange(host_app->is_connected_, false);
   }
 
   if (cause) {
@@ -722,6 +1617,48 @@ void HostApplication::on_connection_lost(void* context, char* cause) {
   } else {
     host_app->log(LogLevel::WARN, "Connection lost");
   }
+
+  if (was_connected && host_app->config_.reconnect.enabled && host_app->reconnector_) {
+    host_app->reconnector_->start(
+        [host_app]() { return host_app->reconnect_and_replay(); },
+        [host_app](size_t attempt, const std::string& error) {
+          host_app->log(LogLevel::WARN,
+                        std::format("Reconnect attempt {} failed: {}", attempt + 1, error));
+        });
+  }
+}
+
+std::expected<void, std::string> HostApplication::reconnect_and_replay() {
+  auto result = connect();
+  if (!result) {
+    return result;
+  }
+
+  std::vector<std::string> subscriptions;
+  bool state_online = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriptions = subscriptions_;
+    state_online = state_online_;
+  }
+
+  for (auto& topic : subscriptions) {
+    if (auto subscribed = subscribe_topic(std::move(topic)); !subscribed) {
+      return subscribed;
+    }
+  }
+
+  if (state_online) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    if (auto state = publish_state_birth(static_cast<uint64_t>(timestamp)); !state) {
+      return state;
+    }
+  }
+
+  log(LogLevel::INFO, "Reconnected");
+  return {};
 }
 
 } // namespace sparkplug
@@ -0,0 +1,424 @@
+// src/host_snapshot.cpp
+// HostApplication::save_snapshot() and restore_snapshot(), behind Config::snapshot
+#include "sparkplug/host_application.hpp"
+
+#include "sparkplug/metric_value.hpp"
+#include "sparkplug/snapshot.hpp"
+#include "sparkplug/wire_format.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sparkplug {
+
+namespace detail {
+
+PeriodicTask::~PeriodicTask() {
+  stop();
+}
+
+void PeriodicTask::start(std::chrono::milliseconds interval, Task task) {
+  thread_.start([interval, task = std::move(task)](const WorkerThread::Run& worker) {
+    while (!worker.wait_for(interval)) {
+      task();
+    }
+  });
+}
+
+void PeriodicTask::stop() {
+  thread_.stop();
+}
+
+} // namespace detail
+
+namespace {
+
+using Payload = org::eclipse::tahu::protobuf::Payload;
+
+// Layout: magic, node count (padded varint, patched once the nodes are written), then per node
+//   [group id][edge node id][bdSeq][seq][birth timestamp][flags][birth][device count]
+// followed per device by [device id][flags][birth]. Integers are varints; strings and births
+// are length-prefixed. A birth is a serialized Payload holding the node's alias map and last
+// values, so restoring goes through the same rebuild() as a live NBIRTH/DBIRTH.
+constexpr std::string_view SNAPSHOT_MAGIC{"SPBSNAP\x01", 8};
+constexpr size_t COUNT_WIDTH = 10;
+constexpr uint64_t FLAG_ONLINE = 1;
+
+void append_string(std::vector<uint8_t>& out, std::string_view text) {
+  detail::wire::append_varint(out, text.size());
+  detail::wire::append_bytes(
+      out, std::span(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+}
+
+// Last values when they are tracked, else the alias map with the values it kept
+void append_birth(std::vector<uint8_t>& out, const AliasRegistry& aliases,
+                  const ValueStore& values, Payload& scratch) {
+  scratch.Clear();
+  if (!values.empty()) {
+    for (const auto& entry : values.entries()) {
+      auto* metric = scratch.add_metrics();
+      metric->set_name(std::string(entry.name.view()));
+      if (entry.has_alias) {
+        metric->set_alias(entry.alias);
+      }
+      if (entry.datatype != DataType::Unknown) {
+        metric->set_datatype(std::to_underlying(entry.datatype));
+      }
+      metric->set_timestamp(entry.timestamp);
+      if (entry.is_historical) {
+        metric->set_is_historical(true);
+      }
+      metric_value_to_proto(entry.value, entry.datatype, metric);
+    }
+  } else {
+    aliases.for_each([&](uint64_t alias, const AliasRegistry::Entry& entry) {
+      auto* metric = scratch.add_metrics();
+      metric->set_name(std::string(entry.name.view()));
+      metric->set_alias(alias);
+      if (entry.datatype != DataType::Unknown) {
+        metric->set_datatype(std::to_underlying(entry.datatype));
+      }
+      metric_value_to_proto(entry.value, entry.datatype, metric);
+    });
+  }
+
+  size_t size = scratch.ByteSizeLong();
+  detail::wire::append_varint(out, size);
+  size_t offset = out.size();
+  out.resize(offset + size);
+  scratch.SerializeWithCachedSizesToArray(out.data() + offset);
+}
+
+class SnapshotReader {
+public:
+  explicit SnapshotReader(std::span<const uint8_t> data) noexcept : data_(data) {
+  }
+
+  bool varint(uint64_t& value) {
+    return detail::wire::read_varint(data_, pos_, value);
+  }
+
+  bool bytes(std::span<const uint8_t>& out) {
+    uint64_t length = 0;
+    if (!varint(length) || length > data_.size() - pos_) {
+      return false;
+    }
+    out = data_.subspan(pos_, length);
+    pos_ += length;
+    return true;
+  }
+
+  bool text(std::string& out) {
+    std::span<const uint8_t> raw;
+    if (!bytes(raw)) {
+      return false;
+    }
+    out.assign(reinterpret_cast<const char*>(raw.data()), raw.size());
+    return true;
+  }
+
+  bool birth(Payload& out) {
+    std::span<const uint8_t> raw;
+    return bytes(raw) && out.ParseFromArray(raw.data(), static_cast<int>(raw.size()));
+  }
+
+  [[nodiscard]] bool at_end() const noexcept {
+    return pos_ == data_.size();
+  }
+
+private:
+  std::span<const uint8_t> data_;
+  size_t pos_{0};
+};
+
+struct SavedDevice {
+  std::string device_id;
+  bool is_online{false};
+  Payload birth;
+};
+
+struct SavedNode {
+  std::string group_id;
+  std::string edge_node_id;
+  uint64_t bd_seq{0};
+  uint64_t last_seq{0};
+  uint64_t birth_timestamp{0};
+  bool is_online{false};
+  Payload birth;
+  std::vector<SavedDevice> devices;
+};
+
+// Decodes the whole file up front so a corrupt snapshot changes nothing
+std::expected<std::vector<SavedNode>, std::string> parse_snapshot(std::span<const uint8_t> data) {
+  if (data.size() < SNAPSHOT_MAGIC.size() + COUNT_WIDTH ||
+      !std::equal(SNAPSHOT_MAGIC.begin(), SNAPSHOT_MAGIC.end(), data.begin())) {
+    return std::unexpected("not a Sparkplug host snapshot");
+  }
+
+  SnapshotReader reader(data.subspan(SNAPSHOT_MAGIC.size()));
+  uint64_t node_count = 0;
+  if (!reader.varint(node_count)) {
+    return std::unexpected("truncated header");
+  }
+
+  std::vector<SavedNode> nodes;
+  for (uint64_t i = 0; i < node_count; i++) {
+    SavedNode node;
+    uint64_t flags = 0;
+    uint64_t device_count = 0;
+    if (!reader.text(node.group_id) || !reader.text(node.edge_node_id) ||
+        !reader.varint(node.bd_seq) || !reader.varint(node.last_seq) ||
+        !reader.varint(node.birth_timestamp) || !reader.varint(flags) ||
+        !reader.birth(node.birth) || !reader.varint(device_count)) {
+      return std::unexpected(std::format("node {} of {} is corrupt", i + 1, node_count));
+    }
+    node.is_online = (flags & FLAG_ONLINE) != 0;
+
+    for (uint64_t j = 0; j < device_count; j++) {
+      SavedDevice device;
+      if (!reader.text(device.device_id) || !reader.varint(flags) ||
+          !reader.birth(device.birth)) {
+        return std::unexpected(std::format("device {} of node {}/{} is corrupt", j + 1,
+                                           node.group_id, node.edge_node_id));
+      }
+      device.is_online = (flags & FLAG_ONLINE) != 0;
+      node.devices.push_back(std::move(device));
+    }
+    nodes.push_back(std::move(node));
+  }
+
+  if (!reader.at_end()) {
+    return std::unexpected("trailing data after the last node");
+  }
+  return nodes;
+}
+
+// Writes through a mapping of path.tmp, then renames it over path
+std::expected<void, std::string> write_snapshot_file(const std::string& path,
+                                                     std::span<const uint8_t> data) {
+  auto temp_path = path + ".tmp";
+  int fd = ::open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    return std::unexpected(
+        std::format("Failed to open snapshot file '{}': {}", temp_path, std::strerror(errno)));
+  }
+
+  auto fail = [&](std::string_view what) {
+    auto error = std::format("Failed to {} snapshot file '{}': {}", what, temp_path,
+                             std::strerror(errno));
+    ::close(fd);
+    ::unlink(temp_path.c_str());
+    return std::unexpected(std::move(error));
+  };
+
+  if (::ftruncate(fd, static_cast<off_t>(data.size())) != 0) {
+    return fail("size");
+  }
+  void* base = ::mmap(nullptr, data.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    return fail("map");
+  }
+  std::memcpy(base, data.data(), data.size());
+  int synced = ::msync(base, data.size(), MS_SYNC);
+  ::munmap(base, data.size());
+  if (synced != 0) {
+    return fail("sync");
+  }
+  ::close(fd);
+
+  if (::rename(temp_path.c_str(), path.c_str()) != 0) {
+    auto error = std::format("Failed to replace snapshot file '{}': {}", path,
+                             std::strerror(errno));
+    ::unlink(temp_path.c_str());
+    return std::unexpected(std::move(error));
+  }
+  return {};
+}
+
+} // namespace
+
+std::expected<size_t, std::string> HostApplication::save_snapshot(const std::string& path) const {
+  std::lock_guard<std::mutex> save_lock(snapshot_mutex_);
+
+  std::vector<uint8_t> out(SNAPSHOT_MAGIC.begin(), SNAPSHOT_MAGIC.end());
+  out.resize(out.size() + COUNT_WIDTH);
+  Payload scratch;
+  size_t node_count = 0;
+
+  for (const auto& shard : node_state_shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const auto& [key, entry] : shard.nodes) {
+      const auto& state = entry.state;
+      // A node awaiting rebirth has nothing trustworthy to restore
+      if (!state.birth_received || entry.awaiting_birth) {
+        continue;
+      }
+
+      append_string(out, key.group_id.view());
+      append_string(out, key.edge_node_id.view());
+      detail::wire::append_varint(out, state.bd_seq);
+      detail::wire::append_varint(out, state.last_seq);
+      detail::wire::append_varint(out, state.birth_timestamp);
+      detail::wire::append_varint(out, state.is_online ? FLAG_ONLINE : 0);
+      append_birth(out, state.aliases, state.values, scratch);
+
+      auto born = [](const auto& device) { return device.second.birth_received; };
+      detail::wire::append_varint(
+          out, static_cast<uint64_t>(std::ranges::count_if(state.devices, born)));
+      for (const auto& [device_id, device] : state.devices) {
+        if (!device.birth_received) {
+          continue;
+        }
+        append_string(out, device_id.view());
+        detail::wire::append_varint(out, device.is_online ? FLAG_ONLINE : 0);
+        append_birth(out, device.aliases, device.values, scratch);
+      }
+      node_count++;
+    }
+  }
+  detail::wire::write_padded_varint(out.data() + SNAPSHOT_MAGIC.size(), node_count, COUNT_WIDTH);
+
+  auto written = write_snapshot_file(path, out);
+  if (!written) {
+    return std::unexpected(std::move(written.error()));
+  }
+  return node_count;
+}
+
+std::expected<size_t, std::string> HostApplication::restore_snapshot(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::unexpected(
+        std::format("Failed to open snapshot file '{}': {}", path, std::strerror(errno)));
+  }
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    auto error =
+        std::format("Failed to stat snapshot file '{}': {}", path, std::strerror(errno));
+    ::close(fd);
+    return std::unexpected(std::move(error));
+  }
+  auto size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return std::unexpected(std::format("Snapshot file '{}' is empty", path));
+  }
+
+  void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return std::unexpected(
+        std::format("Failed to map snapshot file '{}': {}", path, std::strerror(errno)));
+  }
+  auto parsed = parse_snapshot(std::span(static_cast<const uint8_t*>(base), size));
+  ::munmap(base, size);
+  if (!parsed) {
+    return std::unexpected(std::format("Corrupt snapshot file '{}': {}", path, parsed.error()));
+  }
+
+  size_t restored = 0;
+  for (const auto& node : *parsed) {
+    auto& shard = node_state_shards_[node_state_shard_index(node.group_id, node.edge_node_id)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto node_it = shard.nodes.find(std::make_pair(std::string_view(node.group_id),
+                                                   std::string_view(node.edge_node_id)));
+    if (node_it == shard.nodes.end()) {
+      node_it = shard.nodes
+                    .try_emplace(NodeKey{names_.intern(node.group_id),
+                                         names_.intern(node.edge_node_id)})
+                    .first;
+    }
+    auto& entry = node_it->second;
+    auto& state = entry.state;
+    // What the host has seen live is newer than anything in the file
+    if (state.birth_received) {
+      continue;
+    }
+
+    state.bd_seq = node.bd_seq;
+    state.last_seq = node.last_seq;
+    state.birth_timestamp = node.birth_timestamp;
+    state.is_online = node.is_online;
+    state.birth_received = true;
+    state.aliases.rebuild(node.birth, names_);
+    if (config_.track_values) {
+      state.values.rebuild(node.birth, names_);
+    }
+
+    for (const auto& device : node.devices) {
+      auto device_it = state.devices.find(device.device_id);
+      if (device_it == state.devices.end()) {
+        device_it = state.devices.try_emplace(names_.intern(device.device_id)).first;
+      }
+      auto& device_state = device_it->second;
+      device_state.is_online = device.is_online;
+      device_state.birth_received = true;
+      device_state.aliases.rebuild(device.birth, names_);
+      if (config_.track_values) {
+        device_state.values.rebuild(device.birth, names_);
+      }
+    }
+
+    entry.awaiting_birth = false;
+    entry.restored = true;
+    entry.resync_seq = true;
+    restored++;
+  }
+  return restored;
+}
+
+void HostApplication::restore_configured_snapshot() {
+  const auto& path = config_.snapshot.path;
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (path.empty() || std::exchange(snapshot_restored_, true)) {
+      return;
+    }
+  }
+
+  // No file yet is a first start, not an error
+  if (::access(path.c_str(), F_OK) != 0) {
+    return;
+  }
+  auto restored = restore_snapshot(path);
+  if (!restored) {
+    log(LogLevel::WARN, std::format("Starting without node state: {}", restored.error()));
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_has_state_ = true;
+  }
+  if (should_log(LogLevel::INFO)) {
+    log(LogLevel::INFO, std::format("Restored {} nodes from snapshot '{}'", *restored, path));
+  }
+}
+
+void HostApplication::save_configured_snapshot() const {
+  if (config_.snapshot.path.empty()) {
+    return;
+  }
+  {
+    // A host that never connected would replace the previous run's state with nothing
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (!snapshot_has_state_) {
+      return;
+    }
+  }
+  auto saved = save_snapshot(config_.snapshot.path);
+  if (!saved) {
+    log(LogLevel::WARN, std::format("Snapshot not saved: {}", saved.error()));
+  }
+}
+
+} // namespace sparkplug
@@ -0,0 +1,81 @@
+// src/metric_frame.cpp
+#include "sparkplug/metric_frame.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+
+namespace sparkplug {
+
+namespace {
+using namespace detail::wire;
+
+// Layout: payload timestamp, metrics..., seq. Metrics are inserted ahead of the seq field.
+constexpr size_t TIMESTAMP_OFFSET = 1;
+constexpr size_t SEQ_WIDTH = 2; // Holds 0-255
+constexpr size_t SEQ_FIELD_SIZE = 1 + SEQ_WIDTH;
+} // namespace
+
+MetricFrame::MetricFrame() {
+  bytes_.push_back(static_cast<uint8_t>(make_tag(PAYLOAD_TIMESTAMP_FIELD, WIRE_VARINT)));
+  bytes_.resize(bytes_.size() + MAX_VARINT_SIZE);
+  bytes_.push_back(static_cast<uint8_t>(make_tag(PAYLOAD_SEQ_FIELD, WIRE_VARINT)));
+  bytes_.resize(bytes_.size() + SEQ_WIDTH);
+  set_seq(0);
+
+  set_timestamp(system_clock_ms());
+}
+
+std::pair<size_t, size_t> MetricFrame::append_metric(uint64_t alias, uint64_t datatype,
+                                                     uint64_t value_tag, size_t value_width) {
+  size_t body_size = 1 + varint_size(alias) + 1 + MAX_VARINT_SIZE + 1 + varint_size(datatype) +
+                     varint_size(value_tag) + value_width;
+
+  // The seq field is cut off and re-appended after the new metric
+  size_t seq_begin = bytes_.size() - SEQ_FIELD_SIZE;
+  std::array<uint8_t, SEQ_FIELD_SIZE> seq_field;
+  std::copy(bytes_.begin() + static_cast<std::ptrdiff_t>(seq_begin), bytes_.end(),
+            seq_field.begin());
+  bytes_.resize(seq_begin);
+
+  append_varint(bytes_, make_tag(PAYLOAD_METRICS_FIELD, WIRE_LENGTH));
+  append_varint(bytes_, body_size);
+  append_varint(bytes_, make_tag(METRIC_ALIAS_FIELD, WIRE_VARINT));
+  append_varint(bytes_, alias);
+  append_varint(bytes_, make_tag(METRIC_TIMESTAMP_FIELD, WIRE_VARINT));
+  size_t timestamp_offset = bytes_.size();
+  bytes_.resize(bytes_.size() + MAX_VARINT_SIZE);
+  write_padded_varint(bytes_.data() + timestamp_offset, timestamp_ms_, MAX_VARINT_SIZE);
+  append_varint(bytes_, make_tag(METRIC_DATATYPE_FIELD, WIRE_VARINT));
+  append_varint(bytes_, datatype);
+  append_varint(bytes_, value_tag);
+  size_t value_offset = bytes_.size();
+  bytes_.resize(bytes_.size() + value_width);
+
+  bytes_.insert(bytes_.end(), seq_field.begin(), seq_field.end());
+  timestamp_offsets_.push_back(timestamp_offset);
+  return {value_offset, timestamp_offset};
+}
+
+void MetricFrame::set_timestamp(uint64_t timestamp_ms) noexcept {
+  timestamp_ms_ = timestamp_ms;
+  write_padded_varint(bytes_.data() + TIMESTAMP_OFFSET, timestamp_ms, MAX_VARINT_SIZE);
+  for (size_t offset : timestamp_offsets_) {
+    write_padded_varint(bytes_.data() + offset, timestamp_ms, MAX_VARINT_SIZE);
+  }
+}
+
+void MetricFrame::set_seq(uint64_t seq) noexcept {
+  write_padded_varint(bytes_.data() + bytes_.size() - SEQ_WIDTH, seq & 0xFF, SEQ_WIDTH);
+}
+
+std::expected<size_t, std::string> MetricFrame::build_into(std::span<uint8_t> buffer) const {
+  if (bytes_.size() > buffer.size()) {
+    return std::unexpected(
+        std::format("Buffer too small: need {} bytes, have {}", bytes_.size(), buffer.size()));
+  }
+  std::ranges::copy(bytes_, buffer.begin());
+  return bytes_.size();
+}
+
+} // namespace sparkplug
@@ -2,32 +2,245 @@
 #include "sparkplug/payload_builder.hpp"
 
 #include <chrono>
+#include <ctime>
+#include <format>
+#include <type_traits>
+#include <variant>
 
 namespace sparkplug {
 
-PayloadBuilder::PayloadBuilder() {
+uint64_t system_clock_ms() noexcept {
   auto now = std::chrono::system_clock::now();
-  auto timestamp =
-      std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-  payload_.set_timestamp(timestamp);
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
 }
 
-std::vector<uint8_t> PayloadBuilder::build() const {
-  auto payload_copy = payload_;
-  if (!timestamp_explicitly_set_ && !payload_copy.has_timestamp()) {
-    auto now = std::chrono::system_clock::now();
-    auto timestamp =
-        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-    payload_copy.set_timestamp(timestamp);
+uint64_t coarse_clock_ms() noexcept {
+#ifdef CLOCK_REALTIME_COARSE
+  timespec now{};
+  if (clock_gettime(CLOCK_REALTIME_COARSE, &now) == 0) {
+    return static_cast<uint64_t>(now.tv_sec) * 1000 + static_cast<uint64_t>(now.tv_nsec) / 1000000;
+  }
+#endif
+  return system_clock_ms();
+}
+
+namespace {
+
+using DataSetValue = org::eclipse::tahu::protobuf::Payload::DataSet::DataSetValue;
+
+template <typename T>
+void set_dataset_value(DataSetValue* element, const T& value) {
+  if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>) {
+    element->set_long_value(static_cast<uint64_t>(value));
+  } else if constexpr (std::is_same_v<T, float>) {
+    element->set_float_value(value);
+  } else if constexpr (std::is_same_v<T, double>) {
+    element->set_double_value(value);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    element->set_boolean_value(value);
+  } else if constexpr (std::is_integral_v<T>) {
+    // Same int_value encoding as set_metric_value(): sign-extended to 32 bits
+    element->set_int_value(static_cast<uint32_t>(value));
+  } else {
+    element->mutable_string_value()->assign(value);
+  }
+}
+
+void fill_dataset(org::eclipse::tahu::protobuf::Payload::DataSet* dataset,
+                  std::span<const DataSetColumn> columns) {
+  size_t row_count = 0;
+  if (!columns.empty()) {
+    row_count = columns.front().size();
+    for (const auto& column : columns) {
+      row_count = std::min(row_count, column.size());
+    }
+  }
+
+  dataset->set_num_of_columns(columns.size());
+  dataset->mutable_columns()->Reserve(static_cast<int>(columns.size()));
+  dataset->mutable_types()->Reserve(static_cast<int>(columns.size()));
+  for (const auto& column : columns) {
+    dataset->add_columns(std::string(column.name()));
+    dataset->add_types(std::to_underlying(column.type()));
+  }
+
+  // Each row's elements are allocated together, then filled a column at a time: one type
+  // dispatch per column and a tight loop over its rows
+  auto* rows = dataset->mutable_rows();
+  rows->Reserve(static_cast<int>(row_count));
+  for (size_t r = 0; r < row_count; r++) {
+    auto* elements = rows->Add()->mutable_elements();
+    elements->Reserve(static_cast<int>(columns.size()));
+    for (size_t c = 0; c < columns.size(); c++) {
+      elements->Add();
+    }
+  }
+
+  for (size_t c = 0; c < columns.size(); c++) {
+    std::visit(
+        [&](auto values) {
+          for (size_t r = 0; r < row_count; r++) {
+            set_dataset_value(rows->Mutable(static_cast<int>(r))->mutable_elements(
+                                  static_cast<int>(c)),
+                              values[r]);
+          }
+        },
+        columns[c].values());
+  }
+}
+
+} // namespace
+
+TemplateBuilder::TemplateBuilder(std::string_view version) {
+  if (!version.empty()) {
+    template_.set_version(std::string(version));
+  }
+}
+
+PayloadBuilder::PayloadBuilder() : PayloadBuilder(TimestampMode::PerMetric) {}
+
+PayloadBuilder::PayloadBuilder(TimestampMode mode, TimestampClock clock)
+    : mode_(mode), clock_(clock) {
+  payload_.set_timestamp(clock_());
+}
+
+PayloadBuilder& PayloadBuilder::reset() {
+  // Clear() keeps the repeated field's cleared elements for reuse by add_metrics()
+  payload_.Clear();
+  payload_.set_timestamp(clock_());
+  seq_explicitly_set_ = false;
+  timestamp_explicitly_set_ = false;
+  return *this;
+}
+
+// The constructor always stamps a timestamp, so a copy is only needed when the caller
+// cleared it through mutable_payload(). Every other build serializes payload_ in place.
+const org::eclipse::tahu::protobuf::Payload&
+PayloadBuilder::serializable_payload(org::eclipse::tahu::protobuf::Payload& scratch) const {
+  if (timestamp_explicitly_set_ || payload_.has_timestamp()) {
+    return payload_;
   }
 
-  std::vector<uint8_t> buffer(payload_copy.ByteSizeLong());
-  payload_copy.SerializeToArray(buffer.data(), static_cast<int>(buffer.size()));
+  scratch = payload_;
+  scratch.set_timestamp(clock_());
+  return scratch;
+}
+
+std::vector<uint8_t> PayloadBuilder::build() const {
+  std::vector<uint8_t> buffer;
+  build_into(buffer);
   return buffer;
 }
 
+size_t PayloadBuilder::serialized_size() const {
+  org::eclipse::tahu::protobuf::Payload scratch;
+  return serializable_payload(scratch).ByteSizeLong();
+}
+
+std::expected<size_t, std::string> PayloadBuilder::build_into(std::span<uint8_t> buffer) const {
+  org::eclipse::tahu::protobuf::Payload scratch;
+  const auto& payload = serializable_payload(scratch);
+
+  size_t size = payload.ByteSizeLong();
+  if (size > buffer.size()) {
+    return std::unexpected(
+        std::format("Buffer too small: need {} bytes, have {}", size, buffer.size()));
+  }
+
+  payload.SerializeWithCachedSizesToArray(buffer.data());
+  return size;
+}
+
+size_t PayloadBuilder::build_into(std::vector<uint8_t>& buffer) const {
+  org::eclipse::tahu::protobuf::Payload scratch;
+  const auto& payload = serializable_payload(scratch);
+
+  size_t size = payload.ByteSizeLong();
+  buffer.resize(size);
+  payload.SerializeWithCachedSizesToArray(buffer.data());
+  return size;
+}
+
+PayloadBuilder& PayloadBuilder::add_dataset(std::string_view name,
+                                            std::span<const DataSetColumn> columns) {
+  return add_dataset_metric(name, std::nullopt, columns);
+}
+
+PayloadBuilder& PayloadBuilder::add_dataset_with_alias(std::string_view name, uint64_t alias,
+                                                       std::span<const DataSetColumn> columns) {
+  return add_dataset_metric(name, alias, columns);
+}
+
+PayloadBuilder& PayloadBuilder::add_dataset_by_alias(uint64_t alias,
+                                                     std::span<const DataSetColumn> columns) {
+  return add_dataset_metric("", alias, columns);
+}
+
+PayloadBuilder& PayloadBuilder::add_dataset_metric(std::string_view name,
+                                                   std::optional<uint64_t> alias,
+                                                   std::span<const DataSetColumn> columns) {
+  auto* metric = payload_.add_metrics();
+  if (!name.empty()) {
+    metric->mutable_name()->assign(name);
+  }
+  if (alias.has_value()) {
+    metric->set_alias(*alias);
+  }
+  metric->set_datatype(std::to_underlying(DataType::DataSet));
+  metric->set_timestamp(metric_timestamp());
+  fill_dataset(metric->mutable_dataset_value(), columns);
+  return *this;
+}
+
+PayloadBuilder& PayloadBuilder::add_template_definition(std::string_view name,
+                                                        const TemplateBuilder& definition) {
+  return add_template_metric(name, std::nullopt, "", definition, true);
+}
+
+PayloadBuilder& PayloadBuilder::add_template(std::string_view name, std::string_view template_ref,
+                                             const TemplateBuilder& instance) {
+  return add_template_metric(name, std::nullopt, template_ref, instance, false);
+}
+
+PayloadBuilder& PayloadBuilder::add_template_with_alias(std::string_view name, uint64_t alias,
+                                                        std::string_view template_ref,
+                                                        const TemplateBuilder& instance) {
+  return add_template_metric(name, alias, template_ref, instance, false);
+}
+
+PayloadBuilder& PayloadBuilder::add_template_by_alias(uint64_t alias,
+                                                      std::string_view template_ref,
+                                                      const TemplateBuilder& instance) {
+  return add_template_metric("", alias, template_ref, instance, false);
+}
+
+PayloadBuilder& PayloadBuilder::add_template_metric(std::string_view name,
+                                                    std::optional<uint64_t> alias,
+                                                    std::string_view template_ref,
+                                                    const TemplateBuilder& source,
+                                                    bool is_definition) {
+  auto* metric = payload_.add_metrics();
+  if (!name.empty()) {
+    metric->mutable_name()->assign(name);
+  }
+  if (alias.has_value()) {
+    metric->set_alias(*alias);
+  }
+  metric->set_datatype(std::to_underlying(DataType::Template));
+  metric->set_timestamp(metric_timestamp());
+
+  auto* value = metric->mutable_template_value();
+  value->CopyFrom(source.get());
+  value->set_is_definition(is_definition);
+  if (!template_ref.empty()) {
+    value->set_template_ref(std::string(template_ref));
+  }
+  return *this;
+}
+
 const org::eclipse::tahu::protobuf::Payload& PayloadBuilder::payload() const noexcept {
   return payload_;
 }
 
-} // namespace sparkplug
\ No newline at end of file
+} // namespace sparkplug
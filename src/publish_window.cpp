@@ -0,0 +1,194 @@
+// src/publish_window.cpp
+#include "sparkplug/publish_window.hpp"
+
+#include "sparkplug/stats.hpp"
+
+#include <format>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sparkplug {
+
+namespace {
+
+// Owned by Paho between MQTTAsync_sendMessage and the onSuccess/onFailure callback
+struct AsyncPublishContext {
+  PublishWindow::Slot slot;
+  PublishCallback on_complete;
+  std::shared_ptr<detail::StatsRecorder> stats;
+  std::chrono::steady_clock::time_point sent;
+};
+
+// Contexts handed to Paho and not completed yet, with the client they were queued on.
+// MQTTAsync_destroy() can free queued messages without calling back, so the contexts left
+// here when a client is destroyed are completed by abandon_async_publishes().
+struct PendingPublishes {
+  std::mutex mutex;
+  std::unordered_map<AsyncPublishContext*, MQTTAsync> contexts;
+};
+
+PendingPublishes& pending_publishes() {
+  static PendingPublishes pending;
+  return pending;
+}
+
+// Removes ctx from the pending set; false if it was already completed (ctx is not read)
+bool claim(AsyncPublishContext* ctx) {
+  auto& pending = pending_publishes();
+  std::lock_guard<std::mutex> lock(pending.mutex);
+  return pending.contexts.erase(ctx) == 1;
+}
+
+void finish(std::unique_ptr<AsyncPublishContext> ctx, std::expected<void, std::string> result) {
+  if (ctx->stats) {
+    ctx->stats->record_publish_latency(std::chrono::steady_clock::now() - ctx->sent);
+    if (!result) {
+      ctx->stats->record_publish_failure();
+    }
+  }
+  auto on_complete = std::move(ctx->on_complete);
+  ctx.reset();
+  if (on_complete) {
+    on_complete(std::move(result));
+  }
+}
+
+void complete(void* context, std::expected<void, std::string> result) {
+  auto* ctx = static_cast<AsyncPublishContext*>(context);
+  if (claim(ctx)) {
+    finish(std::unique_ptr<AsyncPublishContext>(ctx), std::move(result));
+  }
+}
+
+void on_publish_success(void* context, MQTTAsync_successData* /*response*/) {
+  complete(context, {});
+}
+
+void on_publish_failure(void* context, MQTTAsync_failureData* response) {
+  if (response && response->message) {
+    complete(context, std::unexpected(std::format("Publish failed ({}): {}", response->code,
+                                                  response->message)));
+  } else {
+    complete(context,
+             std::unexpected(std::format("Publish failed: {}", response ? response->code : -1)));
+  }
+}
+
+} // namespace
+
+std::expected<PublishWindow::Slot, std::string>
+PublishWindow::acquire(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (capacity_ != 0 &&
+      !cv_.wait_for(lock, timeout, [this] { return in_flight_ < capacity_; })) {
+    return std::unexpected(std::format("Publish window full ({} in flight)", in_flight_));
+  }
+  in_flight_++;
+  return Slot(shared_from_this());
+}
+
+void PublishWindow::release() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_--;
+  }
+  cv_.notify_all();
+}
+
+bool PublishWindow::wait_idle(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return cv_.wait_for(lock, timeout, [this] { return in_flight_ == 0; });
+}
+
+size_t PublishWindow::in_flight() const noexcept {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return in_flight_;
+}
+
+namespace detail {
+
+std::expected<void, std::string>
+send_message_async(MQTTAsync client, const char* topic, std::span<const uint8_t> payload_data,
+                   int qos, bool retain, PublishWindow::Slot slot, PublishCallback on_complete,
+                   std::shared_ptr<StatsRecorder> stats) {
+  if (!client) {
+    return std::unexpected("Not connected");
+  }
+
+  MQTTAsync_message msg = MQTTAsync_message_initializer;
+  msg.payload = const_cast<void*>(reinterpret_cast<const void*>(payload_data.data()));
+  msg.payloadlen = static_cast<int>(payload_data.size());
+  msg.qos = qos;
+  msg.retained = retain ? 1 : 0;
+
+  auto ctx = std::make_unique<AsyncPublishContext>(
+      AsyncPublishContext{.slot = std::move(slot),
+                          .on_complete = std::move(on_complete),
+                          .stats = std::move(stats),
+                          .sent = {}});
+
+  MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
+  opts.onSuccess = on_publish_success;
+  opts.onFailure = on_publish_failure;
+  opts.context = ctx.get();
+
+  if (ctx->stats) {
+    ctx->sent = std::chrono::steady_clock::now();
+  }
+  // Registered first: Paho may complete the message before MQTTAsync_sendMessage returns
+  auto& pending = pending_publishes();
+  {
+    std::lock_guard<std::mutex> lock(pending.mutex);
+    pending.contexts.emplace(ctx.get(), client);
+  }
+  int rc = MQTTAsync_sendMessage(client, topic, &msg, &opts);
+  if (rc != MQTTASYNC_SUCCESS) {
+    (void)claim(ctx.get());
+    if (ctx->stats) {
+      ctx->stats->record_publish_failure();
+    }
+    return std::unexpected(std::format("Failed to publish: {}", rc));
+  }
+
+  // Paho now owns the context and frees it through the completion callback
+  (void)ctx.release();
+  return {};
+}
+
+void abandon_async_publishes(MQTTAsync client) noexcept {
+  std::vector<AsyncPublishContext*> abandoned;
+  {
+    auto& pending = pending_publishes();
+    std::lock_guard<std::mutex> lock(pending.mutex);
+    for (auto it = pending.contexts.begin(); it != pending.contexts.end();) {
+      if (it->second == client) {
+        abandoned.push_back(it->first);
+        it = pending.contexts.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto* ctx : abandoned) {
+    finish(std::unique_ptr<AsyncPublishContext>(ctx),
+           std::unexpected("Client destroyed before the publish completed"));
+  }
+}
+
+size_t pending_token_count(MQTTAsync client) noexcept {
+  MQTTAsync_token* tokens = nullptr;
+  if (MQTTAsync_getPendingTokens(client, &tokens) != MQTTASYNC_SUCCESS || !tokens) {
+    return 0;
+  }
+  size_t count = 0;
+  while (tokens[count] != -1) {
+    count++;
+  }
+  MQTTAsync_free(tokens);
+  return count;
+}
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,65 @@
+// src/reconnect.cpp
+#include "sparkplug/reconnect.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace sparkplug {
+
+std::chrono::milliseconds ReconnectPolicy::delay_for_attempt(size_t attempt,
+                                                             double random) const {
+  double base = static_cast<double>(std::max(initial_delay_ms, 0));
+  double cap = static_cast<double>(std::max(max_delay_ms, initial_delay_ms));
+  double delay = std::min(cap, base * std::pow(std::max(multiplier, 1.0),
+                                               static_cast<double>(attempt)));
+  delay -= delay * std::clamp(jitter, 0.0, 1.0) * std::clamp(random, 0.0, 1.0);
+  return std::chrono::milliseconds(static_cast<int64_t>(delay));
+}
+
+namespace detail {
+
+Reconnector::~Reconnector() {
+  stop();
+}
+
+void Reconnector::start(Attempt attempt, FailureHook on_failure) {
+  thread_.start([this, attempt = std::move(attempt),
+                 on_failure = std::move(on_failure)](const WorkerThread::Run& worker) {
+    run(worker, attempt, on_failure);
+  });
+}
+
+void Reconnector::stop() {
+  thread_.stop();
+}
+
+bool Reconnector::running() const noexcept {
+  return thread_.running();
+}
+
+void Reconnector::run(const WorkerThread::Run& worker, const Attempt& attempt,
+                      const FailureHook& on_failure) {
+  std::mt19937_64 rng(std::random_device{}());
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  for (size_t n = 0; policy_.max_attempts == 0 || n < policy_.max_attempts; n++) {
+    if (worker.wait_for(policy_.delay_for_attempt(n, unit(rng)))) {
+      return;
+    }
+
+    auto result = attempt();
+    // Stopped by the attempt itself (or while it ran): no failure to report
+    if (result || worker.stopped()) {
+      return;
+    }
+    if (on_failure) {
+      on_failure(n, result.error());
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,147 @@
+// src/sharded_host_application.cpp
+#include "sparkplug/sharded_host_application.hpp"
+
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <utility>
+
+namespace sparkplug {
+
+ShardedHostApplication::ShardedHostApplication(Config config)
+    : groups_(std::move(config.groups)) {
+  size_t connections = std::max<size_t>(config.connections, 1);
+  shards_.reserve(connections);
+  for (size_t i = 0; i < connections; i++) {
+    auto host_config = config.host;
+    host_config.client_id = std::format("{}-{}", config.host.client_id, i);
+    // Each connection only holds the nodes of its own groups, and shares no file with others
+    if (!config.host.snapshot.path.empty()) {
+      host_config.snapshot.path = std::format("{}.{}", config.host.snapshot.path, i);
+    }
+    shards_.push_back(std::make_unique<HostApplication>(std::move(host_config)));
+  }
+}
+
+size_t ShardedHostApplication::shard_index(std::string_view group_id) const noexcept {
+  return std::hash<std::string_view>{}(group_id) % shards_.size();
+}
+
+HostApplication& ShardedHostApplication::shard_for(std::string_view group_id) noexcept {
+  return *shards_[shard_index(group_id)];
+}
+
+const HostApplication&
+ShardedHostApplication::shard_for(std::string_view group_id) const noexcept {
+  return *shards_[shard_index(group_id)];
+}
+
+std::expected<void, std::string> ShardedHostApplication::connect() {
+  for (size_t i = 0; i < shards_.size(); i++) {
+    auto result = shards_[i]->connect();
+    if (!result) {
+      for (size_t j = 0; j < i; j++) {
+        (void)shards_[j]->disconnect();
+      }
+      return std::unexpected(std::format("Connection {} failed: {}", i, result.error()));
+    }
+  }
+
+  for (const auto& group : groups_) {
+    auto result = subscribe_group(group);
+    if (!result) {
+      (void)disconnect();
+      return std::unexpected(
+          std::format("Subscribing to group '{}' failed: {}", group, result.error()));
+    }
+  }
+  return {};
+}
+
+std::expected<void, std::string> ShardedHostApplication::disconnect() {
+  std::expected<void, std::string> first = {};
+  for (auto& shard : shards_) {
+    auto result = shard->disconnect();
+    if (!result && first) {
+      first = std::unexpected(std::move(result.error()));
+    }
+  }
+  return first;
+}
+
+std::expected<void, std::string>
+ShardedHostApplication::subscribe_group(std::string_view group_id) {
+  return shard_for(group_id).subscribe_group(group_id);
+}
+
+std::expected<void, std::string>
+ShardedHostApplication::subscribe_state(std::string_view host_id) {
+  return primary().subscribe_state(host_id);
+}
+
+std::expected<void, std::string> ShardedHostApplication::publish_state_birth(uint64_t timestamp) {
+  return primary().publish_state_birth(timestamp);
+}
+
+std::expected<void, std::string> ShardedHostApplication::publish_state_death(uint64_t timestamp) {
+  return primary().publish_state_death(timestamp);
+}
+
+std::expected<void, std::string>
+ShardedHostApplication::publish_node_command(std::string_view group_id,
+                                             std::string_view target_edge_node_id,
+                                             PayloadBuilder& payload) {
+  return shard_for(group_id).publish_node_command(group_id, target_edge_node_id, payload);
+}
+
+std::expected<void, std::string> ShardedHostApplication::publish_device_command(
+    std::string_view group_id, std::string_view target_edge_node_id,
+    std::string_view target_device_id, PayloadBuilder& payload) {
+  return shard_for(group_id).publish_device_command(group_id, target_edge_node_id,
+                                                    target_device_id, payload);
+}
+
+std::optional<std::reference_wrapper<const HostApplication::NodeState>>
+ShardedHostApplication::get_node_state(std::string_view group_id,
+                                       std::string_view edge_node_id) const {
+  return shard_for(group_id).get_node_state(group_id, edge_node_id);
+}
+
+std::optional<std::string_view>
+ShardedHostApplication::get_metric_name(std::string_view group_id, std::string_view edge_node_id,
+                                        std::string_view device_id, uint64_t alias) const {
+  return shard_for(group_id).get_metric_name(group_id, edge_node_id, device_id, alias);
+}
+
+std::optional<ValueStore::OwnedEntry>
+ShardedHostApplication::get_metric_value(std::string_view group_id, std::string_view edge_node_id,
+                                         std::string_view device_id,
+                                         std::string_view metric_name) const {
+  return shard_for(group_id).get_metric_value(group_id, edge_node_id, device_id, metric_name);
+}
+
+std::optional<std::vector<HostApplication::MetricSnapshot>>
+ShardedHostApplication::snapshot_node_values(std::string_view group_id,
+                                             std::string_view edge_node_id) const {
+  return shard_for(group_id).snapshot_node_values(group_id, edge_node_id);
+}
+
+Stats ShardedHostApplication::stats() const {
+  Stats total;
+  for (const auto& shard : shards_) {
+    total.merge(shard->stats());
+  }
+  return total;
+}
+
+void ShardedHostApplication::inject_message(std::string_view topic,
+                                            std::span<const uint8_t> payload_data) {
+  auto view = TopicView::parse(topic);
+  if (!view || view->message_type == MessageType::STATE) {
+    primary().inject_message(topic, payload_data);
+    return;
+  }
+  shard_for(view->group_id).inject_message(topic, payload_data);
+}
+
+} // namespace sparkplug
@@ -0,0 +1,43 @@
+// src/stats.cpp
+#include "sparkplug/stats.hpp"
+
+namespace sparkplug::detail {
+
+LatencyHistogram StatsRecorder::Histogram::snapshot() const noexcept {
+  LatencyHistogram histogram;
+  for (size_t i = 0; i < LatencyHistogram::BUCKETS; i++) {
+    histogram.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+  histogram.count = count_.load(std::memory_order_relaxed);
+  histogram.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+  histogram.max_ns = max_ns_.load(std::memory_order_relaxed);
+  return histogram;
+}
+
+std::shared_ptr<StatsRecorder> StatsRecorder::detached() noexcept {
+  static StatsRecorder recorder;
+  // Aliasing an empty owner: nothing is allocated and nothing is freed
+  return std::shared_ptr<StatsRecorder>(std::shared_ptr<StatsRecorder>(), &recorder);
+}
+
+Stats StatsRecorder::snapshot() const noexcept {
+  Stats stats;
+  for (size_t i = 0; i < MESSAGE_TYPE_COUNT; i++) {
+    stats.messages_in[i] = messages_in_[i].load(std::memory_order_relaxed);
+    stats.messages_out[i] = messages_out_[i].load(std::memory_order_relaxed);
+  }
+  stats.bytes_in = bytes_in_.load(std::memory_order_relaxed);
+  stats.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+  stats.parse_failures = parse_failures_.load(std::memory_order_relaxed);
+  stats.publish_failures = publish_failures_.load(std::memory_order_relaxed);
+  stats.seq_gaps = seq_gaps_.load(std::memory_order_relaxed);
+  stats.bd_seq_mismatches = bd_seq_mismatches_.load(std::memory_order_relaxed);
+  stats.payloads_skipped = payloads_skipped_.load(std::memory_order_relaxed);
+  stats.rebirth_requests = rebirth_requests_.load(std::memory_order_relaxed);
+  stats.dropped_awaiting_birth = dropped_awaiting_birth_.load(std::memory_order_relaxed);
+  stats.publish_latency = publish_latency_.snapshot();
+  stats.callback_duration = callback_duration_.snapshot();
+  return stats;
+}
+
+} // namespace sparkplug::detail
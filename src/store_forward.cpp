@@ -0,0 +1,310 @@
+// src/store_forward.cpp
+#include "sparkplug/store_forward.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sparkplug {
+
+namespace {
+
+// Spill record layout: [u32 payload size][u16 device id size][device id][payload]
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint16_t);
+
+size_t record_size(const StoreForwardBuffer::Frame& frame) {
+  return RECORD_HEADER_SIZE + frame.device_id.size() + frame.payload.size();
+}
+
+size_t frame_size(const StoreForwardBuffer::Frame& frame) {
+  return frame.device_id.size() + frame.payload.size();
+}
+
+} // namespace
+
+std::expected<StoreForwardBuffer, std::string>
+StoreForwardBuffer::create(const StoreForwardConfig& config) {
+  StoreForwardBuffer buffer;
+  buffer.memory_limit_ = config.memory_limit_bytes;
+
+  if (config.spill_path.empty() || config.spill_limit_bytes == 0) {
+    return buffer;
+  }
+
+  int fd = ::open(config.spill_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    return std::unexpected(
+        std::format("Failed to open spill file '{}': {}", config.spill_path, std::strerror(errno)));
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(config.spill_limit_bytes)) != 0) {
+    auto error = std::format("Failed to size spill file '{}': {}", config.spill_path,
+                             std::strerror(errno));
+    ::close(fd);
+    return std::unexpected(std::move(error));
+  }
+
+  void* base =
+      ::mmap(nullptr, config.spill_limit_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED) {
+    auto error = std::format("Failed to map spill file '{}': {}", config.spill_path,
+                             std::strerror(errno));
+    ::close(fd);
+    return std::unexpected(std::move(error));
+  }
+
+  buffer.spill_path_ = config.spill_path;
+  buffer.spill_fd_ = fd;
+  buffer.spill_base_ = static_cast<uint8_t*>(base);
+  buffer.spill_capacity_ = config.spill_limit_bytes;
+  return buffer;
+}
+
+StoreForwardBuffer::~StoreForwardBuffer() {
+  close_spill();
+}
+
+StoreForwardBuffer::StoreForwardBuffer(StoreForwardBuffer&& other) noexcept
+    : memory_limit_(other.memory_limit_), memory_(std::move(other.memory_)),
+      memory_bytes_(std::exchange(other.memory_bytes_, 0)),
+      spill_path_(std::move(other.spill_path_)), spill_fd_(std::exchange(other.spill_fd_, -1)),
+      spill_base_(std::exchange(other.spill_base_, nullptr)),
+      spill_capacity_(std::exchange(other.spill_capacity_, 0)),
+      spill_head_(std::exchange(other.spill_head_, 0)),
+      spill_tail_(std::exchange(other.spill_tail_, 0)),
+      spill_count_(std::exchange(other.spill_count_, 0)), dropped_(other.dropped_),
+      front_generation_(other.front_generation_) {
+}
+
+StoreForwardBuffer& StoreForwardBuffer::operator=(StoreForwardBuffer&& other) noexcept {
+  if (this != &other) {
+    close_spill();
+    memory_limit_ = other.memory_limit_;
+    memory_ = std::move(other.memory_);
+    memory_bytes_ = std::exchange(other.memory_bytes_, 0);
+    spill_path_ = std::move(other.spill_path_);
+    spill_fd_ = std::exchange(other.spill_fd_, -1);
+    spill_base_ = std::exchange(other.spill_base_, nullptr);
+    spill_capacity_ = std::exchange(other.spill_capacity_, 0);
+    spill_head_ = std::exchange(other.spill_head_, 0);
+    spill_tail_ = std::exchange(other.spill_tail_, 0);
+    spill_count_ = std::exchange(other.spill_count_, 0);
+    dropped_ = other.dropped_;
+    front_generation_ = other.front_generation_;
+  }
+  return *this;
+}
+
+void StoreForwardBuffer::close_spill() noexcept {
+  if (spill_base_) {
+    ::munmap(spill_base_, spill_capacity_);
+    spill_base_ = nullptr;
+  }
+  if (spill_fd_ >= 0) {
+    ::close(spill_fd_);
+    ::unlink(spill_path_.c_str());
+    spill_fd_ = -1;
+  }
+}
+
+void StoreForwardBuffer::push(std::string_view device_id, std::span<const uint8_t> payload) {
+  Frame frame{.device_id = std::string(device_id),
+              .payload = std::vector<uint8_t>(payload.begin(), payload.end())};
+  memory_bytes_ += frame_size(frame);
+  memory_.push_back(std::move(frame));
+
+  // The oldest in-memory frames move to disk (or are lost) until the budget is met again
+  while (memory_bytes_ > memory_limit_ && !memory_.empty()) {
+    auto& oldest = memory_.front();
+    if (!spill(oldest)) {
+      dropped_++;
+      // Spilled frames are older, so only an empty file makes this the front
+      if (spill_count_ == 0) {
+        front_generation_++;
+      }
+    }
+    memory_bytes_ -= frame_size(oldest);
+    memory_.pop_front();
+  }
+}
+
+bool StoreForwardBuffer::spill(const Frame& frame) {
+  size_t needed = record_size(frame);
+  if (!spill_base_ || needed > spill_capacity_ ||
+      frame.device_id.size() > UINT16_MAX || frame.payload.size() > UINT32_MAX) {
+    return false;
+  }
+
+  // Reclaim the space in front of the oldest record first, then give up old records
+  compact_spill(needed);
+  while (spill_capacity_ - spill_tail_ < needed && spill_count_ > 0) {
+    drop_spilled_front();
+    dropped_++;
+    front_generation_++;
+    compact_spill(needed);
+  }
+
+  auto payload_size = static_cast<uint32_t>(frame.payload.size());
+  auto device_size = static_cast<uint16_t>(frame.device_id.size());
+  uint8_t* out = spill_base_ + spill_tail_;
+  std::memcpy(out, &payload_size, sizeof(payload_size));
+  std::memcpy(out + sizeof(payload_size), &device_size, sizeof(device_size));
+  std::memcpy(out + RECORD_HEADER_SIZE, frame.device_id.data(), device_size);
+  std::memcpy(out + RECORD_HEADER_SIZE + device_size, frame.payload.data(), payload_size);
+
+  spill_tail_ += needed;
+  spill_count_++;
+  return true;
+}
+
+void StoreForwardBuffer::compact_spill(size_t needed) noexcept {
+  if (spill_capacity_ - spill_tail_ >= needed || spill_head_ == 0) {
+    return;
+  }
+  size_t live = spill_tail_ - spill_head_;
+  std::memmove(spill_base_, spill_base_ + spill_head_, live);
+  spill_head_ = 0;
+  spill_tail_ = live;
+}
+
+StoreForwardBuffer::Frame StoreForwardBuffer::read_spilled(size_t& size) const {
+  const uint8_t* in = spill_base_ + spill_head_;
+  uint32_t payload_size = 0;
+  uint16_t device_size = 0;
+  std::memcpy(&payload_size, in, sizeof(payload_size));
+  std::memcpy(&device_size, in + sizeof(payload_size), sizeof(device_size));
+
+  const uint8_t* device = in + RECORD_HEADER_SIZE;
+  const uint8_t* payload = device + device_size;
+  size = RECORD_HEADER_SIZE + device_size + payload_size;
+  return Frame{.device_id = std::string(reinterpret_cast<const char*>(device), device_size),
+               .payload = std::vector<uint8_t>(payload, payload + payload_size)};
+}
+
+void StoreForwardBuffer::drop_spilled_front() {
+  size_t size = 0;
+  (void)read_spilled(size);
+  spill_head_ += size;
+  spill_count_--;
+  if (spill_count_ == 0) {
+    spill_head_ = 0;
+    spill_tail_ = 0;
+  }
+}
+
+std::optional<StoreForwardBuffer::Frame> StoreForwardBuffer::front() const {
+  if (spill_count_ > 0) {
+    size_t size = 0;
+    return read_spilled(size);
+  }
+  if (!memory_.empty()) {
+    return memory_.front();
+  }
+  return std::nullopt;
+}
+
+void StoreForwardBuffer::pop_front() {
+  if (spill_count_ > 0) {
+    drop_spilled_front();
+    front_generation_++;
+    return;
+  }
+  if (!memory_.empty()) {
+    memory_bytes_ -= frame_size(memory_.front());
+    memory_.pop_front();
+    front_generation_++;
+  }
+}
+
+namespace detail {
+
+ForwardQueue::~ForwardQueue() {
+  stop();
+}
+
+std::expected<void, std::string> ForwardQueue::open() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buffer_) {
+    return {};
+  }
+  auto buffer = StoreForwardBuffer::create(config_);
+  if (!buffer) {
+    return std::unexpected(buffer.error());
+  }
+  buffer_.emplace(std::move(*buffer));
+  return {};
+}
+
+bool ForwardQueue::push(std::string_view device_id, std::span<const uint8_t> payload) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!buffer_) {
+    return false;
+  }
+  buffer_->push(device_id, payload);
+  return true;
+}
+
+void ForwardQueue::start_drain(Send send) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!buffer_ || buffer_->empty()) {
+    return;
+  }
+  thread_.start([this, send = std::move(send)](const WorkerThread::Run& worker) {
+    drain(worker, send);
+  });
+}
+
+void ForwardQueue::stop() {
+  thread_.stop();
+}
+
+size_t ForwardQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffer_ ? buffer_->size() : 0;
+}
+
+uint64_t ForwardQueue::dropped() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffer_ ? buffer_->dropped() : 0;
+}
+
+void ForwardQueue::drain(const WorkerThread::Run& worker, const Send& send) {
+  auto interval = config_.drain_rate == 0
+                      ? std::chrono::microseconds(0)
+                      : std::chrono::microseconds(1'000'000 / config_.drain_rate);
+
+  while (!worker.wait_for(interval)) {
+    std::optional<StoreForwardBuffer::Frame> frame;
+    uint64_t generation = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      frame = buffer_->front();
+      generation = buffer_->front_generation();
+    }
+    if (!frame) {
+      return;
+    }
+
+    // Sent without the lock so producers keep queueing while the broker is slow
+    if (!send(*frame)) {
+      return;
+    }
+
+    // An overflow during the send may already have dropped the frame; popping then would
+    // discard the next one unsent
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer_->front_generation() == generation) {
+      buffer_->pop_front();
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace sparkplug
@@ -0,0 +1,85 @@
+// src/string_interner.cpp
+#include "sparkplug/string_interner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace sparkplug {
+
+InternedString StringInterner::intern(std::string_view text) {
+  return *lookup_or_add(text, false);
+}
+
+std::optional<InternedString> StringInterner::try_intern(std::string_view text) {
+  return lookup_or_add(text, true);
+}
+
+std::optional<InternedString> StringInterner::lookup_or_add(std::string_view text,
+                                                            bool bounded) {
+  if (text.empty()) {
+    return InternedString{};
+  }
+
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(text);
+    if (it != index_.end()) {
+      return InternedString(it->second);
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  // Another thread may have added it between the two locks
+  auto it = index_.find(text);
+  if (it != index_.end()) {
+    return InternedString(it->second);
+  }
+  if (bounded && max_bytes_ > 0 && bytes_ + text.size() > max_bytes_) {
+    return std::nullopt;
+  }
+
+  const auto& rep = storage_.emplace_back(
+      InternedString::Rep{.text = std::string(text), .hash = std::hash<std::string_view>{}(text)});
+  index_.emplace(std::string_view(rep.text), &rep);
+  bytes_ += rep.text.size();
+  return InternedString(&rep);
+}
+
+std::optional<InternedString> StringInterner::find(std::string_view text) const {
+  if (text.empty()) {
+    return InternedString{};
+  }
+
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = index_.find(text);
+  if (it == index_.end()) {
+    return std::nullopt;
+  }
+  return InternedString(it->second);
+}
+
+size_t StringInterner::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return storage_.size();
+}
+
+size_t StringInterner::bytes() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return bytes_;
+}
+
+size_t StringInterner::available() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (max_bytes_ == 0) {
+    return SIZE_MAX;
+  }
+  return max_bytes_ - std::min(bytes_, max_bytes_);
+}
+
+void StringInterner::set_max_bytes(size_t max_bytes) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  max_bytes_ = max_bytes;
+}
+
+} // namespace sparkplug
@@ -0,0 +1,47 @@
+// src/token_bucket.cpp
+#include "sparkplug/token_bucket.hpp"
+
+#include <algorithm>
+
+namespace sparkplug {
+
+TokenBucket::TokenBucket(double rate_per_second, double burst) noexcept
+    : rate_(rate_per_second), burst_(std::max(burst, 0.0)), tokens_(burst_), last_(Clock::now()) {
+}
+
+TokenBucket::Clock::duration TokenBucket::acquire(double cost, Clock::time_point now) {
+  if (unlimited()) {
+    return Clock::duration::zero();
+  }
+
+  refill(now);
+  tokens_ -= cost;
+  if (tokens_ >= 0) {
+    return Clock::duration::zero();
+  }
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(-tokens_ / rate_));
+}
+
+bool TokenBucket::try_acquire(double cost, Clock::time_point now) {
+  if (unlimited()) {
+    return true;
+  }
+
+  refill(now);
+  if (tokens_ < cost) {
+    return false;
+  }
+  tokens_ -= cost;
+  return true;
+}
+
+void TokenBucket::refill(Clock::time_point now) noexcept {
+  if (now > last_) {
+    std::chrono::duration<double> elapsed = now - last_;
+    tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+    last_ = now;
+  }
+}
+
+} // namespace sparkplug
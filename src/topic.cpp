@@ -1,11 +1,9 @@
 // src/topic.cpp
 #include "sparkplug/topic.hpp"
 
-#include <algorithm>
 #include <format>
-#include <ranges>
+#include <optional>
 #include <utility>
-#include <vector>
 
 namespace sparkplug {
 
@@ -39,27 +37,61 @@ constexpr std::string_view message_type_to_string(MessageType type) noexcept {
   std::unreachable();
 }
 
-std::expected<MessageType, std::string> parse_message_type(std::string_view str) {
-  if (str == "NBIRTH")
-    return MessageType::NBIRTH;
-  if (str == "NDEATH")
-    return MessageType::NDEATH;
-  if (str == "DBIRTH")
-    return MessageType::DBIRTH;
-  if (str == "DDEATH")
-    return MessageType::DDEATH;
-  if (str == "NDATA")
-    return MessageType::NDATA;
-  if (str == "DDATA")
-    return MessageType::DDATA;
-  if (str == "NCMD")
-    return MessageType::NCMD;
-  if (str == "DCMD")
-    return MessageType::DCMD;
-  if (str == "STATE")
-    return MessageType::STATE;
-  return std::unexpected(std::format("Unknown message type: {}", str));
+// Picks the only candidate for a given length and leading characters, then confirms it with
+// a single comparison instead of testing every message type in turn.
+constexpr std::optional<MessageType> parse_message_type(std::string_view str) noexcept {
+  std::optional<MessageType> candidate;
+  switch (str.size()) {
+  case 4:
+    candidate = str[0] == 'N' ? MessageType::NCMD : MessageType::DCMD;
+    break;
+  case 5:
+    candidate = str[0] == 'N'   ? MessageType::NDATA
+                : str[0] == 'D' ? MessageType::DDATA
+                                : MessageType::STATE;
+    break;
+  case 6:
+    if (str[0] == 'N') {
+      candidate = str[1] == 'B' ? MessageType::NBIRTH : MessageType::NDEATH;
+    } else {
+      candidate = str[1] == 'B' ? MessageType::DBIRTH : MessageType::DDEATH;
+    }
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  if (message_type_to_string(*candidate) != str) {
+    return std::nullopt;
+  }
+  return candidate;
 }
+
+// Yields '/'-separated segments of a topic, including empty ones, without allocating
+class SegmentCursor {
+public:
+  constexpr explicit SegmentCursor(std::string_view str) noexcept : rest_(str), done_(str.empty()) {
+  }
+
+  [[nodiscard]] constexpr bool at_end() const noexcept {
+    return done_;
+  }
+
+  constexpr std::string_view next() noexcept {
+    auto pos = rest_.find('/');
+    if (pos == std::string_view::npos) {
+      done_ = true;
+      return rest_;
+    }
+    auto segment = rest_.substr(0, pos);
+    rest_.remove_prefix(pos + 1);
+    return segment;
+  }
+
+private:
+  std::string_view rest_;
+  bool done_;
+};
 } // namespace
 
 std::string Topic::to_string() const {
@@ -77,67 +109,74 @@ std::string Topic::to_string() const {
 }
 
 std::expected<Topic, std::string> Topic::parse(std::string_view topic_str) {
-  // Parse without allocating vector - use iterators directly
-  auto parts =
-      topic_str | std::views::split('/') | std::views::transform([](auto&& rng) {
-        return std::string_view(rng.begin(), std::ranges::distance(rng.begin(), rng.end()));
-      });
+  auto view = TopicView::parse(topic_str);
+  if (!view) {
+    return std::unexpected(std::string(view.error()));
+  }
+  return view->to_topic();
+}
+
+Topic TopicView::to_topic() const {
+  return Topic{.group_id = std::string(group_id),
+               .message_type = message_type,
+               .edge_node_id = std::string(edge_node_id),
+               .device_id = std::string(device_id)};
+}
 
-  auto it = parts.begin();
-  auto end = parts.end();
+std::expected<TopicView, std::string_view> TopicView::parse(std::string_view topic_str) noexcept {
+  SegmentCursor segments(topic_str);
 
-  if (it == end) {
-    return std::unexpected("Invalid topic format");
+  if (segments.at_end()) {
+    return std::unexpected("Invalid topic format"sv);
   }
+  std::string_view part0 = segments.next();
 
-  std::string_view part0 = *it++;
-  if (it == end) {
-    return std::unexpected("Invalid topic format");
+  if (segments.at_end()) {
+    return std::unexpected("Invalid topic format"sv);
   }
-  std::string_view part1 = *it++;
+  std::string_view part1 = segments.next();
 
   // Sparkplug B topic: spBv1.0/{group_id}/{message_type}/{edge_node_id}[/{device_id}]
   // or STATE message: spBv1.0/STATE/{host_id}
   if (part0 != NAMESPACE) {
-    return std::unexpected("Invalid Sparkplug B topic");
+    return std::unexpected("Invalid Sparkplug B topic"sv);
   }
 
   // Check for STATE message: spBv1.0/STATE/{host_id}
   if (part1 == "STATE") {
-    if (it == end) {
-      return std::unexpected("STATE topic requires host_id");
+    if (segments.at_end()) {
+      return std::unexpected("STATE topic requires host_id"sv);
     }
-    std::string_view host_id = *it++;
-    return Topic{.group_id = "",
-                 .message_type = MessageType::STATE,
-                 .edge_node_id = std::string(host_id),
-                 .device_id = ""};
+    return TopicView{.group_id = {},
+                     .message_type = MessageType::STATE,
+                     .edge_node_id = segments.next(),
+                     .device_id = {}};
   }
 
-  if (it == end) {
-    return std::unexpected("Invalid Sparkplug B topic");
+  if (segments.at_end()) {
+    return std::unexpected("Invalid Sparkplug B topic"sv);
   }
-  std::string_view part2 = *it++;
+  std::string_view part2 = segments.next();
 
-  if (it == end) {
-    return std::unexpected("Invalid Sparkplug B topic");
+  if (segments.at_end()) {
+    return std::unexpected("Invalid Sparkplug B topic"sv);
   }
-  std::string_view part3 = *it++;
+  std::string_view part3 = segments.next();
 
   auto msg_type = parse_message_type(part2);
   if (!msg_type) {
-    return std::unexpected(msg_type.error());
+    return std::unexpected("Unknown message type"sv);
   }
 
-  std::string device_id;
-  if (it != end) {
-    device_id = std::string(*it);
+  std::string_view device_id;
+  if (!segments.at_end()) {
+    device_id = segments.next();
   }
 
-  return Topic{.group_id = std::string(part1),
-               .message_type = *msg_type,
-               .edge_node_id = std::string(part3),
-               .device_id = std::move(device_id)};
+  return TopicView{.group_id = part1,
+                   .message_type = *msg_type,
+                   .edge_node_id = part3,
+                   .device_id = device_id};
 }
 
-} // namespace sparkplug
\ No newline at end of file
+} // namespace sparkplug
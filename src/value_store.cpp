@@ -0,0 +1,137 @@
+// src/value_store.cpp
+#include "sparkplug/value_store.hpp"
+
+#include "sparkplug/alias_registry.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace sparkplug {
+
+namespace {
+
+uint64_t value_timestamp(const org::eclipse::tahu::protobuf::Payload& payload,
+                         const org::eclipse::tahu::protobuf::Payload::Metric& metric) {
+  return metric.has_timestamp() ? metric.timestamp() : payload.timestamp();
+}
+
+} // namespace
+
+void ValueStore::rebuild(const org::eclipse::tahu::protobuf::Payload& birth,
+                         StringInterner& names) {
+  clear();
+
+  uint64_t alias_count = 0;
+  uint64_t max_alias = 0;
+  size_t named = 0;
+  for (const auto& metric : birth.metrics()) {
+    if (!metric.has_name()) {
+      continue;
+    }
+    named++;
+    if (metric.has_alias()) {
+      alias_count++;
+      max_alias = std::max(max_alias, metric.alias());
+    }
+  }
+
+  entries_.reserve(named);
+  by_name_.reserve(named);
+  for (const auto& metric : birth.metrics()) {
+    if (!metric.has_name()) {
+      continue;
+    }
+    auto datatype = static_cast<DataType>(metric.datatype());
+    auto name = names.intern(metric.name());
+    by_name_.insert_or_assign(name, static_cast<uint32_t>(entries_.size()));
+    entries_.push_back(Entry{.name = name,
+                             .alias = metric.alias(),
+                             .datatype = datatype,
+                             .has_alias = metric.has_alias(),
+                             .is_historical = metric.is_historical(),
+                             .timestamp = value_timestamp(birth, metric),
+                             .value = metric_value_from_proto(metric, datatype)});
+  }
+
+  if (alias_count == 0) {
+    return;
+  }
+
+  bool dense = AliasRegistry::use_dense_layout(alias_count, max_alias);
+  if (dense) {
+    dense_aliases_.assign(max_alias + 1, NO_ENTRY);
+  } else {
+    sparse_aliases_.reserve(alias_count);
+  }
+
+  for (size_t i = 0; i < entries_.size(); i++) {
+    if (!entries_[i].has_alias) {
+      continue;
+    }
+    if (dense) {
+      dense_aliases_[entries_[i].alias] = static_cast<uint32_t>(i);
+    } else {
+      sparse_aliases_.insert_or_assign(entries_[i].alias, static_cast<uint32_t>(i));
+    }
+  }
+}
+
+uint32_t ValueStore::alias_index(uint64_t alias) const noexcept {
+  if (!dense_aliases_.empty()) {
+    return alias < dense_aliases_.size() ? dense_aliases_[alias] : NO_ENTRY;
+  }
+  auto it = sparse_aliases_.find(alias);
+  return it != sparse_aliases_.end() ? it->second : NO_ENTRY;
+}
+
+uint32_t
+ValueStore::index_of(const org::eclipse::tahu::protobuf::Payload::Metric& metric) const noexcept {
+  if (metric.has_alias()) {
+    return alias_index(metric.alias());
+  }
+  if (metric.has_name()) {
+    auto it = by_name_.find(std::string_view(metric.name()));
+    return it != by_name_.end() ? it->second : NO_ENTRY;
+  }
+  return NO_ENTRY;
+}
+
+size_t ValueStore::update(const org::eclipse::tahu::protobuf::Payload& data) {
+  size_t updated = 0;
+  for (const auto& metric : data.metrics()) {
+    uint32_t index = index_of(metric);
+    if (index == NO_ENTRY) {
+      continue;
+    }
+    auto& entry = entries_[index];
+    uint64_t timestamp = value_timestamp(data, metric);
+    // Backfilled history must not replace a newer live value
+    if (metric.is_historical() && timestamp < entry.timestamp) {
+      continue;
+    }
+    entry.value = metric_value_from_proto(metric, entry.datatype);
+    entry.timestamp = timestamp;
+    entry.is_historical = metric.is_historical();
+    updated++;
+  }
+  return updated;
+}
+
+const ValueStore::Entry* ValueStore::find(std::string_view name) const noexcept {
+  auto it = by_name_.find(name);
+  return it != by_name_.end() ? &entries_[it->second] : nullptr;
+}
+
+const ValueStore::Entry* ValueStore::find(uint64_t alias) const noexcept {
+  uint32_t index = alias_index(alias);
+  return index != NO_ENTRY ? &entries_[index] : nullptr;
+}
+
+void ValueStore::clear() noexcept {
+  by_name_.clear();
+  entries_.clear();
+  dense_aliases_.clear();
+  sparse_aliases_.clear();
+}
+
+} // namespace sparkplug
@@ -0,0 +1,86 @@
+// src/worker_thread.cpp
+#include "sparkplug/worker_thread.hpp"
+
+#include <utility>
+
+namespace sparkplug::detail {
+
+bool WorkerThread::Run::stopped() const {
+  std::lock_guard<std::mutex> lock(state_.mutex);
+  return state_.generation != generation_;
+}
+
+bool WorkerThread::Run::wait_for(std::chrono::steady_clock::duration timeout) const {
+  std::unique_lock<std::mutex> lock(state_.mutex);
+  return state_.cv.wait_for(lock, timeout, [this] { return state_.generation != generation_; });
+}
+
+bool WorkerThread::Run::wait(const std::function<bool()>& ready) const {
+  std::unique_lock<std::mutex> lock(state_.mutex);
+  state_.cv.wait(lock, [&] { return state_.generation != generation_ || ready(); });
+  return state_.generation != generation_;
+}
+
+WorkerThread::~WorkerThread() {
+  stop();
+}
+
+bool WorkerThread::start(Body body) {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->running || state_->stopping) {
+    return false;
+  }
+
+  // A previous body has returned but its thread object still needs joining
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  state_->running = true;
+  // The thread holds its own reference: after a detaching stop() it must not touch *this
+  thread_ = std::thread(
+      [state = state_, generation = state_->generation, body = std::move(body)] {
+        body(Run(*state, generation));
+        std::lock_guard<std::mutex> done_lock(state->mutex);
+        state->running = false;
+      });
+  return true;
+}
+
+void WorkerThread::stop() {
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    // The running body sees a newer generation at its next check
+    state_->generation++;
+    state_->stopping = true;
+    thread = std::move(thread_);
+  }
+  state_->cv.notify_all();
+
+  if (thread.joinable()) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->stopping = false;
+}
+
+bool WorkerThread::running() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->running;
+}
+
+void WorkerThread::notify(const std::function<void()>& update) {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    update();
+  }
+  state_->cv.notify_all();
+}
+
+} // namespace sparkplug::detail
@@ -0,0 +1,91 @@
+// tests/test_alias_registry.cpp
+// Unit tests for the alias registry used by HostApplication
+#include <cassert>
+#include <iostream>
+
+#include <sparkplug/alias_registry.hpp>
+#include <sparkplug/payload_builder.hpp>
+
+void test_dense_registry() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  birth.add_metric_with_alias("Running", 2, true);
+  birth.add_metric_with_alias("Label", 3, "line-a");
+  birth.add_metric("bdSeq", static_cast<uint64_t>(1)); // no alias, not registered
+
+  sparkplug::StringInterner names;
+  sparkplug::AliasRegistry registry;
+  registry.rebuild(birth.payload(), names);
+
+  assert(registry.size() == 3);
+  assert(registry.is_dense());
+
+  [[maybe_unused]] const auto* entry = registry.find(1);
+  assert(entry != nullptr);
+  assert(entry->name == "Temperature");
+  assert(entry->datatype == sparkplug::DataType::Double);
+  assert(std::get<double>(entry->value) == 20.5);
+  assert(std::get<std::string>(registry.find(3)->value) == "line-a");
+  assert(registry.find(0) == nullptr);
+  assert(registry.find(4) == nullptr);
+
+  std::cout << "✓ Dense alias registry\n";
+}
+
+void test_sparse_registry() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("A", 10, 1);
+  birth.add_metric_with_alias("B", 5'000'000, 2);
+
+  sparkplug::StringInterner names;
+  sparkplug::AliasRegistry registry;
+  registry.rebuild(birth.payload(), names);
+
+  assert(registry.size() == 2);
+  assert(!registry.is_dense());
+  assert(registry.find(10)->name == "A");
+  assert(registry.find(5'000'000)->name == "B");
+  assert(registry.find(11) == nullptr);
+
+  std::cout << "✓ Sparse alias registry\n";
+}
+
+void test_update_values() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Counter", 1, static_cast<int32_t>(0));
+  birth.add_metric_with_alias("Level", 2, 1.0f);
+
+  sparkplug::StringInterner names;
+  sparkplug::AliasRegistry registry;
+  registry.rebuild(birth.payload(), names);
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, static_cast<int32_t>(-5));
+  data.add_metric_by_alias(2, 2.5f);
+  data.add_metric_by_alias(99, 7); // unknown alias
+
+  [[maybe_unused]] auto updated = registry.update_values(data.payload());
+  assert(updated == 2);
+  assert(std::get<int64_t>(registry.find(1)->value) == -5);
+  assert(std::get<float>(registry.find(2)->value) == 2.5f);
+
+  // A rebuild discards previous entries
+  sparkplug::PayloadBuilder rebirth;
+  rebirth.add_metric_with_alias("Other", 7, 1);
+  registry.rebuild(rebirth.payload(), names);
+  assert(registry.size() == 1);
+  assert(registry.find(1) == nullptr);
+
+  std::cout << "✓ Alias value updates\n";
+}
+
+int main() {
+  std::cout << "=== AliasRegistry Unit Tests ===\n\n";
+
+  test_dense_registry();
+  test_sparse_registry();
+  test_update_values();
+
+  std::cout << "\n=== All AliasRegistry tests passed! ===\n";
+  return 0;
+}
@@ -137,6 +137,110 @@ void test_payload_empty(void) {
   PASS();
 }
 
+/* Test resetting a payload for reuse */
+void test_payload_reset(void) {
+  TEST("payload reset");
+
+  sparkplug_payload_t* payload = sparkplug_payload_create();
+  assert(payload != NULL);
+
+  sparkplug_payload_set_seq(payload, 7);
+  sparkplug_payload_add_double_by_alias(payload, 1, 20.5);
+  sparkplug_payload_add_double_by_alias(payload, 2, 21.5);
+
+  sparkplug_payload_reset(payload);
+  sparkplug_payload_reset(NULL); /* Ignored */
+  sparkplug_payload_add_double_by_alias(payload, 3, 22.5);
+
+  uint8_t buffer[4096];
+  size_t size = sparkplug_payload_serialize(payload, buffer, sizeof(buffer));
+  assert(size > 0);
+
+  sparkplug_payload_t* parsed = sparkplug_payload_parse(buffer, size);
+  assert(parsed != NULL);
+  assert(sparkplug_payload_get_metric_count(parsed) == 1);
+  uint64_t seq = 0;
+  assert(!sparkplug_payload_get_seq(parsed, &seq));
+  uint64_t timestamp = 0;
+  assert(sparkplug_payload_get_timestamp(parsed, &timestamp) && timestamp > 0);
+  (void)seq;
+  (void)timestamp;
+
+  sparkplug_payload_destroy(parsed);
+  sparkplug_payload_destroy(payload);
+  PASS();
+}
+
+/* Test size query and serializing into the caller's buffer */
+void test_payload_serialized_size(void) {
+  TEST("payload serialized size");
+
+  sparkplug_payload_t* payload = sparkplug_payload_create();
+  assert(payload != NULL);
+  sparkplug_payload_add_double_with_alias(payload, "Temperature", 1, 20.5);
+  sparkplug_payload_add_string(payload, "Status", "running");
+
+  size_t expected = sparkplug_payload_serialized_size(payload);
+  assert(expected > 0);
+  assert(sparkplug_payload_serialized_size(NULL) == 0);
+
+  uint8_t buffer[4096];
+  assert(sparkplug_payload_serialize(payload, buffer, expected - 1) == 0); /* Too small */
+  size_t size = sparkplug_payload_serialize(payload, buffer, expected);
+  assert(size == expected);
+  (void)size;
+
+  sparkplug_payload_t* parsed = sparkplug_payload_parse(buffer, expected);
+  assert(parsed != NULL);
+  assert(sparkplug_payload_get_metric_count(parsed) == 2);
+  sparkplug_payload_destroy(parsed);
+
+  sparkplug_payload_destroy(payload);
+  PASS();
+}
+
+/* Test bulk alias-only metrics */
+void test_payload_add_array_by_alias(void) {
+  TEST("payload bulk add by alias");
+
+  sparkplug_payload_t* payload = sparkplug_payload_create();
+  assert(payload != NULL);
+  sparkplug_payload_set_timestamp(payload, 1700000000000ULL);
+
+  const uint64_t double_aliases[] = {1, 2, 3};
+  const double doubles[] = {20.5, 21.5, 22.5};
+  const uint64_t bool_aliases[] = {10, 11};
+  const bool bools[] = {true, false};
+  sparkplug_payload_add_double_array_by_alias(payload, double_aliases, doubles, 3, 0);
+  sparkplug_payload_add_bool_array_by_alias(payload, bool_aliases, bools, 2, 1234);
+  sparkplug_payload_add_int32_array_by_alias(payload, NULL, NULL, 5, 0); /* Ignored */
+
+  uint8_t buffer[4096];
+  size_t size = sparkplug_payload_serialize(payload, buffer, sizeof(buffer));
+  assert(size > 0);
+
+  sparkplug_payload_t* parsed = sparkplug_payload_parse(buffer, size);
+  assert(parsed != NULL);
+  assert(sparkplug_payload_get_metric_count(parsed) == 5);
+
+  sparkplug_metric_t metric;
+  assert(sparkplug_payload_get_metric_at(parsed, 2, &metric));
+  assert(metric.has_alias && metric.alias == 3);
+  assert(metric.datatype == SPARKPLUG_DATA_TYPE_DOUBLE);
+  assert(metric.value.double_value == 22.5);
+  assert(metric.has_timestamp && metric.timestamp == 1700000000000ULL);
+
+  assert(sparkplug_payload_get_metric_at(parsed, 4, &metric));
+  assert(metric.alias == 11 && metric.datatype == SPARKPLUG_DATA_TYPE_BOOLEAN);
+  assert(!metric.value.boolean_value);
+  assert(metric.timestamp == 1234);
+  (void)metric;
+
+  sparkplug_payload_destroy(parsed);
+  sparkplug_payload_destroy(payload);
+  PASS();
+}
+
 /* Test publisher creation and destruction */
 void test_publisher_create_destroy(void) {
   TEST("publisher create/destroy");
@@ -255,6 +359,24 @@ void test_publisher_data(void) {
   /* Check sequence incremented */
   uint64_t seq = sparkplug_publisher_get_seq(pub);
   assert(seq == 1);
+
+  /* Publish the builder directly: the library assigns its seq */
+  sparkplug_payload_reset(data);
+  sparkplug_payload_add_int32_by_alias(data, 1, 300);
+  result = sparkplug_publisher_publish_data_payload(pub, data);
+  assert(result == 0);
+  assert(sparkplug_publisher_get_seq(pub) == 2);
+  assert(sparkplug_payload_get_seq(data, &seq) && seq == 2);
+
+  /* Republished without a reset, or with a seq of its own, it still gets the next one */
+  result = sparkplug_publisher_publish_data_payload(pub, data);
+  assert(result == 0);
+  assert(sparkplug_payload_get_seq(data, &seq) && seq == 3);
+  sparkplug_payload_set_seq(data, 99);
+  result = sparkplug_publisher_publish_data_payload(pub, data);
+  assert(result == 0);
+  assert(sparkplug_payload_get_seq(data, &seq) && seq == 4);
+  assert(sparkplug_publisher_publish_data_payload(pub, NULL) == -1);
   (void)seq;
 
   sparkplug_payload_destroy(data);
@@ -264,6 +386,61 @@ void test_publisher_data(void) {
   PASS();
 }
 
+/* Test publisher statistics */
+void test_publisher_stats(void) {
+  TEST("publisher stats");
+
+  sparkplug_publisher_t* pub =
+      sparkplug_publisher_create("tcp://localhost:1883", "test_c_stats", "TestGroup", "TestNodeC10");
+  assert(pub != NULL);
+
+  sparkplug_stats_t stats;
+  if (sparkplug_publisher_get_stats(pub, &stats) != 0 || stats.bytes_out != 0) {
+    sparkplug_publisher_destroy(pub);
+    FAIL("fresh publisher should have zero counters");
+  }
+  if (sparkplug_publisher_get_stats(NULL, &stats) != -1 ||
+      sparkplug_publisher_get_stats(pub, NULL) != -1) {
+    sparkplug_publisher_destroy(pub);
+    FAIL("NULL arguments should be rejected");
+  }
+
+  if (sparkplug_publisher_connect(pub) != 0) {
+    sparkplug_publisher_destroy(pub);
+    FAIL("failed to connect");
+  }
+
+  sparkplug_payload_t* birth = sparkplug_payload_create();
+  sparkplug_payload_add_int32_with_alias(birth, "Metric1", 1, 100);
+  uint8_t buffer[4096];
+  size_t size = sparkplug_payload_serialize(birth, buffer, sizeof(buffer));
+  sparkplug_publisher_publish_birth(pub, buffer, size);
+  sparkplug_payload_destroy(birth);
+
+  sparkplug_payload_t* data = sparkplug_payload_create();
+  sparkplug_payload_add_int32_by_alias(data, 1, 200);
+  size = sparkplug_payload_serialize(data, buffer, sizeof(buffer));
+  sparkplug_publisher_publish_data(pub, buffer, size);
+  sparkplug_publisher_publish_data(pub, buffer, size);
+  sparkplug_payload_destroy(data);
+
+  sparkplug_publisher_get_stats(pub, &stats);
+  sparkplug_publisher_disconnect(pub);
+  sparkplug_publisher_destroy(pub);
+
+  if (stats.messages_out[SPARKPLUG_MESSAGE_TYPE_NBIRTH] != 1 ||
+      stats.messages_out[SPARKPLUG_MESSAGE_TYPE_NDATA] != 2 || stats.bytes_out == 0 ||
+      stats.publish_failures != 0) {
+    FAIL("unexpected publish counters");
+  }
+  if (sparkplug_histogram_bucket_upper_bound_us(0) != 1 ||
+      sparkplug_histogram_bucket_upper_bound_us(SPARKPLUG_HISTOGRAM_BUCKETS - 1) != UINT64_MAX) {
+    FAIL("unexpected histogram bucket bounds");
+  }
+
+  PASS();
+}
+
 /* Test publisher rebirth */
 void test_publisher_rebirth(void) {
   TEST("publisher rebirth");
@@ -735,6 +912,98 @@ void test_subscriber_command_callback(void) {
   PASS();
 }
 
+/* Payload callback for testing: records the NDATA it receives */
+static int view_data_received = 0;
+static uint64_t view_seq = 0;
+static size_t view_metric_count = 0;
+static sparkplug_metric_t view_metric;
+static void test_payload_view_callback(const char* topic, const sparkplug_payload_view_t* payload,
+                                       void* ctx) {
+  int* counter = (int*)ctx;
+  (*counter)++;
+  if (strstr(topic, "/NDATA/") == NULL) {
+    return;
+  }
+  view_data_received = 1;
+  sparkplug_payload_view_get_seq(payload, &view_seq);
+  view_metric_count = sparkplug_payload_view_get_metric_count(payload);
+  if (!sparkplug_payload_view_get_metric_at(payload, 0, &view_metric)) {
+    view_metric_count = 0;
+  }
+  /* Strings are borrowed: only valid until the callback returns */
+  view_metric.name = NULL;
+}
+
+/* Test subscriber payload callback (borrowed, already-parsed payloads) */
+void test_subscriber_payload_callback(void) {
+  TEST("subscriber payload callback");
+
+  view_data_received = 0;
+  int messages = 0;
+
+  sparkplug_publisher_t* pub = sparkplug_publisher_create("tcp://localhost:1883", "test_c_view_pub",
+                                                          "TestGroup", "ViewNodeC");
+  assert(pub != NULL);
+
+  sparkplug_subscriber_t* sub = sparkplug_subscriber_create(
+      "tcp://localhost:1883", "test_c_view_sub", "TestGroup", dummy_callback, NULL);
+  assert(sub != NULL);
+  sparkplug_subscriber_set_payload_callback(sub, test_payload_view_callback, &messages);
+  sparkplug_subscriber_set_payload_callback(NULL, test_payload_view_callback, NULL); /* Ignored */
+
+  if (sparkplug_subscriber_connect(sub) != 0) {
+    sparkplug_publisher_destroy(pub);
+    sparkplug_subscriber_destroy(sub);
+    FAIL("subscriber failed to connect");
+    return;
+  }
+  int result = sparkplug_subscriber_subscribe_all(sub);
+  assert(result == 0);
+
+  if (sparkplug_publisher_connect(pub) != 0) {
+    sparkplug_subscriber_disconnect(sub);
+    sparkplug_publisher_destroy(pub);
+    sparkplug_subscriber_destroy(sub);
+    FAIL("publisher failed to connect");
+    return;
+  }
+  usleep(200000);
+
+  uint8_t buffer[4096];
+  sparkplug_payload_t* payload = sparkplug_payload_create();
+  sparkplug_payload_add_double_with_alias(payload, "Temperature", 1, 20.5);
+  size_t size = sparkplug_payload_serialize(payload, buffer, sizeof(buffer));
+  result = sparkplug_publisher_publish_birth(pub, buffer, size);
+  assert(result == 0);
+
+  sparkplug_payload_reset(payload);
+  sparkplug_payload_add_double_by_alias(payload, 1, 42.5);
+  size = sparkplug_payload_serialize(payload, buffer, sizeof(buffer));
+  result = sparkplug_publisher_publish_data(pub, buffer, size);
+  assert(result == 0);
+  sparkplug_payload_destroy(payload);
+
+  usleep(500000);
+
+  sparkplug_subscriber_disconnect(sub);
+  sparkplug_publisher_disconnect(pub);
+  sparkplug_subscriber_destroy(sub);
+  sparkplug_publisher_destroy(pub);
+
+  if (!view_data_received) {
+    FAIL("payload callback not invoked for NDATA");
+    return;
+  }
+  assert(messages >= 2);
+  assert(view_seq == 1);
+  assert(view_metric_count == 1);
+  assert(view_metric.has_alias && view_metric.alias == 1);
+  assert(view_metric.datatype == SPARKPLUG_DATA_TYPE_DOUBLE);
+  assert(view_metric.value.double_value == 42.5);
+
+  PASS();
+}
+
 /* Test payload parse and read */
 void test_payload_parse_and_read(void) {
   TEST("payload parse and read");
@@ -996,6 +1265,9 @@ int main(void) {
   test_payload_add_by_alias();
   test_payload_timestamp_seq();
   test_payload_empty();
+  test_payload_reset();
+  test_payload_serialized_size();
+  test_payload_add_array_by_alias();
 
   /* NEW: Payload parsing tests */
   test_payload_parse_and_read();
@@ -1008,6 +1280,7 @@ int main(void) {
   test_publisher_connect();
   test_publisher_birth();
   test_publisher_data();
+  test_publisher_stats();
   test_publisher_rebirth();
 
   /* Subscriber tests (require MQTT broker) */
@@ -1025,6 +1298,7 @@ int main(void) {
   test_publisher_node_command();
   test_publisher_device_command();
   test_subscriber_command_callback();
+  test_subscriber_payload_callback();
 
   /* Host Application callback tests (require MQTT broker) */
   test_host_application_with_callback();
@@ -0,0 +1,134 @@
+// tests/test_columnar.cpp
+// Unit tests for columnar decoding of DataSet and NDATA metrics
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sparkplug/columnar.hpp>
+#include <sparkplug/payload_builder.hpp>
+
+namespace {
+
+using Payload = org::eclipse::tahu::protobuf::Payload;
+
+void test_decode_dataset() {
+  std::vector<uint64_t> times = {1000, 2000, 3000};
+  std::vector<float> volts = {1.5f, -2.25f, 3.0f};
+  std::vector<int8_t> codes = {-1, 0, 7};
+  std::vector<std::string> labels = {"a", "b", "c"};
+
+  sparkplug::PayloadBuilder builder;
+  builder.add_dataset(
+      "Waveform", {{"t", times}, {"volts", volts}, {"code", codes}, {"label", labels}});
+  auto dataset = builder.payload().metrics(0).dataset_value();
+  dataset.mutable_rows(1)->mutable_elements(1)->clear_value(); // Null cell
+
+  sparkplug::DecodedDataSet table;
+  auto decoded = sparkplug::decode_dataset(dataset, table);
+  assert(decoded);
+  assert(table.row_count == 3);
+  assert(table.columns.size() == 4);
+  assert(table.columns[1].name == "volts");
+  assert(table.columns[1].type == sparkplug::DataType::Float);
+  assert(table.columns[0].values == std::vector<double>({1000, 2000, 3000}));
+  assert(table.columns[1].values[0] == 1.5);
+  assert(std::isnan(table.columns[1].values[1]));
+  assert(table.columns[2].values == std::vector<double>({-1, 0, 7}));
+  assert(table.columns[3].values.empty());
+  assert(table.columns[3].strings == labels);
+
+  // Exact typed copy of one column
+  std::vector<int64_t> exact;
+  auto rows = sparkplug::decode_dataset_column(dataset, 2, exact);
+  assert(rows && *rows == 3);
+  assert(exact == std::vector<int64_t>({-1, 0, 7}));
+  std::vector<uint64_t> stamps;
+  rows = sparkplug::decode_dataset_column(dataset, 0, stamps);
+  assert(rows && stamps == times);
+  assert(!sparkplug::decode_dataset_column(dataset, 4, stamps));
+
+  // Malformed rows are reported rather than decoded
+  dataset.mutable_rows(2)->mutable_elements()->RemoveLast();
+  decoded = sparkplug::decode_dataset(dataset, table);
+  assert(!decoded);
+  (void)rows;
+
+  std::cout << "✓ DataSet decodes into contiguous typed columns\n";
+}
+
+void test_decode_metrics() {
+  sparkplug::PayloadBuilder first;
+  first.set_timestamp(5000);
+  first.add_metric_by_alias(1, 20.5, 4000);
+  first.add_metric_by_alias(2, static_cast<int32_t>(-3), 4001);
+  first.add_metric_by_alias(3, true, 4002);
+  first.add_metric_by_alias(4, "text", 4003); // Not numeric
+  first.add_metric("Named", 1.0, 4004);       // No alias
+  auto payload = first.payload();
+  auto* quality = payload.mutable_metrics(0)->mutable_properties();
+  quality->add_keys("Quality");
+  quality->add_values()->set_int_value(500);
+
+  sparkplug::PayloadBuilder second;
+  second.set_timestamp(6000);
+  second.add_metric_by_alias(1, 21.0);
+  auto nulled = second.payload();
+  nulled.mutable_metrics(0)->clear_timestamp();
+  nulled.mutable_metrics(0)->set_is_null(true);
+  nulled.mutable_metrics(0)->clear_value();
+
+  sparkplug::MetricColumns batch;
+  assert(sparkplug::decode_metrics(payload, batch) == 3);
+  assert(sparkplug::decode_metrics(nulled, batch) == 1);
+  assert(batch.size() == 4);
+  assert(batch.aliases == std::vector<uint64_t>({1, 2, 3, 1}));
+  assert(batch.timestamps == std::vector<uint64_t>({4000, 4001, 4002, 6000}));
+  assert(batch.values[0] == 20.5 && batch.values[1] == -3.0 && batch.values[2] == 1.0);
+  assert(std::isnan(batch.values[3]));
+  assert(batch.quality ==
+         std::vector<int32_t>({500, sparkplug::QUALITY_GOOD, sparkplug::QUALITY_GOOD,
+                               sparkplug::QUALITY_BAD}));
+
+  auto capacity = batch.values.capacity();
+  batch.clear();
+  assert(batch.size() == 0 && batch.values.capacity() == capacity);
+
+  std::cout << "✓ NDATA metrics accumulate into parallel columns\n";
+}
+
+void test_decode_metrics_grows_geometrically() {
+  sparkplug::PayloadBuilder builder;
+  builder.add_metric_by_alias(1, 1.0, 1000);
+  auto payload = builder.payload();
+
+  // Appending one metric at a time must not reallocate the columns on every payload
+  sparkplug::MetricColumns batch;
+  size_t reallocations = 0;
+  for (int i = 0; i < 1024; i++) {
+    auto capacity = batch.values.capacity();
+    assert(sparkplug::decode_metrics(payload, batch) == 1);
+    if (batch.values.capacity() != capacity) {
+      reallocations++;
+    }
+  }
+  assert(batch.size() == 1024);
+  assert(reallocations <= 11);
+
+  std::cout << "✓ Column capacity grows geometrically across payloads\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Columnar Decode Tests ===\n\n";
+
+  test_decode_dataset();
+  test_decode_metrics();
+  test_decode_metrics_grows_geometrically();
+
+  std::cout << "\n=== All columnar decode tests passed ===\n";
+  return 0;
+}
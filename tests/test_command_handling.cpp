@@ -2,7 +2,12 @@
 // Tests for command handling (NCMD/DCMD)
 #include <atomic>
 #include <cassert>
+#include <expected>
+#include <format>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -356,6 +361,237 @@ void test_both_callbacks_invoked() {
   (void)sub.disconnect();
 }
 
+// Test 5: connect_async() sessions are ready for NCMD when the callback fires
+void test_async_connect() {
+  const std::string name = "Async connect subscribes NCMD before completing";
+  constexpr size_t NODE_COUNT = 8;
+  std::atomic<int> commands_received{0};
+
+  sparkplug::HostApplication::Config host_config{.broker_url = "tcp://localhost:1883",
+                                                 .client_id = "test_async_connect_host",
+                                                 .host_id = "AsyncHost"};
+  sparkplug::HostApplication host(std::move(host_config));
+
+  std::promise<std::expected<void, std::string>> host_ready;
+  auto host_future = host_ready.get_future();
+  auto host_started =
+      host.connect_async([&](std::expected<void, std::string> result) {
+        host_ready.set_value(std::move(result));
+      });
+  if (!host_started || host_future.wait_for(std::chrono::seconds(5)) !=
+                           std::future_status::ready ||
+      !host_future.get()) {
+    report_test(name, false, "Host failed to connect");
+    return;
+  }
+
+  std::vector<std::unique_ptr<sparkplug::EdgeNode>> nodes;
+  for (size_t i = 0; i < NODE_COUNT; i++) {
+    sparkplug::EdgeNode::Config config{
+        .broker_url = "tcp://localhost:1883",
+        .client_id = std::format("test_async_connect_{}", i),
+        .group_id = "TestGroup",
+        .edge_node_id = std::format("AsyncNode{}", i),
+        .command_callback = [&](const sparkplug::Topic& topic,
+                                const org::eclipse::tahu::protobuf::Payload&) {
+          if (topic.message_type == sparkplug::MessageType::NCMD) {
+            commands_received++;
+          }
+        }};
+    nodes.push_back(std::make_unique<sparkplug::EdgeNode>(std::move(config)));
+  }
+
+  // Start every connection before waiting for any of them
+  std::atomic<size_t> completed{0};
+  std::atomic<size_t> succeeded{0};
+  bool started = true;
+  for (auto& node : nodes) {
+    started = started && node->connect_async([&](std::expected<void, std::string> result) {
+                             if (result) {
+                               succeeded++;
+                             }
+                             completed++;
+                           }).has_value();
+  }
+
+  for (int i = 0; i < 100 && completed < NODE_COUNT; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  bool empty_rejected = !nodes[0]->connect_async(nullptr);
+
+  for (size_t i = 0; i < NODE_COUNT; i++) {
+    sparkplug::PayloadBuilder cmd;
+    cmd.add_metric("Node Control/Rebirth", true);
+    (void)host.publish_node_command("TestGroup", std::format("AsyncNode{}", i), cmd);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  bool passed = started && empty_rejected && succeeded == NODE_COUNT &&
+                commands_received == static_cast<int>(NODE_COUNT);
+  report_test(name, passed,
+              passed ? ""
+                     : std::format("Connected: {}/{}, commands: {}", succeeded.load(), NODE_COUNT,
+                                   commands_received.load()));
+
+  for (auto& node : nodes) {
+    (void)node->disconnect();
+  }
+  (void)host.disconnect();
+}
+
+// Polls until done() holds or about two seconds have passed
+template <typename Predicate> bool wait_until(Predicate done) {
+  for (int i = 0; i < 100 && !done(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  return done();
+}
+
+// Test 6: Registered handlers receive NCMD/DCMD metrics sent by name or by birth alias
+void test_command_registry() {
+  const std::string name = "Registered handlers dispatch by name and alias";
+  std::atomic<int> reboots{0};
+  std::atomic<int> set_points{0};
+  std::atomic<bool> wrong_device{false};
+  std::atomic<int> pinged{0};
+
+  sparkplug::EdgeNode node({.broker_url = "tcp://localhost:1883",
+                            .client_id = "test_registry_node",
+                            .group_id = "TestGroup",
+                            .edge_node_id = "RegistryNode"});
+  bool registered =
+      node.register_command("Node Control/Reboot",
+                            [&](std::string_view device_id, const auto& metric) {
+                              wrong_device = wrong_device || !device_id.empty();
+                              if (metric.boolean_value()) {
+                                reboots++;
+                              }
+                            })
+          .has_value();
+  registered = registered && node.register_command(42, [&](auto, const auto&) { pinged++; });
+  registered = registered &&
+               node.register_device_command("SetPoint", [&](std::string_view device_id,
+                                                            const auto& metric) {
+                     wrong_device = wrong_device || device_id != "Motor01";
+                     if (metric.double_value() == 75.0) {
+                       set_points++;
+                     }
+                   });
+
+  sparkplug::HostApplication host({.broker_url = "tcp://localhost:1883",
+                                   .client_id = "test_registry_host",
+                                   .host_id = "RegistryHost"});
+  if (!registered || !node.connect() || !host.connect()) {
+    report_test(name, false, "Setup failed");
+    return;
+  }
+
+  bool late_rejected = !node.register_command("Late", [](auto, const auto&) {});
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Node Control/Reboot", 5, false);
+  sparkplug::PayloadBuilder dbirth;
+  dbirth.add_metric_with_alias("SetPoint", 7, 70.0);
+  if (!node.publish_birth(birth) || !node.publish_device_birth("Motor01", dbirth)) {
+    report_test(name, false, "Births failed");
+    return;
+  }
+
+  sparkplug::PayloadBuilder by_name;
+  by_name.add_metric("Node Control/Reboot", true);
+  by_name.add_metric("Unregistered", true);
+  sparkplug::PayloadBuilder by_alias;
+  by_alias.add_metric_by_alias(5, true);
+  by_alias.add_metric_by_alias(42, true);
+  sparkplug::PayloadBuilder device_by_name;
+  device_by_name.add_metric("SetPoint", 75.0);
+  sparkplug::PayloadBuilder device_by_alias;
+  device_by_alias.add_metric_by_alias(7, 75.0);
+  (void)host.publish_node_command("TestGroup", "RegistryNode", by_name);
+  (void)host.publish_node_command("TestGroup", "RegistryNode", by_alias);
+  (void)host.publish_device_command("TestGroup", "RegistryNode", "Motor01", device_by_name);
+  (void)host.publish_device_command("TestGroup", "RegistryNode", "Motor01", device_by_alias);
+
+  bool passed =
+      wait_until([&] { return reboots == 2 && set_points == 2 && pinged == 1; }) &&
+      late_rejected && !wrong_device;
+  report_test(name, passed,
+              passed ? ""
+                     : std::format("Reboots: {}, set points: {}, pinged: {}, late rejected: {}",
+                                   reboots.load(), set_points.load(), pinged.load(),
+                                   late_rejected));
+
+  (void)node.disconnect();
+  (void)host.disconnect();
+}
+
+// Test 7: Node Control/Rebirth and Scan Rate are answered by the library
+void test_library_node_control() {
+  const std::string name = "Library answers Rebirth and Scan Rate";
+  std::atomic<int> births{0};
+  std::atomic<int64_t> confirmed_rate{0};
+
+  sparkplug::HostApplication host(
+      {.broker_url = "tcp://localhost:1883",
+       .client_id = "test_control_host",
+       .host_id = "ControlHost",
+       .message_callback = [&](const sparkplug::Topic& topic,
+                               const org::eclipse::tahu::protobuf::Payload& payload) {
+         if (topic.edge_node_id != "ControlNode") {
+           return;
+         }
+         if (topic.message_type == sparkplug::MessageType::NBIRTH) {
+           births++;
+         } else if (topic.message_type == sparkplug::MessageType::NDATA) {
+           for (const auto& metric : payload.metrics()) {
+             if (metric.alias() == 2) {
+               confirmed_rate = static_cast<int64_t>(metric.long_value());
+             }
+           }
+         }
+       }});
+  sparkplug::EdgeNode node({.broker_url = "tcp://localhost:1883",
+                            .client_id = "test_control_node",
+                            .group_id = "TestGroup",
+                            .edge_node_id = "ControlNode",
+                            .handle_node_control = true});
+  if (!host.connect() || !host.subscribe_node("TestGroup", "ControlNode") || !node.connect()) {
+    report_test(name, false, "Setup failed");
+    return;
+  }
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Node Control/Rebirth", 1, false);
+  birth.add_metric_with_alias("Node Control/Scan Rate", 2, static_cast<int64_t>(1000));
+  if (!node.publish_birth(birth) || !wait_until([&] { return births == 1; })) {
+    report_test(name, false, "NBIRTH failed");
+    return;
+  }
+  bool declared_rate = node.scan_rate_ms() == 1000;
+  auto bd_seq = node.get_bd_seq();
+
+  sparkplug::PayloadBuilder rebirth;
+  rebirth.add_metric_by_alias(1, true);
+  (void)host.publish_node_command("TestGroup", "ControlNode", rebirth);
+  bool reborn = wait_until([&] { return births == 2; }) && node.get_bd_seq() == bd_seq;
+
+  sparkplug::PayloadBuilder scan_rate;
+  scan_rate.add_metric("Node Control/Scan Rate", static_cast<int64_t>(250));
+  (void)host.publish_node_command("TestGroup", "ControlNode", scan_rate);
+  bool confirmed = wait_until([&] { return confirmed_rate == 250; }) && node.scan_rate_ms() == 250;
+
+  bool passed = declared_rate && reborn && confirmed;
+  report_test(name, passed,
+              passed ? ""
+                     : std::format("Declared rate: {}, births: {}, confirmed rate: {}",
+                                   declared_rate, births.load(), confirmed_rate.load()));
+
+  (void)node.disconnect();
+  (void)host.disconnect();
+}
+
 int main() {
   std::cout << "Running Command Handling Tests...\n\n";
 
@@ -363,6 +599,9 @@ int main() {
   test_dcmd_callback_invoked();
   test_multiple_commands();
   test_both_callbacks_invoked();
+  test_async_connect();
+  test_command_registry();
+  test_library_node_control();
 
   // Summary
   std::cout << "\n========== Test Summary ==========\n";
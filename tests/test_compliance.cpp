@@ -1,12 +1,22 @@
 // tests/test_compliance.cpp
 // Sparkplug 2.2 Compliance Tests
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cassert>
+#include <format>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <sparkplug/edge_node.hpp>
+#include <sparkplug/edge_node_group.hpp>
 #include <sparkplug/host_application.hpp>
 
 // Test result tracking
@@ -300,6 +310,73 @@ void test_alias_usage() {
   (void)sub.disconnect();
 }
 
+// Test: resolve_aliases fills in names of alias-only NDATA metrics
+void test_alias_resolution() {
+  std::atomic<bool> got_ndata{false};
+  std::atomic<bool> resolved{false};
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.message_type == sparkplug::MessageType::NDATA &&
+        topic.edge_node_id == "TestNodeResolve") {
+      got_ndata = true;
+      for (const auto& metric : payload.metrics()) {
+        if (metric.alias() == 1 && metric.name() == "Temperature" &&
+            metric.datatype() == std::to_underlying(sparkplug::DataType::Double) &&
+            metric.double_value() == 21.0) {
+          resolved = true;
+        }
+      }
+    }
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_resolve_sub",
+                                                .host_id = "TestGroup",
+                                                .resolve_aliases = true,
+                                                .message_callback = callback};
+
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_all_groups()) {
+    report_test("Host resolves NDATA aliases", false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_resolve_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeResolve"};
+
+  sparkplug::EdgeNode pub(std::move(pub_config));
+  if (!pub.connect()) {
+    report_test("Host resolves NDATA aliases", false, "Publisher failed to connect");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  (void)pub.publish_birth(birth);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, 21.0);
+  (void)pub.publish_data(data);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  bool passed = got_ndata && resolved;
+  report_test("Host resolves NDATA aliases", passed,
+              !got_ndata  ? "No NDATA received"
+              : !resolved ? "Alias not resolved to name"
+                          : "");
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
 // Test 6: Subscriber validates sequence
 void test_subscriber_validation() {
   auto callback = [](const sparkplug::Topic&, const auto&) {
@@ -783,6 +860,1107 @@ void test_command_callback() {
   (void)sub.disconnect();
 }
 
+// Test: Arena-backed parsing delivers the same payload contents
+void test_arena_parsing() {
+  std::atomic<int> births_seen{0};
+  std::atomic<bool> contents_ok{true};
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.message_type != sparkplug::MessageType::NBIRTH ||
+        topic.edge_node_id != "TestNodeArena") {
+      return;
+    }
+    bool found = false;
+    for (const auto& metric : payload.metrics()) {
+      if (metric.name() == "Label" && metric.string_value() == "arena-value") {
+        found = true;
+      }
+    }
+    if (!found || payload.metrics_size() != 3) {
+      contents_ok = false;
+    }
+    births_seen++;
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_arena_sub",
+                                                .host_id = "TestGroup",
+                                                .use_arena = true,
+                                                .arena_block_size = 256,
+                                                .message_callback = callback};
+
+  sparkplug::HostApplication sub(std::move(sub_config));
+
+  if (!sub.connect() || !sub.subscribe_all_groups()) {
+    report_test("Arena payload parsing", false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_arena_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeArena"};
+
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  if (!pub.connect()) {
+    report_test("Arena payload parsing", false, "Publisher failed to connect");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric("Temperature", 20.5);
+  birth.add_metric("Label", "arena-value");
+  (void)pub.publish_birth(birth);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  // Rebirth replays the NBIRTH so the second parse reuses the reset arena
+  (void)pub.rebirth();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  bool passed = births_seen >= 2 && contents_ok;
+  report_test("Arena payload parsing", passed,
+              births_seen < 2 ? "Expected two NBIRTH messages"
+              : !contents_ok  ? "Payload contents mismatch"
+                              : "");
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+// Test: Concurrent NDATA producers advance seq exactly once per message
+void test_concurrent_publish_sequence() {
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_concurrent_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeConcurrent"};
+
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  if (!pub.connect()) {
+    report_test("Concurrent NDATA sequence", false, "Publisher failed to connect");
+    return;
+  }
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Value", 1, 0);
+  if (!pub.publish_birth(birth)) {
+    report_test("Concurrent NDATA sequence", false, "Failed to publish NBIRTH");
+    (void)pub.disconnect();
+    return;
+  }
+
+  constexpr int threads = 4;
+  constexpr int per_thread = 100;
+  std::atomic<int> failures{0};
+  std::vector<std::thread> producers;
+  for (int t = 0; t < threads; t++) {
+    producers.emplace_back([&pub, &failures, t]() {
+      for (int i = 0; i < per_thread; i++) {
+        sparkplug::PayloadBuilder data;
+        data.add_metric_by_alias(1, t * per_thread + i);
+        if (!pub.publish_data(data)) {
+          failures++;
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  uint64_t expected_seq = (threads * per_thread) % 256;
+  bool passed = failures == 0 && pub.get_seq() == expected_seq;
+  report_test("Concurrent NDATA sequence", passed,
+              failures != 0 ? "Publish failed" : passed ? "" : "Sequence counter lost updates");
+
+  (void)pub.disconnect();
+}
+
+// Test: Dispatch workers keep per-node ordering while handling nodes in parallel
+void test_dispatch_pool_ordering() {
+  constexpr int nodes = 3;
+  constexpr int messages = 50;
+  std::mutex seen_mutex;
+  std::vector<std::vector<int64_t>> seen(nodes);
+  std::atomic<bool> off_mqtt_thread{true};
+  // Recorded by the connect completion, which Paho runs on the thread that delivers messages
+  std::atomic<std::thread::id> mqtt_thread{};
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.message_type != sparkplug::MessageType::NDATA ||
+        !topic.edge_node_id.starts_with("TestNodeDispatch")) {
+      return;
+    }
+    if (std::this_thread::get_id() == mqtt_thread.load()) {
+      off_mqtt_thread = false;
+    }
+    int index = topic.edge_node_id.back() - '0';
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen[index].push_back(payload.metrics(0).long_value());
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_dispatch_sub",
+                                                .host_id = "TestGroup",
+                                                .dispatch_threads = 4,
+                                                .dispatch_queue_capacity = 8,
+                                                .message_callback = callback};
+
+  sparkplug::HostApplication sub(std::move(sub_config));
+
+  std::promise<std::expected<void, std::string>> connected;
+  auto connected_future = connected.get_future();
+  auto started = sub.connect_async([&](std::expected<void, std::string> result) {
+    mqtt_thread = std::this_thread::get_id();
+    connected.set_value(std::move(result));
+  });
+  if (!started ||
+      connected_future.wait_for(std::chrono::seconds(10)) != std::future_status::ready ||
+      !connected_future.get() || !sub.subscribe_all_groups()) {
+    report_test("Dispatch pool per-node ordering", false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  std::vector<std::unique_ptr<sparkplug::EdgeNode>> pubs;
+  for (int n = 0; n < nodes; n++) {
+    sparkplug::EdgeNode::Config pub_config{
+        .broker_url = "tcp://localhost:1883",
+        .client_id = "test_dispatch_pub" + std::to_string(n),
+        .group_id = "TestGroup",
+        .edge_node_id = "TestNodeDispatch" + std::to_string(n)};
+    auto pub = std::make_unique<sparkplug::EdgeNode>(std::move(pub_config));
+    sparkplug::PayloadBuilder birth;
+    birth.add_metric_with_alias("Counter", 1, static_cast<int64_t>(0));
+    if (!pub->connect() || !pub->publish_birth(birth)) {
+      report_test("Dispatch pool per-node ordering", false, "Publisher setup failed");
+      (void)sub.disconnect();
+      return;
+    }
+    pubs.push_back(std::move(pub));
+  }
+
+  for (int i = 0; i < messages; i++) {
+    for (auto& pub : pubs) {
+      sparkplug::PayloadBuilder data;
+      data.add_metric_by_alias(1, static_cast<int64_t>(i));
+      (void)pub->publish_data(data);
+    }
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(800));
+
+  bool ordered = true;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    for (const auto& values : seen) {
+      if (values.size() != messages) {
+        ordered = false;
+        break;
+      }
+      for (int i = 0; i < messages; i++) {
+        if (values[i] != i) {
+          ordered = false;
+        }
+      }
+    }
+  }
+
+  bool passed = ordered && off_mqtt_thread && mqtt_thread.load() != std::thread::id{};
+  report_test("Dispatch pool per-node ordering", passed,
+              !ordered ? "Messages missing or out of order" : passed ? "" : "Ran on MQTT thread");
+
+  for (auto& pub : pubs) {
+    (void)pub->disconnect();
+  }
+  (void)sub.disconnect();
+}
+
+// Test: In-session rebirth republishes NBIRTH and DBIRTHs without reconnecting
+void test_in_session_rebirth() {
+  const std::string name = "In-session rebirth republishes births";
+  struct Seen {
+    sparkplug::MessageType type;
+    uint64_t seq;
+    std::optional<uint64_t> bd_seq;
+    size_t metric_count;
+  };
+  std::mutex seen_mutex;
+  std::vector<Seen> seen;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.edge_node_id != "TestNodeRebirth") {
+      return;
+    }
+    Seen entry{.type = topic.message_type,
+               .seq = payload.seq(),
+               .bd_seq = std::nullopt,
+               .metric_count = static_cast<size_t>(payload.metrics_size())};
+    for (const auto& metric : payload.metrics()) {
+      if (metric.name() == "bdSeq") {
+        entry.bd_seq = metric.long_value();
+      }
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.push_back(entry);
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_rebirth_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_all_groups()) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_rebirth_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeRebirth"};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  // A two-byte bdSeq varint forces the patch to shrink the metric
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric("bdSeq", static_cast<uint64_t>(300));
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  birth.add_metric_with_alias("Status", 2, std::string("ok"));
+  if (!pub.connect() || !pub.publish_birth(birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  for (const char* device : {"RebirthDevA", "RebirthDevB"}) {
+    sparkplug::PayloadBuilder device_birth;
+    device_birth.add_metric_with_alias("Speed", 1, 100);
+    (void)pub.publish_device_birth(device, device_birth);
+  }
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, 21.0);
+  (void)pub.publish_data(data);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.clear();
+  }
+
+  auto result = pub.rebirth(sparkplug::RebirthMode::InSession);
+  sparkplug::PayloadBuilder after;
+  after.add_metric_by_alias(1, 22.0);
+  (void)pub.publish_data(after);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  bool passed = false;
+  std::string message;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    if (!result) {
+      message = "Rebirth failed: " + result.error();
+    } else if (seen.size() != 4) {
+      message = std::format("Expected 4 messages, got {}", seen.size());
+    } else {
+      passed = seen[0].type == sparkplug::MessageType::NBIRTH && seen[0].seq == 0 &&
+               seen[0].bd_seq == pub.get_bd_seq() && seen[0].metric_count == 3 &&
+               seen[1].type == sparkplug::MessageType::DBIRTH && seen[1].seq == 1 &&
+               seen[2].type == sparkplug::MessageType::DBIRTH && seen[2].seq == 2 &&
+               seen[3].type == sparkplug::MessageType::NDATA && seen[3].seq == 3;
+      message = passed ? "" : "Births out of order or not patched";
+    }
+  }
+  report_test(name, passed, message);
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+// Test: Paced in-session rebirth spreads DBIRTHs and lets fresh data through
+void test_paced_birth_replay() {
+  const std::string name = "Paced rebirth spreads DBIRTHs behind fresh data";
+  constexpr size_t device_count = 20;
+  struct Seen {
+    sparkplug::MessageType type;
+    std::string device_id;
+    uint64_t seq;
+    std::chrono::steady_clock::time_point at;
+  };
+  std::mutex seen_mutex;
+  std::vector<Seen> seen;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.edge_node_id != "TestNodePacedRebirth") {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.push_back({.type = topic.message_type,
+                    .device_id = topic.device_id,
+                    .seq = payload.seq(),
+                    .at = std::chrono::steady_clock::now()});
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_paced_rebirth_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_paced_rebirth_pub",
+      .group_id = "TestGroup",
+      .edge_node_id = "TestNodePacedRebirth",
+      .birth_replay = {.window = std::chrono::milliseconds(500), .burst = 2}};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  if (!pub.connect() || !pub.publish_birth(birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+  for (size_t i = 0; i < device_count; i++) {
+    sparkplug::PayloadBuilder device_birth;
+    device_birth.add_metric_with_alias("Speed", 1, 100);
+    (void)pub.publish_device_birth(std::format("PacedDev{}", i), device_birth);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.clear();
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  auto result = pub.rebirth(sparkplug::RebirthMode::InSession);
+  auto returned_after = std::chrono::steady_clock::now() - started;
+
+  sparkplug::PayloadBuilder node_data;
+  node_data.add_metric_by_alias(1, 21.0);
+  sparkplug::PayloadBuilder device_data;
+  device_data.add_metric_by_alias(1, 101);
+  auto sent = pub.publish_data(node_data).and_then(
+      [&]() { return pub.publish_device_data("PacedDev7", device_data); });
+
+  auto received = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return seen.size() >= device_count + 3;
+  };
+  for (int i = 0; i < 200 && !received(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  bool passed = false;
+  std::string message;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    auto position = [&](sparkplug::MessageType type, std::string_view device_id) {
+      auto it = std::find_if(seen.begin(), seen.end(), [&](const Seen& entry) {
+        return entry.type == type && entry.device_id == device_id;
+      });
+      return static_cast<size_t>(it - seen.begin());
+    };
+    size_t births = static_cast<size_t>(
+        std::count_if(seen.begin(), seen.end(), [](const Seen& entry) {
+          return entry.type == sparkplug::MessageType::DBIRTH;
+        }));
+    bool in_seq = true;
+    for (size_t i = 0; i < seen.size(); i++) {
+      in_seq = in_seq && seen[i].seq == i;
+    }
+
+    if (!result || !sent) {
+      message = "Rebirth or publish failed: " + (result ? sent.error() : result.error());
+    } else if (seen.size() != device_count + 3 || births != device_count) {
+      message = std::format("Expected {} messages, got {}", device_count + 3, seen.size());
+    } else if (!in_seq || seen[0].type != sparkplug::MessageType::NBIRTH) {
+      message = "Births and data not in seq order";
+    } else if (position(sparkplug::MessageType::NDATA, "") >= seen.size() - 1 ||
+               position(sparkplug::MessageType::DDATA, "PacedDev7") >= seen.size() - 1) {
+      message = "Fresh data waited for the whole replay";
+    } else if (position(sparkplug::MessageType::DBIRTH, "PacedDev7") >
+               position(sparkplug::MessageType::DDATA, "PacedDev7")) {
+      message = "DDATA overtook its DBIRTH";
+    } else {
+      auto spread = std::chrono::duration_cast<std::chrono::milliseconds>(seen.back().at -
+                                                                          seen.front().at);
+      auto blocked = std::chrono::duration_cast<std::chrono::milliseconds>(returned_after);
+      passed = spread.count() >= 300 && blocked.count() < 200;
+      message = passed ? ""
+                       : std::format("DBIRTHs spread over {} ms, rebirth blocked {} ms",
+                                     spread.count(), blocked.count());
+    }
+  }
+  if (passed && sub.stats().seq_gaps != 0) {
+    passed = false;
+    message = "Host reported seq gaps";
+  }
+  report_test(name, passed, message);
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+// Test: Host requests a rebirth after a seq gap, once per node and within a shared budget
+void test_rebirth_recovery() {
+  const std::string name = "Host requests rebirth on seq gaps within its budget";
+  std::atomic<int> rebirth_commands{0};
+  std::atomic<int> data_delivered{0};
+  std::atomic<int> births_delivered{0};
+
+  auto callback = [&](const sparkplug::Topic& topic, const auto&) {
+    if (topic.edge_node_id != "TestNodeRecovery") {
+      return;
+    }
+    if (topic.message_type == sparkplug::MessageType::NDATA) {
+      data_delivered++;
+    } else if (topic.message_type == sparkplug::MessageType::NBIRTH) {
+      births_delivered++;
+    }
+  };
+
+  // Three requests at once, then one every ten seconds: far longer than the test runs
+  sparkplug::HostApplication::Config sub_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_recovery_sub",
+      .host_id = "TestGroup",
+      .message_callback = callback,
+      .rebirth_recovery = {.enabled = true,
+                           .min_interval_ms = 60000,
+                           .max_requests_per_second = 0.1,
+                           .burst = 3}};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_recovery_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeRecovery"};
+  pub_config.command_callback = [&](const sparkplug::Topic&, const auto& payload) {
+    for (const auto& metric : payload.metrics()) {
+      if (metric.name() == "Node Control/Rebirth" && metric.boolean_value()) {
+        rebirth_commands++;
+      }
+    }
+  };
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  if (!pub.connect() || !pub.publish_birth(birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  auto wait_for = [](auto&& done) {
+    for (int i = 0; i < 200 && !done(); i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  };
+  wait_for([&]() { return births_delivered == 1; });
+
+  // Two messages lost on the way: one request, however many gaps follow
+  auto lost = [](uint64_t seq) {
+    sparkplug::PayloadBuilder data;
+    data.set_seq(seq);
+    data.add_metric_by_alias(1, 0.0);
+    return data.build();
+  };
+  sub.inject_message("spBv1.0/TestGroup/NDATA/TestNodeRecovery", lost(100));
+  sub.inject_message("spBv1.0/TestGroup/NDATA/TestNodeRecovery", lost(150));
+  sparkplug::PayloadBuilder stale;
+  stale.add_metric_by_alias(1, 21.0);
+  (void)pub.publish_data(stale);
+
+  wait_for([&]() { return rebirth_commands > 0; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  int commands = rebirth_commands;
+  int dropped_data = data_delivered;
+
+  // Answering the request ends the quarantine
+  auto rebirth = pub.rebirth(sparkplug::RebirthMode::InSession);
+  wait_for([&]() { return births_delivered == 2; });
+  sparkplug::PayloadBuilder fresh;
+  fresh.add_metric_by_alias(1, 22.0);
+  (void)pub.publish_data(fresh);
+  wait_for([&]() { return data_delivered == 1; });
+
+  // Five nodes losing state at once: only the two requests left in the burst go out
+  for (int i = 0; i < 5; i++) {
+    sub.inject_message(std::format("spBv1.0/TestGroup/NDATA/GhostNode{}", i), lost(1));
+  }
+  auto stats = sub.stats();
+
+  bool passed = rebirth && commands == 1 && dropped_data == 0 && data_delivered == 1 &&
+                stats.rebirth_requests == 3 && stats.dropped_awaiting_birth == 8;
+  report_test(name, passed,
+              passed ? ""
+                     : std::format("{} rebirth commands, {} NDATA delivered before rebirth, {} "
+                                   "after, {} requests, {} dropped",
+                                   commands, dropped_data, data_delivered.load(),
+                                   stats.rebirth_requests, stats.dropped_awaiting_birth));
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+// Test: Automatic reconnect replays births (edge) and subscriptions (host)
+void test_auto_reconnect() {
+  const std::string name = "Auto reconnect replays births and subscriptions";
+  const sparkplug::ReconnectPolicy policy{
+      .enabled = true, .initial_delay_ms = 50, .max_delay_ms = 200};
+
+  std::mutex seen_mutex;
+  std::vector<std::pair<sparkplug::MessageType, uint64_t>> seen;
+  std::atomic<int> ndata_after_reconnect{0};
+  std::atomic<bool> host_reconnected{false};
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.edge_node_id != "TestNodeReconnect") {
+      return;
+    }
+    if (topic.message_type == sparkplug::MessageType::NDATA && host_reconnected) {
+      ndata_after_reconnect++;
+    }
+    uint64_t bd_seq = 0;
+    for (const auto& metric : payload.metrics()) {
+      if (metric.name() == "bdSeq") {
+        bd_seq = metric.long_value();
+      }
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.emplace_back(topic.message_type, topic.message_type == sparkplug::MessageType::NDATA
+                                              ? payload.seq()
+                                              : bd_seq);
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_reconnect_sub",
+                                                .host_id = "TestGroup",
+                                                .reconnect = policy,
+                                                .message_callback = callback,
+                                                .log_callback = [&](sparkplug::LogLevel,
+                                                                    std::string_view message) {
+                                                  if (message == "Reconnected") {
+                                                    host_reconnected = true;
+                                                  }
+                                                }};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_reconnect_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeReconnect",
+                                         .reconnect = policy};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Value", 1, 0);
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("Speed", 1, 0);
+  if (!pub.connect() || !pub.publish_birth(birth) ||
+      !pub.publish_device_birth("ReconnectDev", device_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  uint64_t first_bd_seq = pub.get_bd_seq();
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.clear();
+  }
+
+  // Taking over a client id drops that session; the intruders do not fight back
+  sparkplug::EdgeNode::Config intruder_config{.broker_url = "tcp://localhost:1883",
+                                              .client_id = "test_reconnect_pub",
+                                              .group_id = "TestGroup",
+                                              .edge_node_id = "TestNodeIntruder"};
+  sparkplug::EdgeNode intruder(std::move(intruder_config));
+  (void)intruder.connect();
+
+  auto births_replayed = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    auto nbirth = std::ranges::find(seen, std::pair{sparkplug::MessageType::NBIRTH,
+                                                    first_bd_seq + 1});
+    auto dbirth = std::ranges::find_if(seen, [](const auto& entry) {
+      return entry.first == sparkplug::MessageType::DBIRTH;
+    });
+    return nbirth != seen.end() && dbirth != seen.end() && nbirth < dbirth;
+  };
+  for (int i = 0; i < 200 && !births_replayed(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  // Then the host: it must come back with its subscriptions
+  sparkplug::HostApplication::Config intruder_host_config{.broker_url = "tcp://localhost:1883",
+                                                          .client_id = "test_reconnect_sub",
+                                                          .host_id = "Intruder"};
+  sparkplug::HostApplication intruder_host(std::move(intruder_host_config));
+  (void)intruder_host.connect();
+
+  for (int i = 0; i < 200 && !host_reconnected; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, 1);
+  auto published = pub.publish_data(data);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  bool replayed = births_replayed();
+  bool passed = host_reconnected && pub.get_bd_seq() == first_bd_seq + 1 && replayed &&
+                published && ndata_after_reconnect > 0;
+  report_test(name, passed,
+              !host_reconnected      ? "Host did not reconnect"
+              : !replayed            ? "NBIRTH/DBIRTH not replayed with new bdSeq"
+              : ndata_after_reconnect == 0 ? "Subscriptions not restored"
+                                           : (passed ? "" : "Publisher not reconnected"));
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+  (void)intruder.disconnect();
+  (void)intruder_host.disconnect();
+}
+
+void test_store_and_forward() {
+  const std::string name = "Store-and-forward replays offline data as historical";
+
+  std::mutex seen_mutex;
+  std::vector<sparkplug::MessageType> types;
+  std::vector<uint64_t> data_seqs;
+  std::vector<int64_t> data_values;
+  bool all_historical = true;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    // The NDEATH Will of the dropped session is not part of the replay
+    if (topic.edge_node_id != "TestNodeStore" ||
+        topic.message_type == sparkplug::MessageType::NDEATH) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    types.push_back(topic.message_type);
+    if (topic.message_type == sparkplug::MessageType::NDATA ||
+        topic.message_type == sparkplug::MessageType::DDATA) {
+      data_seqs.push_back(payload.seq());
+      for (const auto& metric : payload.metrics()) {
+        all_historical = all_historical && metric.is_historical();
+        data_values.push_back(static_cast<int64_t>(metric.long_value()));
+      }
+    }
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_store_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  // A tiny memory budget forces most frames through the spill file
+  sparkplug::EdgeNode::Config pub_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_store_pub",
+      .group_id = "TestGroup",
+      .edge_node_id = "TestNodeStore",
+      .reconnect = {.enabled = true, .initial_delay_ms = 300, .max_delay_ms = 300},
+      .store_forward = {.enabled = true,
+                        .memory_limit_bytes = 64,
+                        .spill_path = "test_store_forward.spill",
+                        .spill_limit_bytes = 64 * 1024,
+                        .drain_rate = 0}};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Value", 1, static_cast<int64_t>(0));
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("Speed", 1, static_cast<int64_t>(0));
+  if (!pub.connect() || !pub.publish_birth(birth) ||
+      !pub.publish_device_birth("StoreDev", device_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    types.clear();
+  }
+
+  sparkplug::EdgeNode::Config intruder_config{.broker_url = "tcp://localhost:1883",
+                                              .client_id = "test_store_pub",
+                                              .group_id = "TestGroup",
+                                              .edge_node_id = "TestNodeStoreIntruder"};
+  sparkplug::EdgeNode intruder(std::move(intruder_config));
+  (void)intruder.connect();
+  for (int i = 0; i < 100 && pub.is_connected(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  // Published while the session is down: buffered instead of rejected
+  bool stored = !pub.is_connected();
+  for (int64_t value = 1; value <= 5; value++) {
+    sparkplug::PayloadBuilder data;
+    data.add_metric_by_alias(1, value);
+    stored = stored && pub.publish_data(data).has_value();
+    // The buffered copy is flagged historical, not the caller's payload
+    stored = stored && !data.payload().metrics(0).is_historical();
+  }
+  for (int64_t value = 6; value <= 7; value++) {
+    sparkplug::PayloadBuilder data;
+    data.add_metric_by_alias(1, value);
+    stored = stored && pub.publish_device_data("StoreDev", data).has_value();
+  }
+  size_t buffered = pub.stored_messages();
+
+  auto drained = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return data_seqs.size() >= 7;
+  };
+  for (int i = 0; i < 200 && !drained(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  bool ordered = false;
+  bool historical = false;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    // NBIRTH (seq 0) and DBIRTH (seq 1) are replayed first; the frames continue at seq 2
+    ordered = types.size() == 9 && types[0] == sparkplug::MessageType::NBIRTH &&
+              types[1] == sparkplug::MessageType::DBIRTH &&
+              data_seqs == std::vector<uint64_t>{2, 3, 4, 5, 6, 7, 8} &&
+              data_values == std::vector<int64_t>{1, 2, 3, 4, 5, 6, 7};
+    historical = all_historical;
+  }
+
+  bool passed = stored && buffered == 7 && ordered && historical &&
+                pub.stored_messages() == 0 && pub.dropped_stored_messages() == 0;
+  report_test(name, passed,
+              !stored             ? "Offline publish was not buffered"
+              : buffered != 7     ? std::format("Expected 7 buffered frames, got {}", buffered)
+              : !ordered          ? "Frames not forwarded in order after the births"
+              : !historical       ? "Forwarded metrics not flagged historical"
+                                  : (passed ? "" : "Buffer not empty after drain"));
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+  (void)intruder.disconnect();
+}
+
+void test_backfill_pacing() {
+  const std::string name = "Backfill splits samples into paced historical payloads";
+
+  std::mutex seen_mutex;
+  std::vector<size_t> sizes;
+  std::vector<uint64_t> timestamps;
+  bool all_historical = true;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.edge_node_id != "TestNodeBackfill" ||
+        topic.message_type != sparkplug::MessageType::DDATA) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    sizes.push_back(payload.ByteSizeLong());
+    for (const auto& metric : payload.metrics()) {
+      all_historical = all_historical && metric.is_historical() && metric.alias() == 1;
+      timestamps.push_back(metric.timestamp());
+    }
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_backfill_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  // 200 samples of ~25 bytes make ~10 payloads of 512 bytes: about 0.55 s at 8 KiB/s
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_backfill_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeBackfill",
+                                         .backfill = {.max_payload_bytes = 512,
+                                                      .bytes_per_second = 8 * 1024}};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric("Status", true);
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("Level", 1, 0.0);
+  if (!pub.connect() || !pub.publish_birth(birth) ||
+      !pub.publish_device_birth("BackfillDev", device_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::vector<sparkplug::TimedSample<double>> samples;
+  for (uint64_t i = 0; i < 200; i++) {
+    samples.push_back({.timestamp_ms = 1700000000000 + i * 1000, .value = static_cast<double>(i)});
+  }
+  auto started = std::chrono::steady_clock::now();
+  auto published = pub.publish_device_backfill<double>("BackfillDev", 1, samples);
+  auto elapsed = std::chrono::steady_clock::now() - started;
+  auto rejected = pub.publish_device_backfill<double>("NoSuchDevice", 1, samples);
+
+  auto received = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return timestamps.size() >= samples.size();
+  };
+  for (int i = 0; i < 200 && !received(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  bool complete = false;
+  bool bounded = false;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    complete = published && *published == sizes.size() && sizes.size() > 1 &&
+               timestamps.size() == samples.size() &&
+               std::is_sorted(timestamps.begin(), timestamps.end());
+    bounded = std::all_of(sizes.begin(), sizes.end(), [](size_t size) { return size <= 512; });
+  }
+  auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  bool paced = elapsed_ms >= 400;
+
+  bool passed = complete && bounded && all_historical && paced && !rejected;
+  report_test(name, passed,
+              !complete         ? "Samples missing, reordered or not split"
+              : !bounded        ? "Payload exceeded max_payload_bytes"
+              : !all_historical ? "Backfilled metrics not flagged historical"
+              : !paced          ? std::format("Not paced: took {} ms", elapsed_ms)
+                                : (passed ? "" : "Backfill to an unknown device succeeded"));
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+void test_compressed_birth() {
+  const std::string name = "Compressed NBIRTH is inflated transparently by the host";
+
+  std::mutex seen_mutex;
+  int birth_metrics = -1;
+  bool data_seen = false;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.edge_node_id != "TestNodeCompressed") {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    if (topic.message_type == sparkplug::MessageType::NBIRTH) {
+      birth_metrics = payload.metrics_size();
+    } else if (topic.message_type == sparkplug::MessageType::NDATA) {
+      data_seen = payload.metrics_size() == 1 && payload.metrics(0).alias() == 1;
+    }
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_compressed_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_compressed_pub",
+      .group_id = "TestGroup",
+      .edge_node_id = "TestNodeCompressed",
+      .compression = {.algorithm = sparkplug::CompressionAlgorithm::Deflate,
+                      .min_payload_bytes = 1024}};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder birth;
+  for (uint64_t i = 0; i < 200; i++) {
+    birth.add_metric_with_alias(std::format("Line/Sensor{}/Temperature", i), i + 1, 21.0);
+  }
+  auto birth_size = birth.build().size();
+
+  // The NDATA is below min_payload_bytes and goes out uncompressed
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, 22.5);
+  if (!pub.connect() || !pub.publish_birth(birth) || !pub.publish_data(data)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  auto received = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return data_seen;
+  };
+  for (int i = 0; i < 200 && !received(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  auto stats = sub.stats();
+  bool inflated = false;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    inflated = birth_metrics > 200 && data_seen;
+  }
+  bool smaller = stats.bytes_in < birth_size / 2;
+  bool clean = stats.parse_failures == 0 && stats.seq_gaps == 0;
+
+  report_test(name, inflated && smaller && clean,
+              !inflated ? "NBIRTH or NDATA not delivered decoded"
+              : !smaller ? std::format("{} bytes received for a {} byte NBIRTH", stats.bytes_in,
+                                       birth_size)
+                         : (clean ? "" : "Parse failures or seq gaps reported"));
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+void test_edge_node_group() {
+  const std::string name = "EdgeNodeGroup connects, births and reconnects its nodes";
+  constexpr size_t NODES = 12;
+
+  std::mutex seen_mutex;
+  std::vector<std::pair<std::string, uint64_t>> births; // Edge node id, bdSeq
+
+  sparkplug::HostApplication::Config sub_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_node_group_sub",
+      .host_id = "TestGroup",
+      .message_callback = [&](const sparkplug::Topic& topic,
+                              const org::eclipse::tahu::protobuf::Payload& payload) {
+        if (topic.message_type != sparkplug::MessageType::NBIRTH ||
+            !topic.edge_node_id.starts_with("GroupNode")) {
+          return;
+        }
+        for (const auto& metric : payload.metrics()) {
+          if (metric.name() == "bdSeq") {
+            std::lock_guard<std::mutex> lock(seen_mutex);
+            births.emplace_back(topic.edge_node_id, metric.long_value());
+          }
+        }
+      }};
+  sparkplug::HostApplication sub(std::move(sub_config));
+  if (!sub.connect() || !sub.subscribe_group("TestGroup")) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::vector<std::string> ids;
+  for (size_t i = 0; i < NODES; i++) {
+    ids.push_back(std::format("GroupNode{:02}", i));
+  }
+  sparkplug::EdgeNodeGroup group(
+      {.node = {.broker_url = "tcp://localhost:1883",
+                .client_id = "test_node_group",
+                .group_id = "TestGroup",
+                .edge_node_id = {}, // Set per node from edge_node_ids
+                .reconnect = {.enabled = true, .initial_delay_ms = 50, .max_delay_ms = 200}},
+       .edge_node_ids = ids,
+       .workers = 3});
+
+  auto published = group.connect().and_then([&] {
+    return group.for_each([](sparkplug::EdgeNode& node) {
+      sparkplug::PayloadBuilder birth;
+      birth.add_metric_with_alias("Value", 1, 0);
+      return node.publish_birth(birth);
+    });
+  });
+  if (!published || group.size() != NODES || group.find("GroupNode07") != &group.node(7)) {
+    report_test(name, false, published ? "Nodes not indexed" : published.error());
+    (void)sub.disconnect();
+    return;
+  }
+
+  auto count_births = [&](std::string_view id, uint64_t bd_seq) {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return std::ranges::count(births, std::pair<std::string, uint64_t>{id, bd_seq});
+  };
+  auto all_born = [&] {
+    return std::ranges::all_of(ids, [&](const std::string& id) {
+      return count_births(id, group.find(id)->get_bd_seq()) == 1;
+    });
+  };
+  for (int i = 0; i < 100 && !all_born(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  bool born = all_born();
+
+  // Taking over one node's client id drops its session; the group reconnects it on a worker
+  auto& dropped = *group.find("GroupNode03");
+  uint64_t first_bd_seq = dropped.get_bd_seq();
+  sparkplug::EdgeNode intruder({.broker_url = "tcp://localhost:1883",
+                                .client_id = "test_node_group-GroupNode03",
+                                .group_id = "TestGroup",
+                                .edge_node_id = "IntruderNode"});
+  (void)intruder.connect();
+  for (int i = 0; i < 200 && count_births("GroupNode03", first_bd_seq + 1) == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  bool reborn = count_births("GroupNode03", first_bd_seq + 1) == 1;
+
+  auto stats = group.stats();
+  auto nbirths = stats.messages_out[std::to_underlying(sparkplug::MessageType::NBIRTH)];
+  bool passed = born && reborn && nbirths == NODES + 1;
+  report_test(name, passed,
+              !born     ? "Not every node published its NBIRTH"
+              : !reborn ? "Dropped node not reconnected with a new bdSeq"
+                        : (passed ? "" : "Merged stats do not count every NBIRTH"));
+
+  (void)group.disconnect();
+  (void)intruder.disconnect();
+  (void)sub.disconnect();
+}
+
 int main() {
   std::cout << "=== Sparkplug 2.2 Compliance Tests ===\n\n";
 
@@ -792,14 +1970,26 @@ int main() {
   test_bdseq_increment();
   test_nbirth_has_bdseq();
   test_alias_usage();
+  test_alias_resolution();
   test_subscriber_validation();
   test_payload_timestamp();
   test_auto_sequence();
+  test_arena_parsing();
+  test_concurrent_publish_sequence();
+  test_dispatch_pool_ordering();
+  test_rebirth_recovery();
 
   // Device-level tests
   test_dbirth_sequence_zero();
   test_dbirth_requires_nbirth();
   test_device_sequence_shared();
+  test_in_session_rebirth();
+  test_paced_birth_replay();
+  test_auto_reconnect();
+  test_edge_node_group();
+  test_store_and_forward();
+  test_backfill_pacing();
+  test_compressed_birth();
 
   // Command handling tests
   test_ncmd_publishing();
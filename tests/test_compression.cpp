@@ -0,0 +1,189 @@
+// tests/test_compression.cpp
+// Unit tests for Sparkplug compressed payloads and their unwrapping by HostApplication
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparkplug/compression.hpp>
+#include <sparkplug/host_application.hpp>
+#include <sparkplug/payload_builder.hpp>
+#include <sparkplug/wire_format.hpp>
+
+namespace {
+
+using Payload = org::eclipse::tahu::protobuf::Payload;
+
+std::vector<uint8_t> make_birth(size_t metric_count) {
+  sparkplug::PayloadBuilder birth;
+  birth.set_timestamp(1700000000000);
+  birth.set_seq(0);
+  birth.add_metric("bdSeq", static_cast<uint64_t>(3));
+  for (size_t i = 0; i < metric_count; i++) {
+    birth.add_metric_with_alias("Sensors/Temperature" + std::to_string(i), i + 1, 20.5);
+  }
+  return birth.build();
+}
+
+Payload parse(const std::vector<uint8_t>& data) {
+  Payload payload;
+  bool parsed = payload.ParseFromArray(data.data(), static_cast<int>(data.size()));
+  assert(parsed);
+  (void)parsed;
+  return payload;
+}
+
+void test_round_trip() {
+  auto original = make_birth(200);
+
+  for (auto algorithm : {sparkplug::CompressionAlgorithm::Deflate,
+                         sparkplug::CompressionAlgorithm::Gzip}) {
+    std::vector<uint8_t> wrapped;
+    auto compressed = sparkplug::compress_payload(original, algorithm, wrapped);
+    assert(compressed);
+    assert(wrapped.size() < original.size() / 4);
+
+    auto wrapper = parse(wrapped);
+    assert(sparkplug::is_compressed_payload(wrapper));
+    assert(wrapper.timestamp() == 1700000000000 && wrapper.seq() == 0);
+    assert(wrapper.metrics(0).name() == "algorithm");
+    assert(wrapper.metrics(0).string_value() ==
+           (algorithm == sparkplug::CompressionAlgorithm::Gzip ? "GZIP" : "DEFLATE"));
+
+    sparkplug::detail::wire::PayloadHeader header;
+    bool scanned = sparkplug::detail::wire::scan_payload(wrapped, header);
+    assert(scanned && header.compressed && header.seq == 0);
+    (void)scanned;
+
+    std::vector<uint8_t> inflated;
+    auto decompressed = sparkplug::decompress_payload(wrapper, inflated);
+    assert(decompressed);
+    assert(inflated == original);
+  }
+
+  sparkplug::detail::wire::PayloadHeader plain;
+  bool scanned = sparkplug::detail::wire::scan_payload(original, plain);
+  assert(scanned && !plain.compressed);
+  (void)scanned;
+
+  std::vector<uint8_t> unused;
+  assert(!sparkplug::compress_payload(original, sparkplug::CompressionAlgorithm::None, unused));
+
+  std::cout << "✓ DEFLATE and GZIP payloads round-trip\n";
+}
+
+void test_rejects_bad_wrappers() {
+  auto original = make_birth(200);
+  std::vector<uint8_t> wrapped;
+  auto compressed =
+      sparkplug::compress_payload(original, sparkplug::CompressionAlgorithm::Deflate, wrapped);
+  assert(compressed);
+  auto wrapper = parse(wrapped);
+
+  std::vector<uint8_t> inflated;
+  assert(!sparkplug::decompress_payload(wrapper, inflated, original.size() - 1)); // Bomb guard
+  assert(sparkplug::decompress_payload(wrapper, inflated, original.size()));
+
+  auto corrupt = wrapper;
+  corrupt.mutable_body()->resize(corrupt.body().size() / 2);
+  assert(!sparkplug::decompress_payload(corrupt, inflated));
+
+  auto unknown = wrapper;
+  unknown.mutable_metrics(0)->set_string_value("LZ4");
+  assert(!sparkplug::decompress_payload(unknown, inflated));
+
+  // Without an algorithm metric the body is taken to be DEFLATE
+  auto implicit = wrapper;
+  implicit.clear_metrics();
+  assert(sparkplug::decompress_payload(implicit, inflated) && inflated == original);
+
+  std::cout << "✓ Corrupt, unknown and oversized bodies are rejected\n";
+}
+
+void test_host_unwraps() {
+  std::vector<std::pair<sparkplug::MessageType, size_t>> delivered;
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_compression_host",
+      .host_id = "CompressionHost",
+      .message_callback =
+          [&](const sparkplug::Topic& topic, const Payload& payload) {
+            assert(!sparkplug::is_compressed_payload(payload));
+            delivered.emplace_back(topic.message_type, payload.metrics_size());
+          }});
+
+  auto birth = make_birth(50);
+  std::vector<uint8_t> wrapped;
+  auto compressed =
+      sparkplug::compress_payload(birth, sparkplug::CompressionAlgorithm::Gzip, wrapped);
+  assert(compressed);
+  host.inject_message("spBv1.0/Plant/NBIRTH/Node01", wrapped);
+
+  auto state = host.get_node_state("Plant", "Node01");
+  assert(state && state->get().is_online && state->get().bd_seq == 3);
+  assert(host.get_metric_name("Plant", "Node01", "", 50) == "Sensors/Temperature49");
+  assert(delivered.size() == 1 && delivered[0].second == 51);
+
+  // A corrupt body counts as a parse failure and leaves the node as it was
+  auto wrapper = parse(wrapped);
+  wrapper.mutable_body()->resize(8);
+  auto corrupt = wrapper.SerializeAsString();
+  host.inject_message("spBv1.0/Plant/NDATA/Node01",
+                      std::span(reinterpret_cast<const uint8_t*>(corrupt.data()), corrupt.size()));
+  assert(host.stats().parse_failures == 1);
+  assert(delivered.size() == 1);
+
+  std::cout << "✓ HostApplication validates and delivers the inflated payload\n";
+}
+
+void test_host_scans_compressed_death() {
+  sparkplug::HostApplication host(
+      sparkplug::HostApplication::Config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_compression_death",
+                                         .host_id = "CompressionHost"});
+  host.inject_message("spBv1.0/Plant/NBIRTH/Node01", make_birth(1));
+
+  // The wrapper repeats the seq, so an undelivered compressed NDATA is never inflated
+  sparkplug::PayloadBuilder data;
+  data.set_seq(1);
+  data.add_metric_by_alias(1, std::string(512, 'x'));
+  std::vector<uint8_t> wrapped_data;
+  auto data_compressed = sparkplug::compress_payload(
+      data.build(), sparkplug::CompressionAlgorithm::Deflate, wrapped_data);
+  assert(data_compressed);
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", wrapped_data);
+  assert(host.stats().payloads_skipped == 1);
+  assert(host.stats().seq_gaps == 0);
+
+  // Undelivered, so normally scanned; the bdSeq is only reachable by inflating the body
+  sparkplug::PayloadBuilder death;
+  death.add_metric("bdSeq", static_cast<uint64_t>(3));
+  death.add_metric("Padding", std::string(512, 'x'));
+  std::vector<uint8_t> wrapped;
+  auto compressed = sparkplug::compress_payload(death.build(),
+                                                sparkplug::CompressionAlgorithm::Deflate, wrapped);
+  assert(compressed);
+  host.inject_message("spBv1.0/Plant/NDEATH/Node01", wrapped);
+
+  auto state = host.get_node_state("Plant", "Node01");
+  assert(state && !state->get().is_online);
+  assert(host.stats().payloads_skipped == 1);
+
+  std::cout << "✓ Undelivered compressed NDEATH alone is inflated, for its bdSeq\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Payload Compression Tests ===\n\n";
+
+  test_round_trip();
+  test_rejects_bad_wrappers();
+  test_host_unwraps();
+  test_host_scans_compressed_death();
+
+  std::cout << "\n=== All compression tests passed ===\n";
+  return 0;
+}
@@ -2,7 +2,11 @@
 // Tests for device-level Sparkplug B APIs (DBIRTH/DDATA/DDEATH)
 #include <atomic>
 #include <cassert>
+#include <expected>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -496,6 +500,382 @@ void test_ddeath() {
   (void)sub.disconnect();
 }
 
+// Test 7: Report-by-exception sends only changed node and device metrics
+void test_changed_data_publishing() {
+  const std::string name = "Changed data publishes only deltas";
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_rbe_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeDev07"};
+
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  if (!pub.connect()) {
+    report_test(name, false, "Publisher failed to connect");
+    return;
+  }
+
+  sparkplug::PayloadBuilder node_birth;
+  node_birth.add_metric_with_alias("Temperature", 1, 20.0);
+  node_birth.add_metric_with_alias("Running", 2, true);
+  if (!pub.publish_birth(node_birth)) {
+    report_test(name, false, "NBIRTH failed");
+    (void)pub.disconnect();
+    return;
+  }
+
+  pub.set_deadband(1, 0.5);
+
+  auto snapshot = [](double temperature, bool running) {
+    sparkplug::PayloadBuilder scan;
+    scan.add_metric_by_alias(1, temperature);
+    scan.add_metric_by_alias(2, running);
+    return scan;
+  };
+
+  auto scan1 = snapshot(20.2, true); // within deadband, unchanged bool
+  auto scan2 = snapshot(20.8, true); // beyond deadband
+  auto scan3 = snapshot(20.8, false);
+  auto r1 = pub.publish_changed_data(scan1);
+  auto r2 = pub.publish_changed_data(scan2);
+  auto r3 = pub.publish_changed_data(scan3);
+
+  bool node_ok = r1 && *r1 == 0 && r2 && *r2 == 1 && r3 && *r3 == 1;
+
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("Level", 1, static_cast<int32_t>(5));
+  bool device_ok = false;
+  if (pub.publish_device_birth("Device07", device_birth)) {
+    sparkplug::PayloadBuilder same;
+    same.add_metric_by_alias(1, static_cast<int32_t>(5));
+    sparkplug::PayloadBuilder moved;
+    moved.add_metric_by_alias(1, static_cast<int32_t>(6));
+    auto d1 = pub.publish_changed_device_data("Device07", same);
+    auto d2 = pub.publish_changed_device_data("Device07", moved);
+    device_ok = d1 && *d1 == 0 && d2 && *d2 == 1;
+  }
+
+  bool passed = node_ok && device_ok;
+  report_test(name, passed,
+              !node_ok     ? "Node deltas incorrect"
+              : !device_ok ? "Device deltas incorrect"
+                           : "");
+
+  (void)pub.disconnect();
+}
+
+// Test 8: Batched DDATA publish assigns contiguous sequence numbers in order
+void test_device_data_batch() {
+  const std::string name = "Batched DDATA sequences in order";
+  std::mutex seen_mutex;
+  std::vector<std::pair<std::string, uint64_t>> seen;
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& payload) {
+    if (topic.message_type == sparkplug::MessageType::DDATA &&
+        topic.edge_node_id == "TestNodeDev08") {
+      std::lock_guard<std::mutex> lock(seen_mutex);
+      seen.emplace_back(topic.device_id, payload.seq());
+    }
+  };
+
+  sparkplug::HostApplication::Config sub_config{.broker_url = "tcp://localhost:1883",
+                                                .client_id = "test_batch_sub",
+                                                .host_id = "TestGroup",
+                                                .message_callback = callback};
+  sparkplug::HostApplication sub(std::move(sub_config));
+
+  if (!sub.connect() || !sub.subscribe_all_groups()) {
+    report_test(name, false, "Subscriber setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_batch_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeDev08"};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder node_birth;
+  node_birth.add_metric("test", 0);
+  if (!pub.connect() || !pub.publish_birth(node_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)sub.disconnect();
+    return;
+  }
+
+  const std::vector<std::string> devices = {"DevA", "DevB", "DevC"};
+  for (const auto& device : devices) {
+    sparkplug::PayloadBuilder device_birth;
+    device_birth.add_metric_with_alias("value", 1, 0);
+    (void)pub.publish_device_birth(device, device_birth);
+  }
+
+  // An unborn device rejects the whole batch
+  sparkplug::PayloadBuilder stray;
+  stray.add_metric_by_alias(1, 1);
+  std::vector<sparkplug::EdgeNode::DeviceData> bad_batch{
+      {.device_id = "Unknown", .payload = stray}};
+  bool rejected = !pub.publish_device_data_batch(bad_batch);
+
+  std::vector<sparkplug::PayloadBuilder> payloads(devices.size());
+  std::vector<sparkplug::EdgeNode::DeviceData> batch;
+  for (size_t i = 0; i < devices.size(); i++) {
+    payloads[i].add_metric_by_alias(1, static_cast<int32_t>(i));
+    batch.push_back({.device_id = devices[i], .payload = payloads[i]});
+  }
+
+  uint64_t seq_before = pub.get_seq();
+  auto result = pub.publish_device_data_batch(batch);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  bool ordered = false;
+  {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    if (seen.size() == devices.size()) {
+      ordered = true;
+      for (size_t i = 0; i < devices.size(); i++) {
+        if (seen[i].first != devices[i] || seen[i].second != (seq_before + 1 + i) % 256) {
+          ordered = false;
+        }
+      }
+    }
+  }
+
+  bool passed = rejected && result && ordered;
+  report_test(name, passed,
+              !rejected ? "Unborn device accepted"
+              : !result ? "Batch failed: " + result.error()
+              : !ordered ? "DDATA missing or out of sequence"
+                         : "");
+
+  (void)pub.disconnect();
+  (void)sub.disconnect();
+}
+
+void test_async_publish_completion() {
+  const std::string name = "Async publish completions and window";
+  std::atomic<int> ncmd_received{0};
+
+  auto callback = [&](const sparkplug::Topic& topic,
+                      const org::eclipse::tahu::protobuf::Payload& /*payload*/) {
+    if (topic.message_type == sparkplug::MessageType::NCMD &&
+        topic.edge_node_id == "TestNodeDev09") {
+      ncmd_received++;
+    }
+  };
+
+  sparkplug::HostApplication::Config host_config{.broker_url = "tcp://localhost:1883",
+                                                 .client_id = "test_async_host",
+                                                 .host_id = "TestGroup",
+                                                 .publish_window = 4,
+                                                 .message_callback = callback};
+  sparkplug::HostApplication host(std::move(host_config));
+
+  if (!host.connect() || !host.subscribe_all_groups()) {
+    report_test(name, false, "Host setup failed");
+    (void)host.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_async_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeDev09",
+                                         .publish_window = 4};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder node_birth;
+  node_birth.add_metric_with_alias("value", 1, 0);
+  if (!pub.connect() || !pub.publish_birth(node_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)host.disconnect();
+    return;
+  }
+
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("value", 1, 0);
+  (void)pub.publish_device_birth("DevAsync", device_birth);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  std::atomic<int> succeeded{0};
+  std::atomic<int> failed{0};
+  auto on_complete = [&](std::expected<void, std::string> result) {
+    (result ? succeeded : failed)++;
+  };
+
+  // More publishes than window slots: later calls wait for earlier completions
+  constexpr int COUNT = 20;
+  bool queued = true;
+  for (int i = 0; i < COUNT; i++) {
+    sparkplug::PayloadBuilder data;
+    data.add_metric_by_alias(1, i);
+    queued = queued && pub.publish_data_async(data, on_complete).has_value();
+
+    sparkplug::PayloadBuilder device_data;
+    device_data.add_metric_by_alias(1, i);
+    queued = queued && pub.publish_device_data_async("DevAsync", device_data, on_complete)
+                           .has_value();
+
+    sparkplug::PayloadBuilder cmd;
+    cmd.add_metric("Node Control/Rebirth", false);
+    queued = queued && host.publish_node_command_async("TestGroup", "TestNodeDev09", cmd,
+                                                       on_complete)
+                           .has_value();
+  }
+
+  sparkplug::PayloadBuilder ignored;
+  bool unborn_rejected = !pub.publish_device_data_async("Unknown", ignored, on_complete);
+  bool empty_rejected = !pub.publish_data_async(ignored, nullptr);
+
+  bool drained = pub.wait_for_publishes(std::chrono::seconds(5)) &&
+                 host.wait_for_publishes(std::chrono::seconds(5));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // A full window times out instead of queueing without bound
+  auto window = std::make_shared<sparkplug::PublishWindow>(1);
+  auto first = window->acquire(std::chrono::milliseconds(10));
+  bool blocked = first && !window->acquire(std::chrono::milliseconds(10));
+  first->reset();
+  bool reopened = window->acquire(std::chrono::milliseconds(10)).has_value();
+
+  bool passed = queued && unborn_rejected && empty_rejected && drained &&
+                succeeded == COUNT * 3 && failed == 0 && pub.in_flight_publishes() == 0 &&
+                ncmd_received == COUNT && blocked && reopened;
+  report_test(name, passed,
+              !queued    ? "Async publish rejected"
+              : !drained ? "Publishes did not complete"
+              : succeeded != COUNT * 3
+                  ? "Only " + std::to_string(succeeded.load()) + " completions"
+              : ncmd_received != COUNT ? "NCMD not delivered"
+              : !blocked || !reopened  ? "Window did not apply backpressure"
+                                       : (passed ? "" : "Invalid calls accepted"));
+
+  (void)pub.disconnect();
+  (void)host.disconnect();
+}
+
+void test_last_known_values() {
+  const std::string name = "Host last-known-value cache";
+
+  sparkplug::HostApplication::Config host_config{.broker_url = "tcp://localhost:1883",
+                                                 .client_id = "test_lkv_host",
+                                                 .host_id = "TestGroup",
+                                                 .track_values = true};
+  sparkplug::HostApplication host(std::move(host_config));
+  if (!host.connect() || !host.subscribe_group("TestGroup")) {
+    report_test(name, false, "Host setup failed");
+    (void)host.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode::Config pub_config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_lkv_pub",
+                                         .group_id = "TestGroup",
+                                         .edge_node_id = "TestNodeDev10"};
+  sparkplug::EdgeNode pub(std::move(pub_config));
+
+  sparkplug::PayloadBuilder node_birth;
+  node_birth.add_metric_with_alias("Pressure", 1, 1.5);
+  sparkplug::PayloadBuilder device_birth;
+  device_birth.add_metric_with_alias("Speed", 1, static_cast<int64_t>(0));
+  device_birth.add_metric("Mode", "idle");
+  if (!pub.connect() || !pub.publish_birth(node_birth) ||
+      !pub.publish_device_birth("DevLkv", device_birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)host.disconnect();
+    return;
+  }
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, 2.5);
+  (void)pub.publish_data(data);
+  sparkplug::PayloadBuilder device_data;
+  device_data.add_metric_by_alias(1, static_cast<int64_t>(42));
+  device_data.add_metric("Mode", "run");
+  (void)pub.publish_device_data("DevLkv", device_data);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  auto pressure = host.get_metric_value("TestGroup", "TestNodeDev10", "", "Pressure");
+  auto speed = host.get_metric_value("TestGroup", "TestNodeDev10", "DevLkv", uint64_t{1});
+  auto mode = host.get_metric_value("TestGroup", "TestNodeDev10", "DevLkv", "Mode");
+  auto snapshot = host.snapshot_node_values("TestGroup", "TestNodeDev10");
+
+  bool passed = pressure && std::get<double>(pressure->value) == 2.5 && speed &&
+                std::get<int64_t>(speed->value) == 42 && speed->name == "Speed" && mode &&
+                std::get<std::string>(mode->value) == "run" && snapshot &&
+                snapshot->size() == 4 && // Pressure, bdSeq, Speed, Mode
+                !host.get_metric_value("TestGroup", "TestNodeDev10", "DevLkv", "Missing") &&
+                !host.snapshot_node_values("TestGroup", "UnknownNode");
+  report_test(name, passed, passed ? "" : "Cached values do not match the published data");
+
+  (void)pub.disconnect();
+  (void)host.disconnect();
+}
+
+void test_name_limit() {
+  const std::string name = "Host name pool limit";
+
+  std::atomic<int> births{0};
+  std::atomic<int> limit_warnings{0};
+  sparkplug::HostApplication::Config host_config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_name_limit_host",
+      .host_id = "NameLimitGroup",
+      .max_name_bytes = 20, // "NameLimitGroup" + "Node01", nothing more
+      .message_callback =
+          [&](const sparkplug::Topic& topic, const org::eclipse::tahu::protobuf::Payload&) {
+            births += topic.message_type == sparkplug::MessageType::NBIRTH;
+          },
+      .log_callback =
+          [&](sparkplug::LogLevel, std::string_view message) {
+            limit_warnings += message.find("max_name_bytes") != std::string_view::npos;
+          }};
+  sparkplug::HostApplication host(std::move(host_config));
+  if (!host.connect() || !host.subscribe_group("NameLimitGroup")) {
+    report_test(name, false, "Host setup failed");
+    (void)host.disconnect();
+    return;
+  }
+
+  sparkplug::EdgeNode first({.broker_url = "tcp://localhost:1883",
+                             .client_id = "test_name_limit_pub1",
+                             .group_id = "NameLimitGroup",
+                             .edge_node_id = "Node01"});
+  sparkplug::EdgeNode second({.broker_url = "tcp://localhost:1883",
+                              .client_id = "test_name_limit_pub2",
+                              .group_id = "NameLimitGroup",
+                              .edge_node_id = "Node02"});
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Pressure", 1, 1.5);
+  if (!first.connect() || !first.publish_birth(birth) || !second.connect() ||
+      !second.publish_birth(birth)) {
+    report_test(name, false, "Publisher setup failed");
+    (void)host.disconnect();
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // Both births are delivered, but the pool only had room for the first node's key
+  auto tracked = host.get_node_state("NameLimitGroup", "Node01");
+  bool passed = births == 2 && tracked && !tracked->get().birth_received &&
+                !host.get_node_state("NameLimitGroup", "Node02") && limit_warnings == 2;
+  report_test(name, passed,
+              births != 2 ? "Births not delivered"
+              : !tracked  ? "First node not tracked"
+                          : (passed ? "" : "Names past the limit were tracked"));
+
+  (void)first.disconnect();
+  (void)second.disconnect();
+  (void)host.disconnect();
+}
+
 int main() {
   std::cout << "Running Device-Level API Tests...\n\n";
 
@@ -505,6 +885,11 @@ int main() {
   test_device_sequence_shared();
   test_ddata_sequence_increments();
   test_ddeath();
+  test_changed_data_publishing();
+  test_device_data_batch();
+  test_async_publish_completion();
+  test_last_known_values();
+  test_name_limit();
 
   // Summary
   std::cout << "\n========== Test Summary ==========\n";
@@ -0,0 +1,127 @@
+// tests/test_logging.cpp
+// Tests for HostApplication log level filtering and validation warning coalescing
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sparkplug/host_application.hpp>
+
+namespace {
+
+using LogLines = std::vector<std::pair<sparkplug::LogLevel, std::string>>;
+
+std::vector<uint8_t> make_payload(std::optional<uint64_t> seq, std::optional<uint64_t> bd_seq) {
+  sparkplug::PayloadBuilder payload;
+  if (seq) {
+    payload.set_seq(*seq);
+  }
+  if (bd_seq) {
+    payload.add_metric("bdSeq", *bd_seq);
+  }
+  payload.add_metric_with_alias("Temperature", 1, 20.5);
+  return payload.build();
+}
+
+sparkplug::HostApplication::Config make_config(LogLines& logs, int coalesce_interval_ms) {
+  sparkplug::HostApplication::Config config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_logging_host",
+      .host_id = "LogHost",
+      .log_callback = [&logs](sparkplug::LogLevel level, std::string_view message) {
+        logs.emplace_back(level, std::string(message));
+      }};
+  config.log_level = sparkplug::LogLevel::WARN;
+  config.log_coalesce_interval_ms = coalesce_interval_ms;
+  return config;
+}
+
+// NBIRTH of Logs/Node01 followed by count NDATA that each skip four sequence numbers
+void inject_seq_gaps(sparkplug::HostApplication& host, uint64_t count) {
+  host.inject_message("spBv1.0/Logs/NBIRTH/Node01", make_payload(0, 1));
+  for (uint64_t i = 1; i <= count; i++) {
+    host.inject_message("spBv1.0/Logs/NDATA/Node01", make_payload(i * 5, std::nullopt));
+  }
+}
+
+} // namespace
+
+void test_every_warning_logged_by_default() {
+  LogLines logs;
+  sparkplug::HostApplication::Config defaults;
+  assert(defaults.log_coalesce_interval_ms == 0);
+  sparkplug::HostApplication host(make_config(logs, defaults.log_coalesce_interval_ms));
+
+  host.inject_message("not/a/sparkplug/topic", make_payload(0, 1)); // DEBUG: filtered out
+  inject_seq_gaps(host, 3);
+  assert(logs.size() == 3);
+  assert(logs[0].first == sparkplug::LogLevel::WARN);
+  assert(logs[0].second == "Sequence number gap for Logs/Node01 (got 5, expected 1)");
+  assert(logs[2].second == "Sequence number gap for Logs/Node01 (got 15, expected 11)");
+
+  std::cout << "✓ Log level filter, and every warning logged without coalescing\n";
+}
+
+void test_validation_log_coalescing() {
+  LogLines logs;
+  sparkplug::HostApplication host(make_config(logs, 50));
+
+  inject_seq_gaps(host, 5);
+  assert(host.stats().seq_gaps == 5);
+  assert(logs.size() == 1);
+  assert(logs[0].second == "Sequence number gap for Logs/Node01 (got 5, expected 1)");
+
+  // Another node has its own window
+  host.inject_message("spBv1.0/Logs/NDATA/Node02", make_payload(1, std::nullopt));
+  assert(logs.size() == 2);
+  assert(logs[1].second == "Received NDATA for Logs/Node02 before NBIRTH");
+
+  // Once the window expired the next warning reports what was suppressed
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  host.inject_message("spBv1.0/Logs/NDATA/Node01", make_payload(40, std::nullopt));
+  assert(logs.size() == 3);
+  assert(logs[2].second == "Sequence number gap for Logs/Node01 (got 40, expected 26) "
+                           "[4 similar suppressed since the last report]");
+
+  std::cout << "✓ Validation warning coalescing\n";
+}
+
+void test_suppressed_reported_at_shutdown() {
+  LogLines logs;
+  {
+    sparkplug::HostApplication host(make_config(logs, 60'000));
+    inject_seq_gaps(host, 4);
+    assert(logs.size() == 1);
+
+    // No later warning of the window would report them, so disconnect does
+    (void)host.disconnect();
+    assert(logs.size() == 2);
+    assert(logs[1].second == "3 suppressed sequence gap warnings for Logs/Node01 since the last "
+                             "report");
+
+    host.inject_message("spBv1.0/Logs/NDATA/Node01", make_payload(100, std::nullopt));
+    assert(logs.size() == 2);
+  }
+
+  // And so does the destructor, for what was suppressed after it
+  assert(logs.size() == 3);
+  assert(logs[2].second == "1 suppressed sequence gap warnings for Logs/Node01 since the last "
+                           "report");
+
+  std::cout << "✓ Suppressed warnings are reported at disconnect and destruction\n";
+}
+
+int main() {
+  std::cout << "=== HostApplication Logging Tests ===\n\n";
+
+  test_every_warning_logged_by_default();
+  test_validation_log_coalescing();
+  test_suppressed_reported_at_shutdown();
+
+  std::cout << "\n=== All logging tests passed! ===\n";
+  return 0;
+}
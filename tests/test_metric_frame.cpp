@@ -0,0 +1,137 @@
+// tests/test_metric_frame.cpp
+// Unit tests for MetricFrame wire encoding and in-place patching
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <sparkplug/metric_frame.hpp>
+
+namespace {
+
+org::eclipse::tahu::protobuf::Payload decode(const sparkplug::MetricFrame& frame) {
+  org::eclipse::tahu::protobuf::Payload payload;
+  auto bytes = frame.bytes();
+  bool parsed = payload.ParseFromArray(bytes.data(), static_cast<int>(bytes.size()));
+  assert(parsed);
+  return payload;
+}
+
+void test_empty_frame() {
+  sparkplug::MetricFrame frame;
+  auto payload = decode(frame);
+  assert(payload.has_timestamp());
+  assert(payload.timestamp() > 0);
+  assert(payload.has_seq());
+  assert(payload.seq() == 0);
+  assert(payload.metrics_size() == 0);
+  assert(frame.metric_count() == 0);
+
+  std::cout << "✓ Empty frame decodes with timestamp and seq\n";
+}
+
+void test_matches_payload_builder() {
+  sparkplug::MetricFrame frame;
+  frame.add_metric_by_alias(1, 20.5);
+  frame.add_metric_by_alias(2, 1.5f);
+  frame.add_metric_by_alias(3, true);
+  frame.add_metric_by_alias(300, static_cast<int32_t>(-7));
+  frame.add_metric_by_alias(4, static_cast<uint64_t>(1) << 63);
+  frame.set_timestamp(1700000000000);
+  frame.set_seq(42);
+
+  sparkplug::PayloadBuilder builder;
+  builder.add_metric_by_alias(1, 20.5, 1700000000000);
+  builder.add_metric_by_alias(2, 1.5f, 1700000000000);
+  builder.add_metric_by_alias(3, true, 1700000000000);
+  builder.add_metric_by_alias(300, static_cast<int32_t>(-7), 1700000000000);
+  builder.add_metric_by_alias(4, static_cast<uint64_t>(1) << 63, 1700000000000);
+  builder.set_timestamp(1700000000000);
+  builder.set_seq(42);
+
+  auto payload = decode(frame);
+  assert(payload.SerializeAsString() == builder.payload().SerializeAsString());
+  assert(frame.metric_count() == 5);
+
+  std::cout << "✓ Frame decodes to the same payload as PayloadBuilder\n";
+}
+
+void test_patch_in_place() {
+  sparkplug::MetricFrame frame;
+  auto temperature = frame.add_metric_by_alias(1, 20.5);
+  auto count = frame.add_metric_by_alias(2, static_cast<uint8_t>(0));
+  auto level = frame.add_metric_by_alias(3, static_cast<int64_t>(0));
+  auto size = frame.bytes().size();
+  const auto* data = frame.bytes().data();
+
+  frame.set(temperature, 99.25);
+  frame.set(count, 255);
+  frame.set(level, std::numeric_limits<int64_t>::min());
+  frame.set_seq(255);
+  frame.set_timestamp(std::numeric_limits<uint64_t>::max());
+  assert(frame.bytes().size() == size);
+  assert(frame.bytes().data() == data);
+
+  auto payload = decode(frame);
+  assert(payload.metrics(0).double_value() == 99.25);
+  assert(payload.metrics(1).int_value() == 255);
+  assert(static_cast<int64_t>(payload.metrics(2).long_value()) ==
+         std::numeric_limits<int64_t>::min());
+  assert(payload.seq() == 255);
+  assert(payload.timestamp() == std::numeric_limits<uint64_t>::max());
+  for (const auto& metric : payload.metrics()) {
+    assert(metric.timestamp() == std::numeric_limits<uint64_t>::max());
+  }
+
+  // Per-metric timestamps leave the others alone
+  frame.set(temperature, 1.0, 1234);
+  payload = decode(frame);
+  assert(payload.metrics(0).timestamp() == 1234);
+  assert(payload.metrics(1).timestamp() == std::numeric_limits<uint64_t>::max());
+
+  std::cout << "✓ Values, timestamps and seq are patched in place\n";
+}
+
+void test_slots_survive_copy() {
+  sparkplug::MetricFrame frame;
+  auto slot = frame.add_metric_by_alias(7, static_cast<int16_t>(-1));
+  sparkplug::MetricFrame copy = frame;
+  copy.set(slot, -32768);
+
+  assert(decode(frame).metrics(0).int_value() == static_cast<uint32_t>(-1));
+  assert(decode(copy).metrics(0).int_value() == static_cast<uint32_t>(-32768));
+
+  std::cout << "✓ Slots stay valid for copies of the frame\n";
+}
+
+void test_build_into() {
+  sparkplug::MetricFrame frame;
+  frame.add_metric_by_alias(1, 3.0);
+
+  std::vector<uint8_t> small(frame.bytes().size() - 1);
+  auto too_small = frame.build_into(small);
+  assert(!too_small);
+
+  std::vector<uint8_t> buffer(frame.bytes().size() + 8);
+  auto written = frame.build_into(buffer);
+  assert(written && *written == frame.bytes().size());
+  assert(std::equal(frame.bytes().begin(), frame.bytes().end(), buffer.begin()));
+
+  std::cout << "✓ build_into copies into a caller buffer\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== MetricFrame Unit Tests ===\n\n";
+
+  test_empty_frame();
+  test_matches_payload_builder();
+  test_patch_in_place();
+  test_slots_survive_copy();
+  test_build_into();
+
+  std::cout << "\n=== All MetricFrame tests passed! ===\n";
+  return 0;
+}
@@ -1,10 +1,17 @@
 // tests/test_payload_builder.cpp
 // Unit tests for PayloadBuilder type safety and functionality
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <sparkplug/payload_builder.hpp>
+#include <sparkplug/wire_format.hpp>
 
 void test_int_types() {
   sparkplug::PayloadBuilder payload;
@@ -161,6 +168,106 @@ void test_auto_timestamp() {
   std::cout << "✓ Auto-generated timestamp\n";
 }
 
+uint64_t clock_reads = 0;
+
+uint64_t counting_clock() noexcept {
+  return 1000 + clock_reads++;
+}
+
+void test_custom_clock_per_metric() {
+  clock_reads = 0;
+  sparkplug::PayloadBuilder payload(sparkplug::TimestampMode::PerMetric, counting_clock);
+  payload.add_metric_by_alias(1, 1.0);
+  payload.add_metric_by_alias(2, 2.0);
+
+  auto pb = payload.payload();
+  assert(clock_reads == 3);
+  assert(pb.timestamp() == 1000);
+  assert(pb.metrics(0).timestamp() == 1001);
+  assert(pb.metrics(1).timestamp() == 1002);
+
+  std::cout << "✓ Custom clock in PerMetric mode\n";
+}
+
+void test_per_payload_timestamp() {
+  clock_reads = 0;
+  sparkplug::PayloadBuilder payload(sparkplug::TimestampMode::PerPayload, counting_clock);
+  for (uint64_t alias = 1; alias <= 100; alias++) {
+    payload.add_metric_by_alias(alias, static_cast<double>(alias));
+  }
+  payload.add_metric("named", true).add_metric("explicit", 1, 42);
+  [[maybe_unused]] auto bytes = payload.build();
+
+  auto pb = payload.payload();
+  assert(clock_reads == 1);
+  for (int i = 0; i < pb.metrics_size() - 1; i++) {
+    assert(pb.metrics(i).timestamp() == 1000);
+  }
+  assert(pb.metrics(pb.metrics_size() - 1).timestamp() == 42);
+
+  // set_timestamp() restamps the metrics added after it
+  payload.set_timestamp(5000).add_metric_by_alias(101, 0.0);
+  assert(payload.payload().metrics(pb.metrics_size()).timestamp() == 5000);
+
+  // The coarse clock is close to the system clock
+  auto coarse = sparkplug::coarse_clock_ms();
+  auto system = sparkplug::system_clock_ms();
+  assert(coarse <= system + 1 && system - coarse < 100);
+
+  std::cout << "✓ PerPayload mode reads the clock once\n";
+}
+
+void test_reset_reuses_metrics() {
+  sparkplug::PayloadBuilder payload;
+  payload.add_metric("Sensors/A rather long metric name", 1.0);
+  payload.add_metric_by_alias(2, 2.0);
+  payload.set_seq(9);
+  payload.set_timestamp(1);
+
+  const auto* metric = &payload.payload().metrics(0);
+  const auto* name = payload.payload().metrics(0).name().data();
+
+  payload.reset();
+  assert(payload.payload().metrics_size() == 0);
+  assert(!payload.has_seq() && !payload.payload().has_seq());
+  assert(!payload.has_timestamp());
+  assert(payload.payload().timestamp() > 1);
+
+  payload.add_metric("Sensors/Another long metric name", 3.0);
+  assert(payload.payload().metrics_size() == 1);
+  assert(&payload.payload().metrics(0) == metric);
+  assert(payload.payload().metrics(0).name().data() == name);
+  assert(!payload.payload().metrics(0).has_alias());
+  assert(payload.payload().metrics(0).double_value() == 3.0);
+
+  std::cout << "✓ reset() clears the payload and reuses its metrics\n";
+}
+
+void test_add_metrics_by_alias_bulk() {
+  clock_reads = 0;
+  sparkplug::PayloadBuilder payload(sparkplug::TimestampMode::PerMetric, counting_clock);
+  std::vector<uint64_t> aliases = {1, 2, 3};
+  std::vector<double> values = {20.5, 21.5, 22.5};
+  payload.add_metrics_by_alias<double>(aliases, values);
+
+  const int32_t counts[] = {7, 8};
+  payload.add_metrics_by_alias(std::span<const uint64_t>(aliases).first(2),
+                               std::span<const int32_t>(counts), 42);
+
+  auto pb = payload.payload();
+  assert(clock_reads == 2); // Constructor and one for the whole double batch
+  assert(pb.metrics_size() == 5);
+  assert(pb.metrics(2).alias() == 3);
+  assert(pb.metrics(2).double_value() == 22.5);
+  assert(pb.metrics(2).timestamp() == pb.metrics(0).timestamp());
+  assert(!pb.metrics(2).has_name());
+  assert(pb.metrics(4).datatype() == std::to_underlying(sparkplug::DataType::Int32));
+  assert(pb.metrics(4).int_value() == 8);
+  assert(pb.metrics(4).timestamp() == 42);
+
+  std::cout << "✓ Bulk add_metrics_by_alias\n";
+}
+
 void test_payload_timestamp() {
   sparkplug::PayloadBuilder payload;
 
@@ -267,6 +374,177 @@ void test_serialize() {
   std::cout << "✓ Payload serialization\n";
 }
 
+void test_build_into_span() {
+  sparkplug::PayloadBuilder payload;
+  payload.set_seq(3);
+  payload.add_metric("temperature", 21.5);
+  payload.add_metric_with_alias("pressure", 2, 101.3);
+
+  auto expected = payload.build();
+  assert(payload.serialized_size() == expected.size());
+
+  std::vector<uint8_t> buffer(expected.size() + 16);
+  auto written = payload.build_into(std::span<uint8_t>(buffer));
+  assert(written.has_value());
+  assert(*written == expected.size());
+  assert(std::equal(expected.begin(), expected.end(), buffer.begin()));
+
+  std::vector<uint8_t> small(expected.size() - 1);
+  auto too_small = payload.build_into(std::span<uint8_t>(small));
+  assert(!too_small.has_value());
+
+  std::cout << "✓ build_into span\n";
+}
+
+void test_build_into_vector_reuse() {
+  sparkplug::PayloadBuilder large;
+  for (int i = 0; i < 20; ++i) {
+    large.add_metric_by_alias(static_cast<uint64_t>(i), i);
+  }
+
+  std::vector<uint8_t> buffer;
+  size_t size = large.build_into(buffer);
+  assert(size == buffer.size());
+  assert(buffer == large.build());
+
+  const auto* data = buffer.data();
+  size_t capacity = buffer.capacity();
+
+  sparkplug::PayloadBuilder small;
+  small.add_metric_by_alias(1, 7);
+  small.build_into(buffer);
+  assert(buffer == small.build());
+  assert(buffer.data() == data);
+  assert(buffer.capacity() == capacity);
+
+  std::cout << "✓ build_into reuses buffer capacity\n";
+}
+
+void test_scan_payload() {
+  sparkplug::PayloadBuilder birth;
+  birth.set_timestamp(1700000000000);
+  birth.set_seq(0);
+  birth.add_metric("Status", std::string("bdSeq")); // String value, not the bdSeq metric
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  birth.add_metric("bdSeq", static_cast<uint64_t>(300));
+  auto data = birth.build();
+
+  sparkplug::detail::wire::PayloadHeader header;
+  bool scanned = sparkplug::detail::wire::scan_payload(data, header, true);
+  assert(scanned);
+  assert(header.timestamp == 1700000000000);
+  assert(header.seq == 0);
+  assert(header.bd_seq == 300);
+
+  // bdSeq is only looked for on request; a payload without seq leaves it empty
+  sparkplug::PayloadBuilder ndata;
+  ndata.add_metric_by_alias(1, 21.5);
+  data = ndata.build();
+  header = {};
+  scanned = sparkplug::detail::wire::scan_payload(data, header);
+  assert(scanned);
+  assert(header.timestamp.has_value() && !header.seq && !header.bd_seq);
+
+  std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+  assert(!sparkplug::detail::wire::scan_payload(truncated, header));
+  const uint8_t garbage[] = {0xff, 0xff, 0xff};
+  assert(!sparkplug::detail::wire::scan_payload(garbage, header));
+  (void)scanned;
+
+  std::cout << "✓ Header scan matches the encoded seq, timestamp and bdSeq\n";
+}
+
+void test_dataset_columns() {
+  std::vector<uint64_t> times = {1000, 2000, 3000};
+  std::vector<float> volts = {1.5f, -2.25f, 3.0f};
+  std::vector<int16_t> codes = {-1, 0, 7};
+  std::vector<std::string> labels = {"a", "b", "c", "unused"};
+  const bool flags[] = {true, false, true};
+
+  sparkplug::PayloadBuilder builder;
+  builder.add_dataset_with_alias(
+      "Waveform", 5, {{"t", times}, {"volts", volts}, {"code", codes}, {"label", labels},
+                      {"ok", flags}});
+
+  const auto& metric = builder.payload().metrics(0);
+  assert(metric.name() == "Waveform");
+  assert(metric.alias() == 5);
+  assert(metric.datatype() == std::to_underlying(sparkplug::DataType::DataSet));
+
+  const auto& dataset = metric.dataset_value();
+  assert(dataset.num_of_columns() == 5);
+  assert(dataset.columns(1) == "volts");
+  assert(dataset.types(0) == std::to_underlying(sparkplug::DataType::UInt64));
+  assert(dataset.types(2) == std::to_underlying(sparkplug::DataType::Int16));
+  assert(dataset.types(3) == std::to_underlying(sparkplug::DataType::String));
+  assert(dataset.types(4) == std::to_underlying(sparkplug::DataType::Boolean));
+  assert(dataset.rows_size() == 3); // Shortest column
+  for (int r = 0; r < 3; r++) {
+    const auto& row = dataset.rows(r);
+    assert(row.elements_size() == 5);
+    assert(row.elements(0).long_value() == times[r]);
+    assert(row.elements(1).float_value() == volts[r]);
+    assert(static_cast<int32_t>(row.elements(2).int_value()) == codes[r]);
+    assert(row.elements(3).string_value() == labels[r]);
+    assert(row.elements(4).boolean_value() == flags[r]);
+  }
+
+  // Survives the wire, and by alias only
+  std::vector<std::string_view> names = {"x"};
+  sparkplug::PayloadBuilder data;
+  data.add_dataset_by_alias(5, {{"name", names}});
+  org::eclipse::tahu::protobuf::Payload decoded;
+  auto bytes = data.build();
+  bool parsed = decoded.ParseFromArray(bytes.data(), static_cast<int>(bytes.size()));
+  assert(parsed);
+  assert(!decoded.metrics(0).has_name());
+  assert(decoded.metrics(0).dataset_value().rows(0).elements(0).string_value() == "x");
+  (void)parsed;
+
+  std::cout << "✓ DataSet metrics are built from typed columns\n";
+}
+
+void test_template_builders() {
+  sparkplug::TemplateBuilder motor("1.0");
+  motor.add_metric("Speed", 0.0).add_metric("Running", false).add_parameter("Poles", 4);
+  motor.add_parameter("Model", "M-200");
+  assert(motor.metric_count() == 2);
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_template_definition("Motor", motor);
+  birth.add_template_with_alias("Motor01", 10, "Motor", motor);
+
+  const auto& definition = birth.payload().metrics(0);
+  assert(definition.name() == "Motor");
+  assert(definition.datatype() == std::to_underlying(sparkplug::DataType::Template));
+  assert(definition.template_value().is_definition());
+  assert(!definition.template_value().has_template_ref());
+  assert(definition.template_value().version() == "1.0");
+  assert(definition.template_value().metrics(0).name() == "Speed");
+  assert(definition.template_value().parameters(0).int_value() == 4);
+  assert(definition.template_value().parameters(0).type() ==
+         std::to_underlying(sparkplug::DataType::Int32));
+  assert(definition.template_value().parameters(1).string_value() == "M-200");
+
+  const auto& instance = birth.payload().metrics(1);
+  assert(instance.alias() == 10);
+  assert(!instance.template_value().is_definition());
+  assert(instance.template_value().template_ref() == "Motor");
+
+  // Values are patched in the cached layout; out of range indexes are ignored
+  motor.set(0, 1450.5).set(1, true).set(9, 1);
+  sparkplug::PayloadBuilder data;
+  data.add_template_by_alias(10, "Motor", motor);
+  const auto& update = data.payload().metrics(0).template_value();
+  assert(update.metrics(0).name() == "Speed");
+  assert(update.metrics(0).double_value() == 1450.5);
+  assert(update.metrics(1).boolean_value());
+  assert(update.metrics_size() == 2);
+  assert(instance.template_value().metrics(0).double_value() == 0.0); // Earlier copy unchanged
+
+  std::cout << "✓ Template definitions and instances share one cached layout\n";
+}
+
 int main() {
   std::cout << "=== PayloadBuilder Unit Tests ===\n\n";
 
@@ -278,6 +556,10 @@ int main() {
   test_metric_by_alias_only();
   test_custom_timestamp();
   test_auto_timestamp();
+  test_custom_clock_per_metric();
+  test_per_payload_timestamp();
+  test_reset_reuses_metrics();
+  test_add_metrics_by_alias_bulk();
   test_payload_timestamp();
   test_payload_sequence();
   test_empty_payload();
@@ -285,6 +567,11 @@ int main() {
   test_method_chaining();
   test_node_control_metrics();
   test_serialize();
+  test_build_into_span();
+  test_build_into_vector_reuse();
+  test_scan_payload();
+  test_dataset_columns();
+  test_template_builders();
 
   std::cout << "\n=== All PayloadBuilder tests passed! ===\n";
   return 0;
@@ -0,0 +1,239 @@
+// tests/test_sharded_host.cpp
+// Tests for ShardedHostApplication group routing, merged state and STATE on the primary
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sparkplug/edge_node.hpp>
+#include <sparkplug/sharded_host_application.hpp>
+
+namespace {
+
+std::vector<uint8_t> make_payload(std::optional<uint64_t> seq, std::optional<uint64_t> bd_seq) {
+  sparkplug::PayloadBuilder payload;
+  if (seq) {
+    payload.set_seq(*seq);
+  }
+  if (bd_seq) {
+    payload.add_metric("bdSeq", *bd_seq);
+  }
+  payload.add_metric_with_alias("Temperature", 1, 20.5);
+  return payload.build();
+}
+
+sparkplug::ShardedHostApplication::Config make_config(std::string client_id, size_t connections) {
+  return {.host = {.broker_url = "tcp://localhost:1883",
+                   .client_id = std::move(client_id),
+                   .host_id = "ShardedHost"},
+          .connections = connections};
+}
+
+void test_group_routing() {
+  sparkplug::ShardedHostApplication host(make_config("test_sharded_route", 4));
+  assert(host.connection_count() == 4);
+
+  std::set<size_t> used;
+  for (int g = 0; g < 32; g++) {
+    auto group = "Group" + std::to_string(g);
+    auto index = host.shard_index(group);
+    assert(index < 4);
+    assert(index == host.shard_index(group)); // Stable
+    assert(&host.shard_for(group) != &host.primary() || index == 0);
+    used.insert(index);
+  }
+  assert(used.size() > 1);
+
+  sparkplug::ShardedHostApplication single(make_config("test_sharded_single", 0));
+  assert(single.connection_count() == 1);
+
+  std::cout << "✓ Groups map to a stable connection\n";
+}
+
+void test_merged_state() {
+  sparkplug::ShardedHostApplication host(make_config("test_sharded_state", 3));
+
+  // Two groups owned by different connections
+  std::string first = "GroupA";
+  std::string second;
+  for (int g = 0; second.empty(); g++) {
+    auto candidate = "Group" + std::to_string(g);
+    if (host.shard_index(candidate) != host.shard_index(first)) {
+      second = candidate;
+    }
+  }
+
+  for (const auto& group : {first, second}) {
+    host.inject_message("spBv1.0/" + group + "/NBIRTH/Node01", make_payload(0, 4));
+    host.inject_message("spBv1.0/" + group + "/NDATA/Node01", make_payload(1, std::nullopt));
+  }
+  host.inject_message("spBv1.0/" + second + "/NDATA/Node01", make_payload(5, std::nullopt));
+
+  // Each node lives only in its owner, but every query sees both
+  assert(host.get_node_state(first, "Node01")->get().last_seq == 1);
+  assert(host.get_node_state(second, "Node01")->get().last_seq == 5);
+  assert(host.get_node_state(second, "Node01")->get().bd_seq == 4);
+  assert(!host.shard_for(first).get_node_state(second, "Node01"));
+  assert(host.get_metric_name(second, "Node01", "", 1) == "Temperature");
+  assert(!host.get_node_state(first, "Node02"));
+
+  auto stats = host.stats();
+  assert(stats.messages_in[std::to_underlying(sparkplug::MessageType::NBIRTH)] == 2);
+  assert(stats.messages_in[std::to_underlying(sparkplug::MessageType::NDATA)] == 3);
+  assert(stats.seq_gaps == 1);
+
+  std::cout << "✓ Node state is merged across connections\n";
+}
+
+void test_connect_and_state() {
+  std::mutex seen_mutex;
+  std::vector<std::pair<sparkplug::MessageType, std::string>> seen;
+  std::atomic<bool> state_online{false};
+
+  auto config = make_config("test_sharded_live", 2);
+  config.groups = {"ShardLiveA", "ShardLiveB"};
+  config.host.message_callback = [&](const sparkplug::Topic& topic, const auto&) {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    seen.emplace_back(topic.message_type, topic.group_id);
+  };
+  sparkplug::ShardedHostApplication host(std::move(config));
+
+  if (!host.connect()) {
+    std::cout << "⚠ Skipping live sharded host (no broker)\n";
+    return;
+  }
+
+  // STATE is published once, by the primary
+  sparkplug::HostApplication watcher(
+      sparkplug::HostApplication::Config{.broker_url = "tcp://localhost:1883",
+                                         .client_id = "test_sharded_watcher",
+                                         .host_id = "Watcher",
+                                         .message_callback =
+                                             [&](const sparkplug::Topic& topic, const auto&) {
+                                               if (topic.message_type ==
+                                                   sparkplug::MessageType::STATE) {
+                                                 state_online = true;
+                                               }
+                                             }});
+  bool watching = watcher.connect() && watcher.subscribe_state("ShardedHost");
+  assert(watching);
+  auto birth = host.publish_state_birth(1700000000000);
+  assert(birth);
+
+  std::vector<std::unique_ptr<sparkplug::EdgeNode>> nodes;
+  for (std::string group : {"ShardLiveA", "ShardLiveB"}) {
+    auto node = std::make_unique<sparkplug::EdgeNode>(
+        sparkplug::EdgeNode::Config{.broker_url = "tcp://localhost:1883",
+                                    .client_id = "test_sharded_node_" + group,
+                                    .group_id = group,
+                                    .edge_node_id = "Node01"});
+    sparkplug::PayloadBuilder node_birth;
+    node_birth.add_metric_with_alias("Temperature", 1, 20.5);
+    bool published = node->connect() && node->publish_birth(node_birth);
+    assert(published);
+    nodes.push_back(std::move(node));
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  auto births_seen = [&]() {
+    std::lock_guard<std::mutex> lock(seen_mutex);
+    return seen.size();
+  };
+  while ((births_seen() < 2 || !state_online) && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  assert(state_online);
+  assert(births_seen() == 2);
+  assert(host.get_node_state("ShardLiveA", "Node01")->get().is_online);
+  assert(host.get_node_state("ShardLiveB", "Node01")->get().is_online);
+
+  for (auto& node : nodes) {
+    (void)node->disconnect();
+  }
+  auto death = host.publish_state_death(1700000000000);
+  assert(death);
+  auto disconnected = host.disconnect();
+  assert(disconnected);
+  (void)watcher.disconnect();
+
+  std::cout << "✓ Connections ingest their groups; STATE comes from the primary\n";
+}
+
+void test_snapshot_per_connection() {
+  auto path = (std::filesystem::temp_directory_path() / "sparkplug_sharded.snap").string();
+  auto config = make_config("test_sharded_snapshot", 2);
+  config.host.snapshot.path = path;
+  for (size_t i = 0; i < 2; i++) {
+    std::filesystem::remove(std::format("{}.{}", path, i));
+  }
+
+  // Groups owned by different connections
+  std::string first = "SnapGroupA";
+  std::string second;
+  {
+    sparkplug::ShardedHostApplication host(config);
+    for (int g = 0; second.empty(); g++) {
+      auto candidate = "SnapGroup" + std::to_string(g);
+      if (host.shard_index(candidate) != host.shard_index(first)) {
+        second = candidate;
+      }
+    }
+    if (!host.connect()) {
+      std::cout << "⚠ Skipping sharded snapshot (no broker)\n";
+      return;
+    }
+    for (const auto& group : {first, second}) {
+      host.inject_message("spBv1.0/" + group + "/NBIRTH/Node01", make_payload(0, 4));
+    }
+    auto disconnected = host.disconnect();
+    assert(disconnected);
+  }
+
+  // Every connection saved only its own nodes, each to its own file
+  assert(!std::filesystem::exists(path));
+  for (size_t i = 0; i < 2; i++) {
+    sparkplug::HostApplication reader(
+        sparkplug::HostApplication::Config{.broker_url = "tcp://localhost:1883",
+                                           .client_id = "test_sharded_snapshot_reader",
+                                           .host_id = "ShardedHost"});
+    auto restored = reader.restore_snapshot(std::format("{}.{}", path, i));
+    assert(restored && *restored == 1);
+  }
+
+  sparkplug::ShardedHostApplication host(config);
+  auto connected = host.connect();
+  assert(connected);
+  assert(host.get_node_state(first, "Node01")->get().bd_seq == 4);
+  assert(host.get_node_state(second, "Node01")->get().bd_seq == 4);
+  assert(!host.shard_for(first).get_node_state(second, "Node01"));
+  assert(!host.shard_for(second).get_node_state(first, "Node01"));
+  (void)host.disconnect();
+
+  for (size_t i = 0; i < 2; i++) {
+    std::filesystem::remove(std::format("{}.{}", path, i));
+  }
+  std::cout << "✓ Each connection snapshots and restores only its own groups\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== ShardedHostApplication Tests ===\n\n";
+
+  test_group_routing();
+  test_merged_state();
+  test_connect_and_state();
+  test_snapshot_per_connection();
+
+  std::cout << "\n=== All ShardedHostApplication tests passed ===\n";
+  return 0;
+}
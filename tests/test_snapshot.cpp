@@ -0,0 +1,247 @@
+// tests/test_snapshot.cpp
+// Unit tests for HostApplication node state snapshots
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <sparkplug/host_application.hpp>
+#include <sparkplug/payload_builder.hpp>
+
+namespace {
+
+using Payload = org::eclipse::tahu::protobuf::Payload;
+
+std::string snapshot_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / ("sparkplug_" + name + ".snap")).string();
+}
+
+sparkplug::HostApplication::Config host_config(const std::string& client_id) {
+  return sparkplug::HostApplication::Config{.broker_url = "tcp://localhost:1883",
+                                            .client_id = client_id,
+                                            .host_id = "SnapshotHost",
+                                            .track_values = true};
+}
+
+std::vector<uint8_t> make_nbirth(uint64_t bd_seq) {
+  sparkplug::PayloadBuilder birth;
+  birth.set_timestamp(1700000000000);
+  birth.set_seq(0);
+  birth.add_metric("bdSeq", bd_seq);
+  birth.add_metric_with_alias("Sensors/Temperature", 1, 20.5);
+  birth.add_metric_with_alias("Sensors/Count", 2, static_cast<int32_t>(-7));
+  birth.add_metric_with_alias("Sensors/Label", 3, std::string("boiler"));
+  return birth.build();
+}
+
+std::vector<uint8_t> make_ndata(uint64_t seq, uint64_t alias, double value) {
+  sparkplug::PayloadBuilder data;
+  data.set_timestamp(1700000001000);
+  data.set_seq(seq);
+  data.add_metric_by_alias(alias, value);
+  return data.build();
+}
+
+// Node01 with device Pump01, last seq 2 and an updated temperature
+void populate(sparkplug::HostApplication& host) {
+  host.inject_message("spBv1.0/Plant/NBIRTH/Node01", make_nbirth(3));
+
+  sparkplug::PayloadBuilder dbirth;
+  dbirth.set_timestamp(1700000000500);
+  dbirth.set_seq(1);
+  dbirth.add_metric_with_alias("Motor/Speed", 10, static_cast<uint64_t>(1450));
+  dbirth.add_metric_with_alias("Motor/Running", 11, true);
+  host.inject_message("spBv1.0/Plant/DBIRTH/Node01/Pump01", dbirth.build());
+
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(2, 1, 22.25));
+}
+
+void test_round_trip() {
+  auto path = snapshot_path("round_trip");
+  uint64_t saved_timestamp = 0;
+  {
+    sparkplug::HostApplication host(host_config("test_snapshot_save"));
+    populate(host);
+    saved_timestamp = host.get_metric_value("Plant", "Node01", "", 1)->timestamp;
+    host.inject_message("spBv1.0/Plant/NBIRTH/Node02", make_nbirth(9));
+    host.inject_message("spBv1.0/Plant/NDEATH/Node02", make_ndata(0, 1, 0.0));
+
+    auto saved = host.save_snapshot(path);
+    assert(saved && *saved == 2);
+  }
+
+  sparkplug::HostApplication host(host_config("test_snapshot_restore"));
+  auto restored = host.restore_snapshot(path);
+  assert(restored && *restored == 2);
+
+  auto node = host.get_node_state("Plant", "Node01");
+  assert(node && node->get().is_online && node->get().bd_seq == 3);
+  assert(node->get().last_seq == 2 && node->get().birth_timestamp == 1700000000000);
+  auto offline = host.get_node_state("Plant", "Node02");
+  assert(offline && !offline->get().is_online && offline->get().bd_seq == 9);
+
+  assert(host.get_metric_name("Plant", "Node01", "", 3) == "Sensors/Label");
+  assert(host.get_metric_name("Plant", "Node01", "Pump01", 11) == "Motor/Running");
+
+  auto temperature = host.get_metric_value("Plant", "Node01", "", "Sensors/Temperature");
+  assert(temperature && std::get<double>(temperature->value) == 22.25);
+  assert(temperature->timestamp == saved_timestamp);
+  auto count = host.get_metric_value("Plant", "Node01", "", 2);
+  assert(count && std::get<int64_t>(count->value) == -7);
+  auto speed = host.get_metric_value("Plant", "Node01", "Pump01", "Motor/Speed");
+  assert(speed && std::get<uint64_t>(speed->value) == 1450);
+
+  std::filesystem::remove(path);
+  std::cout << "✓ Node, device, alias and value state survive a save and restore\n";
+}
+
+void test_seq_resync() {
+  auto path = snapshot_path("seq_resync");
+  {
+    sparkplug::HostApplication host(host_config("test_snapshot_seq_save"));
+    populate(host);
+    auto saved = host.save_snapshot(path);
+    assert(saved);
+  }
+
+  sparkplug::HostApplication host(host_config("test_snapshot_seq_restore"));
+  auto restored = host.restore_snapshot(path);
+  assert(restored);
+
+  // Messages sent while the host was down are not a gap; later ones are checked again
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(40, 1, 23.0));
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(41, 1, 23.5));
+  assert(host.stats().seq_gaps == 0);
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(43, 1, 24.0));
+  assert(host.stats().seq_gaps == 1);
+
+  auto temperature = host.get_metric_value("Plant", "Node01", "", 1);
+  assert(temperature && std::get<double>(temperature->value) == 24.0);
+
+  std::filesystem::remove(path);
+  std::cout << "✓ First message of a restored node re-bases its seq\n";
+}
+
+void test_unknown_alias_loses_state() {
+  auto path = snapshot_path("unknown_alias");
+  {
+    sparkplug::HostApplication host(host_config("test_snapshot_alias_save"));
+    populate(host);
+    auto saved = host.save_snapshot(path);
+    assert(saved);
+  }
+
+  size_t delivered = 0;
+  auto config = host_config("test_snapshot_alias_restore");
+  config.rebirth_recovery = {.enabled = true};
+  config.message_callback = [&](const sparkplug::Topic&, const Payload&) { delivered++; };
+  sparkplug::HostApplication host(std::move(config));
+  auto restored = host.restore_snapshot(path);
+  assert(restored);
+
+  // The node rebirthed with other aliases while the host was down
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(5, 99, 1.0));
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(6, 1, 1.0));
+  assert(delivered == 0 && host.stats().dropped_awaiting_birth == 2);
+
+  host.inject_message("spBv1.0/Plant/NBIRTH/Node01", make_nbirth(4));
+  host.inject_message("spBv1.0/Plant/NDATA/Node01", make_ndata(1, 1, 1.0));
+  assert(delivered == 2 && host.stats().seq_gaps == 0);
+
+  std::filesystem::remove(path);
+  std::cout << "✓ Data with an alias unknown to the snapshot marks the node as lost\n";
+}
+
+void test_rejects_bad_files() {
+  sparkplug::HostApplication host(host_config("test_snapshot_bad"));
+  auto path = snapshot_path("bad");
+
+  assert(!host.restore_snapshot(path + ".missing"));
+
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not a snapshot at all";
+  }
+  assert(!host.restore_snapshot(path));
+
+  // A truncated snapshot is refused as a whole
+  {
+    sparkplug::HostApplication source(host_config("test_snapshot_bad_source"));
+    populate(source);
+    auto saved = source.save_snapshot(path);
+    assert(saved);
+  }
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+  auto restored = host.restore_snapshot(path);
+  assert(!restored && restored.error().find("Corrupt") != std::string::npos);
+  assert(!host.get_node_state("Plant", "Node01"));
+
+  std::filesystem::remove(path);
+  std::cout << "✓ Missing, foreign and truncated files are rejected without changes\n";
+}
+
+void test_live_state_wins() {
+  auto path = snapshot_path("live_state");
+  {
+    sparkplug::HostApplication host(host_config("test_snapshot_live_save"));
+    populate(host);
+    auto saved = host.save_snapshot(path);
+    assert(saved);
+  }
+
+  sparkplug::HostApplication host(host_config("test_snapshot_live_restore"));
+  host.inject_message("spBv1.0/Plant/NBIRTH/Node01", make_nbirth(5));
+  auto restored = host.restore_snapshot(path);
+  assert(restored && *restored == 0);
+
+  auto node = host.get_node_state("Plant", "Node01");
+  assert(node && node->get().bd_seq == 5 && node->get().devices.empty());
+
+  std::filesystem::remove(path);
+  std::cout << "✓ Nodes already born live are not overwritten\n";
+}
+
+void test_disconnect_keeps_unused_snapshot() {
+  auto path = snapshot_path("unused");
+  {
+    sparkplug::HostApplication host(host_config("test_snapshot_unused_save"));
+    populate(host);
+    auto saved = host.save_snapshot(path);
+    assert(saved);
+  }
+
+  // Never connected and nothing restored: its empty state must not replace the file
+  {
+    auto config = host_config("test_snapshot_unused");
+    config.snapshot.path = path;
+    sparkplug::HostApplication host(std::move(config));
+    (void)host.disconnect();
+  }
+
+  sparkplug::HostApplication host(host_config("test_snapshot_unused_restore"));
+  auto restored = host.restore_snapshot(path);
+  assert(restored && *restored == 1);
+
+  std::filesystem::remove(path);
+  std::cout << "✓ Disconnect before any connect or restore leaves the snapshot alone\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Host Snapshot Tests ===\n\n";
+
+  test_round_trip();
+  test_seq_resync();
+  test_unknown_alias_loses_state();
+  test_rejects_bad_files();
+  test_live_state_wins();
+  test_disconnect_keeps_unused_snapshot();
+
+  std::cout << "\n=== All snapshot tests passed ===\n";
+  return 0;
+}
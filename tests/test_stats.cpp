@@ -0,0 +1,296 @@
+// tests/test_stats.cpp
+// Tests for the EdgeNode and HostApplication stats() counters, rebirth recovery and selective
+// decoding
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sparkplug/edge_node.hpp>
+#include <sparkplug/host_application.hpp>
+#include <sparkplug/stats.hpp>
+
+namespace {
+
+constexpr size_t index_of(sparkplug::MessageType type) {
+  return std::to_underlying(type);
+}
+
+std::vector<uint8_t> make_payload(std::optional<uint64_t> seq, std::optional<uint64_t> bd_seq) {
+  sparkplug::PayloadBuilder payload;
+  if (seq) {
+    payload.set_seq(*seq);
+  }
+  if (bd_seq) {
+    payload.add_metric("bdSeq", *bd_seq);
+  }
+  payload.add_metric_with_alias("Temperature", 1, 20.5);
+  return payload.build();
+}
+
+void test_histogram_buckets() {
+  static_assert(sparkplug::LatencyHistogram::upper_bound_us(0) == 1);
+  static_assert(sparkplug::LatencyHistogram::upper_bound_us(10) == 1024);
+  static_assert(sparkplug::LatencyHistogram::upper_bound_us(sparkplug::LatencyHistogram::BUCKETS -
+                                                            1) == UINT64_MAX);
+
+  sparkplug::detail::StatsRecorder recorder;
+  recorder.record_callback_duration(std::chrono::nanoseconds(500));  // < 1 us
+  recorder.record_callback_duration(std::chrono::microseconds(1));   // [1, 2) us
+  recorder.record_callback_duration(std::chrono::microseconds(1000)); // [512, 1024) us
+  recorder.record_callback_duration(std::chrono::hours(1));           // overflow
+
+  auto histogram = recorder.snapshot().callback_duration;
+  assert(histogram.count == 4);
+  assert(histogram.buckets[0] == 1);
+  assert(histogram.buckets[1] == 1);
+  assert(histogram.buckets[10] == 1);
+  assert(histogram.buckets[sparkplug::LatencyHistogram::BUCKETS - 1] == 1);
+  assert(histogram.max_ns ==
+         static_cast<uint64_t>(std::chrono::nanoseconds(std::chrono::hours(1)).count()));
+  assert(histogram.mean_ns() == histogram.sum_ns / 4);
+
+  std::cout << "✓ Latency histogram buckets\n";
+}
+
+void test_host_ingest_counters() {
+  size_t callbacks = 0;
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_stats_host",
+      .host_id = "StatsHost",
+      .message_callback = [&callbacks](const sparkplug::Topic&, const auto&) { callbacks++; }});
+
+  auto birth = make_payload(0, 7);
+  host.inject_message("spBv1.0/Stats/NBIRTH/Node01", birth);
+  host.inject_message("spBv1.0/Stats/NDATA/Node01", make_payload(1, std::nullopt));
+  host.inject_message("spBv1.0/Stats/NDATA/Node01", make_payload(3, std::nullopt)); // gap
+  host.inject_message("spBv1.0/Stats/NDEATH/Node01", make_payload(std::nullopt, 8)); // mismatch
+
+  const uint8_t garbage[] = {0xff, 0xff, 0xff};
+  host.inject_message("spBv1.0/Stats/NDATA/Node01", garbage);
+  host.inject_message("not/a/sparkplug/topic", birth);
+
+  auto stats = host.stats();
+  assert(stats.messages_in[index_of(sparkplug::MessageType::NBIRTH)] == 1);
+  assert(stats.messages_in[index_of(sparkplug::MessageType::NDATA)] == 3);
+  assert(stats.messages_in[index_of(sparkplug::MessageType::NDEATH)] == 1);
+  assert(stats.bytes_in > birth.size());
+  assert(stats.parse_failures == 1);
+  assert(stats.seq_gaps == 1);
+  assert(stats.bd_seq_mismatches == 1);
+  assert(stats.callback_duration.count == callbacks);
+  assert(callbacks == 4);
+  assert(stats.in_flight == 0);
+
+  std::cout << "✓ Host ingest counters\n";
+}
+
+void test_recovery_drops_until_birth() {
+  std::vector<sparkplug::MessageType> delivered;
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_stats_recovery_host",
+      .host_id = "RecoveryHost",
+      .message_callback = [&delivered](const sparkplug::Topic& topic,
+                                       const auto&) { delivered.push_back(topic.message_type); },
+      .rebirth_recovery = {.enabled = true}});
+
+  host.inject_message("spBv1.0/Recovery/NBIRTH/Node01", make_payload(0, 1));
+  host.inject_message("spBv1.0/Recovery/NDATA/Node01", make_payload(1, std::nullopt));
+  host.inject_message("spBv1.0/Recovery/NDATA/Node01", make_payload(5, std::nullopt)); // gap
+  host.inject_message("spBv1.0/Recovery/NDATA/Node01", make_payload(6, std::nullopt));
+  host.inject_message("spBv1.0/Recovery/DDATA/Node01/Dev", make_payload(7, std::nullopt));
+  assert(delivered.size() == 2);
+
+  // The rebirth ends the quarantine and restarts sequence tracking
+  host.inject_message("spBv1.0/Recovery/NBIRTH/Node01", make_payload(0, 1));
+  host.inject_message("spBv1.0/Recovery/NDATA/Node01", make_payload(1, std::nullopt));
+  assert(delivered.size() == 4);
+  assert(delivered.back() == sparkplug::MessageType::NDATA);
+
+  auto stats = host.stats();
+  assert(stats.seq_gaps == 1);
+  assert(stats.dropped_awaiting_birth == 3);
+  assert(stats.rebirth_requests == 0); // Not connected, so nothing could be sent
+
+  // A node never seen is quarantined from its first data message
+  host.inject_message("spBv1.0/Recovery/NDATA/Node02", make_payload(3, std::nullopt));
+  assert(delivered.size() == 4);
+  assert(host.stats().dropped_awaiting_birth == 4);
+
+  sparkplug::TokenBucket budget(10, 2);
+  auto now = sparkplug::TokenBucket::Clock::now();
+  assert(budget.try_acquire(1, now) && budget.try_acquire(1, now));
+  assert(!budget.try_acquire(1, now));
+  assert(budget.try_acquire(1, now + std::chrono::milliseconds(100)));
+
+  std::cout << "✓ Rebirth recovery drops data until the node rebirths\n";
+}
+
+void test_filtered_ingest() {
+  size_t births = 0;
+  size_t others = 0;
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_stats_filter_host",
+      .host_id = "FilterHost"});
+  host.set_message_callback(sparkplug::MessageType::NBIRTH,
+                            [&births](const sparkplug::Topic& topic, const auto& payload) {
+                              assert(topic.message_type == sparkplug::MessageType::NBIRTH);
+                              assert(payload.metrics_size() == 2);
+                              births++;
+                            });
+  host.set_message_filter(
+      [](const sparkplug::TopicView& topic) { return topic.group_id == "Wanted"; });
+
+  // Births are decoded for state even when filtered out; only the wanted one is delivered
+  host.inject_message("spBv1.0/Wanted/NBIRTH/Node01", make_payload(0, 1));
+  host.inject_message("spBv1.0/Other/NBIRTH/Node01", make_payload(0, 1));
+  assert(births == 1);
+  assert(host.get_node_state("Other", "Node01")->get().bd_seq == 1);
+
+  // Undelivered data only has its seq read, which still detects gaps
+  host.inject_message("spBv1.0/Wanted/NDATA/Node01", make_payload(1, std::nullopt));
+  host.inject_message("spBv1.0/Wanted/NDATA/Node01", make_payload(3, std::nullopt)); // gap
+  host.inject_message("spBv1.0/Other/NDATA/Node01", make_payload(1, std::nullopt));
+  const uint8_t garbage[] = {0xff, 0xff, 0xff};
+  host.inject_message("spBv1.0/Other/NDATA/Node01", garbage);
+
+  auto stats = host.stats();
+  assert(stats.payloads_skipped == 4);
+  assert(stats.seq_gaps == 1);
+  assert(stats.parse_failures == 1);
+  assert(host.get_node_state("Wanted", "Node01")->get().last_seq == 3);
+
+  // Types without their own callback fall back to the general one, still behind the filter
+  host.set_message_callback([&others](const sparkplug::Topic& topic, const auto& payload) {
+    assert(topic.message_type == sparkplug::MessageType::NDATA);
+    assert(payload.metrics_size() == 1);
+    others++;
+  });
+  host.inject_message("spBv1.0/Wanted/NDATA/Node01", make_payload(4, std::nullopt));
+  host.inject_message("spBv1.0/Other/NDATA/Node01", make_payload(2, std::nullopt));
+  assert(others == 1);
+  assert(host.stats().payloads_skipped == 5);
+  assert(host.stats().seq_gaps == 1);
+
+  // An undelivered NDEATH only has its bdSeq scanned
+  host.inject_message("spBv1.0/Other/NDEATH/Node01", make_payload(std::nullopt, 2));
+  assert(host.stats().payloads_skipped == 6);
+  assert(host.stats().bd_seq_mismatches == 1);
+  assert(!host.get_node_state("Other", "Node01")->get().is_online);
+
+  std::cout << "✓ Message filter and per-type callbacks\n";
+}
+
+void test_filtered_dispatch() {
+  sparkplug::HostApplication host(sparkplug::HostApplication::Config{
+      .broker_url = "tcp://localhost:1883",
+      .client_id = "test_stats_dispatch_host",
+      .host_id = "DispatchHost",
+      .dispatch_threads = 2,
+      .message_callback = [](const sparkplug::Topic&, const auto&) {}});
+  host.set_message_filter([](const sparkplug::TopicView& topic) {
+    return topic.message_type != sparkplug::MessageType::NDATA;
+  });
+  if (!host.connect()) {
+    std::cout << "⚠ Skipping filtered dispatch (no broker)\n";
+    return;
+  }
+
+  // Filtered NDATA is scanned on the calling thread and validated in order on the workers
+  host.inject_message("spBv1.0/Dispatch/NBIRTH/Node01", make_payload(0, 1));
+  for (uint64_t seq : {1, 2, 4, 5}) {
+    host.inject_message("spBv1.0/Dispatch/NDATA/Node01", make_payload(seq, std::nullopt));
+  }
+  auto last_seq = [&host]() {
+    auto state = host.get_node_state("Dispatch", "Node01");
+    return state ? state->get().last_seq : 0;
+  };
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (last_seq() != 5 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  auto stats = host.stats();
+  assert(last_seq() == 5);
+  assert(stats.payloads_skipped == 4);
+  assert(stats.seq_gaps == 1);
+  auto disconnected = host.disconnect();
+  assert(disconnected);
+
+  std::cout << "✓ Filtered payloads are scanned before dispatch\n";
+}
+
+void test_edge_node_publish_counters() {
+  sparkplug::EdgeNode node(sparkplug::EdgeNode::Config{.broker_url = "tcp://localhost:1883",
+                                                       .client_id = "test_stats_node",
+                                                       .group_id = "Stats",
+                                                       .edge_node_id = "Node02"});
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric("Temperature", 1.0);
+  auto offline = node.publish_data(data); // Not connected: not counted as a publish
+  assert(!offline);
+  assert(node.stats().messages_out[index_of(sparkplug::MessageType::NDATA)] == 0);
+
+  if (!node.connect()) {
+    std::cout << "⚠ Skipping EdgeNode counters (no broker)\n";
+    return;
+  }
+
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  auto birth_result = node.publish_birth(birth);
+  assert(birth_result);
+
+  for (int i = 0; i < 3; i++) {
+    sparkplug::PayloadBuilder ndata;
+    ndata.add_metric_by_alias(1, 21.0 + i);
+    auto data_result = node.publish_data(ndata);
+    assert(data_result);
+  }
+
+  sparkplug::PayloadBuilder async_data;
+  async_data.add_metric_by_alias(1, 25.0);
+  auto async_result = node.publish_data_async(async_data, [](std::expected<void, std::string>) {});
+  assert(async_result);
+  bool idle = node.wait_for_publishes(std::chrono::seconds(5));
+  assert(idle);
+
+  auto stats = node.stats();
+  assert(stats.messages_out[index_of(sparkplug::MessageType::NBIRTH)] == 1);
+  assert(stats.messages_out[index_of(sparkplug::MessageType::NDATA)] == 4);
+  assert(stats.bytes_out > 0);
+  assert(stats.publish_failures == 0);
+  assert(stats.publish_latency.count == 1);
+
+  // Counters move with the node
+  sparkplug::EdgeNode moved(std::move(node));
+  assert(moved.stats().messages_out[index_of(sparkplug::MessageType::NDATA)] == 4);
+  auto disconnected = moved.disconnect();
+  assert(disconnected);
+
+  std::cout << "✓ EdgeNode publish counters\n";
+}
+
+} // namespace
+
+int main() {
+  std::cout << "=== Stats Tests ===\n\n";
+
+  test_histogram_buckets();
+  test_host_ingest_counters();
+  test_recovery_drops_until_birth();
+  test_filtered_ingest();
+  test_filtered_dispatch();
+  test_edge_node_publish_counters();
+
+  std::cout << "\n=== All stats tests passed ===\n";
+  return 0;
+}
@@ -0,0 +1,224 @@
+// tests/test_store_forward.cpp
+// Unit tests for the store-and-forward buffer behind EdgeNode::Config::store_forward
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sparkplug/store_forward.hpp>
+
+namespace {
+
+constexpr const char* SPILL_PATH = "test_store_forward_unit.spill";
+
+// Every test frame is 1 byte of device id and 4 bytes of payload: 5 bytes in memory and
+// 11 bytes in the spill file (6 bytes of record header)
+constexpr size_t FRAME_BYTES = 5;
+constexpr size_t RECORD_BYTES = 11;
+
+std::vector<uint8_t> payload(uint8_t value) {
+  return {value, value, value, value};
+}
+
+sparkplug::StoreForwardBuffer make_buffer(size_t memory_limit, size_t spill_limit) {
+  auto buffer = sparkplug::StoreForwardBuffer::create({.enabled = true,
+                                                       .memory_limit_bytes = memory_limit,
+                                                       .spill_path = SPILL_PATH,
+                                                       .spill_limit_bytes = spill_limit,
+                                                       .drain_rate = 0});
+  assert(buffer);
+  return std::move(*buffer);
+}
+
+// Pops every frame and returns the first payload byte of each, oldest first
+std::vector<uint8_t> drain(sparkplug::StoreForwardBuffer& buffer) {
+  std::vector<uint8_t> values;
+  while (auto frame = buffer.front()) {
+    assert(frame->device_id == "D");
+    assert(frame->payload.size() == 4);
+    values.push_back(frame->payload[0]);
+    buffer.pop_front();
+  }
+  assert(buffer.empty());
+  return values;
+}
+
+} // namespace
+
+void test_memory_only_drops_oldest() {
+  auto buffer = sparkplug::StoreForwardBuffer::create({.enabled = true,
+                                                       .memory_limit_bytes = 2 * FRAME_BYTES,
+                                                       .spill_path = "",
+                                                       .spill_limit_bytes = 0,
+                                                       .drain_rate = 0});
+  assert(buffer);
+  for (uint8_t value = 1; value <= 3; value++) {
+    buffer->push("D", payload(value));
+  }
+
+  // Without a spill file the oldest frame has nowhere to go
+  assert(buffer->size() == 2);
+  assert(buffer->dropped() == 1);
+  assert(buffer->memory_bytes() == 2 * FRAME_BYTES);
+  assert(buffer->spill_bytes() == 0);
+  assert((drain(*buffer) == std::vector<uint8_t>{2, 3}));
+
+  std::cout << "✓ Memory-only buffer drops the oldest frame\n";
+}
+
+void test_spill_keeps_fifo_order() {
+  {
+    auto buffer = make_buffer(2 * FRAME_BYTES, 16 * RECORD_BYTES);
+    for (uint8_t value = 1; value <= 6; value++) {
+      buffer.push("D", payload(value));
+    }
+
+    // The two newest frames stay in memory, the older ones are on disk
+    assert(buffer.size() == 6);
+    assert(buffer.dropped() == 0);
+    assert(buffer.memory_bytes() == 2 * FRAME_BYTES);
+    assert(buffer.spill_bytes() == 4 * RECORD_BYTES);
+    assert(std::filesystem::exists(SPILL_PATH));
+
+    // Frames pushed after a partial drain still come out after the spilled ones
+    assert(buffer.front()->payload[0] == 1);
+    buffer.pop_front();
+    buffer.push("D", payload(7));
+    assert((drain(buffer) == std::vector<uint8_t>{2, 3, 4, 5, 6, 7}));
+    assert(buffer.spill_bytes() == 0);
+  }
+
+  // The spill file is scratch space and goes away with the buffer
+  assert(!std::filesystem::exists(SPILL_PATH));
+
+  std::cout << "✓ Spilled frames are replayed before newer in-memory frames\n";
+}
+
+void test_spill_compaction() {
+  // Nothing stays in memory, and the file holds exactly three records
+  auto buffer = make_buffer(0, 3 * RECORD_BYTES);
+  for (uint8_t value = 1; value <= 3; value++) {
+    buffer.push("D", payload(value));
+  }
+  assert(buffer.spill_bytes() == 3 * RECORD_BYTES);
+
+  // The tail is at the end of the file: the freed record in front is reclaimed by sliding the
+  // live records down, so nothing has to be dropped
+  buffer.pop_front();
+  buffer.push("D", payload(4));
+  assert(buffer.dropped() == 0);
+  assert(buffer.size() == 3);
+  assert(buffer.spill_bytes() == 3 * RECORD_BYTES);
+  assert((drain(buffer) == std::vector<uint8_t>{2, 3, 4}));
+
+  std::cout << "✓ Spill file is compacted before frames are dropped\n";
+}
+
+void test_spill_full_drops_oldest() {
+  auto buffer = make_buffer(0, 3 * RECORD_BYTES);
+  for (uint8_t value = 1; value <= 5; value++) {
+    buffer.push("D", payload(value));
+  }
+
+  // With no space to reclaim, the oldest records on disk make room for the new ones
+  assert(buffer.size() == 3);
+  assert(buffer.dropped() == 2);
+  assert((drain(buffer) == std::vector<uint8_t>{3, 4, 5}));
+
+  // A frame larger than the whole file cannot be spilled at all
+  buffer.push("D", std::vector<uint8_t>(4 * RECORD_BYTES, 0));
+  assert(buffer.empty());
+  assert(buffer.dropped() == 3);
+
+  std::cout << "✓ Full spill file drops the oldest frames\n";
+}
+
+void test_front_generation_tracks_removals() {
+  // One frame in memory and one in the file
+  auto buffer = make_buffer(FRAME_BYTES, RECORD_BYTES);
+  buffer.push("D", payload(1));
+  buffer.push("D", payload(2));
+
+  // Spilling moves the oldest frame but keeps it at the front
+  auto generation = buffer.front_generation();
+  assert(generation == 0 && buffer.front()->payload[0] == 1);
+
+  // An overflow that drops it does count
+  buffer.push("D", payload(3));
+  assert(buffer.dropped() == 1 && buffer.front_generation() == generation + 1);
+  assert(buffer.front()->payload[0] == 2);
+
+  // And so does popping
+  buffer.pop_front();
+  assert(buffer.front_generation() == generation + 2);
+  assert((drain(buffer) == std::vector<uint8_t>{3}));
+
+  std::cout << "✓ front_generation() changes whenever the oldest frame is removed\n";
+}
+
+void test_drain_survives_overflow_during_send() {
+  sparkplug::detail::ForwardQueue queue({.enabled = true,
+                                         .memory_limit_bytes = 2 * FRAME_BYTES,
+                                         .spill_path = "",
+                                         .spill_limit_bytes = 0,
+                                         .drain_rate = 0});
+  assert(queue.open());
+  queue.push("D", payload(1));
+  queue.push("D", payload(2));
+
+  // While frame 1 is being sent, a producer overflows the queue and frame 1 is dropped; the
+  // drain must not then pop frame 2 as if it were frame 1
+  std::mutex sent_mutex;
+  std::vector<uint8_t> sent;
+  queue.start_drain([&](const sparkplug::StoreForwardBuffer::Frame& frame)
+                        -> std::expected<void, std::string> {
+    std::lock_guard<std::mutex> lock(sent_mutex);
+    sent.push_back(frame.payload[0]);
+    if (sent.size() == 1) {
+      queue.push("D", payload(3));
+    }
+    return {};
+  });
+
+  for (int i = 0; i < 100 && queue.size() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  queue.stop();
+  assert(queue.size() == 0 && queue.dropped() == 1);
+  assert((sent == std::vector<uint8_t>{1, 2, 3}));
+
+  std::cout << "✓ Drain keeps the next frame when an overflow drops the one being sent\n";
+}
+
+void test_create_reports_bad_spill_path() {
+  auto buffer = sparkplug::StoreForwardBuffer::create(
+      {.enabled = true,
+       .memory_limit_bytes = 1024,
+       .spill_path = "/nonexistent-directory/sparkplug.spill",
+       .spill_limit_bytes = 1024,
+       .drain_rate = 0});
+  assert(!buffer);
+  assert(buffer.error().find("/nonexistent-directory/sparkplug.spill") != std::string::npos);
+
+  std::cout << "✓ Unusable spill path is reported by create()\n";
+}
+
+int main() {
+  std::cout << "=== StoreForwardBuffer Unit Tests ===\n\n";
+
+  test_memory_only_drops_oldest();
+  test_spill_keeps_fifo_order();
+  test_spill_compaction();
+  test_spill_full_drops_oldest();
+  test_front_generation_tracks_removals();
+  test_drain_survives_overflow_during_send();
+  test_create_reports_bad_spill_path();
+
+  std::cout << "\n=== All StoreForwardBuffer tests passed! ===\n";
+  return 0;
+}
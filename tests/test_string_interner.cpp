@@ -0,0 +1,110 @@
+// tests/test_string_interner.cpp
+// Unit tests for the string interner shared by HostApplication state
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sparkplug/string_interner.hpp>
+
+void test_intern_deduplicates() {
+  sparkplug::StringInterner names;
+  auto a = names.intern("Temperature");
+  std::string copy = "Temperature";
+  auto b = names.intern(copy);
+
+  assert(a == b);
+  assert(a.data() == b.data()); // same storage, not just equal text
+  assert(a == "Temperature");
+  assert(a.hash() == std::hash<std::string_view>{}("Temperature"));
+  assert(names.size() == 1);
+  assert(names.bytes() == copy.size());
+
+  assert(names.intern("").empty());
+  assert(names.find("Pressure") == std::nullopt);
+  assert(names.find("Temperature") == a);
+
+  std::cout << "✓ Interning deduplicates\n";
+}
+
+void test_heterogeneous_map() {
+  sparkplug::StringInterner names;
+  std::unordered_map<sparkplug::InternedString, int, sparkplug::InternedStringHash,
+                     std::equal_to<>>
+      map;
+  map[names.intern("Sensor01")] = 1;
+  map[names.intern("Sensor02")] = 2;
+
+  // Probing with a view must not need the string to be interned
+  [[maybe_unused]] auto it = map.find(std::string_view("Sensor02"));
+  assert(it != map.end() && it->second == 2);
+  assert(map.find(std::string_view("Sensor03")) == map.end());
+
+  std::cout << "✓ Heterogeneous lookup through InternedStringHash\n";
+}
+
+void test_concurrent_intern() {
+  sparkplug::StringInterner names;
+  constexpr int THREADS = 4;
+  std::vector<std::vector<sparkplug::InternedString>> handles(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; i++) {
+        handles[t].push_back(names.intern("metric/" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  assert(names.size() == 1000);
+  for (int t = 1; t < THREADS; t++) {
+    for (size_t i = 0; i < handles[0].size(); i++) {
+      assert(handles[t][i].data() == handles[0][i].data());
+    }
+  }
+
+  std::cout << "✓ Concurrent interning\n";
+}
+
+void test_byte_limit() {
+  sparkplug::StringInterner names(10);
+  assert(names.available() == 10);
+  assert(names.try_intern("Node01"));
+
+  // Strings already pooled are always found; new ones must fit in what is left
+  assert(names.try_intern("Node01")->data() == names.intern("Node01").data());
+  assert(names.available() == 4);
+  assert(!names.try_intern("Node02"));
+  assert(names.try_intern("Dev1"));
+  assert(names.available() == 0);
+  assert(names.try_intern("")); // The empty string is never stored
+
+  // intern() is for trusted text and ignores the limit
+  assert(names.intern("Node02") == "Node02");
+  assert(names.bytes() == 16 && names.available() == 0);
+
+  names.set_max_bytes(0);
+  assert(names.available() == SIZE_MAX);
+  assert(names.try_intern("Node03"));
+  assert(sparkplug::StringInterner().available() == SIZE_MAX);
+
+  std::cout << "✓ Byte limit applies to try_intern()\n";
+}
+
+int main() {
+  std::cout << "=== StringInterner Unit Tests ===\n\n";
+
+  test_intern_deduplicates();
+  test_heterogeneous_map();
+  test_concurrent_intern();
+  test_byte_limit();
+
+  std::cout << "\n=== All StringInterner tests passed! ===\n";
+  return 0;
+}
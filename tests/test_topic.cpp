@@ -71,6 +71,48 @@ void test_parse_state_topic() {
   std::cout << "✓ Parse STATE topic\n";
 }
 
+void test_topic_view_parse() {
+  std::string_view raw = "spBv1.0/Energy/DDATA/Gateway01/Sensor01";
+  auto result = sparkplug::TopicView::parse(raw);
+  assert(result.has_value());
+
+  [[maybe_unused]] auto& view = *result;
+  assert(view.group_id == "Energy");
+  assert(view.message_type == sparkplug::MessageType::DDATA);
+  assert(view.edge_node_id == "Gateway01");
+  assert(view.device_id == "Sensor01");
+
+  // Views point into the original buffer
+  assert(view.edge_node_id.data() == raw.data() + 21);
+
+  [[maybe_unused]] auto owned = view.to_topic();
+  assert(owned.to_string() == raw);
+  std::cout << "✓ Parse TopicView\n";
+}
+
+void test_topic_view_message_types() {
+  using sparkplug::MessageType;
+  constexpr MessageType types[] = {MessageType::NBIRTH, MessageType::NDEATH, MessageType::DBIRTH,
+                                   MessageType::DDEATH, MessageType::NDATA,  MessageType::DDATA,
+                                   MessageType::NCMD,   MessageType::DCMD};
+  for (auto type : types) {
+    sparkplug::Topic topic{
+        .group_id = "G", .message_type = type, .edge_node_id = "N", .device_id = ""};
+    auto str = topic.to_string();
+    [[maybe_unused]] auto result = sparkplug::TopicView::parse(str);
+    assert(result.has_value());
+    assert(result->message_type == type);
+  }
+
+  assert(!sparkplug::TopicView::parse("spBv1.0/G/NBIRTX/N").has_value());
+  assert(!sparkplug::TopicView::parse("spBv1.0/G/XCMD/N").has_value());
+  assert(!sparkplug::TopicView::parse("spBv1.0/G/ddata/N").has_value());
+  assert(!sparkplug::TopicView::parse("spBv1.0/G/DATA/N").has_value());
+  assert(!sparkplug::TopicView::parse("spBv1.0/").has_value());
+  assert(!sparkplug::TopicView::parse("").has_value());
+  std::cout << "✓ TopicView message type dispatch\n";
+}
+
 int main() {
   test_topic_to_string();
   test_topic_with_device();
@@ -78,6 +120,8 @@ int main() {
   test_parse_topic();
   test_parse_device_topic();
   test_parse_state_topic();
+  test_topic_view_parse();
+  test_topic_view_message_types();
 
   std::cout << "\nAll tests passed!\n";
   return 0;
@@ -0,0 +1,121 @@
+// tests/test_value_store.cpp
+// Unit tests for the last-known-value store used by HostApplication
+#include <cassert>
+#include <iostream>
+
+#include <sparkplug/payload_builder.hpp>
+#include <sparkplug/value_store.hpp>
+
+void test_rebuild_and_lookup() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Temperature", 1, 20.5);
+  birth.add_metric_with_alias("Running", 2, true);
+  birth.add_metric("bdSeq", static_cast<uint64_t>(1)); // no alias, found by name only
+
+  sparkplug::StringInterner names;
+  sparkplug::ValueStore store;
+  store.rebuild(birth.payload(), names);
+
+  assert(store.size() == 3);
+  [[maybe_unused]] const auto* entry = store.find("Temperature");
+  assert(entry != nullptr);
+  assert(entry->has_alias && entry->alias == 1);
+  assert(entry->datatype == sparkplug::DataType::Double);
+  assert(std::get<double>(entry->value) == 20.5);
+  assert(store.find(static_cast<uint64_t>(1)) == entry);
+  assert(std::get<uint64_t>(store.find("bdSeq")->value) == 1);
+  assert(!store.find("bdSeq")->has_alias);
+  assert(store.find("Missing") == nullptr);
+  assert(store.find(static_cast<uint64_t>(3)) == nullptr);
+
+  std::cout << "✓ Rebuild and lookup\n";
+}
+
+void test_update_by_alias_and_name() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Counter", 1, static_cast<int32_t>(0));
+  birth.add_metric("Label", "idle");
+
+  sparkplug::StringInterner names;
+  sparkplug::ValueStore store;
+  store.rebuild(birth.payload(), names);
+
+  sparkplug::PayloadBuilder data;
+  data.add_metric_by_alias(1, static_cast<int32_t>(-5), 1234);
+  data.add_metric("Label", "busy");
+  data.add_metric("Undeclared", 1); // not in the birth, ignored
+
+  [[maybe_unused]] auto updated = store.update(data.payload());
+  assert(updated == 2);
+  assert(std::get<int64_t>(store.find("Counter")->value) == -5);
+  assert(store.find("Counter")->timestamp == 1234);
+  assert(std::get<std::string>(store.find("Label")->value) == "busy");
+  assert(store.find("Undeclared") == nullptr);
+
+  std::cout << "✓ Updates by alias and by name\n";
+}
+
+void test_historical_does_not_replace_newer_value() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("Level", 1, 0.0);
+
+  sparkplug::StringInterner names;
+  sparkplug::ValueStore store;
+  store.rebuild(birth.payload(), names);
+
+  sparkplug::PayloadBuilder live;
+  live.add_metric_by_alias(1, 3.0, 3000);
+  store.update(live.payload());
+
+  // Replayed store-and-forward data older than the live value is dropped
+  sparkplug::PayloadBuilder replay;
+  replay.add_metric_by_alias(1, 2.0, 2000);
+  replay.mutable_payload().mutable_metrics(0)->set_is_historical(true);
+  [[maybe_unused]] auto updated = store.update(replay.payload());
+  assert(updated == 0);
+  assert(std::get<double>(store.find("Level")->value) == 3.0);
+  assert(store.find("Level")->timestamp == 3000);
+  assert(!store.find("Level")->is_historical);
+
+  // History newer than anything seen yet is still the last known value
+  replay.mutable_payload().mutable_metrics(0)->set_timestamp(4000);
+  updated = store.update(replay.payload());
+  assert(updated == 1);
+  assert(std::get<double>(store.find("Level")->value) == 2.0);
+  assert(store.find("Level")->timestamp == 4000);
+  assert(store.find("Level")->is_historical);
+
+  std::cout << "✓ Historical values do not replace newer ones\n";
+}
+
+void test_sparse_aliases_and_copy() {
+  sparkplug::PayloadBuilder birth;
+  birth.add_metric_with_alias("A", 10, 1);
+  birth.add_metric_with_alias("B", 5'000'000, 2);
+
+  sparkplug::StringInterner names;
+  sparkplug::ValueStore store;
+  store.rebuild(birth.payload(), names);
+  assert(store.find(static_cast<uint64_t>(5'000'000))->name == "B");
+
+  // The copy's name index must point at its own entries
+  sparkplug::ValueStore copy = store;
+  store.clear();
+  assert(store.empty());
+  assert(copy.find("A") != nullptr && copy.find("A") == copy.find(static_cast<uint64_t>(10)));
+  assert(copy.find("A") == &copy.entries()[0]);
+
+  std::cout << "✓ Sparse aliases and copies\n";
+}
+
+int main() {
+  std::cout << "=== ValueStore Unit Tests ===\n\n";
+
+  test_rebuild_and_lookup();
+  test_update_by_alias_and_name();
+  test_historical_does_not_replace_newer_value();
+  test_sparse_aliases_and_copy();
+
+  std::cout << "\n=== All ValueStore tests passed! ===\n";
+  return 0;
+}
@@ -0,0 +1,133 @@
+// tests/test_worker_thread.cpp
+// Unit tests for the background thread shared by the library's worker loops
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <sparkplug/worker_thread.hpp>
+
+namespace {
+
+using sparkplug::detail::WorkerThread;
+
+// Polls until done() holds, for up to a second
+template <typename Done> bool eventually(Done done) {
+  for (int i = 0; i < 100 && !done(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return done();
+}
+
+} // namespace
+
+void test_stop_interrupts_wait() {
+  WorkerThread thread;
+  std::atomic<int> runs{0};
+  bool started = thread.start([&](const WorkerThread::Run& worker) {
+    while (!worker.wait_for(std::chrono::hours(1))) {
+      runs++;
+    }
+  });
+  assert(started && thread.running());
+
+  // A second body is refused while the first runs
+  assert(!thread.start([](const WorkerThread::Run&) {}));
+
+  auto stopping = std::chrono::steady_clock::now();
+  thread.stop();
+  assert(std::chrono::steady_clock::now() - stopping < std::chrono::seconds(1));
+  assert(!thread.running() && runs == 0);
+
+  std::cout << "✓ stop() interrupts a waiting body and joins it\n";
+}
+
+void test_restart_after_return() {
+  WorkerThread thread;
+  std::atomic<int> runs{0};
+  auto body = [&](const WorkerThread::Run& worker) {
+    assert(!worker.stopped());
+    runs++;
+  };
+
+  // A body that returned on its own leaves the thread ready for the next start()
+  assert(thread.start(body));
+  assert(eventually([&] { return !thread.running(); }));
+  assert(thread.start(body));
+  assert(eventually([&] { return !thread.running(); }));
+  assert(runs == 2);
+
+  // And so does stop()
+  thread.stop();
+  assert(thread.start(body));
+  assert(eventually([&] { return runs == 3; }));
+
+  std::cout << "✓ The thread can be started again after its body returned or was stopped\n";
+}
+
+void test_notify_wakes_wait() {
+  WorkerThread thread;
+  bool pending = false; // Guarded by thread (notify() and Run::wait())
+  std::atomic<int> handled{0};
+  bool started = thread.start([&](const WorkerThread::Run& worker) {
+    while (!worker.wait([&] { return std::exchange(pending, false); })) {
+      handled++;
+    }
+  });
+  assert(started);
+
+  thread.notify([&] { pending = true; });
+  assert(eventually([&] { return handled == 1; }));
+  thread.notify([&] { pending = true; });
+  assert(eventually([&] { return handled == 2; }));
+
+  thread.stop();
+  assert(handled == 2);
+
+  std::cout << "✓ notify() wakes a body waiting for its state\n";
+}
+
+void test_stop_from_body_detaches() {
+  std::atomic<bool> detached{false};
+  std::atomic<bool> release{false};
+  std::atomic<bool> returned{false};
+  {
+    auto thread = std::make_unique<WorkerThread>();
+    bool started = thread->start([&, owner = thread.get()](const WorkerThread::Run& worker) {
+      owner->stop();
+      detached = true;
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      // The owner is gone by now, but the run still answers
+      assert(worker.stopped());
+      returned = true;
+    });
+    assert(started);
+    assert(eventually([&] { return detached.load(); }));
+
+    // The detached body still runs, so a new one is refused until it returns
+    assert(thread->running());
+    assert(!thread->start([](const WorkerThread::Run&) {}));
+  }
+
+  release = true;
+  assert(eventually([&] { return returned.load(); }));
+
+  std::cout << "✓ A body that stops itself is detached and may outlive its owner\n";
+}
+
+int main() {
+  std::cout << "=== WorkerThread Unit Tests ===\n\n";
+
+  test_stop_interrupts_wait();
+  test_restart_after_return();
+  test_notify_wakes_wait();
+  test_stop_from_body_detaches();
+
+  std::cout << "\n=== All WorkerThread tests passed! ===\n";
+  return 0;
+}